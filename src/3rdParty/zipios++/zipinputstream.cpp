@@ -58,6 +58,10 @@ ConstEntryPointer ZipInputStream::getNextEntry() {
   return izf->getNextEntry() ;
 }
 
+std::streamoff ZipInputStream::getDataOffset() const {
+  return izf->getDataOffset() ;
+}
+
 ZipInputStream::~ZipInputStream() {
   // It's ok to call delete with a Null pointer.
   delete izf ;
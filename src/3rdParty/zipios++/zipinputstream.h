@@ -49,6 +49,10 @@ public:
   */
   ConstEntryPointer getNextEntry() ;
 
+  /** Returns the position of the data of the current entry in the
+      underlying stream, e.g. to access STORED entries directly. */
+  std::streamoff getDataOffset() const ;
+
   /** Destructor. */
   virtual ~ZipInputStream() ;
 
@@ -39,6 +39,10 @@ public:
   */
   ConstEntryPointer getNextEntry() ;
 
+  /** Returns the position of the data of the current entry in the
+      underlying streambuf. */
+  int getDataOffset() const { return _data_start ; }
+
   /** Destructor. */
   virtual ~ZipInputStreambuf() ;
 protected:
@@ -63,6 +63,13 @@ void ZipOutputStream::putNextEntry(const std::string& entryName) {
   putNextEntry( ZipCDirEntry(entryName));
 }
 
+void ZipOutputStream::putRawEntry( const std::string &entryName, const char *data, 
+                                   uint32 compressed_size, uint32 crc, uint32 size,
+                                   StorageMethod method, int alignment ) {
+  ozf->putRawEntry( ZipCDirEntry( entryName ), data, compressed_size, crc, size,
+                    method, alignment ) ;
+}
+
 
 void ZipOutputStream::setComment( const std::string &comment ) {
   ozf->setComment( comment ) ;
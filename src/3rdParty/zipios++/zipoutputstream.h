@@ -54,6 +54,12 @@ public:
   */
   void putNextEntry(const std::string& entryName);
 
+  /** Writes a complete entry of already deflated or STORED data.
+      \see ZipOutputStreambuf::putRawEntry() */
+  void putRawEntry( const std::string &entryName, const char *data, 
+                    uint32 compressed_size, uint32 crc, uint32 size,
+                    StorageMethod method = DEFLATED, int alignment = 0 ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const std::string& comment ) ;
 
@@ -81,6 +81,49 @@ void ZipOutputStreambuf::putNextEntry( const ZipCDirEntry &entry ) {
 }
 
 
+void ZipOutputStreambuf::putRawEntry( const ZipCDirEntry &entry, const char *data, 
+                                      uint32 compressed_size, uint32 crc, uint32 size,
+                                      StorageMethod method, int alignment ) {
+  if ( _open_entry )
+    closeEntry() ;
+
+  _entries.push_back( entry ) ;
+  ZipCDirEntry &ent = _entries.back() ;
+
+  ostream os( _outbuf ) ;
+
+  ent.setLocalHeaderOffset( os.tellp() ) ;
+  ent.setMethod( method ) ;
+  ent.setSize( size ) ;
+  ent.setCrc( crc ) ;
+  ent.setCompressedSize( compressed_size ) ;
+  ent.setTime( currentDosTime() ) ;
+
+  if ( alignment > 1 ) {
+    // Padding extra field as used by zipalign: header id 0xd935, data size,
+    // the alignment and zeros
+    const int header = 6 ;
+    ent.setExtra( vector< unsigned char >() ) ;
+    int start = ent.getLocalHeaderOffset() + ent.getLocalHeaderSize() + header ;
+    int padding = ( alignment - start % alignment ) % alignment ;
+    vector< unsigned char > extra( header + padding, 0 ) ;
+    extra[ 0 ] = 0x35 ;
+    extra[ 1 ] = 0xd9 ;
+    extra[ 2 ] = static_cast< unsigned char >( ( 2 + padding ) & 0xff ) ;
+    extra[ 3 ] = static_cast< unsigned char >( ( 2 + padding ) >> 8 ) ;
+    extra[ 4 ] = static_cast< unsigned char >( alignment & 0xff ) ;
+    extra[ 5 ] = static_cast< unsigned char >( alignment >> 8 ) ;
+    ent.setExtra( extra ) ;
+    os << static_cast< ZipLocalEntry >( ent ) ;
+    // the central directory doesn't need the padding
+    ent.setExtra( vector< unsigned char >() ) ;
+  }
+  else
+    os << static_cast< ZipLocalEntry >( ent ) ;
+  os.write( data, compressed_size ) ;
+}
+
+
 void ZipOutputStreambuf::setComment( const string &comment ) {
   _zip_comment = comment ;
 }
@@ -146,14 +189,7 @@ void ZipOutputStreambuf::updateEntryHeaderInfo() {
   entry.setCompressedSize( curr_pos - entry.getLocalHeaderOffset() 
 			   - entry.getLocalHeaderSize() ) ;
 
-  // Mark Donszelmann: added current date and time
-  time_t ltime;
-  time( &ltime );
-  struct tm *now;
-  now = localtime( &ltime );
-  int dosTime = (now->tm_year - 80) << 25 | (now->tm_mon + 1) << 21 | now->tm_mday << 16 |
-              now->tm_hour << 11 | now->tm_min << 5 | now->tm_sec >> 1;
-  entry.setTime(dosTime);
+  entry.setTime( currentDosTime() ) ;
 
   // write ZipLocalEntry header to header position
   os.seekp( entry.getLocalHeaderOffset() ) ;
@@ -162,6 +198,17 @@ void ZipOutputStreambuf::updateEntryHeaderInfo() {
 }
 
 
+int ZipOutputStreambuf::currentDosTime() {
+  // Mark Donszelmann: added current date and time
+  time_t ltime;
+  time( &ltime );
+  struct tm *now;
+  now = localtime( &ltime );
+  return (now->tm_year - 80) << 25 | (now->tm_mon + 1) << 21 | now->tm_mday << 16 |
+         now->tm_hour << 11 | now->tm_min << 5 | now->tm_sec >> 1;
+}
+
+
 void ZipOutputStreambuf::writeCentralDirectory( const vector< ZipCDirEntry > &entries, 
 						EndOfCentralDirectory eocd, 
 						ostream &os ) {
@@ -49,6 +49,23 @@ public:
       entry. */
   void putNextEntry( const ZipCDirEntry &entry ) ;
 
+  /** Writes a complete entry whose data has already been compressed
+      with raw deflate (no zlib header) by the caller. Any open entry is
+      closed first. This allows entries to be compressed concurrently
+      while the archive itself is still written sequentially.
+      @param entry the entry to write.
+      @param data the raw deflated data, or the data itself for STORED.
+      @param compressed_size size of data in bytes.
+      @param crc the crc32 of the uncompressed data.
+      @param size the size of the uncompressed data.
+      @param method DEFLATED or STORED.
+      @param alignment if greater than 1 the extra field of the local
+      header is padded so that the data starts at a multiple of alignment
+      bytes in the archive. */
+  void putRawEntry( const ZipCDirEntry &entry, const char *data, 
+                    uint32 compressed_size, uint32 crc, uint32 size,
+                    StorageMethod method = DEFLATED, int alignment = 0 ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const string &comment ) ;
 
@@ -68,6 +85,7 @@ protected:
 
   void setEntryClosedState() ;
   void updateEntryHeaderInfo() ;
+  static int currentDosTime() ;
 
   // Should/could be moved to zipheadio.h ?!
   static void writeCentralDirectory( const vector< ZipCDirEntry > &entries, 
@@ -38,6 +38,8 @@
 # include <boost/scope_exit.hpp>
 # include <chrono>
 # include <random>
+# include <atomic>
+# include <future>
 # include <memory>
 # include <utility>
 # include <set>
@@ -91,7 +93,9 @@
 #include <Base/PlacementPy.h>
 #include <Base/PrecisionPy.h>
 #include <Base/ProgressIndicatorPy.h>
+#include <Base/Reader.h>
 #include <Base/RotationPy.h>
+#include <Base/ThreadPool.h>
 #include <Base/UniqueNameManager.h>
 #include <Base/Tools.h>
 #include <Base/Translate.h>
@@ -668,6 +672,83 @@ public:
     }
 };
 
+// Reads project files on a thread pool before they are restored. Only the file
+// I/O and the decompression run in parallel, the documents are still restored
+// on the main thread in the order of Application::openDocuments(). A partially
+// loaded document is read completely, unused files are simply skipped. With
+// lazy restore only Document.xml is inflated in advance, as most data files
+// are then read on demand.
+class DocPrefetcher {
+public:
+    using ArchivePtr = std::shared_ptr<const Base::PrefetchedArchive>;
+
+    DocPrefetcher(unsigned int threads, bool inflateFiles)
+        : inflateFiles(inflateFiles)
+    {
+        if(threads)
+            pool = std::make_unique<Base::ThreadPool>(threads);
+    }
+    ~DocPrefetcher() {
+        // don't read the files still waiting in the queue
+        *cancelled = true;
+    }
+
+    DocPrefetcher(const DocPrefetcher&) = delete;
+    DocPrefetcher(DocPrefetcher&&) = delete;
+    DocPrefetcher& operator=(const DocPrefetcher&) = delete;
+    DocPrefetcher& operator=(DocPrefetcher&&) = delete;
+
+    bool isEnabled() const {
+        return !!pool;
+    }
+
+    // Number of files to read ahead, which bounds the memory held by the
+    // decompressed archives
+    std::size_t lookAhead() const {
+        return pool ? 2 * pool->threadCount() : 0;
+    }
+
+    void prefetch(const std::string &path) {
+        if(!pool || !files.emplace(path, std::future<ArchivePtr>()).second)
+            return;
+        auto promise = std::make_shared<std::promise<ArchivePtr>>();
+        files[path] = promise->get_future();
+        pool->start([promise, path, cancelled=cancelled, inflate=inflateFiles]() {
+            try {
+                if(*cancelled)
+                    promise->set_value(nullptr);
+                else
+                    promise->set_value(Base::PrefetchedArchive::read(path, inflate));
+            }
+            catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+    }
+
+    // Returns the archive of path, null if it hasn't been prefetched or if
+    // reading has failed, in which case restoring reports the error.
+    ArchivePtr take(const std::string &path) {
+        auto it = files.find(path);
+        if(it == files.end())
+            return {};
+        auto future = std::move(it->second);
+        files.erase(it);
+        try {
+            return future.get();
+        }
+        catch (...) {
+            return {};
+        }
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled = std::make_shared<std::atomic<bool>>(false);
+    std::map<std::string, std::future<ArchivePtr>> files;
+    std::unique_ptr<Base::ThreadPool> pool;
+    bool inflateFiles;
+};
+
 Document* Application::openDocument(const char * FileName, DocumentInitFlags initFlags) {
     std::vector<std::string> filenames(1,FileName);
     auto docs = openDocuments(filenames, nullptr, nullptr, nullptr, initFlags);
@@ -737,6 +818,14 @@ std::vector<Document*> Application::openDocuments(const std::vector<std::string>
     ParameterGrp::handle hGrp = GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
     _allowPartial = !hGrp->GetBool("NoPartialLoading",false);
 
+    unsigned int prefetchThreads = 0;
+    if (hGrp->GetBool("ParallelOpen", false)) {
+        long threads = hGrp->GetInt("OpenThreads", 0);
+        prefetchThreads = threads > 0 ? static_cast<unsigned int>(threads)
+                                      : Base::ThreadPool::idealThreadCount();
+    }
+    DocPrefetcher prefetcher(prefetchThreads, !hGrp->GetBool("LazyRestore", false));
+
     for (auto &name : filenames)
         _pendingDocs.emplace_back(name.c_str());
 
@@ -750,6 +839,20 @@ std::vector<Document*> Application::openDocuments(const std::vector<std::string>
     do {
         std::set<DocumentT> newDocs;
         for (std::size_t count=0;; ++count) {
+            if (prefetcher.isEnabled()) {
+                // Keep the workers busy with the next files in the queue,
+                // including the external links found by the previous document
+                std::size_t ahead = 0;
+                for (auto it = _pendingDocs.begin();
+                        it != _pendingDocs.end() && ahead < prefetcher.lookAhead(); ++it, ++ahead) {
+                    std::size_t index = count + ahead;
+                    if (pass == 0 && index < filenames.size() && paths && paths->size() > index)
+                        prefetcher.prefetch((*paths)[index]);
+                    else if (!getDocumentByPath(it->c_str()))
+                        prefetcher.prefetch(*it);
+                }
+            }
+
             std::string name = std::move(_pendingDocs.front());
             _pendingDocs.pop_front();
             bool isMainDoc = (pass == 0 && count < filenames.size());
@@ -781,7 +884,8 @@ std::vector<Document*> Application::openDocuments(const std::vector<std::string>
                         label = (*labels)[count].c_str();
                 }
 
-                auto doc = openDocumentPrivate(path, name.c_str(), label, isMainDoc, initFlags, std::move(objNames));
+                auto doc = openDocumentPrivate(path, name.c_str(), label, isMainDoc, initFlags,
+                                               std::move(objNames), prefetcher.take(path));
                 FC_DURATION_PLUS(timing.d1,t1);
                 if (doc) {
                     timings[doc].d1 += timing.d1;
@@ -921,7 +1025,8 @@ std::vector<Document*> Application::openDocuments(const std::vector<std::string>
 Document* Application::openDocumentPrivate(const char * FileName,
         const char *propFileName, const char *label,
         bool isMainDoc, DocumentInitFlags initFlags,
-        std::vector<std::string> &&objNames)
+        std::vector<std::string> &&objNames,
+        const std::shared_ptr<const Base::PrefetchedArchive> &archive)
 {
     Base::FileInfo File(FileName);
 
@@ -1001,7 +1106,7 @@ Document* Application::openDocumentPrivate(const char * FileName,
 
     try {
         // read the document
-        newDoc->restore(File.filePath().c_str(),true,objNames);
+        newDoc->restore(File.filePath().c_str(),true,objNames,archive);
         if(!DocFileMap.empty())
             DocFileMap[Base::FileInfo(newDoc->FileName.getValue()).filePath()] = newDoc;
         return newDoc;
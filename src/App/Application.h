@@ -28,6 +28,7 @@
 #include <QtCore/qtextstream.h>
 
 #include <deque>
+#include <memory>
 #include <vector>
 #include <list>
 #include <set>
@@ -46,6 +47,7 @@ namespace Base
 {
 class ConsoleObserverStd;
 class ConsoleObserverFile;
+class PrefetchedArchive;
 }
 
 namespace App
@@ -127,6 +129,10 @@ public:
      * name, which maybe NULL if failed.
      *
      * This function will also open any external referenced files.
+     *
+     * With the parameter BaseApp/Preferences/Document/ParallelOpen the files
+     * waiting to be opened are read and decompressed on a thread pool ahead
+     * of time. The documents themselves are still restored one at a time.
      */
     std::vector<Document*> openDocuments(const std::vector<std::string> &filenames,
             const std::vector<std::string> *paths=nullptr,
@@ -513,7 +519,8 @@ protected:
 
     /// open single document only
     App::Document* openDocumentPrivate(const char * FileName, const char *propFileName,
-            const char *label, bool isMainDoc, DocumentInitFlags initFlags, std::vector<std::string> &&objNames);
+            const char *label, bool isMainDoc, DocumentInitFlags initFlags, std::vector<std::string> &&objNames,
+            const std::shared_ptr<const Base::PrefetchedArchive> &archive = {});
 
     /// Helper class for App::Document to signal on close/abort transaction
     class AppExport TransactionSignaller {
@@ -23,10 +23,14 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <atomic>
 #include <bitset>
+#include <condition_variable>
+#include <functional>
 #include <stack>
 #include <deque>
 #include <iostream>
+#include <limits>
 #include <utility>
 #include <set>
 #include <memory>
@@ -36,6 +40,7 @@
 #include <list>
 #include <algorithm>
 #include <filesystem>
+#include <mutex>
 #endif
 
 #include <boost/algorithm/string.hpp>
@@ -43,6 +48,7 @@
 #include <boost/graph/strong_components.hpp>
 
 #include <boost/regex.hpp>
+#include <boost/scope_exit.hpp>
 #include <random>
 #include <unordered_map>
 #include <unordered_set>
@@ -55,6 +61,7 @@
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <Base/ParameterCache.h>
 #include <Base/TimeInfo.h>
 #include <Base/Reader.h>
 #include <Base/Writer.h>
@@ -63,6 +70,7 @@
 #include <Base/Uuid.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
+#include <Base/ThreadPool.h>
 #include <Base/UnitsApi.h>
 
 #include "Document.h"
@@ -125,6 +133,58 @@ DocumentP::DocumentP()
 
 }  // namespace App
 
+namespace
+{
+// A property change signal recorded on a worker thread of a parallel recompute
+struct DeferredChange
+{
+    const DocumentObject* obj;
+    const Property* prop;
+    Document::DeferredSignal type;
+};
+
+// A worker thread of a parallel recompute
+struct RecomputeWorker
+{
+    // EarlyChange and Changed signals, emitted once the object has finished
+    std::vector<DeferredChange> changes;
+    // Emits a BeforeChange signal on the calling thread and waits for it
+    std::function<void(const DocumentObject*, const Property*)> beforeChange;
+};
+
+// Set while a worker thread executes an object of a parallel recompute
+thread_local RecomputeWorker* _RecomputeWorker = nullptr;
+
+// Parameters of BaseApp/Preferences/Document that are read on every recompute, save or restore
+struct DocumentParameters
+{
+    ParameterGrp::handle hGrp =
+        GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
+    Base::ParameterCache<bool> canAbortRecompute {hGrp, "CanAbortRecompute", true};
+    Base::ParameterCache<bool> recomputeProfile {hGrp, "RecomputeProfile", false};
+    Base::ParameterCache<bool> parallelRecompute {hGrp, "ParallelRecompute", false};
+    Base::ParameterCache<long> recomputeThreads {hGrp, "RecomputeThreads", 0};
+    Base::ParameterCache<bool> checkExtension {hGrp, "CheckExtension", true};
+    Base::ParameterCache<bool> setAuthorOnSave {hGrp, "prefSetAuthorOnSave", false};
+    Base::ParameterCache<long> compressionLevel {hGrp, "CompressionLevel", 7};
+    Base::ParameterCache<bool> backupPolicy {hGrp, "BackupPolicy", true};
+    Base::ParameterCache<long> saveThreads {hGrp, "SaveThreads", 1};
+    Base::ParameterCache<bool> saveBinaryBrep {hGrp, "SaveBinaryBrep", false};
+    Base::ParameterCache<bool> storeBinaryUncompressed {hGrp, "StoreBinaryUncompressed", false};
+    Base::ParameterCache<long> countBackupFiles {hGrp, "CountBackupFiles", 1};
+    Base::ParameterCache<bool> createBackupFiles {hGrp, "CreateBackupFiles", true};
+    Base::ParameterCache<bool> useFCBakExtension {hGrp, "UseFCBakExtension", true};
+    Base::ParameterCache<bool> xmlPullParser {hGrp, "XMLPullParser", false};
+    Base::ParameterCache<bool> lazyRestore {hGrp, "LazyRestore", false};
+
+    static const DocumentParameters& instance()
+    {
+        static DocumentParameters params;
+        return params;
+    }
+};
+}  // namespace
+
 PROPERTY_SOURCE(App::Document, App::PropertyContainer)
 
 bool Document::testStatus(const Status pos) const
@@ -189,8 +249,10 @@ bool Document::undo(const int id)
             // save the redo
             mRedoMap[d->activeUndoTransaction->getID()] = d->activeUndoTransaction;
             mRedoTransactions.push_back(d->activeUndoTransaction);
+            d->RedoMemUsed += d->activeUndoTransaction->storeDataSize();
             d->activeUndoTransaction = nullptr;
 
+            d->UndoMemUsed -= mUndoTransactions.back()->getStoredDataSize();
             mUndoMap.erase(mUndoTransactions.back()->getID());
             delete mUndoTransactions.back();
             mUndoTransactions.pop_back();
@@ -241,8 +303,10 @@ bool Document::redo(const int id)
 
             mUndoMap[d->activeUndoTransaction->getID()] = d->activeUndoTransaction;
             mUndoTransactions.push_back(d->activeUndoTransaction);
+            d->UndoMemUsed += d->activeUndoTransaction->storeDataSize();
             d->activeUndoTransaction = nullptr;
 
+            d->RedoMemUsed -= mRedoTransactions.back()->getStoredDataSize();
             mRedoMap.erase(mRedoTransactions.back()->getID());
             delete mRedoTransactions.back();
             mRedoTransactions.pop_back();
@@ -269,6 +333,7 @@ void Document::changePropertyOfObject(TransactionalObject* obj,
     if (!prop || !obj || !obj->isAttachedToDocument()) {
         return;
     }
+    auto lock = d->lockTransaction();
     if ((d->iUndoMode != 0) && !isPerformingTransaction() && !d->activeUndoTransaction) {
         if (!testStatus(Restoring) || testStatus(Importing)) {
             int tid = 0;
@@ -461,6 +526,7 @@ void Document::_clearRedos()
         delete mRedoTransactions.back();
         mRedoTransactions.pop_back();
     }
+    d->RedoMemUsed = 0;
 }
 
 void Document::commitTransaction() // NOLINT
@@ -495,13 +561,9 @@ void Document::_commitTransaction(const bool notify)
         Application::TransactionSignaller signaller(false, true);
         const int id = d->activeUndoTransaction->getID();
         mUndoTransactions.push_back(d->activeUndoTransaction);
+        d->UndoMemUsed += d->activeUndoTransaction->storeDataSize();
         d->activeUndoTransaction = nullptr;
-        // check the stack for the limits
-        if (mUndoTransactions.size() > d->UndoMaxStackSize) {
-            mUndoMap.erase(mUndoTransactions.front()->getID());
-            delete mUndoTransactions.front();
-            mUndoTransactions.pop_front();
-        }
+        _checkUndoLimits();
         signalCommitTransaction(*this);
 
         // closeActiveTransaction() may call again _commitTransaction()
@@ -511,6 +573,33 @@ void Document::_commitTransaction(const bool notify)
     }
 }
 
+void Document::_checkUndoLimits()
+{
+    // check the stack for the limits
+    if (mUndoTransactions.size() > d->UndoMaxStackSize) {
+        d->UndoMemUsed -= mUndoTransactions.front()->getStoredDataSize();
+        mUndoMap.erase(mUndoTransactions.front()->getID());
+        delete mUndoTransactions.front();
+        mUndoTransactions.pop_front();
+    }
+
+    if (d->UndoMemSize == 0) {
+        return;
+    }
+
+    // Drop the oldest transactions until the stack fits into the memory limit.
+    // As in clearUndos() they must be deleted from front to back.
+    while (d->UndoMemUsed > d->UndoMemSize && mUndoTransactions.size() > 1) {
+        Transaction* transaction = mUndoTransactions.front();
+        d->UndoMemUsed -= transaction->getStoredDataSize();
+        FC_LOG("drop undo '" << transaction->Name << "' of " << getName()
+                             << " to fit into the memory limit");
+        mUndoMap.erase(transaction->getID());
+        delete transaction;
+        mUndoTransactions.pop_front();
+    }
+}
+
 void Document::abortTransaction() const
 {
     if (isPerformingTransaction() || d->committing) {
@@ -635,6 +724,7 @@ void Document::clearUndos()
         delete mUndoTransactions.front();
         mUndoTransactions.pop_front();
     }
+    d->UndoMemUsed = 0;
     // while (!mUndoTransactions.empty()) {
     //     delete mUndoTransactions.back();
     //     mUndoTransactions.pop_back();
@@ -701,14 +791,26 @@ int Document::getUndoMode() const
     return d->iUndoMode;
 }
 
-unsigned int Document::getUndoMemSize() const
+std::size_t Document::getUndoMemSize() const
 {
-    return d->UndoMemSize;
+    std::size_t size = d->UndoMemUsed + d->RedoMemUsed;
+    if (d->activeUndoTransaction) {
+        size += d->activeUndoTransaction->getDataSize();
+    }
+    return size;
 }
 
-void Document::setUndoLimit(const unsigned int UndoMemSize) // NOLINT
+void Document::setUndoLimit(const std::size_t UndoMemSize) // NOLINT
 {
     d->UndoMemSize = UndoMemSize;
+    if (!isPerformingTransaction() && !d->committing) {
+        _checkUndoLimits();
+    }
+}
+
+std::size_t Document::getUndoLimit() const
+{
+    return d->UndoMemSize;
 }
 
 void Document::setMaxUndoStackSize(const unsigned int UndoMaxStackSize) // NOLINT
@@ -793,10 +895,13 @@ void Document::onChanged(const Property* prop)
 
 void Document::onBeforeChangeProperty(const TransactionalObject* Who, const Property* What)
 {
-    if (Who->isDerivedFrom<DocumentObject>()) {
+    // on a worker thread DocumentObject has the signal emitted by the calling thread
+    if (Who->isDerivedFrom<DocumentObject>() && !_RecomputeWorker) {
         signalBeforeChangeObject(*static_cast<const DocumentObject*>(Who), *What);
     }
     if (!d->rollback && !globalIsRelabeling) {
+        // objects executed on the calling thread may change properties as well
+        auto lock = d->lockTransaction();
         _checkTransaction(nullptr, What, __LINE__);
         if (d->activeUndoTransaction) {
             d->activeUndoTransaction->addObjectChange(Who, What);
@@ -809,6 +914,23 @@ void Document::onChangedProperty(const DocumentObject* Who, const Property* What
     signalChangedObject(*Who, *What);
 }
 
+bool Document::_deferPropertySignal(const DocumentObject* obj,
+                                    const Property* prop,
+                                    DeferredSignal type)
+{
+    if (!_RecomputeWorker) {
+        return false;
+    }
+    // observers of BeforeChange expect to still see the old value
+    if (type == DeferredSignal::BeforeChange) {
+        _RecomputeWorker->beforeChange(obj, prop);
+    }
+    else {
+        _RecomputeWorker->changes.push_back({obj, prop, type});
+    }
+    return true;
+}
+
 void Document::setTransactionMode(const int iMode) // NOLINT
 {
     d->iTransactionMode = iMode;
@@ -1676,9 +1798,7 @@ static std::string checkFileName(const char* file)
 
     // Append extension if missing. This option is added for security reason, so
     // that the user won't accidentally overwrite other file that may be critical.
-    if (GetApplication()
-            .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document")
-            ->GetBool("CheckExtension", true)) {
+    if (DocumentParameters::instance().checkExtension) {
         const char* ext = strrchr(file, '.');
         if ((ext == nullptr) || !boost::iequals(ext + 1, "fcstd")) {
             if (ext && ext[1] == 0) {
@@ -1731,10 +1851,7 @@ bool Document::save()
         const std::string LastModifiedDateString = Base::Tools::currentDateTimeString();
         LastModifiedDate.setValue(LastModifiedDateString.c_str());
         // set author if needed
-        const bool saveAuthor =
-            GetApplication()
-                .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document")
-                ->GetBool("prefSetAuthorOnSave", false);
+        const bool saveAuthor = DocumentParameters::instance().setAuthorOnSave;
         if (saveAuthor) {
             const std::string Author =
                 GetApplication()
@@ -1753,14 +1870,11 @@ bool Document::saveToFile(const char* filename) const
 {
     signalStartSave(*this, filename);
 
-    auto hGrp = GetApplication().GetParameterGroupByPath(
-        "User parameter:BaseApp/Preferences/Document");
-    int compression = static_cast<int>(hGrp->GetInt("CompressionLevel", 7));
+    const auto& params = DocumentParameters::instance();
+    int compression = static_cast<int>(params.compressionLevel.get());
     compression = Base::clamp<int>(compression, Z_NO_COMPRESSION, Z_BEST_COMPRESSION);
 
-    bool policy = GetApplication()
-                      .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document")
-                      ->GetBool("BackupPolicy", true);
+    bool policy = params.backupPolicy;
 
     auto canonical_path = [](const char* filename) {
         try {
@@ -1794,6 +1908,16 @@ bool Document::saveToFile(const char* filename) const
     // realpath is canonical filename i.e. without symlink
     std::string nativePath = canonical_path(filename);
 
+    // data not yet read from the file must be read before it gets replaced,
+    // and data that can't be read anymore must not be saved as empty
+    bool restored = Base::DeferredDocFile::restoreAll(nativePath);
+    restored = Base::DeferredDocFile::restoreAll(FileName.getValue()) && restored;
+    if (!restored) {
+        throw Base::FileException(
+            "Some data could not be read from the project file the document was opened from",
+            FileName.getValue());
+    }
+
     // make a tmp. file where to save the project data first and then rename to
     // the actual file name. This may be useful if overwriting an existing file
     // fails so that the data of the work up to now isn't lost.
@@ -1817,11 +1941,19 @@ bool Document::saveToFile(const char* filename) const
 
         writer.setComment("FreeCAD Document");
         writer.setLevel(compression);
+        // 0 compresses the entries on one thread per core, 1 sequentially
+        writer.setThreadCount(
+            static_cast<unsigned int>(std::max<long>(params.saveThreads, 0)));
         writer.putNextEntry("Document.xml");
 
-        if (hGrp->GetBool("SaveBinaryBrep", false)) {
+        if (params.saveBinaryBrep) {
             writer.setMode("BinaryBrep");
         }
+        // keep binary data uncompressed and page aligned, so that it can be
+        // read from a memory mapping of the file
+        if (params.storeBinaryUncompressed) {
+            writer.setStorageAlignment(Base::XMLReader::getMappingAlignment());
+        }
 
         writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << '\n'
                         << "<!--" << '\n'
@@ -1848,19 +1980,12 @@ bool Document::saveToFile(const char* filename) const
 
     if (policy) {
         // if saving the project data succeeded rename to the actual file name
-        int count_bak = static_cast<int>(GetApplication()
-                            .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document")
-                            ->GetInt("CountBackupFiles", 1));
-        bool backup = GetApplication()
-                          .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document")
-                          ->GetBool("CreateBackupFiles", true);
+        int count_bak = static_cast<int>(params.countBackupFiles.get());
+        bool backup = params.createBackupFiles;
         if (!backup) {
             count_bak = -1;
         }
-        bool useFCBakExtension =
-            GetApplication()
-                .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document")
-                ->GetBool("UseFCBakExtension", true);
+        bool useFCBakExtension = params.useFCBakExtension;
         std::string saveBackupDateFormat =
             GetApplication()
                 .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document")
@@ -1920,7 +2045,8 @@ bool Document::isAnyRestoring()
 // Open the document
 void Document::restore(const char* filename,
                        bool delaySignal,
-                       const std::vector<std::string>& objNames)
+                       const std::vector<std::string>& objNames,
+                       const std::shared_ptr<const Base::PrefetchedArchive>& archive)
 {
     clearUndos();
     d->activeObject = nullptr;
@@ -1956,16 +2082,30 @@ void Document::restore(const char* filename,
         filename = FileName.getValue();
     }
     Base::FileInfo fi(filename);
-    Base::ifstream file(fi, std::ios::in | std::ios::binary);
-    std::streambuf* buf = file.rdbuf();
-    std::streamoff size = buf->pubseekoff(0, std::ios::end, std::ios::in);
-    buf->pubseekoff(0, std::ios::beg, std::ios::in);
-    if (size < 22) {  // an empty zip archive has 22 bytes
-        throw Base::FileException("Invalid project file", filename);
+    Base::ifstream file;
+    std::unique_ptr<zipios::ZipInputStream> zipstream;
+    std::unique_ptr<std::istream> docstream;
+    std::istream* stream = nullptr;
+    if (archive) {
+        docstream = archive->openDocument();
+        stream = docstream.get();
+    }
+    else {
+        file.open(fi, std::ios::in | std::ios::binary);
+        std::streambuf* buf = file.rdbuf();
+        std::streamoff size = buf->pubseekoff(0, std::ios::end, std::ios::in);
+        buf->pubseekoff(0, std::ios::beg, std::ios::in);
+        if (size < 22) {  // an empty zip archive has 22 bytes
+            throw Base::FileException("Invalid project file", filename);
+        }
+        zipstream = std::make_unique<zipios::ZipInputStream>(file);
+        stream = zipstream.get();
     }
 
-    zipios::ZipInputStream zipstream(file);
-    Base::XMLReader reader(filename, zipstream);
+    const auto& params = DocumentParameters::instance();
+    auto backend = params.xmlPullParser ? Base::XMLReader::Backend::Pull
+                                        : Base::XMLReader::Backend::Xerces;
+    Base::XMLReader reader(filename, *stream, backend);
 
     if (!reader.isValid()) {
         throw Base::FileException("Error reading compression file", filename);
@@ -1994,7 +2134,17 @@ void Document::restore(const char* filename,
     // Note: This file doesn't need to be available if the document has been created
     // without GUI. But if available then follow after all data files of the App document.
     signalRestoreDocument(reader);
-    reader.readFiles(zipstream);
+    // heavy data files may be read on first access instead
+    if (params.lazyRestore) {
+        reader.setDeferredArchive(fi.filePath());
+    }
+    if (archive) {
+        reader.readFiles(*archive);
+    }
+    else {
+        reader.setMappedArchive(fi.filePath());
+        reader.readFiles(*zipstream);
+    }
 
     DocumentP::checkStringHasher(reader);
 
@@ -2669,9 +2819,24 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
         obj->setStatus(ObjectStatus::PendingRecompute, true);
     }
 
-    ParameterGrp::handle hGrp =
-        GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
-    bool canAbort = hGrp->GetBool("CanAbortRecompute", true);
+    const auto& params = DocumentParameters::instance();
+    bool canAbort = params.canAbortRecompute;
+    if (d->recomputeProfiling || params.recomputeProfile) {
+        d->recomputeProfile.start(getName());
+    }
+    // don't leave the profile running if the recompute throws
+    BOOST_SCOPE_EXIT_ALL(this) {
+        d->recomputeProfile.stop();
+    };
+
+    // Opt-in execution of independent objects on a thread pool, see
+    // DocumentObject::isExecuteThreadSafe()
+    unsigned int threads = 0;
+    if (params.parallelRecompute) {
+        long count = params.recomputeThreads;
+        threads = count > 0 ? static_cast<unsigned int>(count)
+                            : Base::ThreadPool::idealThreadCount();
+    }
 
     FC_TIME_INIT(t2);
 
@@ -2686,6 +2851,20 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
                                                                 topoSortedObjects.size());
             }
             FC_LOG("Recompute pass " << passes);
+            if (threads > 1) {
+                bool aborted = false;
+                objectCount += _recomputeParallel(topoSortedObjects,
+                                                  idx,
+                                                  filter,
+                                                  hasError,
+                                                  aborted,
+                                                  seq.get(),
+                                                  threads);
+                idx = topoSortedObjects.size();
+                if (aborted) {
+                    passes = 2;
+                }
+            }
             for (; idx < topoSortedObjects.size(); ++idx) {
                 auto obj = topoSortedObjects[idx];
                 if (!obj->isAttachedToDocument() || filter.find(obj) != filter.end()) {
@@ -2749,6 +2928,7 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
     }
 
     FC_TIME_LOG(t2, "Recompute");
+    d->recomputeProfile.stop();
 
     for (auto obj : topoSortedObjects) {
         if (!obj->isAttachedToDocument()) {
@@ -2977,11 +3157,340 @@ const char* Document::getErrorDescription(const DocumentObject* Obj) const
     return d->findRecomputeLog(Obj);
 }
 
+namespace
+{
+// Releases the GIL, if held by the calling thread, while a thread of a parallel
+// recompute waits for another one that may need the GIL.
+class GILReleaser
+{
+public:
+    GILReleaser()
+    {
+        if (Py_IsInitialized() && PyGILState_Check()) {
+            release = std::make_unique<Base::PyGILStateRelease>();
+        }
+    }
+
+private:
+    std::unique_ptr<Base::PyGILStateRelease> release;
+};
+}  // namespace
+
+int Document::_recomputeParallel(const std::vector<DocumentObject*>& objs,
+                                 size_t start,
+                                 std::set<DocumentObject*>& filter,
+                                 bool* hasError,
+                                 bool& aborted,
+                                 Base::SequencerLauncher* seq,
+                                 unsigned int threads)
+{
+    // Build the dependency graph of the remaining objects. Only links to
+    // objects sorted before are considered, so that the graph stays acyclic
+    // even if getDependencyList() had to break a cycle.
+    const size_t count = objs.size() - start;
+    std::unordered_map<const DocumentObject*, size_t> indices;
+    for (size_t i = 0; i < count; ++i) {
+        indices.emplace(objs[start + i], i);
+    }
+    std::vector<size_t> pending(count, 0);
+    std::vector<std::vector<size_t>> dependents(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::set<size_t> deps;
+        for (auto dep : objs[start + i]->getOutList()) {
+            auto it = indices.find(dep);
+            if (it != indices.end() && it->second < i) {
+                deps.insert(it->second);
+            }
+        }
+        pending[i] = deps.size();
+        for (auto j : deps) {
+            dependents[j].push_back(i);
+        }
+    }
+
+    // Objects whose dependencies are done, kept in topological order. Thread
+    // safe objects are handed out first, before the calling thread blocks on
+    // executing one that is not.
+    std::set<size_t> readySafe;
+    std::set<size_t> readyMain;
+    auto makeReady = [&](size_t i) {
+        if (objs[start + i]->isExecuteThreadSafe()) {
+            readySafe.insert(i);
+        }
+        else {
+            readyMain.insert(i);
+        }
+    };
+    for (size_t i = 0; i < count; ++i) {
+        if (pending[i] == 0) {
+            makeReady(i);
+        }
+    }
+
+    struct Result
+    {
+        size_t index;
+        int res;
+        std::vector<DeferredChange> changes;
+    };
+    // A BeforeChange signal a worker waits for
+    struct SignalRequest
+    {
+        const DocumentObject* obj;
+        const Property* prop;
+        bool done;
+    };
+    std::mutex mutex;
+    std::condition_variable resultAvailable;
+    std::condition_variable requestDone;
+    std::deque<Result> results;
+    std::deque<SignalRequest*> requests;
+
+    // Objects executed on this thread modify the undo transaction concurrently
+    // to the workers. Cleared only after the pool has been joined.
+    struct ParallelFlag
+    {
+        std::atomic<bool>& flag;
+        explicit ParallelFlag(std::atomic<bool>& f)
+            : flag(f)
+        {
+            flag = true;
+        }
+        ~ParallelFlag()
+        {
+            flag = false;
+        }
+        ParallelFlag(const ParallelFlag&) = delete;
+        ParallelFlag(ParallelFlag&&) = delete;
+        ParallelFlag& operator=(const ParallelFlag&) = delete;
+        ParallelFlag& operator=(ParallelFlag&&) = delete;
+    } parallelFlag(d->parallelRecompute);
+
+    // must be destroyed before the result queue
+    Base::ThreadPool pool(threads);
+
+    int objectCount = 0;
+    size_t inFlight = 0;
+
+    auto finish = [&](size_t i) {
+        for (auto j : dependents[i]) {
+            if (--pending[j] == 0) {
+                makeReady(j);
+            }
+        }
+    };
+
+    // same as the body of the sequential loop in recompute() after _recomputeFeature()
+    auto complete = [&](size_t i, int res, bool doRecompute) {
+        auto obj = objs[start + i];
+        if (res != 0) {
+            if (hasError) {
+                *hasError = true;
+            }
+            if (res < 0) {
+                aborted = true;
+            }
+            else {
+                // if something happened filter all object in its
+                // inListRecursive from the queue then proceed
+                obj->getInListEx(filter, true);
+                filter.insert(obj);
+            }
+            finish(i);
+            return;
+        }
+        if (obj->isTouched() || doRecompute) {
+            signalRecomputedObject(*obj);
+            obj->purgeTouched();
+            // set all dependent object touched to force recompute
+            for (auto inObjIt : obj->getInList()) {
+                inObjIt->enforceRecompute();
+            }
+        }
+        finish(i);
+        if (seq) {
+            seq->next(true);
+        }
+    };
+
+    auto replay = [this](const std::vector<DeferredChange>& changes) {
+        for (const auto& change : changes) {
+            const auto& obj = *change.obj;
+            const auto& prop = *change.prop;
+            switch (change.type) {
+                case DeferredSignal::BeforeChange:
+                    // emitted right away by serveRequests()
+                    break;
+                case DeferredSignal::EarlyChange:
+                    obj.signalEarlyChanged(obj, prop);
+                    break;
+                case DeferredSignal::Changed:
+                    onChangedProperty(&obj, &prop);
+                    obj.signalChanged(obj, prop);
+                    break;
+            }
+        }
+    };
+
+    // Called by a worker, blocks until this thread has emitted the signal. A
+    // worker applying an expression binding holds the GIL, which this thread
+    // needs to emit the signal, so the GIL is released while waiting. It is
+    // only taken back after the mutex has been unlocked.
+    auto beforeChange = [&](const DocumentObject* obj, const Property* prop) {
+        SignalRequest request {obj, prop, false};
+        GILReleaser release;
+        std::unique_lock<std::mutex> lock(mutex);
+        requests.push_back(&request);
+        resultAvailable.notify_one();
+        requestDone.wait(lock, [&request] {
+            return request.done;
+        });
+    };
+
+    // Emit the BeforeChange signals the workers are waiting for
+    auto serveRequests = [&]() {
+        std::deque<SignalRequest*> pendingRequests;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pendingRequests.swap(requests);
+        }
+        if (pendingRequests.empty()) {
+            return;
+        }
+        auto release = [&]() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (auto request : pendingRequests) {
+                    request->done = true;
+                }
+            }
+            requestDone.notify_all();
+        };
+        try {
+            for (auto request : pendingRequests) {
+                signalBeforeChangeObject(*request->obj, *request->prop);
+                request->obj->signalBeforeChange(*request->obj, *request->prop);
+            }
+        }
+        catch (...) {
+            release();
+            throw;
+        }
+        release();
+    };
+
+    auto dispatch = [&](size_t i) {
+        auto obj = objs[start + i];
+        if (!obj->isAttachedToDocument() || filter.contains(obj)) {
+            finish(i);
+            return;
+        }
+        // ask the object if it should be recomputed
+        if (!obj->mustRecompute()) {
+            complete(i, 0, false);
+            return;
+        }
+        ++objectCount;
+        if (!obj->isExecuteThreadSafe()) {
+            complete(i, _recomputeFeature(obj), true);
+            return;
+        }
+        ++inFlight;
+        pool.start([this, obj, i, &mutex, &resultAvailable, &results, &beforeChange]() {
+            Result result {i, 1, {}};
+            RecomputeWorker worker {{}, beforeChange};
+            _RecomputeWorker = &worker;
+            try {
+                result.res = _recomputeFeature(obj);
+            }
+            catch (...) {
+                d->addRecomputeLog("Unknown exception!", obj);
+            }
+            _RecomputeWorker = nullptr;
+            result.changes = std::move(worker.changes);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                results.push_back(std::move(result));
+            }
+            resultAvailable.notify_one();
+        });
+    };
+
+    // Wait for the next finished object, serving the workers in the meantime
+    auto waitResult = [&]() {
+        for (;;) {
+            serveRequests();
+            GILReleaser release;
+            std::unique_lock<std::mutex> lock(mutex);
+            resultAvailable.wait(lock, [&results, &requests] {
+                return !results.empty() || !requests.empty();
+            });
+            if (!results.empty()) {
+                Result result = std::move(results.front());
+                results.pop_front();
+                --inFlight;
+                return result;
+            }
+        }
+    };
+
+    auto takeResult = [&]() {
+        Result result = waitResult();
+        replay(result.changes);
+        complete(result.index, result.res, true);
+    };
+
+    auto hasResult = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !results.empty();
+    };
+
+    try {
+        while ((!aborted && (!readySafe.empty() || !readyMain.empty())) || inFlight > 0) {
+            serveRequests();
+            while (!aborted && !readySafe.empty()) {
+                auto i = *readySafe.begin();
+                readySafe.erase(readySafe.begin());
+                dispatch(i);
+            }
+            // collect finished objects first, they may release more work
+            if (inFlight > 0 && hasResult()) {
+                takeResult();
+                continue;
+            }
+            if (!aborted && !readyMain.empty()) {
+                auto i = *readyMain.begin();
+                readyMain.erase(readyMain.begin());
+                dispatch(i);
+                continue;
+            }
+            if (inFlight > 0) {
+                takeResult();
+            }
+        }
+    }
+    catch (...) {
+        // let the running objects finish before unwinding
+        while (inFlight > 0) {
+            try {
+                replay(waitResult().changes);
+            }
+            catch (...) {
+                // the first exception is the one reported
+            }
+        }
+        throw;
+    }
+    return objectCount;
+}
+
 // call the recompute of the Feature and handle the exceptions and errors.
 int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
 {
     FC_LOG("Recomputing " << Feat->getFullName());
 
+    RecomputeProfile::Scope profileScope(d->recomputeProfile, Feat);
+
     DocumentObjectExecReturn* returnCode = nullptr;
     try {
         returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
@@ -3035,6 +3544,21 @@ int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
     return 0;
 }
 
+void Document::setRecomputeProfiling(bool enable)
+{
+    d->recomputeProfiling = enable;
+}
+
+bool Document::isRecomputeProfiling() const
+{
+    return d->recomputeProfiling;
+}
+
+const RecomputeProfile& Document::getRecomputeProfile() const
+{
+    return d->recomputeProfile;
+}
+
 bool Document::recomputeFeature(DocumentObject* feature, bool recursive)
 {
     // delete recompute log
@@ -3169,6 +3693,7 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName, Add
      // do no transactions if we do a rollback!
     if (!d->rollback) {
         // Undo stuff
+        auto lock = d->lockTransaction();
         _checkTransaction(nullptr, nullptr, __LINE__);
         if (d->activeUndoTransaction) {
             d->activeUndoTransaction->addObjectDel(pcObject);
@@ -3242,7 +3767,10 @@ void Document::_removeObject(DocumentObject* pcObject, RemoveObjectOptions optio
     
     TransactionLocker tlock;
 
-    _checkTransaction(pcObject, nullptr, __LINE__);
+    {
+        auto lock = d->lockTransaction();
+        _checkTransaction(pcObject, nullptr, __LINE__);
+    }
 
     auto pos = d->objectMap.find(pcObject->getNameInDocument());
     if (pos == d->objectMap.end()) {
@@ -3267,6 +3795,7 @@ void Document::_removeObject(DocumentObject* pcObject, RemoveObjectOptions optio
             }
             auto sobj = pcObject->getSubObject(sub.c_str());
             if (sobj && sobj->getDocument() == this && !sobj->Visibility.getValue()) {
+                auto lock = d->lockTransaction();
                 d->activeUndoTransaction->addObjectChange(sobj, &sobj->Visibility);
             }
         }
@@ -3300,6 +3829,7 @@ void Document::_removeObject(DocumentObject* pcObject, RemoveObjectOptions optio
 
     // do no transactions if we do a rollback!
     if (!d->rollback && d->activeUndoTransaction) {
+        auto lock = d->lockTransaction();
         d->activeUndoTransaction->addObjectNew(pcObject);
     }
 
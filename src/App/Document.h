@@ -36,6 +36,8 @@
 #include "ExportInfo.h"
 
 #include <map>
+#include <memory>
+#include <set>
 #include <vector>
 #include <utility>
 #include <list>
@@ -43,6 +45,8 @@
 
 namespace Base
 {
+class PrefetchedArchive;
+class SequencerLauncher;
 class Writer;
 }
 
@@ -82,6 +86,7 @@ class Document;
 class DocumentPy;
 class Application;
 class Transaction;
+class RecomputeProfile;
 class StringHasher;
 using StringHasherRef = Base::Reference<StringHasher>;
 
@@ -225,6 +230,14 @@ public:
     using PreRecomputeHook = std::function<void()>;
     void setPreRecomputeHook(const PreRecomputeHook& hook);
 
+    /// property change signals that are postponed during a parallel recompute
+    enum class DeferredSignal
+    {
+        BeforeChange,
+        EarlyChange,
+        Changed,
+    };
+
     void clearDocument();
 
     /** @name File handling of the document */
@@ -235,10 +248,14 @@ public:
     bool save();
     bool saveAs(const char* file);
     bool saveCopy(const char* file) const;
-    /// Restore the document from the file in Property Path
+    /** Restore the document from the file in Property Path
+     * If \a archive is given the project file has already been read and
+     * decompressed, e.g. by Application::openDocuments().
+     */
     void restore(const char* filename = nullptr,
                  bool delaySignal = false,
-                 const std::vector<std::string>& objNames = {});
+                 const std::vector<std::string>& objNames = {},
+                 const std::shared_ptr<const Base::PrefetchedArchive>& archive = {});
     bool afterRestore(bool checkPartial = false);
     bool afterRestore(const std::vector<DocumentObject*>&, bool checkPartial = false);
     enum ExportStatus
@@ -440,6 +457,15 @@ public:
                   int options = 0);
     /// Recompute only one feature
     bool recomputeFeature(DocumentObject* Feat, bool recursive = false);
+    /** Enable per object timing of recompute()
+     *
+     * Profiling is also enabled by the 'RecomputeProfile' document preference.
+     */
+    void setRecomputeProfiling(bool enable);
+    /// check whether recompute() records a profile
+    bool isRecomputeProfiling() const;
+    /// get the profile of the last profiled recompute()
+    const RecomputeProfile& getRecomputeProfile() const;
     /// get the text of the error of a specified object
     const char* getErrorDescription(const DocumentObject*) const;
     /// return the status bits
@@ -494,10 +520,16 @@ public:
     /// Check if a transaction is open and its list is empty.
     /// If no transaction is open true is returned.
     bool isTransactionEmpty() const;
-    /// Set the Undo limit in Byte!
-    void setUndoLimit(unsigned int UndoMemSize = 0);
+    /** Set the Undo limit in Byte!
+     * When the memory used by the Undo stack exceeds the limit, the oldest
+     * transactions are dropped on the next commit. The latest transaction is
+     * always kept. Zero means no limit.
+     */
+    void setUndoLimit(std::size_t UndoMemSize = 0);
+    /// Returns the Undo limit in Byte
+    std::size_t getUndoLimit() const;
     /// Returns the actual memory consumption of the Undo redo stuff.
-    unsigned int getUndoMemSize() const;
+    std::size_t getUndoMemSize() const;
     /// Set the Undo limit as stack size
     void setMaxUndoStackSize(unsigned int UndoMaxStackSize = 20);  // NOLINT
     /// Set the Undo limit as stack size
@@ -678,6 +710,30 @@ protected:
     /// helper which Recompute only this feature
     /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
     int _recomputeFeature(DocumentObject* Feat);
+    /** helper of recompute() which runs independent objects on a thread pool
+     *
+     * @param objs: topologically sorted objects
+     * @param start: index of the first object to process
+     * @param filter: objects to skip, objects depending on a failed one are added
+     * @param hasError: optional output, set to true if any object failed
+     * @param aborted: set to true if the recompute was aborted by the user
+     * @param seq: optional progress indicator
+     * @param threads: number of worker threads
+     *
+     * @return the number of recomputed objects
+     */
+    int _recomputeParallel(const std::vector<DocumentObject*>& objs,
+                           size_t start,
+                           std::set<DocumentObject*>& filter,
+                           bool* hasError,
+                           bool& aborted,
+                           Base::SequencerLauncher* seq,
+                           unsigned int threads);
+    /** Queue a property change signal if called from a worker of a parallel recompute
+     * @return true if the signal was queued and must not be emitted by the caller
+     */
+    static bool
+    _deferPropertySignal(const DocumentObject* obj, const Property* prop, DeferredSignal type);
     void _clearRedos();
 
     /// refresh the internal dependency graph
@@ -700,6 +756,8 @@ protected:
     int _openTransaction(const char* name = nullptr, int id = 0);
     /// Internally called by Application to commit the Command transaction.
     void _commitTransaction(bool notify = false);
+    /// Drops the oldest Undo transactions that exceed the stack size or memory limit
+    void _checkUndoLimits();
     /// Internally called by Application to abort the running transaction.
     void _abortTransaction();
 
@@ -34,6 +34,9 @@ class Document(PropertyContainer):
     UndoRedoMemSize: Final[int] = 0
     """The size of the Undo stack in byte"""
 
+    UndoLimit: int = 0
+    """The memory limit of the Undo stack in byte (0 = no limit)"""
+
     UndoCount: Final[int] = 0
     """Number of possible Undos"""
 
@@ -52,6 +55,9 @@ class Document(PropertyContainer):
     RecomputesFrozen: bool = False
     """Returns or sets if automatic recomputes for this document are disabled."""
 
+    RecomputeProfiling: bool = False
+    """Returns or sets if recompute() records the execution time of each object."""
+
     HasPendingTransaction: Final[bool] = False
     """Check if there is a pending transaction"""
 
@@ -332,6 +338,29 @@ class Document(PropertyContainer):
         """
         ...
 
+    def getRecomputeProfile(self) -> dict:
+        """
+        getRecomputeProfile(): Return the profile of the last profiled recompute
+
+        The returned dictionary contains the document name, the total time in ms
+        and a list of objects in the order they finished. Each object entry holds
+        its name, label, type, start and duration in ms, the executing thread,
+        its memory size, the error state and the touched properties or
+        recomputed dependencies that caused the execution.
+        """
+        ...
+
+    def saveRecomputeProfile(self, filename: str, format: str = "json") -> None:
+        """
+        saveRecomputeProfile(filename, format='json')
+
+        Write the profile of the last profiled recompute to a file.
+
+        format: 'json' for a plain JSON report or 'trace' for the Chrome trace
+        event format, which can be loaded into chrome://tracing or Perfetto.
+        """
+        ...
+
     def mustExecute(self) -> bool:
         """
         Check if any object must be recomputed
@@ -166,7 +166,10 @@ App::DocumentObjectExecReturn* DocumentObject::recompute()
     // mark the object to recompute its extensions
     this->setStatus(App::RecomputeExtension, true);
 
-    auto ret = this->execute();
+    // the output may be restored instead of being computed, the extensions
+    // are executed either way
+    bool cached = restoreFromRecomputeCache();
+    auto ret = cached ? StdReturn : this->execute();
     if (ret == StdReturn) {
         // most feature classes don't call the execute() method of its base class
         // so execute the extensions now
@@ -174,6 +177,9 @@ App::DocumentObjectExecReturn* DocumentObject::recompute()
             ret = executeExtensions();
         }
     }
+    if (ret == StdReturn && !cached) {
+        saveToRecomputeCache();
+    }
 
     return ret;
 }
@@ -776,7 +782,9 @@ void DocumentObject::onBeforeChange(const Property* prop)
         onBeforeChangeProperty(_pDoc, prop);
     }
 
-    signalBeforeChange(*this, *prop);
+    if (!Document::_deferPropertySignal(this, prop, Document::DeferredSignal::BeforeChange)) {
+        signalBeforeChange(*this, *prop);
+    }
 }
 
 std::vector<std::pair<Property*, std::unique_ptr<Property>>>
@@ -858,7 +866,9 @@ void DocumentObject::onEarlyChange(const Property* prop)
         }
     }
 
-    signalEarlyChanged(*this, *prop);
+    if (!Document::_deferPropertySignal(this, prop, Document::DeferredSignal::EarlyChange)) {
+        signalEarlyChanged(*this, *prop);
+    }
 }
 
 /// get called by the container when a Property was changed
@@ -912,6 +922,11 @@ void DocumentObject::onChanged(const Property* prop)
     // call the parent for appropriate handling
     TransactionalObject::onChanged(prop);
 
+    // Postpone the signals while executing on a worker thread of a parallel recompute
+    if (Document::_deferPropertySignal(this, prop, Document::DeferredSignal::Changed)) {
+        return;
+    }
+
     // Now signal the view provider
     if (_pDoc) {
         _pDoc->onChangedProperty(this, prop);
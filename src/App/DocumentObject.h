@@ -517,6 +517,24 @@ public:
     {
         return false;
     }
+
+    /** Return true if execute() can run in parallel with other objects
+     *
+     * Used by Document::recompute() when parallel recompute is enabled. The
+     * execution of a thread safe object may only read its dependencies and
+     * modify its own properties. Its BeforeChange signals are emitted by the
+     * thread running the recompute while the worker waits, the other property
+     * change signals are postponed until its execution has finished.
+     *
+     * Of the Part and PartDesign modules only the primitives without an
+     * attachment opt in, because the element maps of other features are
+     * built with the StringHasher shared by the document, which is not
+     * thread safe.
+     */
+    virtual bool isExecuteThreadSafe() const
+    {
+        return false;
+    }
     /// Handle Label changes, including forcing unique label values,
     /// signalling OnBeforeLabelChange, and arranging to update linked references,
     /// on the assumption that after returning the label will indeed be changed to
@@ -715,6 +733,19 @@ protected:
      */
     virtual App::DocumentObjectExecReturn* execute();
 
+    /** Try to restore the output of this object from a persistent cache
+     * Called by recompute() instead of execute(). If it returns true,
+     * execute() is skipped, while the links are still checked and the
+     * extensions executed. The default implementation does nothing.
+     */
+    virtual bool restoreFromRecomputeCache()
+    {
+        return false;
+    }
+    /// Store the output of a successful recompute() into a persistent cache
+    virtual void saveToRecomputeCache()
+    {}
+
     /**
      * Executes the extensions of a document object.
      */
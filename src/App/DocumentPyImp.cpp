@@ -23,6 +23,8 @@
 
 #include "PreCompiled.h"
 
+#include <limits>
+
 #include <Base/FileInfo.h>
 #include <Base/Interpreter.h>
 #include <Base/Stream.h>
@@ -35,6 +37,7 @@
 // inclusion of the generated files (generated By DocumentPy.xml)
 #include "DocumentPy.h"
 #include "DocumentPy.cpp"
+#include "RecomputeProfile.h"
 #include <boost/regex.hpp>
 #include <Base/PyWrapParseTupleAndKeywords.h>
 
@@ -939,7 +942,22 @@ void DocumentPy::setUndoMode(Py::Long arg)
 
 Py::Long DocumentPy::getUndoRedoMemSize() const
 {
-    return Py::Long((long)getDocumentPtr()->getUndoMemSize());
+    return Py::Long(static_cast<unsigned PY_LONG_LONG>(getDocumentPtr()->getUndoMemSize()));
+}
+
+Py::Long DocumentPy::getUndoLimit() const
+{
+    return Py::Long(static_cast<unsigned PY_LONG_LONG>(getDocumentPtr()->getUndoLimit()));
+}
+
+void DocumentPy::setUndoLimit(Py::Long arg)
+{
+    PY_LONG_LONG limit = arg;
+    if (limit < 0
+        || static_cast<unsigned PY_LONG_LONG>(limit) > std::numeric_limits<std::size_t>::max()) {
+        throw Py::ValueError("Undo limit out of range");
+    }
+    getDocumentPtr()->setUndoLimit(static_cast<std::size_t>(limit));
 }
 
 Py::Long DocumentPy::getUndoCount() const
@@ -998,6 +1016,96 @@ void DocumentPy::setRecomputesFrozen(Py::Boolean arg)
     getDocumentPtr()->setStatus(Document::Status::SkipRecompute, arg.isTrue());
 }
 
+Py::Boolean DocumentPy::getRecomputeProfiling() const
+{
+    return {getDocumentPtr()->isRecomputeProfiling()};
+}
+
+void DocumentPy::setRecomputeProfiling(Py::Boolean arg)
+{
+    getDocumentPtr()->setRecomputeProfiling(arg.isTrue());
+}
+
+PyObject* DocumentPy::getRecomputeProfile(PyObject* args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        auto toList = [](const std::vector<std::string>& names) {
+            Py::List list;
+            for (const auto& name : names) {
+                list.append(Py::String(name));
+            }
+            return list;
+        };
+
+        const auto& profile = getDocumentPtr()->getRecomputeProfile();
+        Py::List objects;
+        for (const auto& entry : profile.getEntries()) {
+            Py::Dict dict;
+            dict.setItem("Name", Py::String(entry.name));
+            dict.setItem("Label", Py::String(entry.label));
+            dict.setItem("Type", Py::String(entry.type));
+            dict.setItem("Start", Py::Float(entry.start));
+            dict.setItem("Duration", Py::Float(entry.duration));
+            dict.setItem("Thread", Py::Long(entry.thread));
+            dict.setItem("MemSize", Py::Long(static_cast<unsigned long>(entry.memSize)));
+            dict.setItem("Error", Py::Boolean(entry.error));
+            dict.setItem("Touched", toList(entry.touched));
+            dict.setItem("Dependencies", toList(entry.dependencies));
+            objects.append(dict);
+        }
+
+        Py::Dict ret;
+        ret.setItem("Document", Py::String(profile.getDocumentName()));
+        ret.setItem("Total", Py::Float(profile.getTotalTime()));
+        ret.setItem("Objects", objects);
+        return Py::new_reference_to(ret);
+    }
+    PY_CATCH;
+}
+
+PyObject* DocumentPy::saveRecomputeProfile(PyObject* args)
+{
+    char* filename;
+    const char* format = "json";
+    if (!PyArg_ParseTuple(args, "et|s", "utf-8", &filename, &format)) {
+        return nullptr;
+    }
+
+    std::string utf8Name(filename);
+    PyMem_Free(filename);
+
+    PY_TRY
+    {
+        std::string fmt(format);
+        if (fmt != "json" && fmt != "trace") {
+            PyErr_SetString(PyExc_ValueError, "format must be 'json' or 'trace'");
+            return nullptr;
+        }
+
+        Base::FileInfo fi(utf8Name);
+        Base::ofstream str(fi);
+        if (!str) {
+            PyErr_Format(PyExc_IOError, "Cannot open file '%s'", utf8Name.c_str());
+            return nullptr;
+        }
+
+        const auto& profile = getDocumentPtr()->getRecomputeProfile();
+        if (fmt == "trace") {
+            profile.toChromeTrace(str);
+        }
+        else {
+            profile.toJson(str);
+        }
+        Py_Return;
+    }
+    PY_CATCH;
+}
+
 PyObject* DocumentPy::getTempFileName(PyObject* args)
 {
     PyObject* value;
@@ -1,5 +1,7 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
+#include <cstdint>
 #include <unordered_map>
 #ifndef FC_DEBUG
 #include <random>
@@ -448,7 +450,7 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
                     }
                 }
 
-                this->mappedNames.emplace(ref->name, idx);
+                this->mappedNames.insert(ref->name, idx);
 
                 if (!hasherRef) {
                     if (offset + 1 < (int)tokens.size()) {
@@ -515,7 +517,7 @@ MappedName ElementMap::addName(MappedName& name,
         if (overwrite) {
             erase(idx);
         }
-        auto ret = mappedNames.insert(std::make_pair(name, idx));
+        auto ret = mappedNames.insert(name, idx);
         if (ret.second) {                // element just inserted did not exist yet in the map
             ret.first->first.compact();  // FIXME see MappedName.cpp
             mappedRef(idx).append(ret.first->first, sids);
@@ -944,6 +946,144 @@ void ElementMap::erase(const IndexedName& idx)
     ref.clear();
 }
 
+std::size_t MappedNameHash::operator()(const MappedName& name) const
+{
+    // FNV-1a over the data followed by the postfix, because two names are equal if their
+    // concatenation is equal regardless of where the data ends
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](const QByteArray& bytes) {
+        for (char byte : bytes) {
+            hash ^= static_cast<unsigned char>(byte);
+            hash *= 1099511628211ULL;
+        }
+    };
+    add(name.dataBytes());
+    add(name.postfixBytes());
+    return static_cast<std::size_t>(hash);
+}
+
+std::size_t MappedNameMap::findSlot(const MappedName& name) const
+{
+    // the slot of the name, or the empty slot where it would be inserted
+    std::size_t mask = slots.size() - 1;
+    for (std::size_t slot = MappedNameHash()(name) & mask;; slot = (slot + 1) & mask) {
+        if (slots[slot] == 0 || entries[slots[slot] - 1].first == name) {
+            return slot;
+        }
+    }
+}
+
+std::size_t MappedNameMap::findSlot(std::size_t index) const
+{
+    std::size_t mask = slots.size() - 1;
+    for (std::size_t slot = MappedNameHash()(entries[index].first) & mask;;
+         slot = (slot + 1) & mask) {
+        if (slots[slot] == index + 1) {
+            return slot;
+        }
+    }
+}
+
+MappedNameMap::iterator MappedNameMap::find(const MappedName& name)
+{
+    auto it = static_cast<const MappedNameMap*>(this)->find(name);
+    return entries.begin() + (it - entries.cbegin());
+}
+
+MappedNameMap::const_iterator MappedNameMap::find(const MappedName& name) const
+{
+    if (entries.empty()) {
+        return entries.cend();
+    }
+    std::uint32_t index = slots[findSlot(name)];
+    if (index == 0) {
+        return entries.cend();
+    }
+    return entries.cbegin() + static_cast<std::ptrdiff_t>(index - 1);
+}
+
+std::pair<MappedNameMap::iterator, bool> MappedNameMap::insert(const MappedName& name,
+                                                               const IndexedName& idx)
+{
+    // keep the load factor of the index below 3/4
+    if ((entries.size() + 1) * 4 > slots.size() * 3) {
+        rehash(std::max<std::size_t>(16, slots.size() * 2));
+    }
+    std::size_t slot = findSlot(name);
+    if (slots[slot] != 0) {
+        return {entries.begin() + static_cast<std::ptrdiff_t>(slots[slot] - 1), false};
+    }
+    // grow by an eighth instead of doubling to keep the unused capacity small
+    if (entries.size() == entries.capacity()) {
+        entries.reserve(entries.size() + entries.size() / 8 + 16);
+    }
+    entries.emplace_back(name, idx);
+    slots[slot] = static_cast<std::uint32_t>(entries.size());
+    return {entries.end() - 1, true};
+}
+
+void MappedNameMap::rehash(std::size_t slotCount)
+{
+    slots.assign(slotCount, 0);
+    std::size_t mask = slotCount - 1;
+    for (std::size_t index = 0; index < entries.size(); ++index) {
+        std::size_t slot = MappedNameHash()(entries[index].first) & mask;
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = static_cast<std::uint32_t>(index + 1);
+    }
+}
+
+void MappedNameMap::erase(const_iterator it)
+{
+    auto index = static_cast<std::size_t>(it - entries.cbegin());
+    std::size_t mask = slots.size() - 1;
+    // backward shift deletion, move the following entries of the probe sequence up
+    std::size_t hole = findSlot(index);
+    for (std::size_t slot = (hole + 1) & mask; slots[slot] != 0; slot = (slot + 1) & mask) {
+        std::size_t home = MappedNameHash()(entries[slots[slot] - 1].first) & mask;
+        if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+            slots[hole] = slots[slot];
+            hole = slot;
+        }
+    }
+    slots[hole] = 0;
+
+    std::size_t last = entries.size() - 1;
+    if (index != last) {
+        slots[findSlot(last)] = static_cast<std::uint32_t>(index + 1);
+        entries[index] = std::move(entries[last]);
+    }
+    entries.pop_back();
+}
+
+void MappedNameMap::erase(const MappedName& name)
+{
+    auto it = find(name);
+    if (it != entries.end()) {
+        erase(it);
+    }
+}
+
+std::vector<const MappedNameMap::value_type*> MappedNameMap::sorted() const
+{
+    std::vector<const value_type*> result;
+    result.reserve(entries.size());
+    for (const auto& entry : entries) {
+        result.push_back(&entry);
+    }
+    std::sort(result.begin(), result.end(), [](const value_type* entry1, const value_type* entry2) {
+        return entry1->first < entry2->first;
+    });
+    return result;
+}
+
+std::size_t MappedNameMap::getMemSize() const
+{
+    return entries.capacity() * sizeof(value_type) + slots.capacity() * sizeof(std::uint32_t);
+}
+
 unsigned long ElementMap::size() const
 {
     return mappedNames.size() + childElementSize;
@@ -1307,8 +1447,8 @@ MappedElement ElementMap::complexFind(const MappedName& name) const {
         return foundName;
     }
 
-    for (const auto &loopName : mappedNames) {
-        loopElement = compileToponamingElement(loopName.first);
+    for (const auto* loopName : mappedNames.sorted()) {
+        loopElement = compileToponamingElement(loopName->first);
 
         if (loopElement.dehashedName.empty()) {
             continue;
@@ -1507,7 +1647,7 @@ MappedElement ElementMap::complexFind(const MappedName& name) const {
                                                   - loopElement.unfilteredSplitSections.size()));
 
         if (foundName == MappedElement() || currentFeatureHistory == 0 || foundFeatureHistory == -1 && currentFeatureHistory == 1) {
-            foundName = MappedElement(loopName.first, loopName.second);
+            foundName = MappedElement(loopName->first, loopName->second);
             foundFeatureHistory = currentFeatureHistory;
         }
     }
@@ -1841,8 +1981,8 @@ void ElementMap::collectChildMaps(std::map<const ElementMap*, int>& childMapSet,
         }
     }
 
-    for (auto& mappedName : this->mappedNames) {
-        addPostfix(mappedName.first.constPostfix(), postfixMap, postfixes);
+    for (const auto* mappedName : mappedNames.sorted()) {
+        addPostfix(mappedName->first.constPostfix(), postfixMap, postfixes);
     }
 
     childMaps.push_back(this);
@@ -2070,8 +2210,8 @@ std::vector<MappedElement> ElementMap::getAll() const
 {
     std::vector<MappedElement> ret;
     ret.reserve(size());
-    for (auto& mappedName : this->mappedNames) {
-        ret.emplace_back(mappedName.first, mappedName.second);
+    for (const auto* mappedName : mappedNames.sorted()) {
+        ret.emplace_back(mappedName->first, mappedName->second);
     }
     for (auto& childElement : this->childElements) {
         auto& child = *childElement.childMap;
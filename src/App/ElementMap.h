@@ -32,11 +32,14 @@
 #include "MappedElement.h"
 #include "StringHasher.h"
 
+#include <cstdint>
 #include <cstring>
 #include <deque>
 #include <functional>
 #include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 
 
 namespace Data
@@ -60,13 +63,83 @@ using ElementMapPtr = std::shared_ptr<ElementMap>;
  */
 typedef std::function<bool(const MappedName&, int, long, long)> TraceCallback;
 
+/// Hash function for MappedName that is consistent with MappedName::operator==(), i.e. it treats
+/// the data and the postfix as one continuous array of bytes.
+struct AppExport MappedNameHash
+{
+    std::size_t operator()(const MappedName& name) const;
+};
+
+/** Flat hash storage of the mapped names of an ElementMap
+ *
+ * The entries are kept in a single vector, a separate open addressing table of entry indices
+ * finds them by name. Compared to a tree or a node based hash table there is no allocation
+ * and no pointers per entry. Erasing an entry moves the last one into its place, so the
+ * entries are in no particular order, use sorted() where the order matters.
+ */
+class AppExport MappedNameMap
+{
+public:
+    using value_type = std::pair<MappedName, IndexedName>;
+    using iterator = std::vector<value_type>::iterator;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    iterator begin()
+    {
+        return entries.begin();
+    }
+    iterator end()
+    {
+        return entries.end();
+    }
+    const_iterator begin() const
+    {
+        return entries.begin();
+    }
+    const_iterator end() const
+    {
+        return entries.end();
+    }
+    std::size_t size() const
+    {
+        return entries.size();
+    }
+    bool empty() const
+    {
+        return entries.empty();
+    }
+
+    iterator find(const MappedName& name);
+    const_iterator find(const MappedName& name) const;
+    /// Inserts the entry unless the name exists, returns the entry of the name
+    std::pair<iterator, bool> insert(const MappedName& name, const IndexedName& idx);
+    /// Erases the entry, the last entry takes its place
+    void erase(const_iterator it);
+    void erase(const MappedName& name);
+    /// Returns the entries in the order of the names
+    std::vector<const value_type*> sorted() const;
+    /// Returns the bytes allocated for the entries and the index, without the name data
+    std::size_t getMemSize() const;
+
+private:
+    std::size_t findSlot(const MappedName& name) const;
+    std::size_t findSlot(std::size_t index) const;
+    void rehash(std::size_t slotCount);
+
+    std::vector<value_type> entries;
+    // entry index + 1 for each used slot, 0 for an empty one
+    std::vector<std::uint32_t> slots;
+};
+
 /* This class provides for ComplexGeoData's ability to provide proper naming.
  * Specifically, ComplexGeoData uses this class for it's `_id` property.
  * Most of the operations work with the `indexedNames` and `mappedNames` maps.
  * `indexedNames` maps a string to both a name queue and children.
  *   each of those children store an IndexedName, offset details, postfix, ids, and
  *   possibly a recursive elementmap
- * `mappedNames` maps a MappedName to a specific IndexedName.
+ * `mappedNames` maps a MappedName to a specific IndexedName. It is a flat hash table because it
+ *   is looked up for every element that is mapped. Where the order matters, e.g. when saving, the
+ *   names are iterated in sorted order using MappedNameMap::sorted().
  */
 class AppExport ElementMap
     : public std::enable_shared_from_this<ElementMap>  // TODO can remove shared_from_this?
@@ -365,7 +438,7 @@ private:
 
     std::map<const char*, IndexedElements, CStringComp> indexedNames;
 
-    std::map<MappedName, IndexedName, std::less<>> mappedNames;
+    MappedNameMap mappedNames;
 
     struct ChildMapInfo
     {
@@ -35,6 +35,7 @@
 #include <boost/math/special_functions/round.hpp>
 #include <boost/math/special_functions/trunc.hpp>
 
+#include <cmath>
 #include <numbers>
 #include <limits>
 #include <sstream>
@@ -1121,6 +1122,417 @@ Py::Object Expression::getPyValue() const {
     return Py::Object();
 }
 
+//
+// Compiled evaluation
+//
+// The compiled closures mirror the Python semantics of the types bool, int,
+// float and Base::Quantity used by the interpreted evaluation. Wherever Python
+// would raise an error or leave the range of a C long, the closures return
+// false and the expression is evaluated by Python instead, which also reports
+// the error.
+//
+
+namespace {
+
+using CompiledType = CompiledValue::Type;
+
+inline bool isIntegral(const CompiledValue &v) {
+    return v.type == CompiledType::Bool || v.type == CompiledType::Long;
+}
+
+// Returns true if the integer converts to double without loss of precision
+inline bool isExact(long v) {
+    constexpr long long limit = 1LL << std::numeric_limits<double>::digits;
+    return v >= -limit && v <= limit;
+}
+
+inline double toDouble(const CompiledValue &v) {
+    switch (v.type) {
+    case CompiledType::Float:
+        return v.d;
+    case CompiledType::Quantity:
+        return v.q.getValue();
+    default:
+        return static_cast<double>(v.l);
+    }
+}
+
+inline Quantity toQuantity(const CompiledValue &v) {
+    if (v.type == CompiledType::Quantity)
+        return v.q;
+    return Quantity(toDouble(v));
+}
+
+inline bool isTrue(const CompiledValue &v) {
+    return toDouble(v) != 0.0;
+}
+
+inline void assignBool(CompiledValue &res, bool value) {
+    res.type = CompiledType::Bool;
+    res.l = value ? 1 : 0;
+}
+
+inline void assignLong(CompiledValue &res, long value) {
+    res.type = CompiledType::Long;
+    res.l = value;
+}
+
+inline void assignFloat(CompiledValue &res, double value) {
+    res.type = CompiledType::Float;
+    res.d = value;
+}
+
+inline void assignQuantity(CompiledValue &res, const Quantity &value) {
+    res.type = CompiledType::Quantity;
+    res.q = value;
+}
+
+CompiledExpression compiledConstant(const CompiledValue &value) {
+    return CompiledExpression([value](CompiledValue &res) {
+        res = value;
+        return true;
+    }, true);
+}
+
+// Same as pyFromQuantity()
+CompiledValue compiledFromQuantity(const Quantity &quantity) {
+    CompiledValue res;
+    if (!quantity.isDimensionless()) {
+        assignQuantity(res, quantity);
+        return res;
+    }
+    double v = quantity.getValue();
+    long l;
+    int i;
+    switch(essentiallyInteger(v,l,i)) {
+    case 1:
+    case 2:
+        assignLong(res, l);
+        break;
+    default:
+        assignFloat(res, v);
+    }
+    return res;
+}
+
+bool addLong(long a, long b, long &res) {
+    if ((b > 0 && a > std::numeric_limits<long>::max() - b)
+            || (b < 0 && a < std::numeric_limits<long>::min() - b))
+        return false;
+    res = a + b;
+    return true;
+}
+
+bool subLong(long a, long b, long &res) {
+    if ((b < 0 && a > std::numeric_limits<long>::max() + b)
+            || (b > 0 && a < std::numeric_limits<long>::min() + b))
+        return false;
+    res = a - b;
+    return true;
+}
+
+bool mulLong(long a, long b, long &res) {
+    if (a == 0 || b == 0) {
+        res = 0;
+        return true;
+    }
+    if (a == std::numeric_limits<long>::min() || b == std::numeric_limits<long>::min()
+            || std::labs(a) > std::numeric_limits<long>::max() / std::labs(b))
+        return false;
+    res = a * b;
+    return true;
+}
+
+// Python's int ** int for a non-negative exponent
+bool powLong(long base, long exp, long &res) {
+    long result = 1;
+    while (exp > 0) {
+        if ((exp & 1) && !mulLong(result, base, result))
+            return false;
+        exp >>= 1;
+        if (exp > 0 && !mulLong(base, base, base))
+            return false;
+    }
+    res = result;
+    return true;
+}
+
+// Python's float % float
+bool modDouble(double a, double b, double &res) {
+    if (b == 0.0)
+        return false;
+    double mod = std::fmod(a, b);
+    if (mod != 0.0) {
+        if ((b < 0) != (mod < 0))
+            mod += b;
+    }
+    else
+        mod = std::copysign(0.0, b);
+    res = mod;
+    return true;
+}
+
+// Python's float ** float, giving up on errors and complex results
+bool powDouble(double a, double b, double &res) {
+    if (a == 0.0 && b < 0.0)
+        return false;
+    if (a < 0.0 && std::isfinite(b) && b != std::floor(b))
+        return false;
+    double result = std::pow(a, b);
+    if (std::isinf(result) && std::isfinite(a) && std::isfinite(b))
+        return false;
+    res = result;
+    return true;
+}
+
+// Python's rich comparison of two numbers
+template<class T>
+bool compare(int op, const T &a, const T &b) {
+    switch (op) {
+    case OperatorExpression::EQ:
+        return a == b;
+    case OperatorExpression::NEQ:
+        return a != b;
+    case OperatorExpression::LT:
+        return a < b;
+    case OperatorExpression::GT:
+        return a > b;
+    case OperatorExpression::LTE:
+        return a <= b;
+    default:
+        return a >= b;
+    }
+}
+
+// Same as QuantityPy::richCompare() for two quantities
+bool compareQuantity(int op, const Quantity &a, const Quantity &b) {
+    switch (op) {
+    case OperatorExpression::EQ:
+        return a == b;
+    case OperatorExpression::NEQ:
+        return !(a == b);
+    case OperatorExpression::LT:
+        return a < b;
+    case OperatorExpression::GT:
+        return !(a < b) && !(a == b);
+    case OperatorExpression::LTE:
+        return a < b || a == b;
+    default:
+        return !(a < b);
+    }
+}
+
+// Same as calc()
+bool compiledCalc(int op, const CompiledValue &l, const CompiledValue &r, CompiledValue &res) {
+    switch (op) {
+    case OperatorExpression::POS:
+        if (l.type == CompiledType::Bool)
+            assignLong(res, l.l);
+        else
+            res = l;
+        return true;
+    case OperatorExpression::NEG:
+        switch (l.type) {
+        case CompiledType::Quantity:
+            assignQuantity(res, l.q * -1.0);
+            return true;
+        case CompiledType::Float:
+            assignFloat(res, -l.d);
+            return true;
+        default:
+            if (l.l == std::numeric_limits<long>::min())
+                return false;
+            assignLong(res, -l.l);
+            return true;
+        }
+    case OperatorExpression::EQ:
+    case OperatorExpression::NEQ:
+    case OperatorExpression::LT:
+    case OperatorExpression::GT:
+    case OperatorExpression::LTE:
+    case OperatorExpression::GTE:
+        if (l.type == CompiledType::Quantity && r.type == CompiledType::Quantity)
+            assignBool(res, compareQuantity(op, l.q, r.q));
+        else if (isIntegral(l) && isIntegral(r))
+            assignBool(res, compare(op, l.l, r.l));
+        else {
+            // Python compares int and float exactly
+            if ((isIntegral(l) && !isExact(l.l)) || (isIntegral(r) && !isExact(r.l)))
+                return false;
+            assignBool(res, compare(op, toDouble(l), toDouble(r)));
+        }
+        return true;
+    default:
+        break;
+    }
+
+    if (l.type == CompiledType::Quantity || r.type == CompiledType::Quantity) {
+        switch (op) {
+        case OperatorExpression::ADD:
+            assignQuantity(res, toQuantity(l) + toQuantity(r));
+            return true;
+        case OperatorExpression::SUB:
+            assignQuantity(res, toQuantity(l) - toQuantity(r));
+            return true;
+        case OperatorExpression::MUL:
+        case OperatorExpression::UNIT:
+            assignQuantity(res, toQuantity(l) * toQuantity(r));
+            return true;
+        case OperatorExpression::DIV:
+            assignQuantity(res, toQuantity(l) / toQuantity(r));
+            return true;
+        case OperatorExpression::MOD: {
+            double mod;
+            if (l.type != CompiledType::Quantity || !modDouble(l.q.getValue(), toDouble(r), mod))
+                return false;
+            assignQuantity(res, Quantity(mod, l.q.getUnit()));
+            return true;
+        }
+        case OperatorExpression::POW:
+            if (l.type != CompiledType::Quantity)
+                return false;
+            if (r.type == CompiledType::Quantity)
+                assignQuantity(res, l.q.pow(r.q));
+            else
+                assignQuantity(res, l.q.pow(toDouble(r)));
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    if (isIntegral(l) && isIntegral(r)) {
+        long value;
+        switch (op) {
+        case OperatorExpression::ADD:
+            if (!addLong(l.l, r.l, value))
+                return false;
+            assignLong(res, value);
+            return true;
+        case OperatorExpression::SUB:
+            if (!subLong(l.l, r.l, value))
+                return false;
+            assignLong(res, value);
+            return true;
+        case OperatorExpression::MUL:
+        case OperatorExpression::UNIT:
+            if (!mulLong(l.l, r.l, value))
+                return false;
+            assignLong(res, value);
+            return true;
+        case OperatorExpression::DIV:
+            if (r.l == 0 || !isExact(l.l) || !isExact(r.l))
+                return false;
+            assignFloat(res, static_cast<double>(l.l) / static_cast<double>(r.l));
+            return true;
+        case OperatorExpression::MOD:
+            if (r.l == 0)
+                return false;
+            if (r.l == -1)
+                value = 0;
+            else {
+                value = l.l % r.l;
+                if (value != 0 && ((value < 0) != (r.l < 0)))
+                    value += r.l;
+            }
+            assignLong(res, value);
+            return true;
+        case OperatorExpression::POW:
+            if (r.l >= 0) {
+                if (!powLong(l.l, r.l, value))
+                    return false;
+                assignLong(res, value);
+                return true;
+            }
+            break;
+        default:
+            return false;
+        }
+    }
+
+    double a = toDouble(l);
+    double b = toDouble(r);
+    double value;
+    switch (op) {
+    case OperatorExpression::ADD:
+        value = a + b;
+        break;
+    case OperatorExpression::SUB:
+        value = a - b;
+        break;
+    case OperatorExpression::MUL:
+    case OperatorExpression::UNIT:
+        value = a * b;
+        break;
+    case OperatorExpression::DIV:
+        if (b == 0.0)
+            return false;
+        value = a / b;
+        break;
+    case OperatorExpression::MOD:
+        if (!modDouble(a, b, value))
+            return false;
+        break;
+    case OperatorExpression::POW:
+        if (!powDouble(a, b, value))
+            return false;
+        break;
+    default:
+        return false;
+    }
+    assignFloat(res, value);
+    return true;
+}
+
+} // anonymous namespace
+
+bool CompiledExpression::eval(App::any &value) const {
+    if (!func)
+        return false;
+
+    CompiledValue res;
+    try {
+        if (!func(res))
+            return false;
+    } catch (Base::Exception &) {
+        return false;
+    }
+
+    // Same as pyObjectToAny(), which converts a Python bool to long
+    switch (res.type) {
+    case CompiledType::Quantity:
+        value = res.q;
+        break;
+    case CompiledType::Float:
+        value = res.d;
+        break;
+    default:
+        value = res.l;
+        break;
+    }
+    return true;
+}
+
+CompiledExpression Expression::compile() const {
+    if (!components.empty())
+        return {};
+
+    CompiledExpression res = _compile();
+    if (res && res.isConstant()) {
+        CompiledValue value;
+        bool ok;
+        try {
+            ok = res.eval(value);
+        } catch (Base::Exception &) {
+            ok = false;
+        }
+        // Keep the closure if it fails, so that the error is reported on evaluation
+        if (ok)
+            return compiledConstant(value);
+    }
+    return res;
+}
+
 void Expression::addComponent(Component *component) {
     assert(component);
     components.push_back(component);
@@ -1267,6 +1679,10 @@ Py::Object UnitExpression::_getPyValue() const {
     return Py::Object(cache);
 }
 
+CompiledExpression UnitExpression::_compile() const {
+    return compiledConstant(compiledFromQuantity(quantity));
+}
+
 //
 // NumberExpression class
 //
@@ -1476,6 +1892,28 @@ Py::Object OperatorExpression::_getPyValue() const {
     return calc(this,op,left,right,false);
 }
 
+CompiledExpression OperatorExpression::_compile() const {
+    CompiledExpression l = left->compile();
+    if (!l)
+        return {};
+
+    Operator oper = op;
+    if (oper == POS || oper == NEG) {
+        return CompiledExpression([l, oper](CompiledValue &res) {
+            CompiledValue value;
+            return l.eval(value) && compiledCalc(oper, value, value, res);
+        }, l.isConstant());
+    }
+
+    CompiledExpression r = right->compile();
+    if (!r)
+        return {};
+    return CompiledExpression([l, r, oper](CompiledValue &res) {
+        CompiledValue lvalue, rvalue;
+        return l.eval(lvalue) && r.eval(rvalue) && compiledCalc(oper, lvalue, rvalue, res);
+    }, l.isConstant() && r.isConstant());
+}
+
 /**
   * Simplify the expression. For OperatorExpressions, we return a NumberExpression if
   * both the left and right side can be simplified to NumberExpressions. In this case
@@ -2185,8 +2623,6 @@ Base::Vector3d FunctionExpression::extractVectorArgument(
 
 Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std::vector<Expression*> &args)
 {
-    using std::numbers::pi;
-
     if(!expr || !expr->getOwner())
         _EXPR_THROW("Invalid owner.", expr);
 
@@ -2444,6 +2880,36 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         v3 = pyToQuantity(e3,expr,"Invalid third argument.");
     }
 
+    switch (f) {
+    case ROTATIONX:
+    case ROTATIONY:
+    case ROTATIONZ:
+        if (!(v1.isDimensionlessOrUnit(Unit::Angle)))
+            _EXPR_THROW("Unit must be either empty or an angle.", expr);
+        return Py::asObject(new Base::RotationPy(Base::Rotation(
+            Vector3d(static_cast<double>(f == ROTATIONX), static_cast<double>(f == ROTATIONY), static_cast<double>(f == ROTATIONZ)),
+            Base::toRadians(v1.getValue()))));
+    case TRANSLATIONM:
+        if (v1.isDimensionlessOrUnit(Unit::Length) && v2.isDimensionlessOrUnit(Unit::Length) && v3.isDimensionlessOrUnit(Unit::Length))
+            return translationMatrix(v1.getValue(), v2.getValue(), v3.getValue());
+        _EXPR_THROW("Translation units must be a length or dimensionless.", expr);
+    default:
+        break;
+    }
+
+    return Py::asObject(new QuantityPy(new Quantity(evalScalar(expr, f, args.size(), v1, v2, v3))));
+}
+
+/**
+  * Checks the units of the arguments of the scalar math functions and computes
+  * the result. Shared by the interpreted and the compiled evaluation.
+  */
+
+Quantity FunctionExpression::evalScalar(const Expression *expr, int f, std::size_t argCount,
+        const Quantity &v1, const Quantity &v2, const Quantity &v3)
+{
+    using std::numbers::pi;
+
     double output;
     Unit unit;
     double scaler = 1;
@@ -2455,9 +2921,6 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     case COS:
     case SIN:
     case TAN:
-    case ROTATIONX:
-    case ROTATIONY:
-    case ROTATIONZ:
         if (!(v1.isDimensionlessOrUnit(Unit::Angle)))
             _EXPR_THROW("Unit must be either empty or an angle.", expr);
 
@@ -2497,7 +2960,7 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         unit = v1.getUnit().cbrt();
         break;
     case ATAN2:
-        if (e2.isNone())
+        if (argCount < 2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (v1.getUnit() != v2.getUnit())
@@ -2506,14 +2969,14 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         scaler = 180.0 / pi;
         break;
     case MOD:
-        if (e2.isNone())
+        if (argCount < 2)
             _EXPR_THROW("Invalid second argument.",expr);
         if (v1.getUnit() != v2.getUnit() && !v1.isDimensionless() && !v2.isDimensionless())
             _EXPR_THROW("Units must be equal or dimensionless.",expr);
         unit = v1.getUnit();
         break;
     case POW: {
-        if (e2.isNone())
+        if (argCount < 2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (!v2.isDimensionless())
@@ -2531,23 +2994,17 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     }
     case HYPOT:
     case CATH:
-        if (e2.isNone())
+        if (argCount < 2)
             _EXPR_THROW("Invalid second argument.",expr);
         if (v1.getUnit() != v2.getUnit())
             _EXPR_THROW("Units must be equal.",expr);
 
-        if (args.size() > 2) {
-            if (e3.isNone())
-                _EXPR_THROW("Invalid second argument.",expr);
+        if (argCount > 2) {
             if (v2.getUnit() != v3.getUnit())
                 _EXPR_THROW("Units must be equal.",expr);
         }
         unit = v1.getUnit();
         break;
-    case TRANSLATIONM:
-        if (v1.isDimensionlessOrUnit(Unit::Length) && v2.isDimensionlessOrUnit(Unit::Length) && v3.isDimensionlessOrUnit(Unit::Length))
-            break;
-        _EXPR_THROW("Translation units must be a length or dimensionless.", expr);
     case NOT:
         unit = Unit();
         break;
@@ -2615,11 +3072,11 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         break;
     }
     case HYPOT: {
-        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (argCount > 2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case CATH: {
-        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (argCount > 2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case ROUND:
@@ -2634,14 +3091,6 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     case FLOOR:
         output = floor(value);
         break;
-    case ROTATIONX:
-    case ROTATIONY:
-    case ROTATIONZ:
-        return Py::asObject(new Base::RotationPy(Base::Rotation(
-            Vector3d(static_cast<double>(f == ROTATIONX), static_cast<double>(f == ROTATIONY), static_cast<double>(f == ROTATIONZ)),
-            value)));
-    case TRANSLATIONM:
-        return translationMatrix(v1.getValue(), v2.getValue(), v3.getValue());
     case NOT:
         output = asBool(value) ? 0 : 1;
         break;
@@ -2649,13 +3098,41 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         _EXPR_THROW("Unknown function: " << f,0);
     }
 
-    return Py::asObject(new QuantityPy(new Quantity(scaler * output, unit)));
+    return Quantity(scaler * output, unit);
 }
 
 Py::Object FunctionExpression::_getPyValue() const {
     return evaluate(this,f,args);
 }
 
+CompiledExpression FunctionExpression::_compile() const {
+    // Only the scalar math functions of evalScalar()
+    if (!owner || args.empty() || ((f < ABS || f > TRUNC) && f != NOT))
+        return {};
+
+    // Like evaluate(), only look at the first three arguments
+    std::vector<CompiledExpression> compiledArgs;
+    bool constant = true;
+    for (std::size_t i = 0; i < args.size() && i < 3; ++i) {
+        compiledArgs.push_back(args[i]->compile());
+        if (!compiledArgs.back())
+            return {};
+        constant = constant && compiledArgs.back().isConstant();
+    }
+
+    return CompiledExpression([this, compiledArgs](CompiledValue &res) {
+        CompiledValue value;
+        Quantity v[3];
+        for (std::size_t i = 0; i < compiledArgs.size(); ++i) {
+            if (!compiledArgs[i].eval(value))
+                return false;
+            v[i] = toQuantity(value);
+        }
+        assignQuantity(res, evalScalar(this, f, args.size(), v[0], v[1], v[2]));
+        return true;
+    }, constant);
+}
+
 /**
   * Try to simplify the expression, i.e calculate all constant expressions.
   *
@@ -2976,6 +3453,34 @@ Py::Object VariableExpression::_getPyValue() const {
     return var.getPyValue(true);
 }
 
+CompiledExpression VariableExpression::_compile() const {
+    if (!var.getSubObjectName().empty())
+        return {};
+
+    // The reference is resolved on each evaluation, as the referenced object
+    // or property may change in between.
+    return CompiledExpression([this](CompiledValue &res) {
+        int ptype = 0;
+        Property *prop = var.getProperty(&ptype);
+        // Only plain properties, i.e. no pseudo property and no attribute of the property
+        if (!prop || ptype != 0 || var.numSubComponents() != 1)
+            return false;
+
+        // Same values as the Python objects of the properties
+        if (auto quantityProp = freecad_cast<PropertyQuantity*>(prop))
+            assignQuantity(res, Quantity(quantityProp->getValue(), quantityProp->getUnit()));
+        else if (auto floatProp = freecad_cast<PropertyFloat*>(prop))
+            assignFloat(res, floatProp->getValue());
+        else if (auto intProp = freecad_cast<PropertyInteger*>(prop))
+            assignLong(res, intProp->getValue());
+        else if (auto boolProp = freecad_cast<PropertyBool*>(prop))
+            assignBool(res, boolProp->getValue());
+        else
+            return false;
+        return true;
+    });
+}
+
 void VariableExpression::_toString(std::ostream &ss, bool persistent,int) const {
     if(persistent)
         ss << var.toPersistentString();
@@ -3255,6 +3760,21 @@ Py::Object ConditionalExpression::_getPyValue() const {
         return falseExpr->getPyValue();
 }
 
+CompiledExpression ConditionalExpression::_compile() const {
+    CompiledExpression c = condition->compile();
+    CompiledExpression t = trueExpr->compile();
+    CompiledExpression f = falseExpr->compile();
+    if (!c || !t || !f)
+        return {};
+
+    return CompiledExpression([c, t, f](CompiledValue &res) {
+        CompiledValue value;
+        if (!c.eval(value))
+            return false;
+        return isTrue(value) ? t.eval(res) : f.eval(res);
+    }, c.isConstant() && t.isConstant() && f.isConstant());
+}
+
 Expression *ConditionalExpression::simplify() const
 {
     std::unique_ptr<Expression> e(condition->simplify());
@@ -3341,6 +3861,17 @@ Py::Object ConstantExpression::_getPyValue() const {
     return Py::Object(cache);
 }
 
+CompiledExpression ConstantExpression::_compile() const {
+    if(strcmp(name,"None")==0)
+        return {};
+    if(strcmp(name,"True")==0 || strcmp(name,"False")==0) {
+        CompiledValue value;
+        assignBool(value, strcmp(name,"True")==0);
+        return compiledConstant(value);
+    }
+    return NumberExpression::_compile();
+}
+
 bool ConstantExpression::isNumber() const {
     return strcmp(name,"None")
         && strcmp(name,"True")
@@ -24,6 +24,7 @@
 #define EXPRESSION_H
 
 #include <deque>
+#include <functional>
 #include <set>
 #include <string>
 
@@ -44,6 +45,7 @@ namespace App  {
 class DocumentObject;
 class Expression;
 class Document;
+struct CompiledValue;
 
 using ExpressionPtr = std::unique_ptr<Expression>;
 
@@ -109,6 +111,47 @@ protected:
 };
 
 
+/**
+  * @brief A numeric expression compiled to a tree of closures.
+  * @ingroup ExpressionFramework
+  *
+  * @details Created by Expression::compile(). The closures refer to the
+  * expression they were compiled from, which must outlive them.
+  */
+class AppExport CompiledExpression {
+public:
+    using Function = std::function<bool(CompiledValue &)>;
+
+    CompiledExpression() = default;
+    explicit CompiledExpression(Function _func, bool _constant=false)
+        : func(std::move(_func)), constant(_constant)
+    {}
+
+    explicit operator bool() const { return static_cast<bool>(func); }
+
+    /// Returns true if the value does not depend on any property
+    bool isConstant() const { return constant; }
+
+    /** Evaluates the expression.
+      *
+      * @param value: receives the same value as Expression::getValueAsAny().
+      *
+      * @return false if the expression has to be evaluated by
+      * Expression::getValueAsAny() instead, e.g. because a referenced property
+      * does not hold a number, or because the evaluation fails and the error
+      * is to be reported.
+      */
+    bool eval(App::any &value) const;
+
+    /// Evaluates the expression into a value of the compiled representation
+    bool eval(CompiledValue &value) const { return func(value); }
+
+private:
+    Function func;
+    bool constant = false;
+};
+
+
 /**
   * @brief %Base class for expressions.
   * @ingroup ExpressionFramework
@@ -188,6 +231,20 @@ public:
 
     Py::Object getPyValue() const;
 
+    /** Compiles the expression for an evaluation without Python.
+      *
+      * Numbers, units, constants, references to integer, float, quantity and
+      * boolean properties, operators, conditionals and the scalar math
+      * functions are lowered to closures working on plain numbers and
+      * quantities. Their result is the same as the one of getValueAsAny(),
+      * but the intermediate values are not boxed into Python objects and the
+      * GIL is not needed. Constant sub-expressions are evaluated once here.
+      *
+      * @return The compiled expression, which is empty if anything else is
+      * used by the expression.
+      */
+    CompiledExpression compile() const;
+
     bool isSame(const Expression &other, bool checkComment=true) const;
 
     friend class ExpressionVisitor;
@@ -214,6 +271,7 @@ protected:
     virtual void _moveCells(const CellAddress &, int, int, ExpressionVisitor &) {}
     virtual void _offsetCells(int, int, ExpressionVisitor &) {}
     virtual Py::Object _getPyValue() const = 0;
+    virtual CompiledExpression _compile() const {return {};}
     virtual void _visit(ExpressionVisitor &) {}
 
 protected:
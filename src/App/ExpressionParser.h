@@ -65,6 +65,26 @@ struct AppExport Expression::Component
     void del(const Expression* owner, Py::Object& pyobj) const;
 };
 
+/**
+ * Value of a compiled expression. The types mirror the Python objects the
+ * interpreted evaluation works with.
+ */
+struct AppExport CompiledValue
+{
+    enum class Type
+    {
+        Bool,
+        Long,
+        Float,
+        Quantity,
+    };
+
+    Type type = Type::Long;
+    long l = 0;       /**< Value of Bool and Long */
+    double d = 0.0;   /**< Value of Float */
+    Base::Quantity q; /**< Value of Quantity */
+};
+
 ////////////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -118,6 +138,7 @@ protected:
     Expression* _copy() const override;
     void _toString(std::ostream& ss, bool persistent, int indent) const override;
     Py::Object _getPyValue() const override;
+    CompiledExpression _compile() const override;
 
 protected:
     mutable PyObject* cache = nullptr;
@@ -168,6 +189,7 @@ public:
 
 protected:
     Py::Object _getPyValue() const override;
+    CompiledExpression _compile() const override;
     void _toString(std::ostream& ss, bool persistent, int indent) const override;
     Expression* _copy() const override;
 
@@ -237,6 +259,8 @@ protected:
 
     Py::Object _getPyValue() const override;
 
+    CompiledExpression _compile() const override;
+
     void _toString(std::ostream& ss, bool persistent, int indent) const override;
 
     void _visit(ExpressionVisitor& v) override;
@@ -275,6 +299,7 @@ protected:
     void _visit(ExpressionVisitor& v) override;
     void _toString(std::ostream& ss, bool persistent, int indent) const override;
     Py::Object _getPyValue() const override;
+    CompiledExpression _compile() const override;
 
 protected:
     Expression* condition; /**< Condition */
@@ -427,7 +452,14 @@ protected:
                                              const std::vector<Expression*>& arguments,
                                              const Base::Matrix4D* transformationMatrix);
     static Py::Object translationMatrix(double x, double y, double z);
+    static Base::Quantity evalScalar(const Expression* expr,
+                                     int type,
+                                     std::size_t argCount,
+                                     const Base::Quantity& v1,
+                                     const Base::Quantity& v2,
+                                     const Base::Quantity& v3);
     Py::Object _getPyValue() const override;
+    CompiledExpression _compile() const override;
     Expression* _copy() const override;
     void _visit(ExpressionVisitor& v) override;
     void _toString(std::ostream& ss, bool persistent, int indent) const override;
@@ -478,6 +510,7 @@ public:
 protected:
     Expression* _copy() const override;
     Py::Object _getPyValue() const override;
+    CompiledExpression _compile() const override;
     void _toString(std::ostream& ss, bool persistent, int indent) const override;
     bool _isIndexable() const override;
     void _getIdentifiers(std::map<App::ObjectIdentifier, bool>&) const override;
@@ -202,6 +202,10 @@ public:
     /** @name methods override Feature */
     //@{
     DocumentObjectExecReturn* execute() override;
+    bool isExecuteThreadSafe() const override
+    {
+        return true;
+    }
     //@}
 };
 
@@ -759,9 +759,19 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
         App::any value;
         try {
             // Evaluate expression
-            std::shared_ptr<App::Expression> expression = expressions[*it].expression;
+            ExpressionInfo& info = expressions[*it];
+            std::shared_ptr<App::Expression> expression = info.expression;
             if (expression) {
-                value = expression->getValueAsAny();
+                // Purely numeric expressions are evaluated without Python,
+                // anything else, including errors, falls back to the interpreter
+                if (info.compiledExpression != expression) {
+                    info.compiled =
+                        std::make_shared<const CompiledExpression>(expression->compile());
+                    info.compiledExpression = expression;
+                }
+                if (!info.compiled->eval(value)) {
+                    value = expression->getValueAsAny();
+                }
 
                 // Enable value comparison for all expression bindings to reduce
                 // unnecessary touch and recompute.
@@ -44,6 +44,7 @@ class DocumentObject;
 class DocumentObjectExecReturn;
 class ObjectIdentifier;
 class Expression;
+class CompiledExpression;
 using ExpressionPtr = std::unique_ptr<Expression>;
 
 class AppExport PropertyExpressionContainer: public App::PropertyXLinkContainer
@@ -98,6 +99,11 @@ public:
     {
         std::shared_ptr<App::Expression> expression; /**< The actual expression tree */
         bool busy;
+        /** Compiled form of the expression, created on the first execution,
+         * see Expression::compile() */
+        std::shared_ptr<const App::CompiledExpression> compiled;
+        /** The expression that was compiled, kept alive as the compiled form refers to it */
+        std::shared_ptr<App::Expression> compiledExpression;
 
         explicit ExpressionInfo(
             std::shared_ptr<App::Expression> expression = std::shared_ptr<App::Expression>())
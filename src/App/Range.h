@@ -23,6 +23,8 @@
 #ifndef RANGE_H
 #define RANGE_H
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <Base/Bitmask.h>
 #ifndef FC_GLOBAL_H
@@ -265,4 +267,14 @@ private:
 
 ENABLE_BITMASK_OPERATORS(App::CellAddress::Cell)
 
+template<>
+struct std::hash<App::CellAddress>
+{
+    std::size_t operator()(const App::CellAddress& address) const noexcept
+    {
+        // same key as CellAddress::operator==(), i.e. the absolute flags are ignored
+        return (std::size_t(std::uint16_t(address.row())) << 16) | std::uint16_t(address.col());
+    }
+};
+
 #endif  // RANGE_H
@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <iomanip>
+#endif
+
+#include "RecomputeProfile.h"
+#include "DocumentObject.h"
+
+using namespace App;
+
+namespace
+{
+void writeString(std::ostream& str, const std::string& text)
+{
+    str << '"';
+    for (char c : text) {
+        switch (c) {
+            case '"':
+                str << "\\\"";
+                break;
+            case '\\':
+                str << "\\\\";
+                break;
+            case '\n':
+                str << "\\n";
+                break;
+            case '\r':
+                str << "\\r";
+                break;
+            case '\t':
+                str << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    str << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                        << static_cast<int>(c) << std::dec << std::setfill(' ');
+                }
+                else {
+                    str << c;
+                }
+                break;
+        }
+    }
+    str << '"';
+}
+
+void writeStringList(std::ostream& str, const std::vector<std::string>& list)
+{
+    str << '[';
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        if (i != 0) {
+            str << ',';
+        }
+        writeString(str, list[i]);
+    }
+    str << ']';
+}
+}  // namespace
+
+RecomputeProfile::Scope::Scope(RecomputeProfile& profile, const DocumentObject* obj)
+{
+    if (!profile.isRunning()) {
+        return;
+    }
+    this->profile = &profile;
+    this->object = obj;
+
+    entry.name = obj->getNameInDocument();
+    entry.label = obj->Label.getValue();
+    entry.type = obj->getTypeId().getName();
+
+    std::vector<Property*> props;
+    obj->getPropertyList(props);
+    for (auto prop : props) {
+        if (prop->isTouched()) {
+            entry.touched.emplace_back(prop->getName());
+        }
+    }
+    for (auto dep : obj->getOutList()) {
+        if (profile.wasRecomputed(dep)) {
+            entry.dependencies.emplace_back(dep->getNameInDocument());
+        }
+    }
+
+    begin = std::chrono::steady_clock::now();
+}
+
+RecomputeProfile::Scope::~Scope()
+{
+    if (!profile) {
+        return;
+    }
+    auto end = std::chrono::steady_clock::now();
+    entry.start = profile->elapsed(begin);
+    entry.duration = std::chrono::duration<double, std::milli>(end - begin).count();
+    entry.memSize = object->getMemSize();
+    entry.error = object->isError();
+    profile->add(std::move(entry), object);
+}
+
+void RecomputeProfile::start(const std::string& document)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    documentName = document;
+    entries.clear();
+    recomputed.clear();
+    threads.clear();
+    threads.emplace(std::this_thread::get_id(), 0);
+    totalTime = 0.0;
+    origin = std::chrono::steady_clock::now();
+    running = true;
+}
+
+void RecomputeProfile::stop()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running) {
+        totalTime = elapsed(std::chrono::steady_clock::now());
+        running = false;
+    }
+}
+
+double RecomputeProfile::elapsed(std::chrono::steady_clock::time_point time) const
+{
+    return std::chrono::duration<double, std::milli>(time - origin).count();
+}
+
+int RecomputeProfile::threadIndex()
+{
+    auto res = threads.emplace(std::this_thread::get_id(), static_cast<int>(threads.size()));
+    return res.first->second;
+}
+
+void RecomputeProfile::add(Entry&& entry, const DocumentObject* obj)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entry.thread = threadIndex();
+    entries.push_back(std::move(entry));
+    recomputed.insert(obj);
+}
+
+bool RecomputeProfile::wasRecomputed(const DocumentObject* obj)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return recomputed.contains(obj);
+}
+
+void RecomputeProfile::toJson(std::ostream& str) const
+{
+    str << "{\"document\":";
+    writeString(str, documentName);
+    str << ",\"total\":" << totalTime << ",\"objects\":[";
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        const auto& entry = entries[i];
+        if (i != 0) {
+            str << ',';
+        }
+        str << "\n{\"name\":";
+        writeString(str, entry.name);
+        str << ",\"label\":";
+        writeString(str, entry.label);
+        str << ",\"type\":";
+        writeString(str, entry.type);
+        str << ",\"start\":" << entry.start << ",\"duration\":" << entry.duration
+            << ",\"thread\":" << entry.thread << ",\"memSize\":" << entry.memSize
+            << ",\"error\":" << (entry.error ? "true" : "false") << ",\"touched\":";
+        writeStringList(str, entry.touched);
+        str << ",\"dependencies\":";
+        writeStringList(str, entry.dependencies);
+        str << '}';
+    }
+    str << "]}\n";
+}
+
+void RecomputeProfile::toChromeTrace(std::ostream& str) const
+{
+    // Complete events ("ph":"X") with timestamps in microseconds
+    str << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    str << "\n{\"name\":";
+    writeString(str, "Recompute " + documentName);
+    str << ",\"cat\":\"Document\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":0,\"dur\":"
+        << totalTime * 1000.0 << '}';
+    for (const auto& entry : entries) {
+        str << ",\n{\"name\":";
+        writeString(str, entry.label);
+        str << ",\"cat\":";
+        writeString(str, entry.type);
+        str << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << entry.thread
+            << ",\"ts\":" << entry.start * 1000.0 << ",\"dur\":" << entry.duration * 1000.0
+            << ",\"args\":{\"object\":";
+        writeString(str, entry.name);
+        str << ",\"memSize\":" << entry.memSize
+            << ",\"error\":" << (entry.error ? "true" : "false") << ",\"touched\":";
+        writeStringList(str, entry.touched);
+        str << ",\"dependencies\":";
+        writeStringList(str, entry.dependencies);
+        str << "}}";
+    }
+    str << "]}\n";
+}
@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef APP_RECOMPUTEPROFILE_H
+#define APP_RECOMPUTEPROFILE_H
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <FCGlobal.h>
+
+namespace App
+{
+
+class DocumentObject;
+
+/** Per object timing of a Document::recompute()
+ *
+ * The profile is filled by Document::recompute() while profiling is enabled,
+ * either through Document::setRecomputeProfiling() or the 'RecomputeProfile'
+ * document preference. It does not depend on Tracy and can be written as
+ * plain JSON or in the Chrome trace event format (chrome://tracing, Perfetto).
+ */
+class AppExport RecomputeProfile
+{
+public:
+    /// Timing of a single object execution
+    struct Entry
+    {
+        /// internal name of the object
+        std::string name;
+        /// label of the object
+        std::string label;
+        /// type name of the object
+        std::string type;
+        /// touched properties that caused the execution
+        std::vector<std::string> touched;
+        /// dependencies recomputed before in the same run that caused the execution
+        std::vector<std::string> dependencies;
+        /// start time in ms relative to the start of the recompute
+        double start {0.0};
+        /// wall time of the execution in ms
+        double duration {0.0};
+        /// 0 for the thread calling recompute(), worker threads count from 1
+        int thread {0};
+        /// memory used by the object properties after execution in bytes
+        unsigned int memSize {0};
+        /// true if the object failed to execute
+        bool error {false};
+    };
+
+    /** Times one object execution, the entry is added on destruction
+     *
+     * Does nothing if the profile is not running.
+     */
+    class AppExport Scope
+    {
+    public:
+        Scope(RecomputeProfile& profile, const DocumentObject* obj);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&) = delete;
+
+    private:
+        RecomputeProfile* profile {nullptr};
+        const DocumentObject* object {nullptr};
+        Entry entry;
+        std::chrono::steady_clock::time_point begin;
+    };
+
+    /// Discard the previous entries and start the clock
+    void start(const std::string& document);
+    /// Stop the clock, entries are kept until the next start()
+    void stop();
+    /// Check if the profile is collecting entries
+    bool isRunning() const
+    {
+        return running;
+    }
+
+    /// Name of the profiled document
+    const std::string& getDocumentName() const
+    {
+        return documentName;
+    }
+    /// The recorded entries in the order the executions finished
+    const std::vector<Entry>& getEntries() const
+    {
+        return entries;
+    }
+    /// Wall time of the whole recompute in ms
+    double getTotalTime() const
+    {
+        return totalTime;
+    }
+
+    /// Write the profile as JSON object
+    void toJson(std::ostream& str) const;
+    /// Write the profile in the Chrome trace event format
+    void toChromeTrace(std::ostream& str) const;
+
+private:
+    double elapsed(std::chrono::steady_clock::time_point time) const;
+    int threadIndex();
+    void add(Entry&& entry, const DocumentObject* obj);
+    bool wasRecomputed(const DocumentObject* obj);
+
+private:
+    std::string documentName;
+    std::vector<Entry> entries;
+    std::set<const DocumentObject*> recomputed;
+    std::map<std::thread::id, int> threads;
+    std::chrono::steady_clock::time_point origin;
+    double totalTime {0.0};
+    bool running {false};
+    std::mutex mutex;
+};
+
+}  // namespace App
+
+#endif  // APP_RECOMPUTEPROFILE_H
@@ -25,7 +25,9 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <algorithm>
 #include <cassert>
+#include <limits>
 #endif
 
 #include <atomic>
@@ -116,7 +118,32 @@ int Transaction::getLastID()
 
 unsigned int Transaction::getMemSize() const
 {
-    return 0;
+    return static_cast<unsigned int>(
+        std::min<std::size_t>(getDataSize(), std::numeric_limits<unsigned int>::max()));
+}
+
+std::size_t Transaction::getDataSize() const
+{
+    std::size_t size = 0;
+    for (const auto& info : _Objects.get<0>()) {
+        size += info.second->getDataSize();
+        // an object removed from the document is owned by the transaction, see ~Transaction()
+        if (info.second->status == TransactionObject::New && !info.first->isAttachedToDocument()) {
+            size += info.first->getMemSize();
+        }
+    }
+    return size;
+}
+
+std::size_t Transaction::storeDataSize()
+{
+    storedDataSize = getDataSize();
+    return storedDataSize;
+}
+
+std::size_t Transaction::getStoredDataSize() const
+{
+    return storedDataSize;
 }
 
 void Transaction::Save(Base::Writer& /*writer*/) const
@@ -473,7 +500,20 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
 
 unsigned int TransactionObject::getMemSize() const
 {
-    return 0;
+    return static_cast<unsigned int>(
+        std::min<std::size_t>(getDataSize(), std::numeric_limits<unsigned int>::max()));
+}
+
+std::size_t TransactionObject::getDataSize() const
+{
+    std::size_t size = 0;
+    for (const auto& v : _PropChangeMap) {
+        // a rename does not own the property, see ~TransactionObject()
+        if (v.second.property && v.second.nameOrig.empty()) {
+            size += v.second.property->getMemSize();
+        }
+    }
+    return size;
 }
 
 void TransactionObject::Save(Base::Writer& /*writer*/) const
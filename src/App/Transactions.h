@@ -66,6 +66,12 @@ public:
     std::string Name;
 
     unsigned int getMemSize() const override;
+    /// Returns the memory used by the stored data, unlike getMemSize() it does not wrap at 4 GiB
+    std::size_t getDataSize() const;
+    /// Computes getDataSize() once the transaction is complete and keeps the result
+    std::size_t storeDataSize();
+    /// Returns the size kept by storeDataSize()
+    std::size_t getStoredDataSize() const;
     void Save(Base::Writer& writer) const override;
     /// This method is used to restore properties from an XML document.
     void Restore(Base::XMLReader& reader) override;
@@ -94,6 +100,7 @@ private:
 
 private:
     int transID;
+    std::size_t storedDataSize {0};
     using Info = std::pair<const TransactionalObject*, TransactionObject*>;
     bmi::multi_index_container<
         Info,
@@ -124,6 +131,8 @@ public:
     void addOrRemoveProperty(const Property* pcProp, bool add);
 
     unsigned int getMemSize() const override;
+    /// Returns the memory used by the stored properties, see Transaction::getDataSize()
+    std::size_t getDataSize() const;
     void Save(Base::Writer& writer) const override;
     /// This method is used to restore properties from an XML document.
     void Restore(Base::XMLReader& reader) override;
@@ -27,9 +27,11 @@
 #pragma warning(disable : 4834)
 #endif
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -43,6 +45,7 @@
 #include <App/DocumentObserver.h>
 #include <App/StringHasher.h>
 #include <App/ExportInfo.h>
+#include <App/RecomputeProfile.h>
 #include <Base/UniqueNameManager.h>
 
 // using VertexProperty = boost::property<boost::vertex_root_t, DocumentObject* >;
@@ -90,12 +93,21 @@ struct DocumentP
     bool opentransaction {false};
     std::bitset<32> StatusBits;
     int iUndoMode {0};
-    unsigned int UndoMemSize {0};
+    std::size_t UndoMemSize {0};
+    /// sum of Transaction::getStoredDataSize() over the undo and the redo stack
+    std::size_t UndoMemUsed {0};
+    std::size_t RedoMemUsed {0};
     unsigned int UndoMaxStackSize {20};
     std::string programVersion;
     mutable HasherMap hashers;
     std::multimap<const App::DocumentObject*, std::unique_ptr<App::DocumentObjectExecReturn>>
         _RecomputeLog;
+    /// guards _RecomputeLog and the undo transaction during parallel recompute
+    std::mutex recomputeMutex;
+    /// set while objects are executed by worker threads
+    std::atomic<bool> parallelRecompute {false};
+    RecomputeProfile recomputeProfile;
+    bool recomputeProfiling {false};
     ExportInfo exportInfo;
 
     StringHasherRef Hasher {new StringHasher};
@@ -104,6 +116,15 @@ struct DocumentP
 
     DocumentP();
 
+    /// Lock the undo transaction if worker threads may modify it concurrently
+    std::unique_lock<std::mutex> lockTransaction()
+    {
+        if (parallelRecompute) {
+            return std::unique_lock<std::mutex>(recomputeMutex);
+        }
+        return std::unique_lock<std::mutex>(recomputeMutex, std::defer_lock);
+    }
+
     void addRecomputeLog(const char* why, App::DocumentObject* obj)
     {
         addRecomputeLog(new DocumentObjectExecReturn(why, obj));
@@ -120,6 +141,7 @@ struct DocumentP
             delete returnCode;
             return;
         }
+        std::lock_guard<std::mutex> lock(recomputeMutex);
         _RecomputeLog.emplace(returnCode->Which,
                               std::unique_ptr<DocumentObjectExecReturn>(returnCode));
         returnCode->Which->setStatus(ObjectStatus::Error, true);
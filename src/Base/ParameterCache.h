@@ -0,0 +1,127 @@
+/**************************************************************************
+ *                                                                         *
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef BASE_PARAMETERCACHE_H
+#define BASE_PARAMETERCACHE_H
+
+#include <atomic>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "Parameter.h"
+
+namespace Base
+{
+
+/** A cached value of a single parameter
+ *
+ * ParameterGrp::GetBool() and friends search the DOM of the group and
+ * transcode the attribute on each call. Code that reads the same parameter
+ * over and over, e.g. on every recompute, can instead keep a ParameterCache
+ * bound to the group and the parameter name. It observes the group and
+ * re-reads the parameter whenever the group notifies a change of it, so that
+ * get() is a single atomic load and may be called from any thread.
+ *
+ * Supported types are bool, long, unsigned long and double, read with
+ * GetBool(), GetInt(), GetUnsigned() and GetFloat() respectively.
+ * Changes are only seen if they are made through ParameterGrp, which is the
+ * case for the parameter editor, the preference pages and Python.
+ *
+ * \code
+ * static Base::ParameterCache<bool> checkExtension(hGrp, "CheckExtension", true);
+ * if (checkExtension) {
+ *     ...
+ * }
+ * \endcode
+ */
+template<typename T>
+class ParameterCache: public ParameterGrp::ObserverType
+{
+    static_assert(std::is_same_v<T, bool> || std::is_same_v<T, long>
+                      || std::is_same_v<T, unsigned long> || std::is_same_v<T, double>,
+                  "unsupported parameter type");
+
+public:
+    ParameterCache(ParameterGrp::handle hGrp, const char* name, T preset)
+        : _hGrp(std::move(hGrp))
+        , _name(name)
+        , _preset(preset)
+        , _value(read())
+    {
+        _hGrp->Attach(this);
+    }
+    ~ParameterCache() override
+    {
+        _hGrp->Detach(this);
+    }
+
+    ParameterCache(const ParameterCache&) = delete;
+    ParameterCache(ParameterCache&&) = delete;
+    ParameterCache& operator=(const ParameterCache&) = delete;
+    ParameterCache& operator=(ParameterCache&&) = delete;
+
+    /// Returns the current value of the parameter
+    T get() const
+    {
+        return _value.load(std::memory_order_relaxed);
+    }
+    operator T() const  // NOLINT
+    {
+        return get();
+    }
+
+    void OnChange(ParameterGrp::SubjectType& rCaller, ParameterGrp::MessageType Reason) override
+    {
+        (void)rCaller;
+        // an empty name is sent when the whole group is cleared
+        if (!Reason || !*Reason || _name == Reason) {
+            _value.store(read(), std::memory_order_relaxed);
+        }
+    }
+
+private:
+    T read() const
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            return _hGrp->GetBool(_name.c_str(), _preset);
+        }
+        else if constexpr (std::is_same_v<T, long>) {
+            return _hGrp->GetInt(_name.c_str(), _preset);
+        }
+        else if constexpr (std::is_same_v<T, unsigned long>) {
+            return _hGrp->GetUnsigned(_name.c_str(), _preset);
+        }
+        else {
+            return _hGrp->GetFloat(_name.c_str(), _preset);
+        }
+    }
+
+    ParameterGrp::handle _hGrp;
+    std::string _name;
+    T _preset;
+    std::atomic<T> _value;
+};
+
+}  // namespace Base
+
+#endif  // BASE_PARAMETERCACHE_H
@@ -24,10 +24,13 @@
 #ifndef APP_PERSISTENCE_H
 #define APP_PERSISTENCE_H
 
+#include <memory>
+
 #include "BaseClass.h"
 
 namespace Base
 {
+class DeferredDocFile;
 class Reader;
 class Writer;
 class XMLReader;
@@ -145,6 +148,16 @@ public:
      * @see Base::Reader,Base::XMLReader
      */
     virtual void RestoreDocFile(Reader& /*reader*/);
+    /** Offer to restore the data of a file later
+     * This method is called instead of RestoreDocFile() if the document is
+     * restored lazily. An object that returns true keeps \a file and calls
+     * DeferredDocFile::restore() when it first needs the data, otherwise the
+     * file is read immediately. The default implementation returns false.
+     */
+    virtual bool deferRestoreDocFile(const std::shared_ptr<DeferredDocFile>& /*file*/)
+    {
+        return false;
+    }
     /// Encodes an attribute upon saving.
     static std::string encodeAttribute(const std::string&);
 
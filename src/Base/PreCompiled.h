@@ -61,6 +61,8 @@
 // STL
 #include <algorithm>
 #include <bitset>
+#include <condition_variable>
+#include <deque>
 #include <iomanip>
 #include <list>
 #include <limits>
@@ -82,6 +84,9 @@
 #include <fstream>
 #include <sstream>
 
+// zlib
+#include <zlib.h>
+
 // Xerces
 #include <xercesc/util/OutOfMemoryException.hpp>
 #include <xercesc/util/PlatformUtils.hpp>
@@ -125,6 +130,7 @@
 #include <QByteArray>
 #include <QCoreApplication>
 #include <QEvent>
+#include <QFile>
 #include <QIODevice>
 #include <QDataStream>
 #include <QDateTime>
@@ -24,12 +24,20 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <algorithm>
+#include <array>
 #include <map>
 #include <vector>
 #include <iostream>
 #include <string>
 #include <xercesc/sax2/XMLReaderFactory.hpp>
 #include <xercesc/sax2/Attributes.hpp>
+#include <QFile>
+#if defined(FC_OS_WIN32)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 #endif
 
 #include <locale>
@@ -43,11 +51,13 @@
 #include "Persistence.h"
 #include "Sequencer.h"
 #include "Stream.h"
+#include "XMLPullParser.h"
 #include "XMLTools.h"
 
 #ifdef _MSC_VER
 #include <zipios++/zipios-config.h>
 #endif
+#include <zipios++/zipfile.h>
 #include <zipios++/zipinputstream.h>
 #include <boost/iostreams/filtering_stream.hpp>
 
@@ -61,11 +71,25 @@ XERCES_CPP_NAMESPACE_USE
 using namespace std;
 
 
+namespace
+{
+std::string readStream(std::istream& str)
+{
+    std::string buffer;
+    std::array<char, 65536> chunk {};
+    std::streamsize count {};
+    while ((count = str.rdbuf()->sgetn(chunk.data(), chunk.size())) > 0) {
+        buffer.append(chunk.data(), count);
+    }
+    return buffer;
+}
+}  // namespace
+
 // ---------------------------------------------------------------------------
 //  Base::XMLReader: Constructors and Destructor
 // ---------------------------------------------------------------------------
 
-Base::XMLReader::XMLReader(const char* FileName, std::istream& str)
+Base::XMLReader::XMLReader(const char* FileName, std::istream& str, Backend backend)
     : _File(FileName)
 {
 #ifdef _MSC_VER
@@ -74,6 +98,18 @@ Base::XMLReader::XMLReader(const char* FileName, std::istream& str)
     str.imbue(std::locale::classic());
 #endif
 
+    if (backend == Backend::Pull) {
+        try {
+            pullParser = std::make_unique<XMLPullParser>(readStream(str));
+            ReadType = StartDocument;
+            _valid = true;
+        }
+        catch (const Base::Exception& e) {
+            cerr << "Exception message is: \n" << e.what() << "\n";
+        }
+        return;
+    }
+
     // create the parser
     parser = XMLReaderFactory::createXMLReader();  // NOLINT
 
@@ -115,9 +151,24 @@ const char* Base::XMLReader::localName() const
 
 unsigned int Base::XMLReader::getAttributeCount() const
 {
+    if (pullParser) {
+        return static_cast<unsigned int>(pullParser->attributes().size());
+    }
     return static_cast<unsigned int>(AttrMap.size());
 }
 
+const char* Base::XMLReader::findAttribute(const char* AttrName) const
+{
+    if (pullParser) {
+        return pullParser->attribute(AttrName);
+    }
+    auto pos = AttrMap.find(AttrName);
+    if (pos == AttrMap.end()) {
+        return nullptr;
+    }
+    return pos->second.c_str();
+}
+
 namespace
 {
 template<typename T>
@@ -148,11 +199,10 @@ template<typename T>
     requires Base::XMLReader::instantiated<T>
 T Base::XMLReader::getAttribute(const char* AttrName, T defaultValue) const
 {
-    auto pos = AttrMap.find(AttrName);
-    if (pos == AttrMap.end()) {
+    const char* rawValue = findAttribute(AttrName);
+    if (!rawValue) {
         return defaultValue;
     }
-    const char* rawValue = pos->second.c_str();
     return readerCast<T>(rawValue);
 }
 
@@ -160,13 +210,12 @@ template<typename T>
     requires Base::XMLReader::instantiated<T>
 T Base::XMLReader::getAttribute(const char* AttrName) const
 {
-    auto pos = AttrMap.find(AttrName);
-    if (pos == AttrMap.end()) {
+    const char* rawValue = findAttribute(AttrName);
+    if (!rawValue) {
         // wrong name, use hasAttribute if not sure!
         std::string msg = std::string("XML Attribute: \"") + AttrName + "\" not found";
         throw Base::XMLAttributeError(msg);
     }
-    const char* rawValue = pos->second.c_str();
     return readerCast<T>(rawValue);
 }
 
@@ -195,13 +244,17 @@ Base::XMLReader::getAttribute<unsigned long>(const char* AttrName) const;
 
 bool Base::XMLReader::hasAttribute(const char* AttrName) const
 {
-    return AttrMap.find(AttrName) != AttrMap.end();
+    return findAttribute(AttrName) != nullptr;
 }
 
 bool Base::XMLReader::read()
 {
     ReadType = None;
 
+    if (pullParser) {
+        return readPull();
+    }
+
     try {
         parser->parseNext(token);
     }
@@ -225,6 +278,50 @@ bool Base::XMLReader::read()
     return true;
 }
 
+bool Base::XMLReader::readPull()
+{
+    switch (pullParser->next()) {
+        case XMLPullParser::Event::StartDocument:
+            ReadType = StartDocument;
+            break;
+        case XMLPullParser::Event::EndDocument:
+            ReadType = EndDocument;
+            break;
+        case XMLPullParser::Event::StartElement:
+            LocalName = pullParser->name();
+            // like with the SAX parser an empty element is read at once
+            if (pullParser->isEmptyElement()) {
+                ReadType = StartEndElement;
+            }
+            else {
+                Level++;
+                ReadType = StartElement;
+            }
+            break;
+        case XMLPullParser::Event::EndElement:
+            Level--;
+            LocalName = pullParser->name();
+            ReadType = EndElement;
+            break;
+        case XMLPullParser::Event::Characters:
+            CharacterData = pullParser->text();
+            CharacterCount += static_cast<unsigned int>(CharacterData.size());
+            ReadType = Chars;
+            break;
+        case XMLPullParser::Event::CDATA:
+            CharacterData = pullParser->text();
+            ReadType = EndCDATA;
+            break;
+    }
+
+    // the SAX parser reports the end of the document along with the end of the root element
+    if ((ReadType == EndElement || ReadType == StartEndElement) && pullParser->depth() == 0) {
+        pullParser->next();
+        ReadType = EndDocument;
+    }
+    return true;
+}
+
 void Base::XMLReader::readElement(const char* ElementName)
 {
     bool ok {};
@@ -345,11 +442,11 @@ std::streamsize Base::XMLReader::read(char_type* s, std::streamsize n)
 
     for (;;) {
         std::streamsize copy_size =
-            static_cast<std::streamsize>(Characters.size()) - CharacterOffset;
+            static_cast<std::streamsize>(CharacterData.size()) - CharacterOffset;
         if (n < copy_size) {
             copy_size = n;
         }
-        std::memcpy(s, Characters.c_str() + CharacterOffset, copy_size);
+        std::memcpy(s, CharacterData.data() + CharacterOffset, copy_size);
         n -= copy_size;
         s += copy_size;
         CharacterOffset += copy_size;
@@ -434,10 +531,112 @@ void Base::XMLReader::readBinFile(const char* filename)
         }
     } while (ReadType != EndCDATA);
 
-    to << Base::base64_decode(Characters);
+    std::string data;
+    Base::base64_decode(data, CharacterData.data(), CharacterData.size());
+    to << data;
     to.close();
 }
 
+namespace
+{
+// read-only streambuf over a block of memory
+class MemoryStreambuf: public std::streambuf
+{
+public:
+    MemoryStreambuf(char* data, std::size_t size)
+    {
+        setg(data, data, data + size);
+    }
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir way, std::ios_base::openmode which) override
+    {
+        if (!(which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+        }
+        char* base = egptr();
+        if (way == std::ios_base::beg) {
+            base = eback();
+        }
+        else if (way == std::ios_base::cur) {
+            base = gptr();
+        }
+        char* pos = base + off;
+        if (pos < eback() || pos > egptr()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), pos, egptr());
+        return pos_type(pos - eback());
+    }
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+
+// stream over a memory mapping of the data of an uncompressed zip entry
+class MappedEntry: public std::istream
+{
+public:
+    static std::unique_ptr<MappedEntry>
+    map(const std::string& archive, std::streamoff offset, std::streamsize size)
+    {
+        if (size <= 0) {
+            return {};
+        }
+        auto entry = std::make_unique<MappedEntry>(archive);
+        if (!entry->file.open(QIODevice::ReadOnly)) {
+            return {};
+        }
+        entry->data = entry->file.map(offset, size);
+        if (!entry->data) {
+            return {};
+        }
+        entry->buf = std::make_unique<MemoryStreambuf>(reinterpret_cast<char*>(entry->data),
+                                                       static_cast<std::size_t>(size));
+        entry->rdbuf(entry->buf.get());
+        return entry;
+    }
+
+    explicit MappedEntry(const std::string& archive)
+        : std::istream(nullptr)
+        , file(QString::fromUtf8(archive.c_str()))
+    {}
+    ~MappedEntry()
+    {
+        if (data) {
+            file.unmap(data);
+        }
+    }
+
+    MappedEntry(const MappedEntry&) = delete;
+    MappedEntry(MappedEntry&&) = delete;
+    MappedEntry& operator=(const MappedEntry&) = delete;
+    MappedEntry& operator=(MappedEntry&&) = delete;
+
+private:
+    QFile file;
+    uchar* data {nullptr};
+    std::unique_ptr<MemoryStreambuf> buf;
+};
+}  // namespace
+
+unsigned int Base::XMLReader::getMappingAlignment()
+{
+    static const unsigned int pageSize = []() -> unsigned int {
+#if defined(FC_OS_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        long size = static_cast<long>(info.dwPageSize);
+#else
+        long size = sysconf(_SC_PAGESIZE);
+#endif
+        const long defaultSize = 4096;
+        return static_cast<unsigned int>(size > 0 ? size : defaultSize);
+    }();
+    return pageSize;
+}
+
 void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
 {
     // It's possible that not all objects inside the document could be created, e.g. if a module
@@ -457,6 +656,10 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
         // project file was created without GUI
         return;
     }
+    std::shared_ptr<DeferredDocFile::Archive> archive;
+    if (!DeferredArchive.empty()) {
+        archive = DeferredDocFile::openArchive(DeferredArchive);
+    }
     std::vector<FileEntry>::const_iterator it = FileList.begin();
     Base::SequencerLauncher seq("Importing project files...", FileList.size());
     while (entry->isValid() && it != FileList.end()) {
@@ -470,10 +673,23 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
         // no file name for the current entry in the zip was registered.
         if (jt != FileList.end()) {
             try {
-                Base::Reader reader(zipstream, jt->FileName, FileVersion);
-                jt->Object->RestoreDocFile(reader);
-                if (reader.getLocalReader()) {
-                    reader.getLocalReader()->readFiles(zipstream);
+                // an object accepting the file reads it when it needs the data
+                bool deferred = archive
+                    && jt->Object->deferRestoreDocFile(
+                        DeferredDocFile::create(archive, jt->FileName, FileVersion));
+                if (!deferred) {
+                    std::unique_ptr<MappedEntry> mapped;
+                    if (!MappedArchive.empty() && entry->getMethod() == zipios::STORED) {
+                        mapped = MappedEntry::map(MappedArchive,
+                                                  zipstream.getDataOffset(),
+                                                  entry->getSize());
+                    }
+                    std::istream& data = mapped ? *mapped : static_cast<std::istream&>(zipstream);
+                    Base::Reader reader(data, jt->FileName, FileVersion);
+                    jt->Object->RestoreDocFile(reader);
+                    if (reader.getLocalReader()) {
+                        reader.getLocalReader()->readFiles(zipstream);
+                    }
                 }
             }
             catch (...) {
@@ -503,6 +719,65 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
     }
 }
 
+void Base::XMLReader::readFiles(const PrefetchedArchive& archive) const
+{
+    std::size_t index = 0;
+    readFiles(archive, index);
+}
+
+void Base::XMLReader::readFiles(const PrefetchedArchive& archive, std::size_t& index) const
+{
+    // The same matching of the entries with the registered files as in
+    // readFiles(zipios::ZipInputStream&), only the data is taken from memory.
+    // Like the zip stream, index is shared with the readers of nested files.
+    std::shared_ptr<DeferredDocFile::Archive> deferredArchive;
+    if (!DeferredArchive.empty()) {
+        deferredArchive = DeferredDocFile::openArchive(DeferredArchive);
+    }
+    std::vector<FileEntry>::const_iterator it = FileList.begin();
+    Base::SequencerLauncher seq("Importing project files...", FileList.size());
+    while (index < archive.countFiles() && it != FileList.end()) {
+        std::size_t current = index++;
+        const std::string& name = archive.getFileName(current);
+        std::vector<FileEntry>::const_iterator jt = it;
+        while (jt != FileList.end() && name != jt->FileName) {
+            ++jt;
+        }
+        if (jt != FileList.end()) {
+            try {
+                bool deferred = deferredArchive
+                    && jt->Object->deferRestoreDocFile(
+                        DeferredDocFile::create(deferredArchive, jt->FileName, FileVersion));
+                if (!deferred) {
+                    auto stream = archive.openFile(current);
+                    Base::Reader reader(*stream, jt->FileName, FileVersion);
+                    jt->Object->RestoreDocFile(reader);
+                    if (reader.getLocalReader()) {
+                        reader.getLocalReader()->readFiles(archive, index);
+                    }
+                }
+            }
+            catch (...) {
+                Base::Console().error("Reading failed from embedded file: %s\n", name.c_str());
+                FailedFiles.push_back(jt->FileName);
+            }
+            it = jt + 1;
+        }
+
+        seq.next();
+    }
+}
+
+void Base::XMLReader::setDeferredArchive(const std::string& archive)
+{
+    DeferredArchive = archive;
+}
+
+void Base::XMLReader::setMappedArchive(const std::string& archive)
+{
+    MappedArchive = archive;
+}
+
 const char* Base::XMLReader::addFile(const char* Name, Base::Persistence* Object)
 {
     FileEntry temp;
@@ -608,6 +883,7 @@ void Base::XMLReader::endCDATA()
 void Base::XMLReader::characters(const XMLCh* const chars, const XMLSize_t length)
 {
     Characters = StrX(chars).c_str();
+    CharacterData = Characters;
     ReadType = Chars;
     CharacterCount += length;
 }
@@ -729,3 +1005,370 @@ std::shared_ptr<Base::XMLReader> Base::Reader::getLocalReader() const
 {
     return (this->localreader);
 }
+
+// ---------------------------------------------------------------------------
+//  Base::DeferredDocFile
+// ---------------------------------------------------------------------------
+
+struct Base::DeferredDocFile::Archive
+{
+    std::filesystem::path path;
+    std::unique_ptr<zipios::ZipFile> zip;
+    std::uintmax_t size {0};
+    std::filesystem::file_time_type time;
+    std::mutex mutex;
+
+    bool isUnchanged() const
+    {
+        std::error_code ec;
+        auto curSize = std::filesystem::file_size(path, ec);
+        if (ec || curSize != size) {
+            return false;
+        }
+        auto curTime = std::filesystem::last_write_time(path, ec);
+        return !ec && curTime == time;
+    }
+};
+
+namespace
+{
+std::filesystem::path canonicalArchivePath(const std::string& path)
+{
+    std::error_code ec;
+    auto fspath = Base::FileInfo::stringToPath(path);
+    auto canonical = std::filesystem::weakly_canonical(fspath, ec);
+    return ec ? fspath : canonical;
+}
+
+// files are held weakly so that restoreAll() never uses one being destroyed
+struct DeferredRegistry
+{
+    struct Entry
+    {
+        const Base::DeferredDocFile* file;
+        std::weak_ptr<Base::DeferredDocFile> ref;
+    };
+    std::mutex mutex;
+    std::multimap<std::filesystem::path, Entry> files;
+};
+
+DeferredRegistry& deferredRegistry()
+{
+    static DeferredRegistry registry;
+    return registry;
+}
+}  // namespace
+
+std::shared_ptr<Base::DeferredDocFile::Archive>
+Base::DeferredDocFile::openArchive(const std::string& path)
+{
+    auto archive = std::make_shared<Archive>();
+    archive->path = canonicalArchivePath(path);
+    std::error_code ec;
+    archive->size = std::filesystem::file_size(archive->path, ec);
+    if (!ec) {
+        archive->time = std::filesystem::last_write_time(archive->path, ec);
+    }
+    if (ec) {
+        return {};
+    }
+    try {
+        archive->zip = std::make_unique<zipios::ZipFile>(FileInfo::pathToString(archive->path));
+    }
+    catch (const std::exception&) {
+        return {};
+    }
+    if (!archive->zip->isValid()) {
+        return {};
+    }
+    return archive;
+}
+
+Base::DeferredDocFile::DeferredDocFile(std::shared_ptr<Archive> archive,
+                                       std::string fileName,
+                                       int fileVersion)
+    : archive(std::move(archive))
+    , fileName(std::move(fileName))
+    , fileVersion(fileVersion)
+{}
+
+std::shared_ptr<Base::DeferredDocFile>
+Base::DeferredDocFile::create(std::shared_ptr<Archive> archive,
+                              std::string fileName,
+                              int fileVersion)
+{
+    std::shared_ptr<DeferredDocFile> file(
+        new DeferredDocFile(std::move(archive), std::move(fileName), fileVersion));
+    auto& registry = deferredRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.files.emplace(file->archive->path, DeferredRegistry::Entry {file.get(), file});
+    return file;
+}
+
+Base::DeferredDocFile::~DeferredDocFile()
+{
+    unregister();
+}
+
+void Base::DeferredDocFile::unregister()
+{
+    if (!archive) {
+        return;
+    }
+    auto& registry = deferredRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto range = registry.files.equal_range(archive->path);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.file == this) {
+            registry.files.erase(it);
+            break;
+        }
+    }
+}
+
+std::size_t Base::DeferredDocFile::getSize() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    if (!pending || !archive) {
+        return 0;
+    }
+    if (size == 0) {
+        std::lock_guard<std::mutex> zipLock(archive->mutex);
+        auto entry = archive->zip->getEntry(fileName);
+        if (entry) {
+            size = entry->getSize();
+        }
+    }
+    return size;
+}
+
+void Base::DeferredDocFile::setRestorer(Restorer func)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    restorer = std::move(func);
+}
+
+bool Base::DeferredDocFile::restore()
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    // also returns when the restorer itself asks for the data
+    if (!pending || restoring) {
+        return true;
+    }
+    if (failed) {
+        return false;
+    }
+    restoring = true;
+
+    auto zipArchive = archive;
+    bool ok = false;
+    try {
+        std::unique_ptr<std::istream> stream;
+        zipios::ConstEntryPointer entry;
+        {
+            std::lock_guard<std::mutex> zipLock(zipArchive->mutex);
+            if (!zipArchive->isUnchanged()) {
+                throw FileException("Project file has changed since it was opened",
+                                    FileInfo::pathToString(zipArchive->path));
+            }
+            entry = zipArchive->zip->getEntry(fileName);
+            stream.reset(zipArchive->zip->getInputStream(fileName));
+        }
+        if (!stream) {
+            throw FileException("Embedded file is missing", fileName);
+        }
+        std::unique_ptr<MappedEntry> mapped;
+        auto zipstream = dynamic_cast<zipios::ZipInputStream*>(stream.get());
+        if (zipstream && entry && entry->getMethod() == zipios::STORED) {
+            mapped = MappedEntry::map(FileInfo::pathToString(zipArchive->path),
+                                      zipstream->getDataOffset(),
+                                      entry->getSize());
+        }
+        Base::Reader reader(mapped ? *mapped : *stream, fileName, fileVersion);
+        if (restorer) {
+            restorer(reader);
+        }
+        ok = true;
+    }
+    catch (const Base::Exception& e) {
+        Base::Console().error("Reading failed from embedded file %s: %s\n",
+                              fileName.c_str(),
+                              e.what());
+    }
+    catch (const std::exception& e) {
+        Base::Console().error("Reading failed from embedded file %s: %s\n",
+                              fileName.c_str(),
+                              e.what());
+    }
+    catch (...) {
+        Base::Console().error("Reading failed from embedded file: %s\n", fileName.c_str());
+    }
+
+    restoring = false;
+    if (!ok) {
+        // keep the file registered so that its archive isn't overwritten
+        failed = true;
+        return false;
+    }
+
+    // other threads only see the file as restored once the restorer is done,
+    // the archive is released once all of its files have been read
+    unregister();
+    archive.reset();
+    pending = false;
+    return true;
+}
+
+void Base::DeferredDocFile::discard()
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    if (pending && !restoring) {
+        unregister();
+        archive.reset();
+        pending = false;
+    }
+}
+
+bool Base::DeferredDocFile::restoreAll(const std::string& path)
+{
+    std::vector<std::shared_ptr<DeferredDocFile>> files;
+    {
+        auto& registry = deferredRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto range = registry.files.equal_range(canonicalArchivePath(path));
+        for (auto it = range.first; it != range.second; ++it) {
+            if (auto file = it->second.ref.lock()) {
+                files.push_back(std::move(file));
+            }
+        }
+    }
+    bool ok = true;
+    for (const auto& file : files) {
+        ok = file->restore() && ok;
+    }
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+//  Base::PrefetchedArchive
+// ---------------------------------------------------------------------------
+
+namespace
+{
+// read-only stream over a string that outlives it
+class MemoryStream: public std::istream
+{
+public:
+    explicit MemoryStream(const std::string& data)
+        : std::istream(nullptr)
+        , buf(const_cast<char*>(data.data()), data.size())  // NOLINT
+    {
+        rdbuf(&buf);
+    }
+
+private:
+    MemoryStreambuf buf;
+};
+}  // namespace
+
+std::shared_ptr<Base::PrefetchedArchive> Base::PrefetchedArchive::read(const std::string& path,
+                                                                       bool inflateFiles)
+{
+    Base::FileInfo fi(path);
+    Base::ifstream file(fi, std::ios::in | std::ios::binary);
+    if (!file) {
+        throw Base::FileException("Cannot open project file", fi);
+    }
+    std::streambuf* buf = file.rdbuf();
+    std::streamoff size = buf->pubseekoff(0, std::ios::end, std::ios::in);
+    buf->pubseekoff(0, std::ios::beg, std::ios::in);
+    if (size < 22) {  // an empty zip archive has 22 bytes
+        throw Base::FileException("Invalid project file", fi);
+    }
+
+    auto archive = std::make_shared<PrefetchedArchive>();
+    try {
+        zipios::ZipInputStream zipstream(file);
+        archive->document = readStream(zipstream);
+        for (;;) {
+            zipios::ConstEntryPointer entry;
+            try {
+                entry = zipstream.getNextEntry();
+            }
+            catch (const std::exception&) {
+                // there is no further entry
+                break;
+            }
+            if (!entry->isValid()) {
+                break;
+            }
+            Entry file;
+            file.name = entry->getName();
+            // uncompressed files are read in place, skipping them also avoids
+            // inflating files that are going to be restored on demand
+            if (entry->getMethod() == zipios::STORED) {
+                file.stored = true;
+                file.offset = zipstream.getDataOffset();
+                file.size = entry->getSize();
+            }
+            else if (inflateFiles) {
+                file.data = readStream(zipstream);
+                file.loaded = true;
+            }
+            archive->files.push_back(std::move(file));
+        }
+    }
+    catch (const std::exception&) {
+        throw Base::FileException("Error reading compression file", fi);
+    }
+
+    bool loaded = std::all_of(archive->files.begin(), archive->files.end(), [](const Entry& file) {
+        return file.loaded;
+    });
+    if (!loaded) {
+        archive->zip = DeferredDocFile::openArchive(path);
+        if (!archive->zip) {
+            throw Base::FileException("Error reading compression file", fi);
+        }
+    }
+    return archive;
+}
+
+std::unique_ptr<std::istream> Base::PrefetchedArchive::openDocument() const
+{
+    return std::make_unique<MemoryStream>(document);
+}
+
+std::unique_ptr<std::istream> Base::PrefetchedArchive::openFile(std::size_t index) const
+{
+    const Entry& file = files[index];
+    if (file.loaded) {
+        return std::make_unique<MemoryStream>(file.data);
+    }
+
+    std::lock_guard<std::mutex> zipLock(zip->mutex);
+    if (!zip->isUnchanged()) {
+        throw FileException("Project file has changed since it was opened",
+                            FileInfo::pathToString(zip->path));
+    }
+    if (file.stored) {
+        auto mapped = MappedEntry::map(FileInfo::pathToString(zip->path), file.offset, file.size);
+        if (mapped) {
+            return mapped;
+        }
+    }
+    std::unique_ptr<std::istream> stream(zip->zip->getInputStream(file.name));
+    if (!stream) {
+        throw FileException("Embedded file is missing", file.name);
+    }
+    return stream;
+}
+
+std::size_t Base::PrefetchedArchive::getMemSize() const
+{
+    std::size_t size = document.capacity();
+    for (const auto& entry : files) {
+        size += entry.name.capacity() + entry.data.capacity();
+    }
+    return size;
+}
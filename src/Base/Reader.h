@@ -23,10 +23,14 @@
 #ifndef SRC_BASE_READER_H_
 #define SRC_BASE_READER_H_
 
+#include <atomic>
 #include <bitset>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <xercesc/framework/XMLPScanToken.hpp>
@@ -39,6 +43,7 @@
 
 namespace zipios
 {
+class ZipFile;
 class ZipInputStream;
 }
 #ifndef XERCES_CPP_NAMESPACE_BEGIN
@@ -60,6 +65,8 @@ XERCES_CPP_NAMESPACE_END
 namespace Base
 {
 class Persistence;
+class PrefetchedArchive;
+class XMLPullParser;
 
 /** The XML reader class
  * This is an important helper class for the store and retrieval system
@@ -138,8 +145,16 @@ public:
         PartialRestoreInProperty = 2,        // Local to the Property
         PartialRestoreInObject = 3           // Local to the object partially restored itself
     };
+    /// The parser used for reading the stream
+    enum class Backend
+    {
+        /// Xerces SAX parser
+        Xerces,
+        /// Base::XMLPullParser working in place on the whole stream read into memory
+        Pull
+    };
     /// open the file and read the first element
-    XMLReader(const char* FileName, std::istream&);
+    XMLReader(const char* FileName, std::istream&, Backend backend = Backend::Xerces);
     ~XMLReader() override;
 
     /** @name boost iostream device interface */
@@ -285,6 +300,24 @@ public:
     const char* addFile(const char* Name, Base::Persistence* Object);
     /// process the requested file writes
     void readFiles(zipios::ZipInputStream& zipstream) const;
+    /// process the requested file writes from an archive decompressed in advance
+    void readFiles(const PrefetchedArchive& archive) const;
+    /** Offer the registered files to their objects for restoring on demand
+     * \a archive is the path of the project file being read. Objects accepting
+     * a Base::DeferredDocFile in Persistence::deferRestoreDocFile() are then
+     * skipped by readFiles().
+     */
+    void setDeferredArchive(const std::string& archive);
+    /** Read uncompressed files from a memory mapping of \a archive
+     * \a archive is the path of the project file being read. Files stored
+     * uncompressed are then read in place instead of through the zip stream.
+     */
+    void setMappedArchive(const std::string& archive);
+    /** Alignment of files meant to be read from a memory mapping
+     * This is the page size of the system, a file written at such an offset
+     * is mapped without copying any of its data.
+     */
+    static unsigned int getMappingAlignment();
     /// Returns whether reader has any registered filenames
     bool hasFilenames() const;
     /// returns true if reading the file \a filename has failed
@@ -317,6 +350,10 @@ public:
 protected:
     /// read the next element
     bool read();
+    /// read the next element with the pull parser
+    bool readPull();
+    /// return the value of the attribute \a AttrName or null if it is missing
+    const char* findAttribute(const char* AttrName) const;
 
     // -----------------------------------------------------------------------
     //  Handlers for the SAX ContentHandler interface
@@ -359,10 +396,15 @@ protected:
     void resetErrors() override;
     //@}
 
+private:
+    /// read the files from the entry \a index on and leave it at the first unread one
+    void readFiles(const PrefetchedArchive& archive, std::size_t& index) const;
+
 private:
     int Level {0};
     std::string LocalName;
     std::string Characters;
+    std::string_view CharacterData;
     unsigned int CharacterCount {0};
     std::streamsize CharacterOffset {-1};
 
@@ -384,8 +426,9 @@ private:
 
 
     FileInfo _File;
-    XERCES_CPP_NAMESPACE_QUALIFIER SAX2XMLReader* parser;
+    XERCES_CPP_NAMESPACE_QUALIFIER SAX2XMLReader* parser {nullptr};
     XERCES_CPP_NAMESPACE_QUALIFIER XMLPScanToken token;
+    std::unique_ptr<XMLPullParser> pullParser;
     bool _valid {false};
     bool _verbose {true};
 
@@ -399,6 +442,8 @@ public:
 
 private:
     mutable std::vector<std::string> FailedFiles;
+    std::string DeferredArchive;
+    std::string MappedArchive;
 
     std::bitset<32> StatusBits;
 
@@ -422,6 +467,142 @@ private:
     std::shared_ptr<Base::XMLReader> localreader;
 };
 
+/** A data file of a project archive whose restore has been postponed
+ *
+ * An object that accepts the file in Persistence::deferRestoreDocFile() keeps
+ * this reference to the entry in the archive instead of being passed the data
+ * while the document is loaded, and calls restore() when it first needs it.
+ * The archive must not change in the meantime, which is checked by its size
+ * and modification time. Call restoreAll() before overwriting an archive.
+ * A file that cannot be read stays pending so that the archive it refers to
+ * isn't overwritten with the missing data.
+ */
+class BaseExport DeferredDocFile
+{
+public:
+    using Restorer = std::function<void(Base::Reader&)>;
+    struct Archive;
+
+    /// Create a reference to the file \a fileName of \a archive
+    static std::shared_ptr<DeferredDocFile>
+    create(std::shared_ptr<Archive> archive, std::string fileName, int fileVersion);
+    ~DeferredDocFile();
+
+    DeferredDocFile(const DeferredDocFile&) = delete;
+    DeferredDocFile(DeferredDocFile&&) = delete;
+    DeferredDocFile& operator=(const DeferredDocFile&) = delete;
+    DeferredDocFile& operator=(DeferredDocFile&&) = delete;
+
+    /// Open the project file \a path, returns null on failure
+    static std::shared_ptr<Archive> openArchive(const std::string& path);
+
+    const std::string& getFileName() const
+    {
+        return fileName;
+    }
+    /// Returns true as long as the file has been neither restored nor discarded
+    bool isPending() const
+    {
+        return pending;
+    }
+    /// Returns true if reading the file has failed, the file then stays pending
+    bool hasFailed() const
+    {
+        return failed;
+    }
+    /// Uncompressed size of the pending file, or 0 if it isn't pending
+    std::size_t getSize() const;
+    /// Set the function reading the file
+    void setRestorer(Restorer func);
+    /** Read the file if it is still pending
+     * Errors are reported to the console like for a file read while loading
+     * the document. Returns false if reading has failed, in which case the
+     * file isn't read again.
+     */
+    bool restore();
+    /// Drop the reference without reading the file
+    void discard();
+
+    /** Restore all pending files of the project file \a path
+     * Returns false if any of them couldn't be read.
+     */
+    static bool restoreAll(const std::string& path);
+
+private:
+    DeferredDocFile(std::shared_ptr<Archive> archive, std::string fileName, int fileVersion);
+    void unregister();
+
+private:
+    std::shared_ptr<Archive> archive;
+    std::string fileName;
+    int fileVersion;
+    Restorer restorer;
+    mutable std::recursive_mutex mutex;
+    mutable std::size_t size {0};
+    std::atomic<bool> pending {true};
+    std::atomic<bool> failed {false};
+    bool restoring {false};
+};
+
+/** A project archive decompressed into memory
+ *
+ * read() loads the project file and inflates its entries. It touches neither
+ * documents nor objects and can therefore run in a worker thread, e.g. to
+ * prepare several project files while another one is being restored. The
+ * document XML is then parsed from openDocument() and the data files are
+ * passed to their objects with XMLReader::readFiles(const PrefetchedArchive&).
+ *
+ * Files stored uncompressed aren't copied, they are read from a memory mapping
+ * of the project file like with XMLReader::setMappedArchive(). Files not held
+ * in memory are read from the project file when opened, which fails if the
+ * file has changed since read().
+ */
+class BaseExport PrefetchedArchive
+{
+public:
+    /** Read and decompress the project file \a path
+     * With \a inflateFiles false only Document.xml is decompressed, e.g. because
+     * the data files are mostly restored on demand with Base::DeferredDocFile.
+     * Throws Base::FileException on failure.
+     */
+    static std::shared_ptr<PrefetchedArchive> read(const std::string& path,
+                                                   bool inflateFiles = true);
+
+    /// Returns a stream of the first entry, i.e. Document.xml
+    std::unique_ptr<std::istream> openDocument() const;
+    /// Number of data files, i.e. the entries following Document.xml
+    std::size_t countFiles() const
+    {
+        return files.size();
+    }
+    /// Returns the name of the data file \a index
+    const std::string& getFileName(std::size_t index) const
+    {
+        return files[index].name;
+    }
+    /// Returns a stream of the data file \a index, throws Base::FileException on failure
+    std::unique_ptr<std::istream> openFile(std::size_t index) const;
+    /// Returns the number of bytes of the decompressed entries
+    std::size_t getMemSize() const;
+
+private:
+    struct Entry
+    {
+        std::string name;
+        std::string data;
+        /// false if the file is read from the project file when opened
+        bool loaded {false};
+        /// the file is stored uncompressed at offset
+        bool stored {false};
+        std::streamoff offset {0};
+        std::streamsize size {0};
+    };
+    std::string document;
+    std::vector<Entry> files;
+    /// the project file, if any of the files isn't loaded
+    std::shared_ptr<DeferredDocFile::Archive> zip;
+};
+
 }  // namespace Base
 
 
@@ -0,0 +1,169 @@
+/**************************************************************************
+ *                                                                         *
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#endif
+
+#include "ThreadPool.h"
+
+using namespace Base;
+
+ThreadPool::ThreadPool(unsigned int threads)
+{
+    if (threads == 0) {
+        threads = idealThreadCount();
+    }
+    workers.reserve(threads);
+    for (unsigned int i = 0; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::run, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+unsigned int ThreadPool::idealThreadCount()
+{
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+void ThreadPool::start(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::waitForDone()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    allDone.wait(lock, [this] {
+        return tasks.empty() && running == 0;
+    });
+}
+
+void ThreadPool::run()
+{
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this] {
+                return stopping || !tasks.empty();
+            });
+            // drain the queue before honouring a stop request
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            ++running;
+        }
+
+        try {
+            task();
+        }
+        catch (...) {
+            // tasks are responsible for reporting their own errors
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --running;
+            if (tasks.empty() && running == 0) {
+                allDone.notify_all();
+            }
+        }
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count,
+                             const std::function<void(std::size_t)>& func,
+                             unsigned int threads,
+                             std::size_t grain)
+{
+    if (threads == 0) {
+        threads = idealThreadCount();
+    }
+    grain = std::max<std::size_t>(grain, 1);
+    std::size_t chunks = (count + grain - 1) / grain;
+    if (threads <= 1 || chunks <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next {0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+        try {
+            for (;;) {
+                std::size_t begin = next.fetch_add(grain);
+                if (begin >= count) {
+                    return;
+                }
+                std::size_t end = std::min(count, begin + grain);
+                for (std::size_t i = begin; i < end; ++i) {
+                    func(i);
+                }
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            // make the other workers stop early
+            next = count;
+        }
+    };
+
+    // the calling thread is one of the workers
+    auto helpers = static_cast<unsigned int>(std::min<std::size_t>(threads, chunks)) - 1;
+    ThreadPool pool(helpers);
+    for (unsigned int i = 0; i < helpers; ++i) {
+        pool.start(worker);
+    }
+    worker();
+    pool.waitForDone();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,103 @@
+/**************************************************************************
+ *                                                                         *
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef BASE_THREADPOOL_H
+#define BASE_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifndef FC_GLOBAL_H
+#include <FCGlobal.h>
+#endif
+
+namespace Base
+{
+
+/** A small fixed size pool of worker threads
+ *
+ * Unlike QThreadPool::globalInstance() the pool is owned by the caller, so
+ * that a long running batch (e.g. a document recompute) cannot starve, or be
+ * starved by, unrelated users of the global pool.
+ *
+ * Tasks are taken from a shared FIFO queue by whichever worker becomes idle
+ * first. Exceptions escaping from a task are swallowed, so tasks are expected
+ * to report their own errors.
+ */
+class BaseExport ThreadPool
+{
+public:
+    /// Create a pool with \a threads workers, 0 means idealThreadCount()
+    explicit ThreadPool(unsigned int threads = 0);
+    /// Waits for all queued tasks to finish and joins the workers
+    ~ThreadPool();
+
+    /// Queue a task for execution on one of the workers
+    void start(std::function<void()> task);
+    /// Block until the queue is empty and no task is running
+    void waitForDone();
+    /// Number of worker threads of this pool
+    unsigned int threadCount() const
+    {
+        return static_cast<unsigned int>(workers.size());
+    }
+
+    /// The number of hardware threads, at least 1
+    static unsigned int idealThreadCount();
+
+    /** Run \a func(i) for every i in [0, count) on a temporary pool
+     *
+     * The indices are handed out in chunks of \a grain. The calling thread
+     * takes part in the work, so with \a threads == 1 or a small \a count
+     * everything runs inline. The first exception thrown by \a func stops
+     * the loop and is rethrown in the calling thread.
+     */
+    static void parallelFor(std::size_t count,
+                            const std::function<void(std::size_t)>& func,
+                            unsigned int threads = 0,
+                            std::size_t grain = 1);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+private:
+    void run();
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable allDone;
+    std::size_t running {0};
+    bool stopping {false};
+};
+
+}  // namespace Base
+
+#endif  // BASE_THREADPOOL_H
@@ -23,10 +23,14 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 #include <string>
+#include <zlib.h>
 #endif
 
 #include <limits>
@@ -40,6 +44,7 @@
 #include "FileInfo.h"
 #include "Persistence.h"
 #include "Stream.h"
+#include "ThreadPool.h"
 #include "Tools.h"
 
 #include <boost/iostreams/filtering_stream.hpp>
@@ -267,7 +272,7 @@ std::vector<std::string> Writer::getErrors() const
     return Errors;
 }
 
-std::string Writer::addFile(const char* Name, const Base::Persistence* Object)
+std::string Writer::addFile(const char* Name, const Base::Persistence* Object, bool binary)
 {
     // always check isForceXML() before requesting a file!
     assert(!isForceXML());
@@ -278,6 +283,7 @@ std::string Writer::addFile(const char* Name, const Base::Persistence* Object)
         temp.FileName = FileNameManager.makeUniqueName(temp.FileName);
     }
     temp.Object = Object;
+    temp.Binary = binary;
 
     FileList.push_back(temp);
     FileNameManager.addExactName(temp.FileName);
@@ -316,6 +322,82 @@ void Writer::putNextEntry(const char* file, const char* obj)
 
 // ----------------------------------------------------------------------------
 
+namespace
+{
+// in-memory stream for an entry, formatted like the zip stream
+std::unique_ptr<std::ostringstream> makeEntryBuffer(const std::ostream& format)
+{
+    auto buffer = std::make_unique<std::ostringstream>();
+    buffer->imbue(format.getloc());
+    buffer->precision(format.precision());
+    buffer->flags(format.flags());
+    return buffer;
+}
+}  // namespace
+
+struct ZipWriter::ParallelState
+{
+    struct Entry
+    {
+        std::string name;
+        std::string data;
+        std::string compressed;
+        uLong crc {0};
+        std::size_t size {0};
+        bool stored {false};
+        bool done {false};
+        bool failed {false};
+    };
+
+    explicit ParallelState(unsigned int threads)
+        : pool(threads)
+    {}
+
+    static void compress(Entry& entry, int level)
+    {
+        entry.size = entry.data.size();
+        entry.crc = crc32(0L, Z_NULL, 0);
+        entry.crc = crc32(entry.crc,
+                          reinterpret_cast<const Bytef*>(entry.data.data()),
+                          static_cast<uInt>(entry.size));
+        if (entry.stored) {
+            entry.compressed.swap(entry.data);
+            return;
+        }
+
+        // raw deflate stream, with the same parameters as zipios uses
+        z_stream zs {};
+        const int memLevel = 8;
+        if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, memLevel, Z_DEFAULT_STRATEGY)
+            != Z_OK) {
+            entry.failed = true;
+            return;
+        }
+        entry.compressed.resize(deflateBound(&zs, static_cast<uLong>(entry.size)));
+        zs.next_in = reinterpret_cast<Bytef*>(entry.data.data());
+        zs.avail_in = static_cast<uInt>(entry.size);
+        zs.next_out = reinterpret_cast<Bytef*>(entry.compressed.data());
+        zs.avail_out = static_cast<uInt>(entry.compressed.size());
+        entry.failed = deflate(&zs, Z_FINISH) != Z_STREAM_END;
+        entry.compressed.resize(zs.total_out);
+        deflateEnd(&zs);
+        std::string().swap(entry.data);
+    }
+
+    // NOLINTBEGIN
+    std::unique_ptr<std::ostringstream> buffer;
+    std::string bufferName;
+    bool bufferStored {false};
+    std::deque<std::shared_ptr<Entry>> pending;
+    std::size_t pendingBytes {0};
+    std::size_t maxPendingBytes {0};
+    std::mutex mutex;
+    std::condition_variable entryDone;
+    // destroyed first, so that running tasks can still access the members above
+    ThreadPool pool;
+    // NOLINTEND
+};
+
 ZipWriter::ZipWriter(const char* FileName)
     : ZipStream(FileName)
 {
@@ -340,15 +422,141 @@ ZipWriter::ZipWriter(std::ostream& os)
     ZipStream.setf(std::ios::fixed, std::ios::floatfield);
 }
 
+std::ostream& ZipWriter::Stream()
+{
+    if (parallel && parallel->buffer) {
+        return *parallel->buffer;
+    }
+    if (storedBuffer) {
+        return *storedBuffer;
+    }
+    return ZipStream;
+}
+
+void ZipWriter::setThreadCount(unsigned int threads)
+{
+    if (threads == 0) {
+        threads = ThreadPool::idealThreadCount();
+    }
+    if (threads <= 1) {
+        parallel.reset();
+        return;
+    }
+    parallel = std::make_unique<ParallelState>(threads);
+    // bound the memory held by entries waiting for compression or writing
+    const std::size_t bytesPerThread = 32 * 1024 * 1024;
+    parallel->maxPendingBytes = threads * bytesPerThread;
+}
+
 void ZipWriter::putNextEntry(const char* file, const char* obj)
+{
+    putEntry(file, obj, false);
+}
+
+void ZipWriter::putEntry(const char* file, const char* obj, bool stored)
 {
     Writer::putNextEntry(file, obj);
 
+    if (parallel) {
+        flushEntry();
+        parallel->buffer = makeEntryBuffer(ZipStream);
+        parallel->bufferName = file;
+        parallel->bufferStored = stored;
+        return;
+    }
+
+    flushStoredEntry();
+    if (stored) {
+        // the size and checksum go into the local header in front of the data
+        storedBuffer = makeEntryBuffer(ZipStream);
+        storedName = file;
+        return;
+    }
+
     ZipStream.putNextEntry(file);
 
     Writer::checkErrNo();
 }
 
+void ZipWriter::flushStoredEntry()
+{
+    if (!storedBuffer) {
+        return;
+    }
+    std::string_view data = storedBuffer->view();
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, reinterpret_cast<const Bytef*>(data.data()), static_cast<uInt>(data.size()));
+    ZipStream.putRawEntry(storedName,
+                          data.data(),
+                          static_cast<zipios::uint32>(data.size()),
+                          static_cast<zipios::uint32>(crc),
+                          static_cast<zipios::uint32>(data.size()),
+                          zipios::STORED,
+                          static_cast<int>(storageAlignment));
+    storedBuffer.reset();
+    Writer::checkErrNo();
+}
+
+void ZipWriter::flushEntry()
+{
+    if (!parallel->buffer) {
+        return;
+    }
+    auto entry = std::make_shared<ParallelState::Entry>();
+    entry->name = parallel->bufferName;
+    entry->stored = parallel->bufferStored;
+    // take the buffer over instead of copying it
+    entry->data = std::move(*parallel->buffer).str();
+    parallel->buffer.reset();
+    parallel->pendingBytes += entry->data.size();
+    parallel->pending.push_back(entry);
+
+    int level = compressionLevel;
+    auto state = parallel.get();
+    state->pool.start([state, entry, level]() {
+        ParallelState::compress(*entry, level);
+        std::lock_guard<std::mutex> lock(state->mutex);
+        entry->done = true;
+        state->entryDone.notify_all();
+    });
+
+    writeCompressed(false);
+}
+
+void ZipWriter::writeCompressed(bool all)
+{
+    // Write out finished entries in order, and block on the oldest one
+    // if asked for all of them or while too much data is waiting.
+    while (!parallel->pending.empty()) {
+        auto entry = parallel->pending.front();
+        {
+            std::unique_lock<std::mutex> lock(parallel->mutex);
+            if (!entry->done) {
+                if (!all && parallel->pendingBytes <= parallel->maxPendingBytes) {
+                    return;
+                }
+                parallel->entryDone.wait(lock, [&entry]() {
+                    return entry->done;
+                });
+            }
+        }
+        parallel->pending.pop_front();
+        parallel->pendingBytes -= entry->size;
+        if (entry->failed) {
+            addError(entry->name + ": compression failed");
+            continue;
+        }
+        ZipStream.putRawEntry(entry->name,
+                              entry->compressed.data(),
+                              static_cast<zipios::uint32>(entry->compressed.size()),
+                              static_cast<zipios::uint32>(entry->crc),
+                              static_cast<zipios::uint32>(entry->size),
+                              entry->stored ? zipios::STORED : zipios::DEFLATED,
+                              entry->stored ? static_cast<int>(storageAlignment) : 0);
+        Writer::checkErrNo();
+    }
+}
+
 void ZipWriter::writeFiles()
 {
     // use a while loop because it is possible that while
@@ -356,16 +564,35 @@ void ZipWriter::writeFiles()
     size_t index = 0;
     while (index < FileList.size()) {
         FileEntry entry = FileList[index];
-        putNextEntry(entry.FileName.c_str());
+        putEntry(entry.FileName.c_str(), nullptr, entry.Binary && storageAlignment > 0);
         indent = 0;
         indBuf[0] = 0;
         entry.Object->SaveDocFile(*this);
         index++;
     }
+
+    if (parallel) {
+        flushEntry();
+        writeCompressed(true);
+    }
+    else {
+        flushStoredEntry();
+    }
 }
 
 ZipWriter::~ZipWriter()
 {
+    try {
+        if (parallel) {
+            flushEntry();
+            writeCompressed(true);
+        }
+        else {
+            flushStoredEntry();
+        }
+    }
+    catch (...) {
+    }
     ZipStream.close();
 }
 
@@ -93,8 +93,11 @@ public:
 
     /** @name additional file writing */
     //@{
-    /// add a write request of a persistent object
-    std::string addFile(const char* Name, const Base::Persistence* Object);
+    /** Add a write request of a persistent object
+     * Set \a binary for a file of raw binary data, which a ZipWriter with a
+     * storage alignment keeps uncompressed so that it can be read in place.
+     */
+    std::string addFile(const char* Name, const Base::Persistence* Object, bool binary = false);
     /// process the requested file storing
     virtual void writeFiles() = 0;
     /// Set mode
@@ -167,6 +170,7 @@ protected:
     {
         std::string FileName;
         const Base::Persistence* Object;
+        bool Binary {false};
     };
     std::vector<FileEntry> FileList;
     UniqueFileNameManager FileNameManager;
@@ -207,10 +211,7 @@ public:
 
     void writeFiles() override;
 
-    std::ostream& Stream() override
-    {
-        return ZipStream;
-    }
+    std::ostream& Stream() override;
 
     void setComment(const char* str)
     {
@@ -218,8 +219,27 @@ public:
     }
     void setLevel(int level)
     {
+        compressionLevel = level;
         ZipStream.setLevel(level);
     }
+    /** Compress the entries on \a threads worker threads
+     *
+     * Entries are still serialized in the calling thread, but into memory.
+     * Each finished entry is deflated by a worker while the next one is being
+     * serialized, and written to the archive in its original order. Must be
+     * called before the first entry is put. 0 means one thread per core, 1
+     * (the default) compresses directly into the archive.
+     */
+    void setThreadCount(unsigned int threads);
+    /** Store binary files uncompressed with their data aligned to \a alignment bytes
+     *
+     * This makes it possible to read them from a memory mapping of the
+     * archive instead of inflating them. 0 (the default) compresses all files.
+     */
+    void setStorageAlignment(unsigned int alignment)
+    {
+        storageAlignment = alignment;
+    }
     void putNextEntry(const char* filename, const char* objName = nullptr) override;
 
     ZipWriter(const ZipWriter&) = delete;
@@ -227,8 +247,20 @@ public:
     ZipWriter& operator=(const ZipWriter&) = delete;
     ZipWriter& operator=(ZipWriter&&) = delete;
 
+private:
+    void putEntry(const char* filename, const char* objName, bool stored);
+    void flushEntry();
+    void flushStoredEntry();
+    void writeCompressed(bool all);
+
 private:
     zipios::ZipOutputStream ZipStream;
+    int compressionLevel {Z_DEFAULT_COMPRESSION};
+    unsigned int storageAlignment {0};
+    std::unique_ptr<std::ostringstream> storedBuffer;
+    std::string storedName;
+    struct ParallelState;
+    std::unique_ptr<ParallelState> parallel;
 };
 
 /** The StringWriter class
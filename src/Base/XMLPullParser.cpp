@@ -0,0 +1,458 @@
+/**************************************************************************
+ *                                                                         *
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#endif
+
+#include "XMLPullParser.h"
+#include "Exception.h"
+
+using namespace Base;
+
+namespace
+{
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool isNameEnd(char c)
+{
+    switch (c) {
+        case '\0':
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+        case '/':
+        case '>':
+        case '<':
+        case '=':
+        case '"':
+        case '\'':
+        case '&':
+            return true;
+        default:
+            return false;
+    }
+}
+
+char* encodeUtf8(unsigned long code, char* out)
+{
+    if (code < 0x80) {
+        *out++ = static_cast<char>(code);
+    }
+    else if (code < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (code >> 6));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (code >> 12));
+        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else {
+        *out++ = static_cast<char>(0xF0 | (code >> 18));
+        *out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    }
+    return out;
+}
+}  // namespace
+
+XMLPullParser::XMLPullParser(std::string buf)
+    : buffer(std::move(buf))
+{
+    std::string_view text(buffer);
+    if (text.starts_with("\xEF\xBB\xBF")) {
+        pos = 3;
+    }
+    else if (text.starts_with("\xFE\xFF") || text.starts_with("\xFF\xFE")) {
+        error("UTF-16 encoded documents are not supported");
+    }
+
+    // the declaration is only checked for the encoding
+    if (text.substr(pos).starts_with("<?xml") && isSpace(buffer[pos + 5])) {
+        auto end = text.find("?>", pos);
+        if (end == std::string_view::npos) {
+            error("Unterminated XML declaration");
+        }
+        auto decl = text.substr(pos, end - pos);
+        auto enc = decl.find("encoding");
+        auto quote = decl.find_first_of("\"'", enc);
+        if (enc != std::string_view::npos && quote != std::string_view::npos) {
+            auto close = decl.find(decl[quote], quote + 1);
+            std::string name(decl.substr(quote + 1, close - quote - 1));
+            std::transform(name.begin(), name.end(), name.begin(), [](char c) {
+                return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            });
+            if (name != "utf-8" && name != "utf8" && name != "us-ascii" && name != "ascii") {
+                error("Unsupported encoding " + name);
+            }
+        }
+        pos = end + 2;
+    }
+}
+
+const char* XMLPullParser::attribute(std::string_view name) const
+{
+    for (const auto& attr : attrs) {
+        if (attr.name == name) {
+            return attr.value.data();
+        }
+    }
+    return nullptr;
+}
+
+XMLPullParser::Event XMLPullParser::next()
+{
+    if (current == Event::EndDocument) {
+        return current;
+    }
+
+    char* data = buffer.data();
+    const std::size_t size = buffer.size();
+    for (;;) {
+        if (pos >= size) {
+            if (!openElements.empty()) {
+                error("Unexpected end of document, missing </" + std::string(openElements.back())
+                      + ">");
+            }
+            if (!rootSeen) {
+                error("No root element");
+            }
+            return current = Event::EndDocument;
+        }
+
+        if (data[pos] != '<') {
+            char* begin = data + pos;
+            auto* lt = static_cast<char*>(std::memchr(begin, '<', size - pos));
+            char* end = lt ? lt : data + size;
+            if (openElements.empty()) {
+                if (!std::all_of(begin, end, isSpace)) {
+                    error("Text outside of the root element");
+                }
+                pos = end - data;
+                continue;
+            }
+            content = std::string_view(begin, decode(begin, end, Content::Text) - begin);
+            pos = end - data;
+            return current = Event::Characters;
+        }
+
+        const char c = data[pos + 1];
+        if (c == '/') {
+            readEndElement();
+            return current = Event::EndElement;
+        }
+        if (c == '!' || c == '?') {
+            if (skipMarkup()) {
+                return current = Event::CDATA;
+            }
+            continue;
+        }
+        readStartElement();
+        return current = Event::StartElement;
+    }
+}
+
+void XMLPullParser::readStartElement()
+{
+    if (rootSeen && openElements.empty()) {
+        error("Extra content after the root element");
+    }
+
+    char* data = buffer.data();
+    ++pos;
+    char* nameBegin = data + pos;
+    char* nameEnd = scanName();
+    if (nameEnd == nameBegin) {
+        error("Invalid element name");
+    }
+
+    attrs.clear();
+    emptyElement = false;
+    for (;;) {
+        const std::size_t before = pos;
+        skipSpaces();
+        if (pos >= buffer.size()) {
+            error("Unterminated start tag");
+        }
+        if (data[pos] == '>') {
+            ++pos;
+            break;
+        }
+        if (data[pos] == '/') {
+            if (data[pos + 1] != '>') {
+                error("Expected '>' after '/'");
+            }
+            pos += 2;
+            emptyElement = true;
+            break;
+        }
+        if (pos == before) {
+            error("Expected whitespace before attribute");
+        }
+
+        char* attrBegin = data + pos;
+        char* attrEnd = scanName();
+        if (attrEnd == attrBegin) {
+            error("Invalid attribute name");
+        }
+        skipSpaces();
+        if (data[pos] != '=') {
+            error("Expected '=' after attribute name");
+        }
+        ++pos;
+        skipSpaces();
+        const char quote = data[pos];
+        if (quote != '"' && quote != '\'') {
+            error("Expected quoted attribute value");
+        }
+        char* valueBegin = data + ++pos;
+        auto* close = static_cast<char*>(std::memchr(valueBegin, quote, buffer.size() - pos));
+        if (!close) {
+            error("Unterminated attribute value");
+        }
+        char* valueEnd = decode(valueBegin, close, Content::Attribute);
+        pos = close - data + 1;
+
+        // the terminating characters have been consumed, so they can be overwritten
+        *valueEnd = '\0';
+        *attrEnd = '\0';
+        std::string_view name(attrBegin, attrEnd - attrBegin);
+        if (attribute(name)) {
+            error("Duplicate attribute " + std::string(name));
+        }
+        attrs.push_back({name, std::string_view(valueBegin, valueEnd - valueBegin)});
+    }
+
+    *nameEnd = '\0';
+    elementName = std::string_view(nameBegin, nameEnd - nameBegin);
+    rootSeen = true;
+    if (!emptyElement) {
+        openElements.push_back(elementName);
+    }
+}
+
+void XMLPullParser::readEndElement()
+{
+    char* data = buffer.data();
+    pos += 2;
+    char* nameBegin = data + pos;
+    char* nameEnd = scanName();
+    skipSpaces();
+    if (data[pos] != '>') {
+        error("Expected '>' in end tag");
+    }
+    ++pos;
+
+    std::string_view name(nameBegin, nameEnd - nameBegin);
+    if (openElements.empty() || openElements.back() != name) {
+        error("Unexpected end tag </" + std::string(name) + ">");
+    }
+    *nameEnd = '\0';
+    openElements.pop_back();
+    elementName = name;
+    emptyElement = false;
+}
+
+bool XMLPullParser::skipMarkup()
+{
+    std::string_view rest(buffer.data() + pos, buffer.size() - pos);
+    auto skipPast = [&](std::size_t start, std::string_view term, const char* what) {
+        auto end = rest.find(term, start);
+        if (end == std::string_view::npos) {
+            error(std::string("Unterminated ") + what);
+        }
+        pos += end + term.size();
+    };
+
+    if (rest.starts_with("<!--")) {
+        skipPast(4, "-->", "comment");
+        return false;
+    }
+    if (rest.starts_with("<?")) {
+        skipPast(2, "?>", "processing instruction");
+        return false;
+    }
+    if (rest.starts_with("<![CDATA[")) {
+        if (openElements.empty()) {
+            error("CDATA section outside of the root element");
+        }
+        auto end = rest.find("]]>", 9);
+        if (end == std::string_view::npos) {
+            error("Unterminated CDATA section");
+        }
+        char* begin = buffer.data() + pos + 9;
+        content = std::string_view(begin, decode(begin, begin + end - 9, Content::CData) - begin);
+        pos += end + 3;
+        return true;
+    }
+    if (rest.starts_with("<!DOCTYPE") && !rootSeen) {
+        // skip the internal subset as well
+        int brackets = 0;
+        char quote = 0;
+        for (std::size_t i = 9; i < rest.size(); ++i) {
+            const char c = rest[i];
+            if (quote) {
+                if (c == quote) {
+                    quote = 0;
+                }
+            }
+            else if (c == '"' || c == '\'') {
+                quote = c;
+            }
+            else if (c == '[') {
+                ++brackets;
+            }
+            else if (c == ']') {
+                --brackets;
+            }
+            else if (c == '>' && brackets == 0) {
+                pos += i + 1;
+                return false;
+            }
+        }
+        error("Unterminated document type declaration");
+    }
+    error("Invalid markup");
+}
+
+void XMLPullParser::skipSpaces()
+{
+    const char* data = buffer.data();
+    while (isSpace(data[pos])) {
+        ++pos;
+    }
+}
+
+char* XMLPullParser::scanName()
+{
+    char* data = buffer.data();
+    while (!isNameEnd(data[pos])) {
+        ++pos;
+    }
+    return data + pos;
+}
+
+char* XMLPullParser::decode(char* begin, char* end, Content type)
+{
+    auto needsDecoding = [type](char c) {
+        switch (c) {
+            case '\r':
+                return true;
+            case '&':
+                return type != Content::CData;
+            case '\n':
+            case '\t':
+            case '<':
+                return type == Content::Attribute;
+            default:
+                return false;
+        }
+    };
+
+    // most content is copied unchanged, so only start moving at the first special character
+    char* in = std::find_if(begin, end, needsDecoding);
+    char* out = in;
+    while (in != end) {
+        const char c = *in;
+        if (!needsDecoding(c)) {
+            *out++ = *in++;
+        }
+        else if (c == '&') {
+            in = decodeReference(in, end, out);
+        }
+        else if (c == '\r') {
+            // line breaks are normalized, and in attribute values all whitespace becomes a space
+            if (++in != end && *in == '\n') {
+                ++in;
+            }
+            *out++ = type == Content::Attribute ? ' ' : '\n';
+        }
+        else if (c == '<') {
+            error("Invalid character '<' in attribute value");
+        }
+        else {
+            *out++ = ' ';
+            ++in;
+        }
+    }
+    return out;
+}
+
+char* XMLPullParser::decodeReference(char* ref, char* end, char*& out)
+{
+    // the longest valid reference is &#x10FFFF;
+    const std::size_t maxLength = 10;
+    auto* semicolon = static_cast<char*>(
+        std::memchr(ref, ';', std::min(static_cast<std::size_t>(end - ref), maxLength + 1)));
+    if (!semicolon) {
+        error("Invalid reference");
+    }
+
+    std::string_view entity(ref + 1, semicolon - ref - 1);
+    if (entity == "lt") {
+        *out++ = '<';
+    }
+    else if (entity == "gt") {
+        *out++ = '>';
+    }
+    else if (entity == "amp") {
+        *out++ = '&';
+    }
+    else if (entity == "quot") {
+        *out++ = '"';
+    }
+    else if (entity == "apos") {
+        *out++ = '\'';
+    }
+    else if (entity.starts_with('#')) {
+        const bool hex = entity.starts_with("#x");
+        const char* first = entity.data() + (hex ? 2 : 1);
+        unsigned long code = 0;
+        auto [ptr, ec] = std::from_chars(first, semicolon, code, hex ? 16 : 10);
+        if (ec != std::errc() || ptr != semicolon || code == 0 || code > 0x10FFFF
+            || (code >= 0xD800 && code <= 0xDFFF)) {
+            error("Invalid character reference &" + std::string(entity) + ";");
+        }
+        // a reference is always longer than its encoding, so this stays behind the input
+        out = encodeUtf8(code, out);
+    }
+    else {
+        error("Unknown entity &" + std::string(entity) + ";");
+    }
+    return semicolon + 1;
+}
+
+void XMLPullParser::error(const std::string& msg) const
+{
+    const std::size_t end = std::min(pos, buffer.size());
+    const auto line = std::count(buffer.begin(), buffer.begin() + end, '\n') + 1;
+    throw Base::XMLParseException(msg + " at line " + std::to_string(line));
+}
@@ -0,0 +1,140 @@
+/**************************************************************************
+ *                                                                         *
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef BASE_XMLPULLPARSER_H
+#define BASE_XMLPULLPARSER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#ifndef FC_GLOBAL_H
+#include <FCGlobal.h>
+#endif
+
+namespace Base
+{
+
+/** A non-validating XML pull parser working in place on a UTF-8 buffer
+ *
+ * The parser owns the document text and decodes it where it is: element
+ * names, attribute values and character data are handed out as views into
+ * the buffer, with entity and character references already replaced. Names
+ * and attribute values are null terminated. Apart from the attribute list and
+ * the element stack, which keep their capacity, nothing is allocated while
+ * parsing.
+ *
+ * Only what is needed for documents written by FreeCAD is supported: UTF-8 or
+ * ASCII text without a DTD, i.e. the predefined entities and character
+ * references. Comments, processing instructions and a document type
+ * declaration are skipped. Malformed input raises a Base::XMLParseException.
+ */
+class BaseExport XMLPullParser
+{
+public:
+    enum class Event
+    {
+        StartDocument,
+        EndDocument,
+        StartElement,
+        EndElement,
+        Characters,
+        CDATA
+    };
+
+    struct Attribute
+    {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    explicit XMLPullParser(std::string buffer);
+
+    /// Parse up to the next event and return it
+    Event next();
+    /// Return the current event
+    Event event() const
+    {
+        return current;
+    }
+
+    /// Name of the current start or end element
+    std::string_view name() const
+    {
+        return elementName;
+    }
+    /** Return true if the current start element is an empty element tag
+     * No end element event is reported for \<name/\>.
+     */
+    bool isEmptyElement() const
+    {
+        return emptyElement;
+    }
+    /// Attributes of the current start element
+    const std::vector<Attribute>& attributes() const
+    {
+        return attrs;
+    }
+    /// Value of the attribute \a name of the current start element, null if it is missing
+    const char* attribute(std::string_view name) const;
+    /// Content of the current character data or CDATA section
+    std::string_view text() const
+    {
+        return content;
+    }
+    /// Number of currently open elements
+    std::size_t depth() const
+    {
+        return openElements.size();
+    }
+
+private:
+    enum class Content
+    {
+        Text,
+        Attribute,
+        CData
+    };
+    char* decode(char* begin, char* end, Content type);
+    char* decodeReference(char* ref, char* end, char*& out);
+    void readStartElement();
+    void readEndElement();
+    bool skipMarkup();
+    void skipSpaces();
+    char* scanName();
+    [[noreturn]] void error(const std::string& msg) const;
+
+private:
+    std::string buffer;
+    std::size_t pos {0};
+    Event current {Event::StartDocument};
+    std::string_view elementName;
+    std::string_view content;
+    bool emptyElement {false};
+    bool rootSeen {false};
+    std::vector<Attribute> attrs;
+    std::vector<std::string_view> openElements;
+};
+
+}  // namespace Base
+
+#endif  // BASE_XMLPULLPARSER_H
@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <tuple>
 # include <memory>
 # include <list>
@@ -519,6 +520,9 @@ Document::Document(App::Document* pcDocument,Application * app)
         d->_pcDocument->setUndoMode(1);
         // set the maximum stack size
         d->_pcDocument->setMaxUndoStackSize(hGrp->GetInt("MaxUndoSize",20));
+        // the memory limit of the stack in MB, 0 means no limit
+        std::size_t limit = hGrp->GetUnsigned("MaxUndoMemory", 0);
+        d->_pcDocument->setUndoLimit(limit * 1024 * 1024);
     }
 
     d->_changeViewTouchDocument = hGrp->GetBool("ChangeViewProviderTouchDocument", true);
@@ -119,6 +119,7 @@ void PropertyPostDataObject::scaleDataObject(vtkDataObject* dataObject, double s
 
 void PropertyPostDataObject::scale(double s)
 {
+    restoreDeferred();
     if (m_dataObject) {
         aboutToSetValue();
         scaleDataObject(m_dataObject, s);
@@ -128,6 +129,7 @@ void PropertyPostDataObject::scale(double s)
 
 void PropertyPostDataObject::setValue(const vtkSmartPointer<vtkDataObject>& ds)
 {
+    discardDeferred();
     aboutToSetValue();
 
     if (ds) {
@@ -143,24 +145,25 @@ void PropertyPostDataObject::setValue(const vtkSmartPointer<vtkDataObject>& ds)
 
 const vtkSmartPointer<vtkDataObject>& PropertyPostDataObject::getValue() const
 {
+    restoreDeferred();
     return m_dataObject;
 }
 
 bool PropertyPostDataObject::isComposite()
 {
-
+    restoreDeferred();
     return m_dataObject && !m_dataObject->IsA("vtkDataSet");
 }
 
 bool PropertyPostDataObject::isDataSet()
 {
-
+    restoreDeferred();
     return m_dataObject && m_dataObject->IsA("vtkDataSet");
 }
 
 int PropertyPostDataObject::getDataType()
 {
-
+    restoreDeferred();
     if (!m_dataObject) {
         return -1;
     }
@@ -195,6 +198,7 @@ void PropertyPostDataObject::setPyObject(PyObject* value)
         throw Base::TypeError("Can only set vtkDataObject");
     }
     auto dobj = static_cast<vtkDataObject*>(obj);
+    discardDeferred();
     createDataObjectByExternalType(dobj);
 
     aboutToSetValue();
@@ -207,6 +211,7 @@ void PropertyPostDataObject::setPyObject(PyObject* value)
 
 App::Property* PropertyPostDataObject::Copy() const
 {
+    restoreDeferred();
     PropertyPostDataObject* prop = new PropertyPostDataObject();
     if (m_dataObject) {
 
@@ -257,14 +262,22 @@ void PropertyPostDataObject::createDataObjectByExternalType(vtkSmartPointer<vtkD
 
 void PropertyPostDataObject::Paste(const App::Property& from)
 {
+    const auto& prop = dynamic_cast<const PropertyPostDataObject&>(from);
+    prop.restoreDeferred();
+    discardDeferred();
     aboutToSetValue();
-    m_dataObject = dynamic_cast<const PropertyPostDataObject&>(from).m_dataObject;
+    m_dataObject = prop.m_dataObject;
     hasSetValue();
 }
 
 unsigned int PropertyPostDataObject::getMemSize() const
 {
-    return m_dataObject ? m_dataObject->GetActualMemorySize() : 0;
+    unsigned int size = m_dataObject ? m_dataObject->GetActualMemorySize() : 0;
+    // count the data still to be read without reading it, in kibibytes like VTK
+    if (deferredFile) {
+        size += static_cast<unsigned int>(deferredFile->getSize() / 1024);
+    }
+    return size;
 }
 
 void PropertyPostDataObject::getPaths(std::vector<App::ObjectIdentifier>& /*paths*/) const
@@ -294,6 +307,7 @@ void PropertyPostDataObject::getPaths(std::vector<App::ObjectIdentifier>& /*path
 
 void PropertyPostDataObject::Save(Base::Writer& writer) const
 {
+    restoreDeferred();
     if (!m_dataObject) {
         return;
     }
@@ -367,6 +381,7 @@ void add_to_zip(Base::FileInfo path, int zip_path_idx, zipios::ZipOutputStream&
 
 void PropertyPostDataObject::SaveDocFile(Base::Writer& writer) const
 {
+    restoreDeferred();
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
     if (!m_dataObject) {
@@ -456,6 +471,49 @@ void PropertyPostDataObject::SaveDocFile(Base::Writer& writer) const
 
 void PropertyPostDataObject::RestoreDocFile(Base::Reader& reader)
 {
+    vtkSmartPointer<vtkDataObject> data = readDataObject(reader);
+    if (data) {
+        aboutToSetValue();
+        createDataObjectByExternalType(data);
+        m_dataObject->DeepCopy(data);
+        hasSetValue();
+    }
+}
+
+bool PropertyPostDataObject::deferRestoreDocFile(
+    const std::shared_ptr<Base::DeferredDocFile>& file)
+{
+    aboutToSetValue();
+    deferredFile = file;
+    // reading the data later doesn't change the property, so no notification
+    deferredFile->setRestorer([this](Base::Reader& reader) {
+        vtkSmartPointer<vtkDataObject> data = readDataObject(reader);
+        if (data) {
+            createDataObjectByExternalType(data);
+            m_dataObject->DeepCopy(data);
+        }
+    });
+    hasSetValue();
+    return true;
+}
+
+void PropertyPostDataObject::restoreDeferred() const
+{
+    if (deferredFile && deferredFile->isPending()) {
+        deferredFile->restore();
+    }
+}
+
+void PropertyPostDataObject::discardDeferred()
+{
+    if (deferredFile) {
+        deferredFile->discard();
+    }
+}
+
+vtkSmartPointer<vtkDataObject> PropertyPostDataObject::readDataObject(Base::Reader& reader) const
+{
+    vtkSmartPointer<vtkDataObject> data;
     Base::FileInfo xml(reader.getFileName());
     // create a temporary file and copy the content from the zip stream
     Base::FileInfo fi(App::Application::getTempFileName());
@@ -560,10 +618,7 @@ void PropertyPostDataObject::RestoreDocFile(Base::Reader& reader)
                 }
             }
             else {
-                aboutToSetValue();
-                createDataObjectByExternalType(xmlReader->GetOutputDataObject(0));
-                m_dataObject->DeepCopy(xmlReader->GetOutputDataObject(0));
-                hasSetValue();
+                data = xmlReader->GetOutputDataObject(0);
             }
         }
         else {
@@ -579,4 +634,5 @@ void PropertyPostDataObject::RestoreDocFile(Base::Reader& reader)
     if (xml.extension() == "zip") {
         fo.deleteDirectoryRecursive();
     }
+    return data;
 }
@@ -23,6 +23,8 @@
 #ifndef FEM_PROPERTYPOSTDATASET_H
 #define FEM_PROPERTYPOSTDATASET_H
 
+#include <memory>
+
 #include <vtkDataObject.h>
 #include <vtkSmartPointer.h>
 
@@ -71,6 +73,8 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    /// Keeps a reference to the data file and reads it on first access
+    bool deferRestoreDocFile(const std::shared_ptr<Base::DeferredDocFile>& file) override;
 
     App::Property* Copy() const override;
     void Paste(const App::Property& from) override;
@@ -82,6 +86,11 @@ public:
 
 private:
     static void scaleDataObject(vtkDataObject*, double s);
+    vtkSmartPointer<vtkDataObject> readDataObject(Base::Reader& reader) const;
+    void restoreDeferred() const;
+    void discardDeferred();
+
+    std::shared_ptr<Base::DeferredDocFile> deferredFile;
 
 protected:
     void createDataObjectByExternalType(vtkSmartPointer<vtkDataObject> ex);
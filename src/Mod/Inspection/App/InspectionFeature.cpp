@@ -200,7 +200,8 @@ protected:
         assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
     }
 
-    void AddFacet(const MeshCore::MeshGeomFacet& rclFacet, unsigned long ulFacetIndex)
+    template<class Func>
+    void VisitGrids(const MeshCore::MeshGeomFacet& rclFacet, Func&& add) const
     {
         unsigned long ulX1;
         unsigned long ulY1;
@@ -223,21 +224,19 @@ protected:
                 for (unsigned long ulY = ulY1; ulY <= ulY2; ulY++) {
                     for (unsigned long ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
                         if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ))) {
-                            _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                            add(ulX, ulY, ulZ);
                         }
                     }
                 }
             }
         }
         else {
-            _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+            add(ulX1, ulY1, ulZ1);
         }
     }
 
     void InitGrid() override
     {
-        unsigned long i, j;
-
         Base::BoundBox3f clBBMesh = _pclMesh->GetBoundBox().Transformed(_transform);
 
         float fLengthX = clBBMesh.LengthX();
@@ -253,14 +252,7 @@ protected:
         _fGridLenZ = (1.0f + fLengthZ) / float(_ulCtGridsZ);
         _fMinZ = clBBMesh.MinZ - 0.5f;
 
-        _aulGrid.clear();
-        _aulGrid.resize(_ulCtGridsX);
-        for (i = 0; i < _ulCtGridsX; i++) {
-            _aulGrid[i].resize(_ulCtGridsY);
-            for (j = 0; j < _ulCtGridsY; j++) {
-                _aulGrid[i][j].resize(_ulCtGridsZ);
-            }
-        }
+        _aulGrid.Init(_ulCtGridsX, _ulCtGridsY, _ulCtGridsZ);
     }
 
     void RebuildGrid() override
@@ -268,12 +260,12 @@ protected:
         _ulCtElements = _pclMesh->CountFacets();
         InitGrid();
 
-        unsigned long i = 0;
-        MeshCore::MeshFacetIterator clFIter(*_pclMesh);
-        clFIter.Transform(_transform);
-        for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
-            AddFacet(*clFIter, i++);
-        }
+        const MeshCore::MeshKernel& kernel = *_pclMesh;
+        _aulGrid.Fill(_ulCtElements, [this, &kernel](MeshCore::ElementIndex index, auto&& add) {
+            MeshCore::MeshGeomFacet facet = kernel.GetFacet(index);
+            facet.Transform(_transform);
+            VisitGrids(facet, add);
+        });
     }
 
 private:
@@ -24,6 +24,10 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
 #endif
 
 #include <Base/Exception.h>
@@ -32,7 +36,6 @@
 #include "Builder.h"
 #include "Functional.h"
 #include "MeshKernel.h"
-#include <QVector>
 
 
 using namespace MeshCore;
@@ -279,46 +282,171 @@ void MeshBuilder::Finish(bool freeMemory)
 
 struct MeshFastBuilder::Private
 {
-    struct Vertex
+    // The vertices are collected in chunks and merged with the points found so far by a hash
+    // table. The table is split into shards by the upper bits of the hash so that each thread
+    // can work on its own shards without locking.
+    static constexpr std::size_t chunkSize = 3 * 131072;
+    static constexpr int shardBits = 6;
+    static constexpr std::size_t numShards = std::size_t(1) << shardBits;
+    // marks a slot that refers to a vertex of the current chunk instead of a point
+    static constexpr std::uint64_t pending = std::uint64_t(1) << 63;
+
+    struct Shard
     {
-        Vertex()
-            : x(0)
-            , y(0)
-            , z(0)
-            , i(0)
-        {}
-        Vertex(float x, float y, float z)
-            : x(x)
-            , y(y)
-            , z(z)
-            , i(0)
-        {}
-
-        float x, y, z;
-        size_type i;
-
-        bool operator!=(const Vertex& rhs) const
-        {
-            return x != rhs.x || y != rhs.y || z != rhs.z;
+        // 0 for an empty slot, otherwise point index + 1 or (pending | chunk position)
+        std::vector<std::uint64_t> slots;
+        std::size_t used = 0;
+    };
+
+    MeshPointArray points;
+    MeshFacetArray facets;
+    std::vector<Base::Vector3f> chunk;
+    std::array<Shard, numShards> shards;
+
+    static std::uint64_t hash(const Base::Vector3f& v)
+    {
+        auto bits = [](float value) {
+            value += 0.0F;  // -0 and +0 are equal points
+            std::uint32_t u {};
+            std::memcpy(&u, &value, sizeof(u));
+            return std::uint64_t(u);
+        };
+        std::uint64_t h = bits(v.x) | (bits(v.y) << 32);
+        h ^= bits(v.z) * 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 30;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 27;
+        h *= 0x94D049BB133111EBULL;
+        h ^= h >> 31;
+        return h;
+    }
+    static bool isEqual(const Base::Vector3f& v1, const Base::Vector3f& v2)
+    {
+        return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z;
+    }
+
+    void reserve(Shard& shard, std::size_t count)
+    {
+        std::size_t size = std::max<std::size_t>(shard.slots.size(), 1024);
+        while (size < 2 * count) {
+            size *= 2;
+        }
+        if (size == shard.slots.size()) {
+            return;
+        }
+
+        std::vector<std::uint64_t> slots(size, 0);
+        std::size_t mask = size - 1;
+        for (std::uint64_t slot : shard.slots) {
+            if (slot != 0) {
+                std::size_t pos = hash(points[slot - 1]) & mask;
+                while (slots[pos] != 0) {
+                    pos = (pos + 1) & mask;
+                }
+                slots[pos] = slot;
+            }
+        }
+        shard.slots.swap(slots);
+    }
+
+    void flush()
+    {
+        std::size_t count = chunk.size();
+        if (count == 0) {
+            return;
+        }
+
+        std::vector<std::uint64_t> hashes(count);
+        parallel_for(count, 4096, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                hashes[i] = hash(chunk[i]);
+            }
+        });
+
+        // group the vertices by shard but keep their order within a shard
+        std::array<std::size_t, numShards + 1> offsets {};
+        for (std::uint64_t h : hashes) {
+            offsets[(h >> (64 - shardBits)) + 1]++;
+        }
+        for (std::size_t i = 0; i < numShards; i++) {
+            offsets[i + 1] += offsets[i];
+        }
+        std::vector<std::size_t> order(count);
+        std::array<std::size_t, numShards> cursor {};
+        std::copy(offsets.begin(), offsets.end() - 1, cursor.begin());
+        for (std::size_t i = 0; i < count; i++) {
+            order[cursor[hashes[i] >> (64 - shardBits)]++] = i;
         }
-        bool operator<(const Vertex& rhs) const
-        {
-            if (x != rhs.x) {
-                return x < rhs.x;
+
+        // Look up each vertex in its shard. A new vertex is inserted as pending and a later
+        // occurrence in the same chunk refers to it. The points array is not modified here.
+        std::vector<std::uint64_t> refs(count);
+        std::vector<std::size_t> slotOf(count);
+        parallel_for(numShards, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t s = begin; s < end; s++) {
+                Shard& shard = shards[s];
+                reserve(shard, shard.used + offsets[s + 1] - offsets[s]);
+                std::size_t mask = shard.slots.size() - 1;
+                for (std::size_t k = offsets[s]; k < offsets[s + 1]; k++) {
+                    std::size_t i = order[k];
+                    std::size_t pos = hashes[i] & mask;
+                    for (;;) {
+                        std::uint64_t slot = shard.slots[pos];
+                        if (slot == 0) {
+                            shard.slots[pos] = pending | i;
+                            shard.used++;
+                            refs[i] = pending | i;
+                            slotOf[i] = pos;
+                            break;
+                        }
+                        if ((slot & pending) != 0) {
+                            if (isEqual(chunk[slot & ~pending], chunk[i])) {
+                                refs[i] = slot;
+                                break;
+                            }
+                        }
+                        else if (isEqual(points[slot - 1], chunk[i])) {
+                            refs[i] = slot - 1;
+                            break;
+                        }
+                        pos = (pos + 1) & mask;
+                    }
+                }
             }
-            if (y != rhs.y) {
-                return y < rhs.y;
+        });
+
+        // number the new points in the order of their first occurrence
+        for (std::size_t i = 0; i < count; i++) {
+            std::uint64_t ref = refs[i];
+            if (ref == (pending | i)) {
+                Shard& shard = shards[hashes[i] >> (64 - shardBits)];
+                shard.slots[slotOf[i]] = points.size() + 1;
+                refs[i] = points.size();
+                points.emplace_back(chunk[i]);
             }
-            if (z != rhs.z) {
-                return z < rhs.z;
+            else if ((ref & pending) != 0) {
+                refs[i] = refs[ref & ~pending];
             }
+        }
 
-            return false;
+        for (std::size_t i = 0; i < count; i += 3) {
+            facets.emplace_back(static_cast<PointIndex>(refs[i]),
+                                static_cast<PointIndex>(refs[i + 1]),
+                                static_cast<PointIndex>(refs[i + 2]));
         }
-    };
 
-    // Hint: Using a QVector instead of std::vector is a bit faster
-    QVector<Vertex> verts;
+        chunk.clear();
+    }
+
+    void add(const Base::Vector3f& p0, const Base::Vector3f& p1, const Base::Vector3f& p2)
+    {
+        chunk.push_back(p0);
+        chunk.push_back(p1);
+        chunk.push_back(p2);
+        if (chunk.size() >= chunkSize) {
+            flush();
+        }
+    }
 };
 
 MeshFastBuilder::MeshFastBuilder(MeshKernel& rclM)
@@ -333,70 +461,32 @@ MeshFastBuilder::~MeshFastBuilder()
 
 void MeshFastBuilder::Initialize(size_type ctFacets)
 {
-    p->verts.reserve(ctFacets * 3);
+    // a closed mesh has about half as many points as facets
+    p->facets.reserve(ctFacets);
+    p->points.reserve(ctFacets / 2 + 3);
+    p->chunk.reserve(std::min<std::size_t>(3 * ctFacets, Private::chunkSize));
+    for (auto& shard : p->shards) {
+        p->reserve(shard, ctFacets / (2 * Private::numShards));
+    }
 }
 
 void MeshFastBuilder::AddFacet(const Base::Vector3f* facetPoints)
 {
-    Private::Vertex v;
-    for (int i = 0; i < 3; i++) {
-        v.x = facetPoints[i].x;
-        v.y = facetPoints[i].y;
-        v.z = facetPoints[i].z;
-        p->verts.push_back(v);
-    }
+    p->add(facetPoints[0], facetPoints[1], facetPoints[2]);
 }
 
 void MeshFastBuilder::AddFacet(const MeshGeomFacet& facetPoints)
 {
-    Private::Vertex v;
-    for (const auto& pnt : facetPoints._aclPoints) {
-        v.x = pnt.x;
-        v.y = pnt.y;
-        v.z = pnt.z;
-        p->verts.push_back(v);
-    }
+    p->add(facetPoints._aclPoints[0], facetPoints._aclPoints[1], facetPoints._aclPoints[2]);
 }
 
 void MeshFastBuilder::Finish()
 {
-    using size_type = QVector<Private::Vertex>::size_type;
-    QVector<Private::Vertex>& verts = p->verts;
-    size_type ulCtPts = verts.size();
-    for (size_type i = 0; i < ulCtPts; ++i) {
-        verts[i].i = i;
-    }
-
-    // std::sort(verts.begin(), verts.end());
-    int threads = int(std::thread::hardware_concurrency());
-    MeshCore::parallel_sort(verts.begin(), verts.end(), std::less<>(), threads);
-
-    QVector<FacetIndex> indices(ulCtPts);
-
-    size_type vertex_count = 0;
-    for (QVector<Private::Vertex>::iterator v = verts.begin(); v != verts.end(); ++v) {
-        if (!vertex_count || *v != verts[vertex_count - 1]) {
-            verts[vertex_count++] = *v;
-        }
-
-        indices[v->i] = static_cast<FacetIndex>(vertex_count - 1);
-    }
-
-    size_type ulCt = verts.size() / 3;
-    MeshFacetArray rFacets(static_cast<FacetIndex>(ulCt));
-    for (size_type i = 0; i < ulCt; ++i) {
-        rFacets[static_cast<size_t>(i)]._aulPoints[0] = indices[3 * i];
-        rFacets[static_cast<size_t>(i)]._aulPoints[1] = indices[3 * i + 1];
-        rFacets[static_cast<size_t>(i)]._aulPoints[2] = indices[3 * i + 2];
-    }
-
-    verts.resize(vertex_count);
-
-    MeshPointArray rPoints;
-    rPoints.reserve(static_cast<size_t>(vertex_count));
-    for (const auto& v : verts) {
-        rPoints.push_back(MeshPoint(v.x, v.y, v.z));
+    p->flush();
+    for (auto& shard : p->shards) {
+        std::vector<std::uint64_t>().swap(shard.slots);
     }
+    std::vector<Base::Vector3f>().swap(p->chunk);
 
-    _meshKernel.Adopt(rPoints, rFacets, true);
+    _meshKernel.Adopt(p->points, p->facets, true);
 }
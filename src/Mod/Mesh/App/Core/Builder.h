@@ -191,6 +191,8 @@ private:
  * ...
  * builder.Finish();
  * \endcode
+ * The facets are processed in chunks and equal points are merged with a hash table while adding
+ * them, so the memory needed is roughly the size of the resulting mesh.
  * @author Werner Mayer
  */
 class MeshExport MeshFastBuilder
@@ -199,7 +201,7 @@ private:
     MeshKernel& _meshKernel;
 
 public:
-    using size_type = int;
+    using size_type = std::size_t;
     explicit MeshFastBuilder(MeshKernel& rclM);
     ~MeshFastBuilder();
 
@@ -0,0 +1,308 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or        *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <thread>
+#endif
+
+#include <Base/Exception.h>
+
+#include "CompactKernel.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+struct CompactEdge
+{
+    std::uint64_t key;
+    MeshCompactKernel::Index facet;
+    unsigned short side;
+};
+
+struct CompactEdge_Less
+{
+    bool operator()(const CompactEdge& x, const CompactEdge& y) const
+    {
+        return x.key < y.key;
+    }
+};
+
+FacetIndex toFacetIndex(MeshCompactKernel::Index index)
+{
+    return index == MeshCompactKernel::INDEX_MAX ? FACET_INDEX_MAX : FacetIndex(index);
+}
+}  // namespace
+
+MeshCompactKernel::MeshCompactKernel(const MeshKernel& rclMesh)
+{
+    Assign(rclMesh);
+}
+
+void MeshCompactKernel::Assign(const MeshKernel& rclMesh)
+{
+    const MeshPointArray& rPoints = rclMesh.GetPoints();
+    const MeshFacetArray& rFacets = rclMesh.GetFacets();
+    if (rPoints.size() >= INDEX_MAX || rFacets.size() >= INDEX_MAX) {
+        throw Base::ValueError("Mesh is too big for the compact storage mode");
+    }
+
+    Clear();
+
+    std::size_t numPoints = rPoints.size();
+    _x.resize(numPoints);
+    _y.resize(numPoints);
+    _z.resize(numPoints);
+    _pointFlags.resize(numPoints);
+    for (std::size_t i = 0; i < numPoints; i++) {
+        const MeshPoint& pnt = rPoints[i];
+        _x[i] = pnt.x;
+        _y[i] = pnt.y;
+        _z[i] = pnt.z;
+        _pointFlags[i] = pnt._ucFlag;
+    }
+
+    std::size_t numFacets = rFacets.size();
+    _corners.resize(3 * numFacets);
+    _facetFlags.resize(numFacets);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        const MeshFacet& face = rFacets[i];
+        _corners[3 * i] = static_cast<Index>(face._aulPoints[0]);
+        _corners[3 * i + 1] = static_cast<Index>(face._aulPoints[1]);
+        _corners[3 * i + 2] = static_cast<Index>(face._aulPoints[2]);
+        _facetFlags[i] = face._ucFlag;
+    }
+
+    _clBoundBox = rclMesh.GetBoundBox();
+}
+
+void MeshCompactKernel::Export(MeshKernel& rclMesh) const
+{
+    std::size_t numPoints = _x.size();
+    MeshPointArray points(numPoints);
+    for (std::size_t i = 0; i < numPoints; i++) {
+        MeshPoint& pnt = points[i];
+        pnt.Set(_x[i], _y[i], _z[i]);
+        pnt._ucFlag = _pointFlags[i];
+    }
+
+    if (!HasNeighbours()) {
+        RebuildNeighbours();
+    }
+
+    std::size_t numFacets = _facetFlags.size();
+    MeshFacetArray facets(numFacets);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        MeshFacet& face = facets[i];
+        for (std::size_t j = 0; j < 3; j++) {
+            face._aulPoints[j] = _corners[3 * i + j];
+            face._aulNeighbours[j] = toFacetIndex(_neighbours[3 * i + j]);
+        }
+        face._ucFlag = _facetFlags[i];
+    }
+
+    rclMesh.Adopt(points, facets, false);
+}
+
+void MeshCompactKernel::Clear()
+{
+    _x.clear();
+    _y.clear();
+    _z.clear();
+    _corners.clear();
+    _pointFlags.clear();
+    _facetFlags.clear();
+    _neighbours.clear();
+    _clBoundBox.SetVoid();
+}
+
+MeshGeomFacet MeshCompactKernel::GetFacet(FacetIndex index) const
+{
+    const Index* corners = &_corners[3 * index];
+    MeshGeomFacet clFacet(GetPoint(corners[0]), GetPoint(corners[1]), GetPoint(corners[2]));
+    clFacet._ucFlag = _facetFlags[index];
+    return clFacet;
+}
+
+void MeshCompactKernel::GetFacetNeighbours(FacetIndex index,
+                                           FacetIndex& n0,
+                                           FacetIndex& n1,
+                                           FacetIndex& n2) const
+{
+    if (!HasNeighbours()) {
+        RebuildNeighbours();
+    }
+
+    const Index* neighbours = &_neighbours[3 * index];
+    n0 = toFacetIndex(neighbours[0]);
+    n1 = toFacetIndex(neighbours[1]);
+    n2 = toFacetIndex(neighbours[2]);
+}
+
+std::size_t MeshCompactKernel::GetMemSize() const
+{
+    return sizeof(float) * (_x.capacity() + _y.capacity() + _z.capacity())
+        + sizeof(Index) * (_corners.capacity() + _neighbours.capacity())
+        + _pointFlags.capacity() + _facetFlags.capacity();
+}
+
+void MeshCompactKernel::Transform(const Base::Matrix4D& rclMat)
+{
+    // same arithmetic as Base::Matrix4D::multVec() so that the result is identical to
+    // MeshKernel::Transform()
+    const double m00 = rclMat[0][0], m01 = rclMat[0][1], m02 = rclMat[0][2], m03 = rclMat[0][3];
+    const double m10 = rclMat[1][0], m11 = rclMat[1][1], m12 = rclMat[1][2], m13 = rclMat[1][3];
+    const double m20 = rclMat[2][0], m21 = rclMat[2][1], m22 = rclMat[2][2], m23 = rclMat[2][3];
+
+    float* px = _x.data();
+    float* py = _y.data();
+    float* pz = _z.data();
+    std::size_t numPoints = _x.size();
+    for (std::size_t i = 0; i < numPoints; i++) {
+        double sx = static_cast<double>(px[i]);
+        double sy = static_cast<double>(py[i]);
+        double sz = static_cast<double>(pz[i]);
+        px[i] = static_cast<float>(m00 * sx + m01 * sy + m02 * sz + m03);
+        py[i] = static_cast<float>(m10 * sx + m11 * sy + m12 * sz + m13);
+        pz[i] = static_cast<float>(m20 * sx + m21 * sy + m22 * sz + m23);
+    }
+
+    RecalcBoundBox();
+}
+
+void MeshCompactKernel::RecalcBoundBox()
+{
+    _clBoundBox.SetVoid();
+    if (_x.empty()) {
+        return;
+    }
+
+    // Each coordinate array is reduced separately. The values are distributed over independent
+    // lanes because a plain min/max reduction over floats is not vectorized without fast-math.
+    auto range = [](const std::vector<float>& values, float& minValue, float& maxValue) {
+        constexpr std::size_t lanes = 8;
+        std::array<float, lanes> lo;
+        std::array<float, lanes> hi;
+        lo.fill(values.front());
+        hi.fill(values.front());
+
+        const float* data = values.data();
+        std::size_t count = values.size();
+        std::size_t blocks = count / lanes;
+        for (std::size_t b = 0; b < blocks; b++) {
+            const float* block = data + b * lanes;
+            for (std::size_t k = 0; k < lanes; k++) {
+                lo[k] = block[k] < lo[k] ? block[k] : lo[k];
+                hi[k] = block[k] > hi[k] ? block[k] : hi[k];
+            }
+        }
+        for (std::size_t i = blocks * lanes; i < count; i++) {
+            lo[0] = std::min(lo[0], data[i]);
+            hi[0] = std::max(hi[0], data[i]);
+        }
+
+        minValue = *std::min_element(lo.begin(), lo.end());
+        maxValue = *std::max_element(hi.begin(), hi.end());
+    };
+
+    range(_x, _clBoundBox.MinX, _clBoundBox.MaxX);
+    range(_y, _clBoundBox.MinY, _clBoundBox.MaxY);
+    range(_z, _clBoundBox.MinZ, _clBoundBox.MaxZ);
+}
+
+std::vector<Base::Vector3f> MeshCompactKernel::CalcVertexNormals() const
+{
+    std::vector<Base::Vector3f> normals(_x.size());
+
+    std::size_t numFacets = _facetFlags.size();
+    for (std::size_t i = 0; i < numFacets; i++) {
+        const Index* corners = &_corners[3 * i];
+        Base::Vector3f p1 = GetPoint(corners[0]);
+        Base::Vector3f norm = (GetPoint(corners[1]) - p1) % (GetPoint(corners[2]) - p1);
+
+        normals[corners[0]] += norm;
+        normals[corners[1]] += norm;
+        normals[corners[2]] += norm;
+    }
+
+    return normals;
+}
+
+std::vector<Base::Vector3f> MeshCompactKernel::CalcFacetNormals() const
+{
+    std::size_t numFacets = _facetFlags.size();
+    std::vector<Base::Vector3f> normals(numFacets);
+
+    for (std::size_t i = 0; i < numFacets; i++) {
+        const Index* corners = &_corners[3 * i];
+        Base::Vector3f p1 = GetPoint(corners[0]);
+        Base::Vector3f norm = (GetPoint(corners[1]) - p1) % (GetPoint(corners[2]) - p1);
+        norm.Normalize();
+        normals[i] = norm;
+    }
+
+    return normals;
+}
+
+void MeshCompactKernel::RebuildNeighbours() const
+{
+    // Same approach as MeshKernel::RebuildNeighbours(): sort all edges and connect the facets
+    // of an edge that is shared by exactly two of them. Non-manifold edges are left open.
+    std::size_t numFacets = _facetFlags.size();
+    std::vector<CompactEdge> edges;
+    edges.reserve(3 * numFacets);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        for (unsigned short j = 0; j < 3; j++) {
+            std::uint64_t p0 = _corners[3 * i + j];
+            std::uint64_t p1 = _corners[3 * i + (j + 1) % 3];
+            if (p0 > p1) {
+                std::swap(p0, p1);
+            }
+            edges.push_back({(p0 << 32) | p1, static_cast<Index>(i), j});
+        }
+    }
+
+    int threads = int(std::thread::hardware_concurrency());
+    MeshCore::parallel_sort(edges.begin(), edges.end(), CompactEdge_Less(), threads);
+
+    _neighbours.assign(_corners.size(), INDEX_MAX);
+    auto pE = edges.begin();
+    while (pE != edges.end()) {
+        auto pN = pE + 1;
+        while (pN != edges.end() && pN->key == pE->key) {
+            ++pN;
+        }
+        if (pN - pE == 2) {
+            _neighbours[3 * std::size_t(pE->facet) + pE->side] = (pE + 1)->facet;
+            _neighbours[3 * std::size_t((pE + 1)->facet) + (pE + 1)->side] = pE->facet;
+        }
+        pE = pN;
+    }
+}
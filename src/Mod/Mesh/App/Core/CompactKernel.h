@@ -0,0 +1,174 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or        *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MESH_COMPACTKERNEL_H
+#define MESH_COMPACTKERNEL_H
+
+#include <cstdint>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Matrix.h>
+
+#include "Elements.h"
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshCompactKernel class is a memory saving storage mode for very large meshes.
+ *
+ * The coordinates are kept as structure of arrays, i.e. one array for each of x, y and z, the
+ * corner indices of the facets as 32 bit integers and the status flags of points and facets in
+ * separate arrays. The free usable properties are not stored at all and the neighbourhood of
+ * the facets is only computed when it is accessed the first time.
+ *
+ * A point takes 13 bytes and a facet 13 bytes, or 25 bytes once the neighbourhood is known,
+ * compared to 24 and 64 bytes with MeshKernel.
+ * Whole-mesh operations like the bounding box, transformations and normals work on plain float
+ * arrays which the compiler can vectorize.
+ *
+ * Use Assign() to convert a MeshKernel and Export() to convert back, e.g. to run one of the
+ * algorithms that require a MeshKernel.
+ */
+class MeshExport MeshCompactKernel
+{
+public:
+    using Index = std::uint32_t;
+    static constexpr Index INDEX_MAX = UINT32_MAX;
+
+    /** @name Construction */
+    //@{
+    MeshCompactKernel() = default;
+    explicit MeshCompactKernel(const MeshKernel& rclMesh);
+    //@}
+
+    /** @name Conversion */
+    //@{
+    /** Copies the points, facets and flags of \a rclMesh. A mesh with 2^32 or more points or
+     * facets cannot be stored and raises a Base::ValueError. */
+    void Assign(const MeshKernel& rclMesh);
+    /** Replaces the data of \a rclMesh with the data of this mesh. The properties of points
+     * and facets are reset. */
+    void Export(MeshKernel& rclMesh) const;
+    /** Deletes all points and facets. */
+    void Clear();
+    //@}
+
+    /** @name Access */
+    //@{
+    unsigned long CountPoints() const
+    {
+        return static_cast<unsigned long>(_x.size());
+    }
+    unsigned long CountFacets() const
+    {
+        return static_cast<unsigned long>(_facetFlags.size());
+    }
+    Base::Vector3f GetPoint(PointIndex index) const
+    {
+        return Base::Vector3f(_x[index], _y[index], _z[index]);
+    }
+    void GetFacetPoints(FacetIndex index, PointIndex& p0, PointIndex& p1, PointIndex& p2) const
+    {
+        const Index* corners = &_corners[3 * index];
+        p0 = corners[0];
+        p1 = corners[1];
+        p2 = corners[2];
+    }
+    MeshGeomFacet GetFacet(FacetIndex index) const;
+    /** Returns the neighbour facets of the facet \a index, FACET_INDEX_MAX for an open edge.
+     * The neighbourhood of all facets is computed on the first call. */
+    void GetFacetNeighbours(FacetIndex index, FacetIndex& n0, FacetIndex& n1, FacetIndex& n2) const;
+    /** Returns true if the neighbourhood has been computed. */
+    bool HasNeighbours() const
+    {
+        return _neighbours.size() == _corners.size();
+    }
+    const Base::BoundBox3f& GetBoundBox() const
+    {
+        return _clBoundBox;
+    }
+    /** Returns the number of bytes used by the arrays. */
+    std::size_t GetMemSize() const;
+    //@}
+
+    /** @name Flags */
+    //@{
+    bool IsPointFlag(PointIndex index, MeshPoint::TFlagType tF) const
+    {
+        return (_pointFlags[index] & static_cast<unsigned char>(tF)) != 0;
+    }
+    void SetPointFlag(PointIndex index, MeshPoint::TFlagType tF)
+    {
+        _pointFlags[index] |= static_cast<unsigned char>(tF);
+    }
+    void ResetPointFlag(PointIndex index, MeshPoint::TFlagType tF)
+    {
+        _pointFlags[index] &= ~static_cast<unsigned char>(tF);
+    }
+    bool IsFacetFlag(FacetIndex index, MeshFacet::TFlagType tF) const
+    {
+        return (_facetFlags[index] & static_cast<unsigned char>(tF)) != 0;
+    }
+    void SetFacetFlag(FacetIndex index, MeshFacet::TFlagType tF)
+    {
+        _facetFlags[index] |= static_cast<unsigned char>(tF);
+    }
+    void ResetFacetFlag(FacetIndex index, MeshFacet::TFlagType tF)
+    {
+        _facetFlags[index] &= ~static_cast<unsigned char>(tF);
+    }
+    //@}
+
+    /** @name Evaluation */
+    //@{
+    /** Transforms all points with \a rclMat and updates the bounding box. */
+    void Transform(const Base::Matrix4D& rclMat);
+    /** Recalculates the bounding box of all points. */
+    void RecalcBoundBox();
+    /** Returns the (not normalized) vertex normals computed as the sum of the adjacent facet
+     * normals, weighted by twice the facet area. */
+    std::vector<Base::Vector3f> CalcVertexNormals() const;
+    /** Returns the normalized facet normals. */
+    std::vector<Base::Vector3f> CalcFacetNormals() const;
+    //@}
+
+private:
+    void RebuildNeighbours() const;
+
+private:
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _z;
+    std::vector<Index> _corners;
+    std::vector<unsigned char> _pointFlags;
+    std::vector<unsigned char> _facetFlags;
+    mutable std::vector<Index> _neighbours;
+    Base::BoundBox3f _clBoundBox;
+};
+
+}  // namespace MeshCore
+
+#endif  // MESH_COMPACTKERNEL_H
@@ -24,7 +24,10 @@
 #define MESH_FUNCTIONAL_H
 
 #include <algorithm>
+#include <atomic>
 #include <future>
+#include <thread>
+#include <vector>
 
 
 namespace MeshCore
@@ -62,6 +65,41 @@ static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
     }
 }
 
+/** Splits the range [0, count) into blocks of \a blockSize and calls \a func(begin, end) for
+ * each of them on all cores. Idle threads take the next unprocessed block so that uneven work
+ * is balanced among them. */
+template<class Func>
+static void parallel_for(std::size_t count, std::size_t blockSize, Func func)
+{
+    std::size_t numBlocks = (count + blockSize - 1) / blockSize;
+    std::size_t threads = std::min<std::size_t>(std::thread::hardware_concurrency(), numBlocks);
+    if (threads < 2) {
+        func(std::size_t(0), count);
+        return;
+    }
+
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        for (;;) {
+            std::size_t begin = next.fetch_add(blockSize);
+            if (begin >= count) {
+                break;
+            }
+            func(begin, std::min(begin + blockSize, count));
+        }
+    };
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; i++) {
+        futures.push_back(std::async(std::launch::async, worker));
+    }
+    worker();
+    for (auto& it : futures) {
+        it.get();
+    }
+}
+
 }  // namespace MeshCore
 
 
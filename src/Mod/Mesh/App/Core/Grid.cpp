@@ -36,6 +36,33 @@
 
 using namespace MeshCore;
 
+void MeshGridCells::Init(unsigned long ulX, unsigned long ulY, unsigned long ulZ)
+{
+    _ulX = ulX;
+    _ulY = ulY;
+    _ulZ = ulZ;
+    _offsets.assign(std::size_t(ulX) * ulY * ulZ + 1, 0);
+    _indices.clear();
+}
+
+void MeshGridCells::Clear()
+{
+    Init(0, 0, 0);
+    _offsets.shrink_to_fit();
+    _indices.shrink_to_fit();
+}
+
+void MeshGridCells::SortCells()
+{
+    parallel_for(_offsets.size() - 1, 4096, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::sort(_indices.begin() + _offsets[i], _indices.begin() + _offsets[i + 1]);
+        }
+    });
+}
+
+// ----------------------------------------------------------------
+
 MeshGrid::MeshGrid(const MeshKernel& rclM)
     : _pclMesh(&rclM)
     , _ulCtElements(0)
@@ -72,7 +99,7 @@ void MeshGrid::Attach(const MeshKernel& rclM)
 
 void MeshGrid::Clear()
 {
-    _aulGrid.clear();
+    _aulGrid.Clear();
     _pclMesh = nullptr;
 }
 
@@ -130,14 +157,7 @@ void MeshGrid::InitGrid()
     }
 
     // Create data structure
-    _aulGrid.clear();
-    _aulGrid.resize(_ulCtGridsX);
-    for (unsigned long i = 0; i < _ulCtGridsX; i++) {
-        _aulGrid[i].resize(_ulCtGridsY);
-        for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-            _aulGrid[i][j].resize(_ulCtGridsZ);
-        }
-    }
+    _aulGrid.Init(_ulCtGridsX, _ulCtGridsY, _ulCtGridsZ);
 }
 
 unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
@@ -160,9 +180,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
     for (auto i = ulMinX; i <= ulMaxX; i++) {
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
-                raulElements.insert(raulElements.end(),
-                                    _aulGrid[i][j][k].begin(),
-                                    _aulGrid[i][j][k].end());
+                MeshGridCells::Cell cell = _aulGrid.Get(i, j, k);
+                raulElements.insert(raulElements.end(), cell.begin(), cell.end());
             }
         }
     }
@@ -202,9 +221,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
                 if (Base::DistanceP2(GetBoundBox(i, j, k).GetCenter(), rclOrg) < fMinDistP2) {
-                    raulElements.insert(raulElements.end(),
-                                        _aulGrid[i][j][k].begin(),
-                                        _aulGrid[i][j][k].end());
+                    MeshGridCells::Cell cell = _aulGrid.Get(i, j, k);
+                    raulElements.insert(raulElements.end(), cell.begin(), cell.end());
                 }
             }
         }
@@ -239,7 +257,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
     for (auto i = ulMinX; i <= ulMaxX; i++) {
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
-                raulElements.insert(_aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+                MeshGridCells::Cell cell = _aulGrid.Get(i, j, k);
+                raulElements.insert(cell.begin(), cell.end());
             }
         }
     }
@@ -463,7 +482,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nX < _ulCtGridsX) {
                     for (unsigned long i = 0; i < _ulCtGridsY; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+                            MeshGridCells::Cell cell = _aulGrid.Get(nX, i, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nX++;
@@ -475,7 +495,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nX < _ulCtGridsX) {
                     for (unsigned long i = 0; i < _ulCtGridsY; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+                            MeshGridCells::Cell cell = _aulGrid.Get(nX, i, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nX++;
@@ -487,7 +508,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nY < _ulCtGridsY) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+                            MeshGridCells::Cell cell = _aulGrid.Get(i, nY, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nY++;
@@ -499,7 +521,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nY < _ulCtGridsY) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+                            MeshGridCells::Cell cell = _aulGrid.Get(i, nY, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nY--;
@@ -511,7 +534,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nZ < _ulCtGridsZ) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-                            indices.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+                            MeshGridCells::Cell cell = _aulGrid.Get(i, j, nZ);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nZ++;
@@ -523,7 +547,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nZ < _ulCtGridsZ) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-                            indices.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+                            MeshGridCells::Cell cell = _aulGrid.Get(i, j, nZ);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nZ--;
@@ -611,7 +636,7 @@ unsigned long MeshGrid::GetElements(unsigned long ulX,
                                     unsigned long ulZ,
                                     std::set<ElementIndex>& raclInd) const
 {
-    const std::set<ElementIndex>& rclSet = _aulGrid[ulX][ulY][ulZ];
+    MeshGridCells::Cell rclSet = _aulGrid.Get(ulX, ulY, ulZ);
     if (!rclSet.empty()) {
         raclInd.insert(rclSet.begin(), rclSet.end());
         return rclSet.size();
@@ -630,9 +655,8 @@ unsigned long MeshGrid::GetElements(const Base::Vector3f& rclPoint,
         return 0;
     }
 
-    aulFacets.resize(_aulGrid[ulX][ulY][ulZ].size());
-
-    std::copy(_aulGrid[ulX][ulY][ulZ].begin(), _aulGrid[ulX][ulY][ulZ].end(), aulFacets.begin());
+    MeshGridCells::Cell cell = _aulGrid.Get(ulX, ulY, ulZ);
+    aulFacets.assign(cell.begin(), cell.end());
     return aulFacets.size();
 }
 
@@ -749,13 +773,10 @@ void MeshFacetGrid::RebuildGrid()
     InitGrid();
 
     // Fill data structure
-    MeshFacetIterator clFIter(*_pclMesh);
-
-    unsigned long i = 0;
-    for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
-        //    AddFacet(*clFIter, i++, 2.0f);
-        AddFacet(*clFIter, i++);
-    }
+    const MeshKernel& kernel = *_pclMesh;
+    _aulGrid.Fill(_ulCtElements, [this, &kernel](ElementIndex index, auto&& add) {
+        VisitGrids(kernel.GetFacet(index), add);
+    });
 }
 
 unsigned long MeshFacetGrid::SearchNearestFromPoint(const Base::Vector3f& rclPt) const
@@ -986,7 +1007,7 @@ void MeshFacetGrid::SearchNearestFacetInGrid(unsigned long ulX,
                                              float& rfMinDist,
                                              ElementIndex& rulFacetInd) const
 {
-    const std::set<ElementIndex>& rclSet = _aulGrid[ulX][ulY][ulZ];
+    MeshGridCells::Cell rclSet = _aulGrid.Get(ulX, ulY, ulZ);
     for (ElementIndex pI : rclSet) {
         float fDist = _pclMesh->GetFacet(pI).DistanceToPoint(rclPt);
         if (fDist < rfMinDist) {
@@ -1030,18 +1051,6 @@ MeshPointGrid::MeshPointGrid(const MeshKernel& rclM, float fGridLen)
             std::max<unsigned long>(static_cast<unsigned long>(clBBMesh.LengthZ() / fGridLen), 1));
 }
 
-void MeshPointGrid::AddPoint(const MeshPoint& rclPt, ElementIndex ulPtIndex, float fEpsilon)
-{
-    (void)fEpsilon;
-    unsigned long ulX {};
-    unsigned long ulY {};
-    unsigned long ulZ {};
-    Pos(Base::Vector3f(rclPt.x, rclPt.y, rclPt.z), ulX, ulY, ulZ);
-    if ((ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ)) {
-        _aulGrid[ulX][ulY][ulZ].insert(ulPtIndex);
-    }
-}
-
 void MeshPointGrid::Validate(const MeshKernel& rclMesh)
 {
     if (_pclMesh != &rclMesh) {
@@ -1095,13 +1104,16 @@ void MeshPointGrid::RebuildGrid()
     InitGrid();
 
     // Fill data structure
-
-    MeshPointIterator cPIter(*_pclMesh);
-
-    unsigned long i = 0;
-    for (cPIter.Init(); cPIter.More(); cPIter.Next()) {
-        AddPoint(*cPIter, i++);
-    }
+    const MeshPointArray& points = _pclMesh->GetPoints();
+    _aulGrid.Fill(_ulCtElements, [this, &points](ElementIndex index, auto&& add) {
+        unsigned long ulX {};
+        unsigned long ulY {};
+        unsigned long ulZ {};
+        Pos(points[index], ulX, ulY, ulZ);
+        if ((ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ)) {
+            add(ulX, ulY, ulZ);
+        }
+    });
 }
 
 void MeshPointGrid::Pos(const Base::Vector3f& rclPoint,
@@ -1166,9 +1178,8 @@ bool MeshGridIterator::InitOnRay(const Base::Vector3f& rclPt,
     // point lies within global BB
     if (_rclGrid.GetBoundBox().IsInBox(rclPt)) {  // Determine the voxel by the starting point
         _rclGrid.Position(rclPt, _ulX, _ulY, _ulZ);
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        MeshGridCells::Cell cell = _rclGrid._aulGrid.Get(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
         _bValidRay = true;
     }
     else {  // Start point outside
@@ -1183,9 +1194,8 @@ bool MeshGridIterator::InitOnRay(const Base::Vector3f& rclPt,
                 _rclGrid.Position(cP1, _ulX, _ulY, _ulZ);
             }
 
-            raulElements.insert(raulElements.end(),
-                                _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                                _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+            MeshGridCells::Cell cell = _rclGrid._aulGrid.Get(_ulX, _ulY, _ulZ);
+            raulElements.insert(raulElements.end(), cell.begin(), cell.end());
             _bValidRay = true;
         }
     }
@@ -1249,9 +1259,8 @@ bool MeshGridIterator::NextOnRay(std::vector<ElementIndex>& raulElements)
     if (_bValidRay && _rclGrid.CheckPos(_ulX, _ulY, _ulZ)) {
         GridElement pos(_ulX, _ulY, _ulZ);
         _cSearchPositions.insert(pos);
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        MeshGridCells::Cell cell = _rclGrid._aulGrid.Get(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
     }
     else {
         _bValidRay = false;  // Beam leaked
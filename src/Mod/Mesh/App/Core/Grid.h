@@ -23,11 +23,13 @@
 #ifndef MESH_GRID_H
 #define MESH_GRID_H
 
+#include <atomic>
 #include <limits>
 #include <set>
 
 #include <Base/BoundBox.h>
 
+#include "Functional.h"
 #include "MeshKernel.h"
 
 
@@ -45,6 +47,78 @@ class MeshGrid;
 
 static constexpr float MESHGRID_BBOX_EXTENSION = 10.0F;
 
+/**
+ * The MeshGridCells class stores the element indices of all cells of a grid in one
+ * contiguous array. The indices are ordered by cell and an offset table points to the
+ * first index of each cell. Within a cell the indices are sorted in ascending order.
+ */
+class MeshExport MeshGridCells
+{
+public:
+    /** Read-only view of the indices of one cell. */
+    class Cell
+    {
+    public:
+        Cell(const ElementIndex* begin, const ElementIndex* end)
+            : _begin(begin)
+            , _end(end)
+        {}
+        const ElementIndex* begin() const
+        {
+            return _begin;
+        }
+        const ElementIndex* end() const
+        {
+            return _end;
+        }
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(_end - _begin);
+        }
+        bool empty() const
+        {
+            return _begin == _end;
+        }
+
+    private:
+        const ElementIndex* _begin;
+        const ElementIndex* _end;
+    };
+
+    /** Sets the number of cells in x, y and z direction. All cells are empty afterwards. */
+    void Init(unsigned long ulX, unsigned long ulY, unsigned long ulZ);
+    /** Removes all cells. */
+    void Clear();
+    /** Returns the indices of the given cell. */
+    Cell Get(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+    {
+        std::size_t index = Index(ulX, ulY, ulZ);
+        const ElementIndex* data = _indices.data();
+        return {data + _offsets[index], data + _offsets[index + 1]};
+    }
+    /** Fills the cells with the elements 0 to \a count - 1. For each element \a cells is
+     * invoked as cells(index, add) and must call add(x, y, z) once for every cell the element
+     * belongs to. The elements are processed in parallel and every element is visited twice,
+     * so \a cells must not have side effects.
+     */
+    template<class Func>
+    void Fill(std::size_t count, Func cells);
+
+private:
+    std::size_t Index(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+    {
+        return (std::size_t(ulZ) * _ulY + ulY) * _ulX + ulX;
+    }
+    void SortCells();
+
+private:
+    unsigned long _ulX {0};
+    unsigned long _ulY {0};
+    unsigned long _ulZ {0};
+    std::vector<std::size_t> _offsets {0};
+    std::vector<ElementIndex> _indices;
+};
+
 /**
  * The MeshGrid allows one to divide a global mesh object into smaller regions
  * of elements (e.g. facets, points or edges) depending on the resolution
@@ -152,7 +226,7 @@ public:
     /** Returns the number of elements in a given grid. */
     unsigned long GetCtElements(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
     {
-        return static_cast<unsigned long>(_aulGrid[ulX][ulY][ulZ].size());
+        return static_cast<unsigned long>(_aulGrid.Get(ulX, ulY, ulZ).size());
     }
     /** Validates the grid structure and rebuilds it if needed. Must be implemented in sub-classes.
      */
@@ -196,8 +270,7 @@ protected:
 
 protected:
     // NOLINTBEGIN
-    std::vector<std::vector<std::vector<std::set<ElementIndex>>>>
-        _aulGrid;                /**< Grid data structure. */
+    MeshGridCells _aulGrid;      /**< Grid data structure. */
     const MeshKernel* _pclMesh;  /**< The mesh kernel. */
     unsigned long _ulCtElements; /**< Number of grid elements for validation issues. */
     unsigned long _ulCtGridsX;   /**< Number of grid elements in z. */
@@ -285,11 +358,9 @@ protected:
                              unsigned long& rulX,
                              unsigned long& rulY,
                              unsigned long& rulZ) const;
-    /** Adds a new facet element to the grid structure. \a rclFacet is the geometric facet and \a
-     * ulFacetIndex the corresponding index in the mesh kernel. The facet is added to each grid
-     * element that intersects the facet. */
-    inline void
-    AddFacet(const MeshGeomFacet& rclFacet, ElementIndex ulFacetIndex, float fEpsilon = 0.0F);
+    /** Calls \a add(x, y, z) for each grid element that intersects the facet \a rclFacet. */
+    template<class Func>
+    inline void VisitGrids(const MeshGeomFacet& rclFacet, Func&& add) const;
     /** Returns the number of stored elements. */
     unsigned long HasElements() const override
     {
@@ -337,9 +408,6 @@ public:
     bool Verify() const override;
 
 protected:
-    /** Adds a new point element to the grid structure. \a rclPt is the geometric point and \a
-     * ulPtIndex the corresponding index in the mesh kernel. */
-    void AddPoint(const MeshPoint& rclPt, ElementIndex ulPtIndex, float fEpsilon = 0.0F);
     /** Returns the grid numbers to the given point \a rclPoint. */
     void Pos(const Base::Vector3f& rclPoint,
              unsigned long& rulX,
@@ -371,9 +439,8 @@ public:
     /** Returns indices of the elements in the current grid. */
     void GetElements(std::vector<ElementIndex>& raulElements) const
     {
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        MeshGridCells::Cell cell = _rclGrid._aulGrid.Get(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
     }
     /** Returns the number of elements in the current grid. */
     unsigned long GetCtElements() const
@@ -561,9 +628,8 @@ inline void MeshFacetGrid::PosWithCheck(const Base::Vector3f& rclPoint,
     assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
 }
 
-inline void MeshFacetGrid::AddFacet(const MeshGeomFacet& rclFacet,
-                                    ElementIndex ulFacetIndex,
-                                    float /*fEpsilon*/)
+template<class Func>
+inline void MeshFacetGrid::VisitGrids(const MeshGeomFacet& rclFacet, Func&& add) const
 {
     unsigned long ulX {};
     unsigned long ulY {};
@@ -605,17 +671,55 @@ inline void MeshFacetGrid::AddFacet(const MeshGeomFacet& rclFacet,
             for (ulY = ulY1; ulY <= ulY2; ulY++) {
                 for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
                     if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ))) {
-                        _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                        add(ulX, ulY, ulZ);
                     }
                 }
             }
         }
     }
     else {
-        _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+        add(ulX1, ulY1, ulZ1);
     }
 }
 
+template<class Func>
+void MeshGridCells::Fill(std::size_t count, Func cells)
+{
+    std::size_t numCells = _offsets.size() - 1;
+    std::vector<std::atomic<std::size_t>> cursor(numCells);
+
+    // count the entries of each cell
+    parallel_for(count, 4096, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            cells(ElementIndex(i), [&](unsigned long ulX, unsigned long ulY, unsigned long ulZ) {
+                cursor[Index(ulX, ulY, ulZ)].fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+    });
+
+    // turn the counts into offsets and let the cursors point to the start of each cell
+    _offsets[0] = 0;
+    for (std::size_t i = 0; i < numCells; i++) {
+        std::size_t num = cursor[i].load(std::memory_order_relaxed);
+        cursor[i].store(_offsets[i], std::memory_order_relaxed);
+        _offsets[i + 1] = _offsets[i] + num;
+    }
+
+    // scatter the element indices
+    _indices.resize(_offsets.back());
+    parallel_for(count, 4096, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            cells(ElementIndex(i), [&](unsigned long ulX, unsigned long ulY, unsigned long ulZ) {
+                std::size_t pos =
+                    cursor[Index(ulX, ulY, ulZ)].fetch_add(1, std::memory_order_relaxed);
+                _indices[pos] = ElementIndex(i);
+            });
+        }
+    });
+
+    SortCells();
+}
+
 }  // namespace MeshCore
 
 #endif  // MESH_GRID_H
@@ -23,13 +23,17 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
+#include <cstring>
 #include <istream>
+#include <vector>
 #endif
 
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 #include <Base/Tools.h>
 
 #include "ReaderPLY.h"
@@ -37,6 +41,20 @@
 
 using namespace MeshCore;
 
+namespace
+{
+template<typename T>
+float readBinaryValue(const char* data, bool swap)
+{
+    T value {};
+    std::memcpy(&value, data, sizeof(T));
+    if (swap) {
+        Base::SwapEndian(value);
+    }
+    return static_cast<float>(value);
+}
+}  // namespace
+
 // http://local.wasp.uwa.edu.au/~pbourke/dataformats/ply/
 ReaderPLY::ReaderPLY(MeshKernel& kernel, Material* material)
     : _kernel(kernel)
@@ -520,62 +538,88 @@ void ReaderPLY::addVertexProperty(const PropertyArray& prop)
 
 bool ReaderPLY::ReadVertexes(Base::InputStream& is)
 {
-    for (std::size_t i = 0; i < v_count; i++) {
-        // go through the vertex properties
-        PropertyArray prop_values {};
-        for (const auto& it : vertex_props) {
-            switch (it.second) {
-                case int8: {
-                    int8_t vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case uint8: {
-                    uint8_t vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case int16: {
-                    int16_t vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case uint16: {
-                    uint16_t vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case int32: {
-                    int32_t vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case uint32: {
-                    uint32_t vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                case float32: {
-                    float vt {};
-                    is >> vt;
-                    prop_values[it.first] = vt;
-                } break;
-                case float64: {
-                    double vt {};
-                    is >> vt;
-                    prop_values[it.first] = static_cast<float>(vt);
-                } break;
-                default:
-                    return false;
-            }
+    // a vertex is a record of fixed size, so read them in blocks instead of value by value
+    std::size_t recordSize = 0;
+    for (const auto& it : vertex_props) {
+        recordSize += sizeOfNumber(it.second);
+    }
+    if (recordSize == 0) {
+        return v_count == 0;
+    }
+
+    const bool swap = is.byteOrder() == Base::Stream::BigEndian;
+    const std::size_t blockSize = 65536;
+    std::vector<char> block(blockSize * recordSize);
+    for (std::size_t i = 0; i < v_count; i += blockSize) {
+        std::size_t num = std::min(blockSize, v_count - i);
+        is.read(block.data(), static_cast<int>(num * recordSize));
+        if (!is) {
+            return false;
         }
 
-        addVertexProperty(prop_values);
+        const char* data = block.data();
+        for (std::size_t j = 0; j < num; j++) {
+            // go through the vertex properties
+            PropertyArray prop_values {};
+            for (const auto& it : vertex_props) {
+                float value {};
+                switch (it.second) {
+                    case int8:
+                        value = readBinaryValue<int8_t>(data, swap);
+                        break;
+                    case uint8:
+                        value = readBinaryValue<uint8_t>(data, swap);
+                        break;
+                    case int16:
+                        value = readBinaryValue<int16_t>(data, swap);
+                        break;
+                    case uint16:
+                        value = readBinaryValue<uint16_t>(data, swap);
+                        break;
+                    case int32:
+                        value = readBinaryValue<int32_t>(data, swap);
+                        break;
+                    case uint32:
+                        value = readBinaryValue<uint32_t>(data, swap);
+                        break;
+                    case float32:
+                        value = readBinaryValue<float>(data, swap);
+                        break;
+                    case float64:
+                        value = readBinaryValue<double>(data, swap);
+                        break;
+                }
+                prop_values[it.first] = value;
+                data += sizeOfNumber(it.second);
+            }
+
+            addVertexProperty(prop_values);
+        }
     }
 
     return true;
 }
 
+std::size_t ReaderPLY::sizeOfNumber(Number number)
+{
+    switch (number) {
+        case int8:
+        case uint8:
+            return 1;
+        case int16:
+        case uint16:
+            return 2;
+        case int32:
+        case uint32:
+        case float32:
+            return 4;
+        case float64:
+            return 8;
+    }
+
+    return 0;
+}
+
 bool ReaderPLY::ReadFaces(Base::InputStream& is)
 {
     unsigned char num {};
@@ -100,6 +100,7 @@ private:
         float32,
         float64
     };
+    static std::size_t sizeOfNumber(Number number);
 
     struct PropertyComp
     {
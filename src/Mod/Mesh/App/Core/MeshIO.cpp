@@ -25,9 +25,11 @@
 #ifndef _PreComp_
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <string_view>
+#include <vector>
 #endif
 
 #include <boost/algorithm/string.hpp>
@@ -802,7 +804,6 @@ bool MeshInput::LoadBinarySTL(std::istream& input)
 {
     char szInfo[80];
     Base::Vector3f clVects[4];
-    uint16_t usAtt = 0;
     uint32_t ulCt = 0;
 
     if (!input || input.bad()) {
@@ -842,15 +843,26 @@ bool MeshInput::LoadBinarySTL(std::istream& input)
 #endif
     builder.Initialize(ulCt);
 
-    for (uint32_t i = 0; i < ulCt; i++) {
-        // read normal, points
-        input.read((char*)&clVects, sizeof(clVects));
-
-        std::swap(clVects[0], clVects[3]);
-        builder.AddFacet(clVects);
+    // read the facets in blocks, each record has the normal, 3 points and 2 bytes attribute
+    const std::size_t recordSize = 50;
+    const std::size_t blockSize = 65536;
+    std::vector<char> block(blockSize * recordSize);
+    uint32_t ulRead = 0;
+    while (ulRead < ulCt) {
+        std::size_t num = std::min<std::size_t>(blockSize, ulCt - ulRead);
+        input.read(block.data(), static_cast<std::streamsize>(num * recordSize));
+        num = static_cast<std::size_t>(input.gcount()) / recordSize;
+        if (num == 0) {
+            break;
+        }
 
-        // overread 2 bytes attribute
-        input.read((char*)&usAtt, sizeof(usAtt));
+        const char* record = block.data();
+        for (std::size_t i = 0; i < num; i++, record += recordSize) {
+            std::memcpy(clVects, record, sizeof(clVects));
+            std::swap(clVects[0], clVects[3]);
+            builder.AddFacet(clVects);
+        }
+        ulRead += static_cast<uint32_t>(num);
     }
 
     builder.Finish();
@@ -743,6 +743,7 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
     // use the tmp. object to guarantee that the referenced mesh is not destroyed
     // before calling hasSetValue()
     Base::Reference<MeshObject> tmp(_meshObject);
+    discardDeferred();
     aboutToSetValue();
     _meshObject = mesh;
     hasSetValue();
@@ -750,6 +751,7 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
 
 void PropertyMeshKernel::setValue(const MeshObject& mesh)
 {
+    discardDeferred();
     aboutToSetValue();
     *_meshObject = mesh;
     hasSetValue();
@@ -757,6 +759,7 @@ void PropertyMeshKernel::setValue(const MeshObject& mesh)
 
 void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 {
+    discardDeferred();
     aboutToSetValue();
     _meshObject->setKernel(mesh);
     hasSetValue();
@@ -764,6 +767,7 @@ void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 
 void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 {
+    restoreDeferred();
     aboutToSetValue();
     _meshObject->swap(mesh);
     hasSetValue();
@@ -771,6 +775,7 @@ void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 
 void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 {
+    restoreDeferred();
     aboutToSetValue();
     _meshObject->swap(mesh);
     hasSetValue();
@@ -778,21 +783,25 @@ void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 
 const MeshObject& PropertyMeshKernel::getValue() const
 {
+    restoreDeferred();
     return *_meshObject;
 }
 
 const MeshObject* PropertyMeshKernel::getValuePtr() const
 {
+    restoreDeferred();
     return static_cast<MeshObject*>(_meshObject);
 }
 
 const Data::ComplexGeoData* PropertyMeshKernel::getComplexData() const
 {
+    restoreDeferred();
     return static_cast<MeshObject*>(_meshObject);
 }
 
 Base::BoundBox3d PropertyMeshKernel::getBoundingBox() const
 {
+    restoreDeferred();
     return _meshObject->getBoundBox();
 }
 
@@ -800,12 +809,17 @@ unsigned int PropertyMeshKernel::getMemSize() const
 {
     unsigned int size = 0;
     size += _meshObject->getMemSize();
+    // count the mesh still to be read without reading it
+    if (deferredFile) {
+        size += static_cast<unsigned int>(deferredFile->getSize());
+    }
 
     return size;
 }
 
 MeshObject* PropertyMeshKernel::startEditing()
 {
+    restoreDeferred();
     aboutToSetValue();
     return static_cast<MeshObject*>(_meshObject);
 }
@@ -817,6 +831,7 @@ void PropertyMeshKernel::finishEditing()
 
 void PropertyMeshKernel::transformGeometry(const Base::Matrix4D& rclMat)
 {
+    restoreDeferred();
     aboutToSetValue();
     _meshObject->transformGeometry(rclMat);
     hasSetValue();
@@ -825,6 +840,7 @@ void PropertyMeshKernel::transformGeometry(const Base::Matrix4D& rclMat)
 void PropertyMeshKernel::setPointIndices(
     const std::vector<std::pair<PointIndex, Base::Vector3f>>& inds)
 {
+    restoreDeferred();
     aboutToSetValue();
     MeshCore::MeshKernel& kernel = _meshObject->getKernel();
     for (const auto& it : inds) {
@@ -845,6 +861,7 @@ Base::Matrix4D PropertyMeshKernel::getTransform() const
 
 PyObject* PropertyMeshKernel::getPyObject()
 {
+    restoreDeferred();
     if (!meshPyObject) {
         meshPyObject = new MeshPy(
             &*_meshObject);  // Lgtm[cpp/resource-not-released-in-destructor] ** Not destroyed in
@@ -882,13 +899,14 @@ void PropertyMeshKernel::setPyObject(PyObject* value)
 
 void PropertyMeshKernel::Save(Base::Writer& writer) const
 {
+    restoreDeferred();
     if (writer.isForceXML()) {
         writer.Stream() << writer.ind() << "<Mesh>" << std::endl;
         MeshCore::MeshOutput saver(_meshObject->getKernel());
         saver.SaveXML(writer);
     }
     else {
-        writer.Stream() << writer.ind() << "<Mesh file=\"" << writer.addFile("MeshKernel.bms", this)
+        writer.Stream() << writer.ind() << "<Mesh file=\"" << writer.addFile("MeshKernel.bms", this, true)
                         << "\"/>" << std::endl;
     }
 }
@@ -921,6 +939,7 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
 
 void PropertyMeshKernel::SaveDocFile(Base::Writer& writer) const
 {
+    restoreDeferred();
     _meshObject->save(writer.Stream());
 }
 
@@ -931,9 +950,36 @@ void PropertyMeshKernel::RestoreDocFile(Base::Reader& reader)
     hasSetValue();
 }
 
+bool PropertyMeshKernel::deferRestoreDocFile(const std::shared_ptr<Base::DeferredDocFile>& file)
+{
+    aboutToSetValue();
+    deferredFile = file;
+    // reading the mesh later doesn't change the property, so no notification
+    deferredFile->setRestorer([this](Base::Reader& reader) {
+        _meshObject->load(reader);
+    });
+    hasSetValue();
+    return true;
+}
+
+void PropertyMeshKernel::restoreDeferred() const
+{
+    if (deferredFile && deferredFile->isPending()) {
+        deferredFile->restore();
+    }
+}
+
+void PropertyMeshKernel::discardDeferred()
+{
+    if (deferredFile) {
+        deferredFile->discard();
+    }
+}
+
 App::Property* PropertyMeshKernel::Copy() const
 {
     // Note: Copy the content, do NOT reference the same mesh object
+    restoreDeferred();
     PropertyMeshKernel* prop = new PropertyMeshKernel();
     *(prop->_meshObject) = *(this->_meshObject);
     return prop;
@@ -942,8 +988,10 @@ App::Property* PropertyMeshKernel::Copy() const
 void PropertyMeshKernel::Paste(const App::Property& from)
 {
     // Note: Copy the content, do NOT reference the same mesh object
-    aboutToSetValue();
     const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
+    prop.restoreDeferred();
+    discardDeferred();
+    aboutToSetValue();
     *(this->_meshObject) = *(prop._meshObject);
     hasSetValue();
 }
@@ -25,6 +25,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -315,13 +316,22 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    /** Keeps a reference to the mesh file and reads it when the mesh is
+     * accessed for the first time.
+     */
+    bool deferRestoreDocFile(const std::shared_ptr<Base::DeferredDocFile>& file) override;
 
     App::Property* Copy() const override;
     void Paste(const App::Property& from) override;
     //@}
 
+private:
+    void restoreDeferred() const;
+    void discardDeferred();
+
 private:
     Base::Reference<MeshObject> _meshObject;
+    std::shared_ptr<Base::DeferredDocFile> deferredFile;
     MeshPy* meshPyObject {nullptr};
 };
 
@@ -101,6 +101,12 @@ const char *Boolean::opCode() const
     return Part::OpCodes::Boolean;
 }
 
+bool Boolean::makeClusteredShape(const std::vector<TopoShape>& /*shapes*/,
+                                 TopoShape& /*result*/) const
+{
+    return false;
+}
+
 App::DocumentObjectExecReturn* Boolean::execute()
 {
     try {
@@ -127,27 +133,35 @@ App::DocumentObjectExecReturn* Boolean::execute()
             throw NullShapeException("Tool shape is null");
         }
 
-        std::unique_ptr<BRepAlgoAPI_BooleanOperation> mkBool(makeOperation(BaseShape, ToolShape));
-        if (!mkBool->IsDone()) {
-            std::stringstream error;
-            error << "Boolean operation failed";
-            if (BaseShape.ShapeType() != TopAbs_SOLID) {
-                error << std::endl << base->Label.getValue() << " is not a solid";
-            }
-            if (ToolShape.ShapeType() != TopAbs_SOLID) {
-                error << std::endl << tool->Label.getValue() << " is not a solid";
+        TopoShape res(0);
+        if (makeClusteredShape(shapes, res)) {
+            if (res.isNull()) {
+                return new App::DocumentObjectExecReturn("Resulting shape is null");
             }
-            return new App::DocumentObjectExecReturn(error.str());
-        }
-        TopoDS_Shape resShape = mkBool->Shape();
-        if (resShape.IsNull()) {
-            return new App::DocumentObjectExecReturn("Resulting shape is null");
+            throwIfInvalidIfCheckModel(res.getShape());
         }
+        else {
+            std::unique_ptr<BRepAlgoAPI_BooleanOperation> mkBool(makeOperation(BaseShape, ToolShape));
+            if (!mkBool->IsDone()) {
+                std::stringstream error;
+                error << "Boolean operation failed";
+                if (BaseShape.ShapeType() != TopAbs_SOLID) {
+                    error << std::endl << base->Label.getValue() << " is not a solid";
+                }
+                if (ToolShape.ShapeType() != TopAbs_SOLID) {
+                    error << std::endl << tool->Label.getValue() << " is not a solid";
+                }
+                return new App::DocumentObjectExecReturn(error.str());
+            }
+            TopoDS_Shape resShape = mkBool->Shape();
+            if (resShape.IsNull()) {
+                return new App::DocumentObjectExecReturn("Resulting shape is null");
+            }
 
-        throwIfInvalidIfCheckModel(resShape);
+            throwIfInvalidIfCheckModel(resShape);
 
-        TopoShape res(0);
-        res.makeElementShape(*mkBool, shapes, opCode());
+            res.makeElementShape(*mkBool, shapes, opCode());
+        }
         if (this->Refine.getValue()) {
             res = res.makeElementRefine();
         }
@@ -158,6 +172,9 @@ App::DocumentObjectExecReturn* Boolean::execute()
     catch (const Base::Exception& e) {
         return new App::DocumentObjectExecReturn(e.what());
     }
+    catch (Standard_Failure& e) {
+        return new App::DocumentObjectExecReturn(e.GetMessageString());
+    }
     catch (...) {
         return new App::DocumentObjectExecReturn(
             "A fatal error occurred when running boolean operation");
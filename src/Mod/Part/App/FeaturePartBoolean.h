@@ -59,6 +59,12 @@ public:
 protected:
     virtual BRepAlgoAPI_BooleanOperation* makeOperation(const TopoDS_Shape&, const TopoDS_Shape&) const = 0;
     virtual const char *opCode() const = 0;
+    /** Make the result by clusters instead of one makeOperation()
+     * @param shapes: the base and the tool shape
+     * @param result: the result of the operation
+     * @return false if the operation is to be made by makeOperation(), which the default does
+     */
+    virtual bool makeClusteredShape(const std::vector<TopoShape>& shapes, TopoShape& result) const;
 };
 
 }
@@ -26,6 +26,7 @@
 #endif
 
 #include "FeaturePartCut.h"
+#include "TopoShape.h"
 #include "TopoShapeOpCode.h"
 
 using namespace Part;
@@ -33,7 +34,29 @@ using namespace Part;
 PROPERTY_SOURCE(Part::Cut, Part::Boolean)
 
 
-Cut::Cut() = default;
+Cut::Cut()
+{
+    ADD_PROPERTY_TYPE(Clustered,(false),"Boolean",(App::PropertyType)(App::Prop_None),
+        "Cut each part of a compound base shape separately and in parallel by the tools\n"
+        "that overlap it. This is much faster for compounds of many shapes.");
+}
+
+short Cut::mustExecute() const
+{
+    if (Clustered.isTouched()) {
+        return 1;
+    }
+    return Boolean::mustExecute();
+}
+
+bool Cut::makeClusteredShape(const std::vector<TopoShape>& shapes, TopoShape& result) const
+{
+    if (!Clustered.getValue()) {
+        return false;
+    }
+    result.makeElementClusteredCut(shapes, opCode());
+    return true;
+}
 
 const char *Cut::opCode() const
 {
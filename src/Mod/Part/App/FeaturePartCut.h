@@ -36,12 +36,16 @@ class Cut : public Boolean
 public:
     Cut();
 
+    App::PropertyBool Clustered;
+
     /** @name methods override Feature */
     //@{
     /// recalculate the Feature
+    short mustExecute() const override;
 protected:
     BRepAlgoAPI_BooleanOperation* makeOperation(const TopoDS_Shape&, const TopoDS_Shape&) const override;
     const char *opCode() const override;
+    bool makeClusteredShape(const std::vector<TopoShape>& shapes, TopoShape& result) const override;
     //@}
 };
 
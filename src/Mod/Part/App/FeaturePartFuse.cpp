@@ -77,11 +77,15 @@ MultiFuse::MultiFuse()
     ADD_PROPERTY_TYPE(Refine,(0),"Boolean",(App::PropertyType)(App::Prop_None),"Refine shape (clean up redundant edges) after this boolean operation");
 
     this->Refine.setValue(getRefineModelParameter());
+
+    ADD_PROPERTY_TYPE(Clustered,(false),"Boolean",(App::PropertyType)(App::Prop_None),
+        "Fuse groups of shapes with overlapping bounding boxes separately and in parallel.\n"
+        "This is much faster for many disjoint or loosely overlapping shapes.");
 }
 
 short MultiFuse::mustExecute() const
 {
-    if (Shapes.isTouched())
+    if (Shapes.isTouched() || Clustered.isTouched())
         return 1;
     return 0;
 }
@@ -115,35 +119,49 @@ App::DocumentObjectExecReturn *MultiFuse::execute()
     if (shapes.size() >= 2) {
         try {
             std::vector<ShapeHistory> history;
-            FCBRepAlgoAPI_Fuse mkFuse;
-            TopTools_ListOfShape shapeArguments, shapeTools;
-            const TopoShape& shape = shapes.front();
-            if (shape.isNull()) {
-                throw Base::RuntimeError("Input shape is null");
+            TopoShape res(0);
+            for (const auto& shape : shapes) {
+                if (shape.isNull()) {
+                    throw Base::RuntimeError("Input shape is null");
+                }
             }
-            shapeArguments.Append(shape.getShape());
 
-            for (auto it2 = shapes.begin() + 1; it2 != shapes.end(); ++it2) {
-                if (it2->isNull()) {
-                    throw Base::RuntimeError("Input shape is null");
+            if (Clustered.getValue()) {
+                std::vector<std::shared_ptr<BRepAlgoAPI_BooleanOperation>> makers;
+                res.makeElementClusteredFuse(shapes, OpCodes::Fuse, -1.0, &makers);
+                for (std::size_t i = 0; i < shapes.size(); i++) {
+                    if (makers[i]) {
+                        history.push_back(buildHistory(
+                            *makers[i], TopAbs_FACE, res.getShape(), shapes[i].getShape()));
+                    }
+                    else {
+                        history.push_back(
+                            buildCopyHistory(TopAbs_FACE, res.getShape(), shapes[i].getShape()));
+                    }
                 }
-                shapeTools.Append(it2->getShape());
             }
+            else {
+                FCBRepAlgoAPI_Fuse mkFuse;
+                TopTools_ListOfShape shapeArguments, shapeTools;
+                shapeArguments.Append(shapes.front().getShape());
+                for (auto it2 = shapes.begin() + 1; it2 != shapes.end(); ++it2) {
+                    shapeTools.Append(it2->getShape());
+                }
 
-            mkFuse.SetArguments(shapeArguments);
-            mkFuse.SetTools(shapeTools);
-            mkFuse.setAutoFuzzy();
-            mkFuse.Build();
+                mkFuse.SetArguments(shapeArguments);
+                mkFuse.SetTools(shapeTools);
+                mkFuse.setAutoFuzzy();
+                mkFuse.Build();
 
-            if (!mkFuse.IsDone()) {
-                throw Base::RuntimeError("MultiFusion failed");
-            }
+                if (!mkFuse.IsDone()) {
+                    throw Base::RuntimeError("MultiFusion failed");
+                }
 
-            TopoShape res(0);
-            res = res.makeShapeWithElementMap(mkFuse.Shape(), MapperMaker(mkFuse), shapes, OpCodes::Fuse);
-            for (const auto& it2 : shapes) {
-                history.push_back(
-                    buildHistory(mkFuse, TopAbs_FACE, res.getShape(), it2.getShape()));
+                res = res.makeShapeWithElementMap(mkFuse.Shape(), MapperMaker(mkFuse), shapes, OpCodes::Fuse);
+                for (const auto& it2 : shapes) {
+                    history.push_back(
+                        buildHistory(mkFuse, TopAbs_FACE, res.getShape(), it2.getShape()));
+                }
             }
             if (res.isNull()) {
                 throw Base::RuntimeError("Resulting shape is null");
@@ -55,6 +55,7 @@ public:
     App::PropertyLinkList Shapes;
     PropertyShapeHistory History;
     App::PropertyBool Refine;
+    App::PropertyBool Clustered;
 
     /** @name methods override feature */
     //@{
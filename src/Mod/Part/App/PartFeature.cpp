@@ -76,6 +76,7 @@
 #include "PartFeature.h"
 #include "PartFeaturePy.h"
 #include "PartPyCXX.h"
+#include "ShapeCache.h"
 #include "TopoShapePy.h"
 #include "Tools.h"
 
@@ -120,6 +121,24 @@ App::DocumentObjectExecReturn *Feature::execute()
     return GeoFeature::execute();
 }
 
+bool Feature::restoreFromRecomputeCache()
+{
+    _ShapeCacheKey.clear();
+    auto& cache = ShapeCache::instance();
+    if (!isShapeCacheable() || !cache.isEnabled()) {
+        return false;
+    }
+    _ShapeCacheKey = cache.computeKey(this);
+    return !_ShapeCacheKey.empty() && cache.restore(this, _ShapeCacheKey);
+}
+
+void Feature::saveToRecomputeCache()
+{
+    if (!_ShapeCacheKey.empty()) {
+        ShapeCache::instance().store(this, _ShapeCacheKey);
+    }
+}
+
 PyObject *Feature::getPyObject()
 {
     if (PythonObject.is(Py::_None())){
@@ -1492,6 +1511,13 @@ void Feature::onBeforeChange(const App::Property* prop)
 
 void Feature::onChanged(const App::Property* prop)
 {
+    // any change outside of recompute, e.g. of the placement, invalidates the
+    // cache key used by dependent features
+    if (!isRestoring() && !testStatus(App::Recompute)
+        && !freecad_cast<const PropertyPartShape*>(prop)) {
+        _ShapeCacheKey.clear();
+    }
+
     // if the placement has changed apply the change to the point data as well
     if (prop == &this->Placement) {
         TopoShape shape = this->Shape.getShape();
@@ -1508,9 +1534,11 @@ void Feature::onChanged(const App::Property* prop)
     // if the point data has changed check and adjust the transformation as well
     else if (prop == &this->Shape) {
         if (this->isRecomputing()) {
+            this->Shape.restoreDeferred();
             this->Shape._Shape.setTransform(this->Placement.getValue().toMatrix());
         }
-        else {
+        // a shape still to be read from the project file was saved with the placement
+        else if (!this->Shape.isRestorePending()) {
             Base::Placement p;
             // shape must not be null to override the placement
             if (!this->Shape.getValue().IsNull()) {
@@ -1662,6 +1690,29 @@ ShapeHistory Feature::buildHistory(BRepBuilderAPI_MakeShape& mkShape, TopAbs_Sha
     return history;
 }
 
+ShapeHistory Feature::buildCopyHistory(TopAbs_ShapeEnum type,
+                                       const TopoDS_Shape& newS, const TopoDS_Shape& oldS)
+{
+    ShapeHistory history;
+    history.type = type;
+
+    TopTools_IndexedMapOfShape newM, oldM;
+    TopExp::MapShapes(newS, type, newM);
+    TopExp::MapShapes(oldS, type, oldM);
+
+    for (int i=1; i<=oldM.Extent(); i++) {
+        int j = newM.FindIndex(oldM(i));
+        if (j > 0) {
+            history.shapeMap[i-1].push_back(j-1);
+        }
+        else {
+            history.shapeMap[i-1] = std::vector<int>();
+        }
+    }
+
+    return history;
+}
+
 ShapeHistory Feature::joinHistory(const ShapeHistory& oldH, const ShapeHistory& newH)
 {
     ShapeHistory join;
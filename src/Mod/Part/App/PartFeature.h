@@ -174,6 +174,21 @@ public:
                                                        Data::SearchOptions options = Data::SearchOption::CheckGeometry,
                                                        double tol = 1e-7,
                                                        double atol = 1e-10) const override;
+
+    /** Whether the output of this feature can be kept in the persistent ShapeCache
+     *
+     * Only features whose output shapes are fully determined by their input
+     * properties and linked objects should return true. Best suited for
+     * expensive operations, as computing the cache key has a cost, too.
+     */
+    virtual bool isShapeCacheable() const {
+        return false;
+    }
+    /// Return the ShapeCache key of the last recompute, or empty if it has been invalidated
+    const std::string& getShapeCacheKey() const {
+        return _ShapeCacheKey;
+    }
+
 protected:
     /// recompute only this object
     App::DocumentObjectExecReturn *recompute() override;
@@ -182,6 +197,8 @@ protected:
     void onBeforeChange(const App::Property* prop) override;
     void onChanged(const App::Property* prop) override;
     void onDocumentRestored() override;
+    bool restoreFromRecomputeCache() override;
+    void saveToRecomputeCache() override;
 
     void copyMaterial(Feature* feature);
     void copyMaterial(App::DocumentObject* link);
@@ -208,11 +225,20 @@ protected:
      */
     ShapeHistory buildHistory(BRepBuilderAPI_MakeShape&, TopAbs_ShapeEnum type,
         const TopoDS_Shape& newS, const TopoDS_Shape& oldS);
+    /**
+     * Build the history of a shape that is contained unchanged in the new shape
+     * type: The type of object we are interested in, e.g. TopAbs_FACE
+     * newS: The new shape that contains the original shape
+     * oldS: The original shape
+     */
+    ShapeHistory buildCopyHistory(TopAbs_ShapeEnum type,
+        const TopoDS_Shape& newS, const TopoDS_Shape& oldS);
     ShapeHistory joinHistory(const ShapeHistory&, const ShapeHistory&);
 private:
     struct ElementCache;
     std::map<std::string, ElementCache> _elementCache;
     std::vector<std::pair<std::string, PropertyPartShape*>> _elementCachePrefixMap;
+    std::string _ShapeCacheKey;
 };
 
 class PartExport FilletBase : public Part::Feature
@@ -229,6 +255,9 @@ public:
     short mustExecute() const override;
     App::DocumentObjectExecReturn* execute() override;
     void onUpdateElementReference(const App::Property* prop) override;
+    bool isShapeCacheable() const override {
+        return true;
+    }
 
 protected:
     void onDocumentRestored() override;
@@ -147,6 +147,9 @@ public:
     const char* getViewProviderName() const override {
         return "PartGui::ViewProviderThickness";
     }
+    bool isShapeCacheable() const override {
+        return true;
+    }
     //@}
 
 protected:
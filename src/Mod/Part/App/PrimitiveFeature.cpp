@@ -78,6 +78,13 @@ short Primitive::mustExecute() const
     return Feature::mustExecute();
 }
 
+bool Primitive::isExecuteThreadSafe() const
+{
+    // The shape is made from the own properties only and has no element map. An attached
+    // primitive reads the shapes of its support, which may build their element maps.
+    return AttachmentSupport.getValues().empty();
+}
+
 App::DocumentObjectExecReturn* Primitive::execute() {
     return Part::Feature::execute();
 }
@@ -44,6 +44,7 @@ public:
     App::DocumentObjectExecReturn *execute() override;
     short mustExecute() const override;
     PyObject* getPyObject() override;
+    bool isExecuteThreadSafe() const override;
     //@}
 
 protected:
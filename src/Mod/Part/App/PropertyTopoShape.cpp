@@ -65,6 +65,9 @@ PropertyPartShape::~PropertyPartShape() = default;
 
 void PropertyPartShape::setValue(const TopoShape& sh)
 {
+    if (_Deferred) {
+        _Deferred->discard();
+    }
     aboutToSetValue();
     TopoShape oldShape = _Shape;
     _Shape = sh;
@@ -106,6 +109,9 @@ void PropertyPartShape::setValue(const TopoShape& sh)
 
 void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 {
+    if (_Deferred) {
+        _Deferred->discard();
+    }
     aboutToSetValue();
     auto obj = dynamic_cast<App::DocumentObject*>(getContainer());
     if(obj) {
@@ -119,11 +125,13 @@ void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 
 const TopoDS_Shape& PropertyPartShape::getValue() const
 {
+    restoreDeferred();
     return _Shape.getShape();
 }
 
 const TopoShape& PropertyPartShape::getShape() const
 {
+    restoreDeferred();
     _Shape.initCache(-1);
     // March, 2024 Toponaming project:  There was originally an unused feature to disable
     // elementMapping that has not been kept:
@@ -140,6 +148,7 @@ const TopoShape& PropertyPartShape::getShape() const
 
 const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 {
+    restoreDeferred();
     _Shape.initCache(-1);
     return &(this->_Shape);
 }
@@ -147,6 +156,7 @@ const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 {
     Base::BoundBox3d box;
+    restoreDeferred();
     if (_Shape.getShape().IsNull())
         return box;
     try {
@@ -172,16 +182,19 @@ Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 
 void PropertyPartShape::setTransform(const Base::Matrix4D &rclTrf)
 {
+    restoreDeferred();
     _Shape.setTransform(rclTrf);
 }
 
 Base::Matrix4D PropertyPartShape::getTransform() const
 {
+    restoreDeferred();
     return _Shape.getTransform();
 }
 
 void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 {
+    restoreDeferred();
     aboutToSetValue();
     _Shape.transformGeometry(rclTrf);
     hasSetValue();
@@ -189,6 +202,7 @@ void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 
 PyObject *PropertyPartShape::getPyObject()
 {
+    restoreDeferred();
     Base::PyObjectBase* prop = static_cast<Base::PyObjectBase*>(_Shape.getPyObject());
     if (prop)
         prop->setConst();
@@ -225,6 +239,7 @@ void PropertyPartShape::setPyObject(PyObject *value)
 
 App::Property *PropertyPartShape::Copy() const
 {
+    restoreDeferred();
     PropertyPartShape *prop = new PropertyPartShape();
 
     // March, 2024 Toponaming project:  There was originally a feature to enable making an element
@@ -243,6 +258,7 @@ void PropertyPartShape::Paste(const App::Property &from)
 {
     auto prop = freecad_cast<const PropertyPartShape*>(&from);
     if(prop) {
+        prop->restoreDeferred();
         setValue(prop->_Shape);
         _Ver = prop->_Ver;
     }
@@ -250,6 +266,10 @@ void PropertyPartShape::Paste(const App::Property &from)
 
 unsigned int PropertyPartShape::getMemSize () const
 {
+    // count the geometry still to be read without reading it
+    if (isRestorePending()) {
+        return _Shape.getMemSize() + static_cast<unsigned int>(_Deferred->getSize());
+    }
     return _Shape.getMemSize();
 }
 
@@ -269,6 +289,7 @@ void PropertyPartShape::getPaths(std::vector<App::ObjectIdentifier> &paths) cons
 
 void PropertyPartShape::beforeSave() const
 {
+    restoreDeferred();
     _HasherIndex = 0;
     _SaveHasher = false;
     auto owner = freecad_cast<App::DocumentObject*>(getContainer());
@@ -282,6 +303,7 @@ void PropertyPartShape::beforeSave() const
 void PropertyPartShape::Save (Base::Writer &writer) const
 {
     //See SaveDocFile(), RestoreDocFile()
+    restoreDeferred();
     writer.Stream() << writer.ind() << "<Part";
     auto owner = dynamic_cast<App::DocumentObject*>(getContainer());
     if(owner && !_Shape.isNull()
@@ -304,7 +326,7 @@ void PropertyPartShape::Save (Base::Writer &writer) const
     bool toXML = writer.isForceXML();
     if(!toXML) {
         writer.Stream() << " file=\""
-                        << writer.addFile(getFileName(binary?".bin":".brp").c_str(), this)
+                        << writer.addFile(getFileName(binary?".bin":".brp").c_str(), this, binary)
                         << "\"/>\n";
     } else if(binary) {
         writer.Stream() << " binary=\"1\">\n";
@@ -528,7 +550,7 @@ void PropertyPartShape::saveToFile(Base::Writer &writer) const
     fi.deleteFile();
 }
 
-void PropertyPartShape::loadFromFile(Base::Reader &reader)
+TopoDS_Shape PropertyPartShape::loadFromFile(Base::Reader &reader) const
 {
     BRep_Builder builder;
     // create a temporary file and copy the content from the zip stream
@@ -568,26 +590,50 @@ void PropertyPartShape::loadFromFile(Base::Reader &reader)
 
     // delete the temp file
     fi.deleteFile();
-    setValue(shape);
+    return shape;
 }
 
-void PropertyPartShape::loadFromStream(Base::Reader &reader)
+TopoDS_Shape PropertyPartShape::loadFromStream(Base::Reader &reader) const
 {
+    TopoDS_Shape shape;
     try {
         reader.exceptions(std::istream::failbit | std::istream::badbit);
         BRep_Builder builder;
-        TopoDS_Shape shape;
         BRepTools::Read(shape, reader, builder);
-        setValue(shape);
     }
     catch (const std::exception&) {
         if (!reader.eof())
             Base::Console().warning("Failed to load BRep file %s\n", reader.getFileName().c_str());
     }
+    return shape;
+}
+
+TopoShape PropertyPartShape::loadShape(Base::Reader &reader) const
+{
+    Base::FileInfo brep(reader.getFileName());
+    TopoShape shape;
+
+    if (brep.hasExtension("bin")) {
+        shape.importBinary(reader);
+    }
+    else {
+        bool direct = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
+        if (!direct) {
+            shape.setShape(loadFromFile(reader));
+        }
+        else {
+            auto iostate = reader.exceptions();
+            shape.setShape(loadFromStream(reader));
+            reader.exceptions(iostate);
+        }
+    }
+    return shape;
 }
 
 void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 {
+    restoreDeferred();
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
     if (_Shape.getShape().IsNull())
@@ -619,34 +665,15 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
     auto elementMap = _Shape.resetElementMap();
     auto hasher = _Shape.Hasher;
 
-    Base::FileInfo brep(reader.getFileName());
-    TopoShape shape;
-
     // In LS3 the following statement is executed right before shape.Hasher = hasher;
     // https://github.com/realthunder/FreeCAD/blob/a9810d509a6f112b5ac03d4d4831b67e6bffd5b7/src/Mod/Part/App/PropertyTopoShape.cpp#L639
-    // Now it's not possible anymore because both PropertyPartShape::loadFromFile() and
-    // PropertyPartShape::loadFromStream() calls PropertyPartShape::setValue() which clears the
+    // Now it's not possible anymore because PropertyPartShape::setValue() clears the
     // value of _Ver.
     // Therefore we're storing the value of _Ver here so that we don't lose it.
 
     std::string ver = _Ver;
 
-    if (brep.hasExtension("bin")) {
-        shape.importBinary(reader);
-    }
-    else {
-        bool direct = App::GetApplication().GetParameterGroupByPath
-            ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
-        if (!direct) {
-            loadFromFile(reader);
-        }
-        else {
-            auto iostate = reader.exceptions();
-            loadFromStream(reader);
-            reader.exceptions(iostate);
-        }
-        shape = getValue();
-    }
+    TopoShape shape = loadShape(reader);
 
     // restore the element map
     shape.Hasher = hasher;
@@ -655,6 +682,40 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
     _Ver = ver;
 }
 
+bool PropertyPartShape::deferRestoreDocFile(const std::shared_ptr<Base::DeferredDocFile>& file)
+{
+    auto owner = freecad_cast<App::DocumentObject*>(getContainer());
+    if (!owner) {
+        return false;
+    }
+
+    // notify like RestoreDocFile() does, e.g. a visible view provider will
+    // ask for the shape right away
+    aboutToSetValue();
+    _Shape.Tag = owner->getID();
+    _Deferred = file;
+    // The element map is restored from its own file in the meantime, so only
+    // the geometry is set. This is done silently because reading the shape
+    // doesn't change the property from the document's point of view.
+    _Deferred->setRestorer([this](Base::Reader& reader) {
+        _Shape.setShape(loadShape(reader).getShape(), false);
+    });
+    hasSetValue();
+    return true;
+}
+
+bool PropertyPartShape::isRestorePending() const
+{
+    return _Deferred && _Deferred->isPending();
+}
+
+void PropertyPartShape::restoreDeferred() const
+{
+    if (isRestorePending()) {
+        _Deferred->restore();
+    }
+}
+
 // -------------------------------------------------------------------------
 
 ShapeHistory::ShapeHistory(BRepBuilderAPI_MakeShape& mkShape, TopAbs_ShapeEnum type,
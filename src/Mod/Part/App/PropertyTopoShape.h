@@ -24,6 +24,7 @@
 #define PART_PROPERTYTOPOSHAPE_H
 
 #include <map>
+#include <memory>
 #include <vector>
 
 #include <App/PropertyGeo.h>
@@ -90,6 +91,9 @@ public:
 
     void SaveDocFile (Base::Writer &writer) const override;
     void RestoreDocFile(Base::Reader &reader) override;
+    bool deferRestoreDocFile(const std::shared_ptr<Base::DeferredDocFile>& file) override;
+    /// Returns true if the geometry is yet to be read from the project file
+    bool isRestorePending() const;
 
     App::Property *Copy() const override;
     void Paste(const App::Property &from) override;
@@ -108,11 +112,14 @@ public:
 
 private:
     void saveToFile(Base::Writer &writer) const;
-    void loadFromFile(Base::Reader &reader);
-    void loadFromStream(Base::Reader &reader);
+    TopoDS_Shape loadFromFile(Base::Reader &reader) const;
+    TopoDS_Shape loadFromStream(Base::Reader &reader) const;
+    TopoShape loadShape(Base::Reader &reader) const;
+    void restoreDeferred() const;
 
 private:
     TopoShape _Shape;
+    std::shared_ptr<Base::DeferredDocFile> _Deferred;
     std::string _Ver;
     bool needsToMigrate = false;
     mutable int _HasherIndex = 0;
@@ -174,7 +174,8 @@ void PropertyTopoShapeList::Save(Writer& writer) const
                 ext += ".brp";
             }
             writer.Stream() << writer.ind() << " file=\""
-                            << writer.addFile(getFileName(ext.c_str()).c_str(), this) << "\"/>\n";
+                            << writer.addFile(getFileName(ext.c_str()).c_str(), this, binary)
+                            << "\"/>\n";
         }
         else if (binary) {
             writer.Stream() << " binary=\"1\">\n";
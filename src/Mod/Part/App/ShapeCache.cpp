@@ -0,0 +1,520 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cstdint>
+# include <filesystem>
+# include <fstream>
+# include <set>
+# include <sstream>
+# include <vector>
+# include <Standard_Failure.hxx>
+# include <Standard_Version.hxx>
+#endif
+
+#include <QCryptographicHash>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/PropertyLinks.h>
+#include <App/StringHasher.h>
+#include <Base/Console.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Reader.h>
+#include <Base/Writer.h>
+
+#include "PartFeature.h"
+#include "ShapeCache.h"
+
+
+FC_LOG_LEVEL_INIT("ShapeCache", true, true)
+
+using namespace Part;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+// Bump this when the layout of an entry or the content of the key changes
+constexpr const char* cacheMagic = "FCShapeCache 1";
+constexpr const char* entryExtension = ".fcsc";
+
+ParameterGrp::handle getParameter()
+{
+    return App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/ShapeCache");
+}
+
+/// Writer serializing properties into a single in-memory stream, including
+/// the content of any file they add
+class KeyWriter: public Base::Writer
+{
+public:
+    KeyWriter()
+    {
+        setForceXML(true);
+        setMode("BinaryBrep");
+    }
+
+    std::ostream& Stream() override
+    {
+        return stream;
+    }
+
+    void writeFiles() override
+    {
+        // files may be added while writing files
+        for (std::size_t i = 0; i < FileList.size(); ++i) {
+            FileList[i].Object->SaveDocFile(*this);
+        }
+    }
+
+    std::string getString() const
+    {
+        return stream.str();
+    }
+
+private:
+    std::ostringstream stream;
+};
+
+void addString(QCryptographicHash& hash, const std::string& str)
+{
+    std::string size = std::to_string(str.size()) + ':';
+    hash.addData(size.c_str(), static_cast<int>(size.size()));
+    hash.addData(str.c_str(), static_cast<int>(str.size()));
+}
+
+bool isInputProperty(const App::DocumentObject* obj, const App::Property* prop)
+{
+    if (prop->testStatus(App::Property::Output) || prop->testStatus(App::Property::Transient)
+        || (obj->getPropertyType(prop) & (App::Prop_Output | App::Prop_Transient))) {
+        return false;
+    }
+    // expressions are already evaluated into the properties they are bound to
+    return prop != &obj->Label && prop != &obj->Label2 && prop != &obj->Visibility
+        && prop != &obj->ExpressionEngine && !freecad_cast<const PropertyPartShape*>(prop);
+}
+
+void addShape(QCryptographicHash& hash, const TopoShape& shape)
+{
+    std::ostringstream brep;
+    shape.exportBinary(brep);
+    addString(hash, brep.str());
+    for (const auto& element : shape.getElementMap()) {
+        addString(hash, element.index.toString());
+        addString(hash, element.name.toString());
+    }
+}
+
+class KeyBuilder
+{
+public:
+    explicit KeyBuilder(QCryptographicHash& hash)
+        : hash(hash)
+    {}
+
+    /// Hash the input properties of \c obj and everything they link to
+    void addInputs(const App::DocumentObject* obj)
+    {
+        std::vector<App::DocumentObject*> links;
+        KeyWriter writer;
+        std::vector<std::pair<const char*, App::Property*>> props;
+        obj->getPropertyNamedList(props);
+        for (const auto& [name, prop] : props) {
+            if (!isInputProperty(obj, prop)) {
+                continue;
+            }
+            writer.Stream() << name << '\n';
+            prop->Save(writer);
+            if (auto linkProp = freecad_cast<const App::PropertyLinkBase*>(prop)) {
+                linkProp->getLinks(links);
+            }
+        }
+        writer.writeFiles();
+        addString(hash, obj->getTypeId().getName());
+        addString(hash, writer.getString());
+
+        std::set<App::DocumentObject*> unique;
+        for (auto link : links) {
+            if (link && link != obj && unique.insert(link).second) {
+                addDependency(link);
+            }
+        }
+    }
+
+private:
+    void addDependency(App::DocumentObject* dep)
+    {
+        if (!visited.insert(dep).second) {
+            addString(hash, dep->getFullName());
+            return;
+        }
+        // The output of a shape feature fully describes what a dependent
+        // feature can see of it. Prefer its own cache key, which is a lot
+        // cheaper than hashing the shape.
+        if (auto feature = freecad_cast<Feature*>(dep)) {
+            if (!feature->isTouched() && !feature->getShapeCacheKey().empty()) {
+                addString(hash, feature->getShapeCacheKey());
+                return;
+            }
+            std::vector<std::pair<const char*, App::Property*>> props;
+            feature->getPropertyNamedList(props);
+            for (const auto& [name, prop] : props) {
+                auto shapeProp = freecad_cast<PropertyPartShape*>(prop);
+                if (shapeProp && !shapeProp->testStatus(App::Property::Transient)) {
+                    addString(hash, name);
+                    addShape(hash, shapeProp->getShape());
+                }
+            }
+            return;
+        }
+        addInputs(dep);
+    }
+
+    QCryptographicHash& hash;
+    std::set<App::DocumentObject*> visited;
+};
+
+// Length prefixed chunks of the entry file
+void writeChunk(std::ostream& stream, const std::string& data)
+{
+    auto size = static_cast<std::uint64_t>(data.size());
+    stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    stream.write(data.c_str(), static_cast<std::streamsize>(data.size()));
+}
+
+std::string readChunk(std::istream& stream)
+{
+    std::uint64_t size = 0;
+    if (!stream.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+        FC_THROWM(Base::FileException, "Truncated shape cache entry");
+    }
+    // don't trust a corrupt size before allocating the chunk
+    auto pos = stream.tellg();
+    stream.seekg(0, std::ios::end);
+    auto end = stream.tellg();
+    stream.seekg(pos);
+    if (pos < 0 || end < pos || size > static_cast<std::uint64_t>(end - pos)) {
+        FC_THROWM(Base::FileException, "Truncated shape cache entry");
+    }
+    std::string data;
+    data.resize(static_cast<std::size_t>(size));
+    if (!stream.read(data.data(), static_cast<std::streamsize>(size))) {
+        FC_THROWM(Base::FileException, "Truncated shape cache entry");
+    }
+    return data;
+}
+
+std::vector<std::pair<std::string, PropertyPartShape*>> getShapeProperties(const Feature* feature)
+{
+    std::vector<std::pair<std::string, PropertyPartShape*>> res;
+    std::vector<std::pair<const char*, App::Property*>> props;
+    feature->getPropertyNamedList(props);
+    for (const auto& [name, prop] : props) {
+        auto shapeProp = freecad_cast<PropertyPartShape*>(prop);
+        if (shapeProp && !shapeProp->testStatus(App::Property::Transient)) {
+            res.emplace_back(name, shapeProp);
+        }
+    }
+    return res;
+}
+
+}  // namespace
+
+ShapeCache& ShapeCache::instance()
+{
+    static ShapeCache cache;
+    return cache;
+}
+
+bool ShapeCache::isEnabled() const
+{
+    return getParameter()->GetBool("Enabled", false);
+}
+
+std::string ShapeCache::getDirectory() const
+{
+    std::string dir = getParameter()->GetASCII("Directory", "");
+    if (dir.empty()) {
+        dir = App::Application::getUserCachePath() + "ShapeCache";
+    }
+    return dir;
+}
+
+std::string ShapeCache::getEntryPath(const std::string& key) const
+{
+    return getDirectory() + "/" + key + entryExtension;
+}
+
+std::string ShapeCache::computeKey(const Feature* feature) const
+{
+    try {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        addString(hash, cacheMagic);
+        addString(hash, OCC_VERSION_STRING_EXT);
+        addString(hash, feature->getElementMapVersion(&feature->Shape));
+        KeyBuilder builder(hash);
+        builder.addInputs(feature);
+        return hash.result().toHex().toStdString();
+    }
+    catch (Base::Exception& e) {
+        FC_LOG("Cannot compute shape cache key of " << feature->getFullName() << ": "
+                                                     << e.what());
+    }
+    catch (Standard_Failure& e) {
+        FC_LOG("Cannot compute shape cache key of " << feature->getFullName() << ": "
+                                                     << e.GetMessageString());
+    }
+    return {};
+}
+
+void ShapeCache::store(const Feature* feature, const std::string& key)
+{
+    auto hasher = feature->getDocument()->getStringHasher();
+    std::ostringstream entry;
+    entry << cacheMagic << '\n';
+
+    try {
+        auto props = getShapeProperties(feature);
+        writeChunk(entry, std::to_string(props.size()));
+        for (const auto& [name, prop] : props) {
+            const TopoShape& shape = prop->getShape();
+            if (shape.Hasher && shape.Hasher != hasher) {
+                // element map of a foreign hasher cannot be validated on restore
+                return;
+            }
+            writeChunk(entry, name);
+
+            std::ostringstream brep;
+            shape.exportBinary(brep);
+            writeChunk(entry, brep.str());
+
+            std::string map;
+            std::ostringstream sids;
+            if (shape.getElementMapSize()) {
+                // Only marked string IDs are written to the element map.
+                // Record their content to verify them on restore.
+                if (hasher) {
+                    hasher->clearMarks();
+                }
+                shape.beforeSave();
+                if (hasher) {
+                    for (const auto& [id, sid] : hasher->getIDMap()) {
+                        if (sid.isMarked()) {
+                            writeChunk(sids, std::to_string(id));
+                            writeChunk(sids, sid.deref().data().toStdString());
+                            writeChunk(sids, sid.deref().postfix().toStdString());
+                        }
+                    }
+                    hasher->clearMarks();
+                }
+                Base::StringWriter writer;
+                shape.SaveDocFile(writer);
+                map = writer.getString();
+            }
+            writeChunk(entry, sids.str());
+            writeChunk(entry, map);
+        }
+    }
+    catch (Base::Exception& e) {
+        FC_LOG("Skip caching " << feature->getFullName() << ": " << e.what());
+        return;
+    }
+    catch (Standard_Failure& e) {
+        FC_LOG("Skip caching " << feature->getFullName() << ": " << e.GetMessageString());
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Base::FileInfo dir(getDirectory());
+        if (!dir.exists() && !dir.createDirectories()) {
+            FC_WARN("Cannot create shape cache directory " << dir.filePath());
+            return;
+        }
+
+        // write to a temporary file first, so that a concurrent reader never
+        // sees a partial entry
+        std::string tmpName = Base::FileInfo::getTempFileName(key.c_str(), dir.filePath().c_str());
+        {
+            std::ofstream file(Base::FileInfo::stringToPath(tmpName),
+                               std::ios::out | std::ios::binary);
+            std::string data = entry.str();
+            file.write(data.c_str(), static_cast<std::streamsize>(data.size()));
+            if (!file) {
+                FC_WARN("Failed to write shape cache entry " << tmpName);
+                return;
+            }
+        }
+        std::error_code ec;
+        fs::rename(Base::FileInfo::stringToPath(tmpName),
+                   Base::FileInfo::stringToPath(getEntryPath(key)),
+                   ec);
+        if (ec) {
+            fs::remove(Base::FileInfo::stringToPath(tmpName), ec);
+            return;
+        }
+        FC_LOG("Cached " << feature->getFullName() << " as " << key);
+    }
+
+    constexpr unsigned pruneInterval = 32;
+    if (storeCount++ % pruneInterval == 0) {
+        prune();
+    }
+}
+
+bool ShapeCache::restore(Feature* feature, const std::string& key)
+{
+    std::string data;
+    {
+        auto path = Base::FileInfo::stringToPath(getEntryPath(key));
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        data = buffer.str();
+
+        // touch the entry for least recently used pruning
+        std::error_code ec;
+        fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    }
+
+    auto hasher = feature->getDocument()->getStringHasher();
+    std::vector<std::pair<PropertyPartShape*, TopoShape>> shapes;
+    try {
+        std::istringstream entry(data);
+        std::string magic;
+        if (!std::getline(entry, magic) || magic != cacheMagic) {
+            return false;
+        }
+        auto count = std::stoul(readChunk(entry));
+        for (unsigned long i = 0; i < count; ++i) {
+            auto name = readChunk(entry);
+            auto prop = freecad_cast<PropertyPartShape*>(feature->getPropertyByName(name.c_str()));
+            if (!prop) {
+                return false;
+            }
+
+            TopoShape shape(feature->getID(), hasher);
+            std::istringstream brep(readChunk(entry));
+            shape.importBinary(brep);
+
+            std::istringstream sids(readChunk(entry));
+            while (sids.peek() != std::char_traits<char>::eof()) {
+                long id = std::stol(readChunk(sids));
+                auto text = readChunk(sids);
+                auto postfix = readChunk(sids);
+                if (!hasher) {
+                    return false;
+                }
+                auto sid = hasher->getID(id);
+                if (!sid || sid.deref().data().toStdString() != text
+                    || sid.deref().postfix().toStdString() != postfix) {
+                    FC_LOG("Stale string id in shape cache entry " << key);
+                    return false;
+                }
+            }
+
+            auto map = readChunk(entry);
+            if (!map.empty()) {
+                std::istringstream stream(map);
+                Base::Reader reader(stream, name, 1);
+                shape.RestoreDocFile(reader);
+            }
+            shapes.emplace_back(prop, shape);
+        }
+    }
+    catch (Base::Exception& e) {
+        FC_LOG("Invalid shape cache entry " << key << ": " << e.what());
+        return false;
+    }
+    catch (Standard_Failure& e) {
+        FC_LOG("Invalid shape cache entry " << key << ": " << e.GetMessageString());
+        return false;
+    }
+    catch (std::exception& e) {
+        FC_LOG("Invalid shape cache entry " << key << ": " << e.what());
+        return false;
+    }
+
+    for (auto& [prop, shape] : shapes) {
+        prop->setValue(shape);
+    }
+    FC_LOG("Restored " << feature->getFullName() << " from " << key);
+    return true;
+}
+
+void ShapeCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::error_code ec;
+    for (const auto& entry :
+         fs::directory_iterator(Base::FileInfo::stringToPath(getDirectory()), ec)) {
+        if (entry.path().extension() == entryExtension) {
+            fs::remove(entry.path(), ec);
+        }
+    }
+}
+
+void ShapeCache::prune()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    constexpr std::uintmax_t megaByte = 1024 * 1024;
+    auto limit = static_cast<std::uintmax_t>(getParameter()->GetUnsigned("MaxSize", 512))
+        * megaByte;
+
+    std::vector<std::pair<fs::file_time_type, fs::path>> entries;
+    std::uintmax_t total = 0;
+    std::error_code ec;
+    for (const auto& entry :
+         fs::directory_iterator(Base::FileInfo::stringToPath(getDirectory()), ec)) {
+        if (entry.path().extension() != entryExtension) {
+            continue;
+        }
+        total += entry.file_size(ec);
+        entries.emplace_back(entry.last_write_time(ec), entry.path());
+    }
+    if (total <= limit) {
+        return;
+    }
+
+    // remove the oldest entries until there is some headroom left
+    std::sort(entries.begin(), entries.end());
+    auto target = limit / 4 * 3;
+    for (const auto& [time, path] : entries) {
+        if (total <= target) {
+            break;
+        }
+        auto size = fs::file_size(path, ec);
+        if (fs::remove(path, ec)) {
+            total -= std::min(size, total);
+        }
+    }
+}
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef PART_SHAPECACHE_H
+#define PART_SHAPECACHE_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include <Mod/Part/PartGlobal.h>
+
+namespace Part
+{
+
+class Feature;
+
+/** Persistent, content addressed cache of feature output shapes
+ *
+ * An entry is keyed by a hash of the input properties of a feature and of
+ * the shapes (or, recursively, the inputs) of the objects it links to. It
+ * stores the binary BRep and the element map of every persistent shape
+ * property of the feature, so that a feature whose inputs did not change
+ * since a previous session can skip its execution, e.g. when a document is
+ * recomputed right after being opened.
+ *
+ * The element map refers to string IDs of the document string hasher.
+ * These are stored along with the entry and the entry is only used if the
+ * hasher of the document still maps the same IDs to the same strings.
+ *
+ * The cache is controlled by the parameter group
+ * "User parameter:BaseApp/Preferences/Mod/Part/ShapeCache":
+ *  - Enabled: turn the cache on (default false)
+ *  - Directory: location of the entries (default "ShapeCache" in the user cache path)
+ *  - MaxSize: size limit of the directory in MB, least recently used
+ *    entries are removed when exceeded (default 512)
+ */
+class PartExport ShapeCache
+{
+public:
+    static ShapeCache& instance();
+
+    bool isEnabled() const;
+    std::string getDirectory() const;
+
+    /// Compute the cache key of a feature, returns an empty string on failure
+    std::string computeKey(const Feature* feature) const;
+    /// Restore the shapes of \c feature from the entry \c key, returns true on success
+    bool restore(Feature* feature, const std::string& key);
+    /// Store the shapes of \c feature as entry \c key
+    void store(const Feature* feature, const std::string& key);
+
+    /// Remove all entries
+    void clear();
+    /// Remove least recently used entries until the directory is within its size limit
+    void prune();
+
+    ShapeCache(const ShapeCache&) = delete;
+    ShapeCache(ShapeCache&&) = delete;
+    ShapeCache& operator=(const ShapeCache&) = delete;
+    ShapeCache& operator=(ShapeCache&&) = delete;
+
+private:
+    ShapeCache() = default;
+    ~ShapeCache() = default;
+
+    std::string getEntryPath(const std::string& key) const;
+
+private:
+    std::mutex mutex;
+    std::atomic<unsigned> storeCount {0};
+};
+
+}  // namespace Part
+
+#endif  // PART_SHAPECACHE_H
@@ -25,6 +25,7 @@
 
 #include <iosfwd>
 #include <list>
+#include <memory>
 #include <unordered_map>
 
 #include <App/ComplexGeoData.h>
@@ -44,6 +45,7 @@
 #include <BRepTools_ReShape.hxx>
 #include <ShapeFix_Root.hxx>
 
+class BRepAlgoAPI_BooleanOperation;
 class gp_Ax1;
 class gp_Ax2;
 class gp_Pln;
@@ -1430,6 +1432,56 @@ public:
         return TopoShape(0, Hasher).makeElementCut({*this, source}, op, tol);
     }
 
+    /** Make a fusion of input shapes by clusters
+     *
+     * The shapes are grouped into clusters of shapes whose bounding boxes
+     * overlap. The clusters are fused independently and in parallel and the
+     * result is a flat compound of the parts of the fused clusters, which has
+     * the same structure as the result of makeElementFuse() but is much faster to
+     * compute for many disjoint or loosely overlapping shapes. Unlike makeElementFuse(), a
+     * compound is not expanded but used as one argument.
+     *
+     * @param sources: the source shapes
+     * @param op: optional string to be encoded into topo naming for indicating
+     *            the operation
+     * @param tol: tolerance for the fusion
+     * @param makers: optional output of the boolean operation that fused each
+     *                source shape, or null if the source shape does not
+     *                overlap any other shape and is copied unchanged
+     *
+     * @return The original content of this TopoShape is discarded and replaced
+     *         with the new shape. The function returns the TopoShape itself as
+     *         a self reference so that multiple operations can be carried out
+     *         for the same shape in the same line of code.
+     */
+    TopoShape& makeElementClusteredFuse(
+        const std::vector<TopoShape>& sources,
+        const char* op = nullptr,
+        double tol = -1.0,
+        std::vector<std::shared_ptr<BRepAlgoAPI_BooleanOperation>>* makers = nullptr);
+
+    /** Make a boolean cut of the first input shape by clusters
+     *
+     * The first shape and the tools are expanded if they are compounds. Each
+     * part of the first shape is cut independently and in parallel by the
+     * tools whose bounding boxes overlap its own, the result is a flat
+     * compound of the cut parts. This is much faster than makeElementCut() when a
+     * compound of many shapes is cut by many small tools.
+     *
+     * @param sources: the source shapes, the first one is cut by the others
+     * @param op: optional string to be encoded into topo naming for indicating
+     *            the operation
+     * @param tol: tolerance for the cut
+     *
+     * @return The original content of this TopoShape is discarded and replaced
+     *         with the new shape. The function returns the TopoShape itself as
+     *         a self reference so that multiple operations can be carried out
+     *         for the same shape in the same line of code.
+     */
+    TopoShape& makeElementClusteredCut(const std::vector<TopoShape>& sources,
+                                       const char* op = nullptr,
+                                       double tol = -1.0);
+
     /** Try to simplify geometry of any linear/planar subshape to line/plane
      *
      * @return Return true if the shape is modified
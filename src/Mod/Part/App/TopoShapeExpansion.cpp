@@ -25,9 +25,12 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <numeric>
 
+#include <Bnd_Box.hxx>
 #include <BRepAdaptor_Curve.hxx>
 #include <BRepAdaptor_CompCurve.hxx>
 #if OCC_VERSION_HEX < 0x070600
@@ -35,6 +38,7 @@
 #include <BRepAdaptor_HCompCurve.hxx>
 #endif
 
+#include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_MakeWire.hxx>
 #include <BRepCheck_Analyzer.hxx>
 #include <BRepFill.hxx>
@@ -76,6 +80,7 @@
 #include <ShapeConstruct_Curve.hxx>
 #include <ShapeUpgrade_ShellSewing.hxx>
 #include <TopTools_HSequenceOfShape.hxx>
+#include <TopoDS_Iterator.hxx>
 #include <ShapeFix_Shape.hxx>
 #include <ShapeFix_ShapeTolerance.hxx>
 #include <gp_Pln.hxx>
@@ -93,6 +98,7 @@
 #include "TopoShapeCache.h"
 #include "TopoShapeMapper.h"
 #include "FaceMaker.h"
+#include "FuzzyHelper.h"
 #include "Geometry.h"
 #include "BRepOffsetAPI_MakeOffsetFix.h"
 #include "Base/BoundBox.h"
@@ -5838,6 +5844,270 @@ TopoShape& TopoShape::makeElementBoolean(const char* maker,
     return *this;
 }
 
+// Groups the given boxes into clusters of boxes that overlap directly or through other boxes
+// of the cluster. The clusters are ordered by their first box and list the box indices in
+// increasing order.
+static std::vector<std::vector<int>> findBoxClusters(const std::vector<Bnd_Box>& boxes)
+{
+    int count = static_cast<int>(boxes.size());
+    std::vector<int> parent(count);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto findRoot = [&parent](int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    // sweep along x so that only boxes whose x ranges overlap are compared
+    std::vector<int> order;
+    order.reserve(count);
+    for (int i = 0; i < count; i++) {
+        if (!boxes[i].IsVoid()) {
+            order.push_back(i);
+        }
+    }
+    auto xMin = [&boxes](int i) {
+        return boxes[i].CornerMin().X();
+    };
+    std::sort(order.begin(), order.end(), [&xMin](int a, int b) {
+        return xMin(a) < xMin(b);
+    });
+    std::vector<int> active;
+    for (int i : order) {
+        double x = xMin(i);
+        active.erase(std::remove_if(active.begin(),
+                                    active.end(),
+                                    [&boxes, x](int j) {
+                                        return boxes[j].CornerMax().X() < x;
+                                    }),
+                     active.end());
+        for (int j : active) {
+            if (!boxes[i].IsOut(boxes[j])) {
+                parent[findRoot(i)] = findRoot(j);
+            }
+        }
+        active.push_back(i);
+    }
+
+    std::vector<std::vector<int>> clusters;
+    std::vector<int> clusterOfRoot(count, -1);
+    for (int i = 0; i < count; i++) {
+        int& cluster = clusterOfRoot[findRoot(i)];
+        if (cluster < 0) {
+            cluster = static_cast<int>(clusters.size());
+            clusters.emplace_back();
+        }
+        clusters[cluster].push_back(i);
+    }
+    return clusters;
+}
+
+// Returns the bounding boxes of the shapes enlarged by the fuzzy value that a boolean
+// operation of all shapes would use with the given tolerance.
+static std::vector<Bnd_Box> getBooleanBoxes(const std::vector<TopoShape>& shapes,
+                                            double tolerance,
+                                            double& fuzzy)
+{
+    std::vector<Bnd_Box> boxes(shapes.size());
+    Bnd_Box bounds;
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        BRepBndLib::Add(shapes[i].getShape(), boxes[i]);
+        bounds.Add(boxes[i]);
+    }
+    fuzzy = 0.0;
+    if (tolerance > 0.0) {
+        fuzzy = tolerance;
+    }
+    else if (tolerance < 0.0 && !bounds.IsVoid()) {
+        // same value as FCBRepAlgoAPIHelper::setAutoFuzzy()
+        fuzzy = FuzzyHelper::getBooleanFuzzy() * sqrt(bounds.SquareExtent())
+            * Precision::Confusion();
+    }
+    for (auto& box : boxes) {
+        box.Enlarge(std::max(fuzzy, Precision::Confusion()));
+    }
+    return boxes;
+}
+
+// Runs one boolean operation per cluster in parallel. The first shape of a cluster is the
+// argument, the others are the tools. No operation is made for a cluster with a single shape.
+static std::vector<std::shared_ptr<BRepAlgoAPI_BooleanOperation>>
+buildClusters(const char* maker,
+              const std::vector<TopoShape>& shapes,
+              const std::vector<std::vector<int>>& clusters,
+              double fuzzy)
+{
+    std::vector<std::shared_ptr<BRepAlgoAPI_BooleanOperation>> makers(clusters.size());
+    for (std::size_t i = 0; i < clusters.size(); i++) {
+        const auto& cluster = clusters[i];
+        if (cluster.size() < 2) {
+            continue;
+        }
+        std::shared_ptr<BRepAlgoAPI_BooleanOperation> mk;
+        if (strcmp(maker, Part::OpCodes::Fuse) == 0) {
+            mk = std::make_shared<FCBRepAlgoAPI_Fuse>();
+        }
+        else {
+            mk = std::make_shared<FCBRepAlgoAPI_Cut>();
+        }
+        TopTools_ListOfShape shapeArguments, shapeTools;
+        shapeArguments.Append(shapes[cluster.front()].getShape());
+        for (auto it = cluster.begin() + 1; it != cluster.end(); ++it) {
+            shapeTools.Append(shapes[*it].getShape());
+        }
+        mk->SetArguments(shapeArguments);
+        mk->SetTools(shapeTools);
+        mk->SetFuzzyValue(fuzzy);
+        makers[i] = mk;
+    }
+
+    std::vector<std::string> errors(makers.size());
+    OSD_Parallel::For(
+        0,
+        static_cast<int>(makers.size()),
+        [&](int i) {
+            if (!makers[i]) {
+                return;
+            }
+            try {
+                makers[i]->Build();
+            }
+            catch (const Standard_Failure& e) {
+                errors[i] = e.GetMessageString();
+            }
+        },
+        makers.size() < 2);
+
+    for (std::size_t i = 0; i < makers.size(); i++) {
+        if (!errors[i].empty()) {
+            FC_THROWM(Base::CADKernelError, "Boolean operation failed: " << errors[i]);
+        }
+        if (makers[i] && !makers[i]->IsDone()) {
+            FC_THROWM(Base::CADKernelError, "Boolean operation failed");
+        }
+    }
+    if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
+        FC_THROWM(Base::CADKernelError, "User aborted");
+    }
+    return makers;
+}
+
+TopoShape& TopoShape::makeElementClusteredFuse(
+    const std::vector<TopoShape>& shapes,
+    const char* op,
+    double tolerance,
+    std::vector<std::shared_ptr<BRepAlgoAPI_BooleanOperation>>* makers)
+{
+    if (!op) {
+        op = Part::OpCodes::Fuse;
+    }
+    if (shapes.empty()) {
+        FC_THROWM(NullShapeException, "Null shape");
+    }
+    for (const auto& shape : shapes) {
+        if (shape.isNull()) {
+            FC_THROWM(NullShapeException, "Null input shape");
+        }
+    }
+    if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
+        FC_THROWM(Base::CADKernelError, "User aborted");
+    }
+
+    double fuzzy {};
+    auto clusters = findBoxClusters(getBooleanBoxes(shapes, tolerance, fuzzy));
+    auto clusterMakers = buildClusters(Part::OpCodes::Fuse, shapes, clusters, fuzzy);
+    FC_LOG("fuse " << shapes.size() << " shapes in " << clusters.size() << " clusters");
+
+    // The result of a cluster is a compound itself. It is expanded, so that the result is a flat
+    // compound like the one of a single boolean operation.
+    std::vector<TopoShape> results;
+    results.reserve(clusters.size());
+    if (makers) {
+        makers->assign(shapes.size(), nullptr);
+    }
+    for (std::size_t i = 0; i < clusters.size(); i++) {
+        const auto& cluster = clusters[i];
+        if (makers) {
+            for (int index : cluster) {
+                (*makers)[index] = clusterMakers[i];
+            }
+        }
+        if (!clusterMakers[i]) {
+            expandCompound(shapes[cluster.front()], results);
+            continue;
+        }
+        std::vector<TopoShape> inputs;
+        inputs.reserve(cluster.size());
+        for (int index : cluster) {
+            inputs.push_back(shapes[index]);
+        }
+        expandCompound(TopoShape(0, Hasher).makeElementShape(*clusterMakers[i], inputs, op),
+                       results);
+    }
+    return makeElementCompound(results, nullptr, SingleShapeCompoundCreationPolicy::forceCompound);
+}
+
+TopoShape& TopoShape::makeElementClusteredCut(const std::vector<TopoShape>& shapes,
+                                              const char* op,
+                                              double tolerance)
+{
+    if (!op) {
+        op = Part::OpCodes::Cut;
+    }
+    if (shapes.empty()) {
+        FC_THROWM(NullShapeException, "Null shape");
+    }
+    if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
+        FC_THROWM(Base::CADKernelError, "User aborted");
+    }
+
+    // the parts of the base shape and the tools are all expanded, each part is cut only by the
+    // tools that overlap it
+    std::vector<TopoShape> inputs;
+    expandCompound(shapes.front(), inputs);
+    std::size_t partCount = inputs.size();
+    for (auto it = shapes.begin() + 1; it != shapes.end(); ++it) {
+        expandCompound(*it, inputs);
+    }
+
+    double fuzzy {};
+    auto boxes = getBooleanBoxes(inputs, tolerance, fuzzy);
+    std::vector<std::vector<int>> clusters(partCount);
+    for (std::size_t i = 0; i < partCount; i++) {
+        clusters[i].push_back(static_cast<int>(i));
+        for (std::size_t j = partCount; j < inputs.size(); j++) {
+            if (!boxes[i].IsOut(boxes[j])) {
+                clusters[i].push_back(static_cast<int>(j));
+            }
+        }
+    }
+    auto clusterMakers = buildClusters(Part::OpCodes::Cut, inputs, clusters, fuzzy);
+
+    // expanded like the results of makeElementClusteredFuse()
+    std::vector<TopoShape> results;
+    results.reserve(partCount);
+    for (std::size_t i = 0; i < partCount; i++) {
+        if (!clusterMakers[i]) {
+            results.push_back(inputs[i]);
+            continue;
+        }
+        std::vector<TopoShape> clusterInputs;
+        clusterInputs.reserve(clusters[i].size());
+        for (int index : clusters[i]) {
+            clusterInputs.push_back(inputs[index]);
+        }
+        TopoShape result(0, Hasher);
+        result.makeElementShape(*clusterMakers[i], clusterInputs, op);
+        // drop parts that are cut away completely
+        if (!result.isNull() && TopoDS_Iterator(result.getShape()).More()) {
+            expandCompound(result, results);
+        }
+    }
+    return makeElementCompound(results, nullptr, SingleShapeCompoundCreationPolicy::forceCompound);
+}
+
 bool TopoShape::isSame(const Data::ComplexGeoData& _other) const
 {
     if (!_other.isDerivedFrom<TopoShape>()) {
@@ -24,8 +24,11 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <limits>
+# include <map>
 # include <numbers>
 # include <iterator>
+# include <set>
 # include <Bnd_Box.hxx>
 # include <BRep_Builder.hxx>
 # include <BRep_Tool.hxx>
@@ -65,9 +68,13 @@
 # include <TopTools_DataMapIteratorOfDataMapOfIntegerListOfShape.hxx>
 # include <TopTools_DataMapIteratorOfDataMapOfShapeShape.hxx>
 # include <TopTools_ListIteratorOfListOfShape.hxx>
+# include <TopTools_DataMapOfShapeInteger.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
 # include <TopTools_ListOfShape.hxx>
 #endif // _PreComp_
 
+#include <OSD_Parallel.hxx>
+
 #include <Base/Console.h>
 
 #include "modelRefine.h"
@@ -75,6 +82,8 @@
 
 using namespace ModelRefine;
 
+FC_LOG_LEVEL_INIT("ModelRefine", true, true)
+
 
 void ModelRefine::getFaceEdges(const TopoDS_Face &face, EdgeVectorType &edges)
 {
@@ -86,7 +95,11 @@ void ModelRefine::getFaceEdges(const TopoDS_Face &face, EdgeVectorType &edges)
 void ModelRefine::boundaryEdges(const FaceVectorType &faces, EdgeVectorType &edgesOut)
 {
     //this finds all the boundary edges. Maybe more than one boundary.
-    std::list<TopoDS_Edge> edges;
+    //an edge that is found a second time is an inner edge and removed again. The position of
+    //the edges is kept in a map so that large groups of faces don't need a linear search.
+    EdgeVectorType edges;
+    std::vector<bool> boundary;
+    TopTools_DataMapOfShapeInteger position;
     FaceVectorType::const_iterator faceIt;
     for (faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
     {
@@ -95,24 +108,26 @@ void ModelRefine::boundaryEdges(const FaceVectorType &faces, EdgeVectorType &edg
         getFaceEdges(*faceIt, faceEdges);
         for (faceEdgesIt = faceEdges.begin(); faceEdgesIt != faceEdges.end(); ++faceEdgesIt)
         {
-            bool foundSignal(false);
-            std::list<TopoDS_Edge>::iterator edgesIt;
-            for (edgesIt = edges.begin(); edgesIt != edges.end(); ++edgesIt)
+            if (position.IsBound(*faceEdgesIt))
             {
-                if ((*edgesIt).IsSame(*faceEdgesIt))
-                {
-                    edgesIt = edges.erase(edgesIt);
-                    foundSignal = true;
-                    break;
-                }
+                boundary[position.Find(*faceEdgesIt)] = false;
+                position.UnBind(*faceEdgesIt);
             }
-            if (!foundSignal)
+            else
+            {
+                position.Bind(*faceEdgesIt, static_cast<Standard_Integer>(edges.size()));
                 edges.push_back(*faceEdgesIt);
+                boundary.push_back(true);
+            }
         }
     }
 
-    edgesOut.reserve(edges.size());
-    std::copy(edges.begin(), edges.end(), back_inserter(edgesOut));
+    edgesOut.reserve(position.Extent());
+    for (std::size_t index = 0; index < edges.size(); ++index)
+    {
+        if (boundary[index])
+            edgesOut.push_back(edges[index]);
+    }
 }
 
 TopoDS_Shell ModelRefine::removeFaces(const TopoDS_Shell &shell, const FaceVectorType &faces)
@@ -222,7 +237,7 @@ void FaceAdjacencySplitter::split(const FaceVectorType &facesIn)
 
         tempFaces.clear();
         processedMap.Add(*it);
-        recursiveFind(*it, tempFaces);
+        findAdjacent(*it, tempFaces);
         if (tempFaces.size() > 1)
         {
             adjacencyArray.push_back(tempFaces);
@@ -230,25 +245,52 @@ void FaceAdjacencySplitter::split(const FaceVectorType &facesIn)
     }
 }
 
-void FaceAdjacencySplitter::recursiveFind(const TopoDS_Face &face, FaceVectorType &outVector)
+void FaceAdjacencySplitter::findAdjacent(const TopoDS_Face &face, FaceVectorType &outVector)
 {
-    outVector.push_back(face);
-
-    const TopTools_ListOfShape &edges = faceToEdgeMap.FindFromKey(face);
-    TopTools_ListIteratorOfListOfShape edgeIt;
-    for (edgeIt.Initialize(edges); edgeIt.More(); edgeIt.Next())
+    //depth first search with an explicit stack because a recursion overflows the call stack
+    //for groups with many faces.
+    struct Frame
     {
-        const TopTools_ListOfShape &faces = edgeToFaceMap.FindFromKey(edgeIt.Value());
+        TopTools_ListIteratorOfListOfShape edgeIt;
         TopTools_ListIteratorOfListOfShape faceIt;
-        for (faceIt.Initialize(faces); faceIt.More(); faceIt.Next())
+    };
+    std::vector<Frame> stack;
+
+    auto visit = [&](const TopoDS_Face &current)
+    {
+        outVector.push_back(current);
+        Frame frame;
+        frame.edgeIt.Initialize(faceToEdgeMap.FindFromKey(current));
+        if (frame.edgeIt.More())
+            frame.faceIt.Initialize(edgeToFaceMap.FindFromKey(frame.edgeIt.Value()));
+        stack.push_back(frame);
+    };
+
+    visit(face);
+    while (!stack.empty())
+    {
+        Frame &frame = stack.back();
+        if (!frame.edgeIt.More())
         {
-            if (!facesInMap.Contains(faceIt.Value()))
-                continue;
-            if (processedMap.Contains(faceIt.Value()))
-                continue;
-            processedMap.Add(faceIt.Value());
-            recursiveFind(TopoDS::Face(faceIt.Value()), outVector);
+            stack.pop_back();
+            continue;
         }
+        if (!frame.faceIt.More())
+        {
+            frame.edgeIt.Next();
+            if (frame.edgeIt.More())
+                frame.faceIt.Initialize(edgeToFaceMap.FindFromKey(frame.edgeIt.Value()));
+            continue;
+        }
+
+        const TopoDS_Shape &adjacent = frame.faceIt.Value();
+        frame.faceIt.Next();
+        if (!facesInMap.Contains(adjacent))
+            continue;
+        if (processedMap.Contains(adjacent))
+            continue;
+        processedMap.Add(adjacent);
+        visit(TopoDS::Face(adjacent));
     }
 }
 
@@ -256,28 +298,57 @@ void FaceAdjacencySplitter::recursiveFind(const TopoDS_Face &face, FaceVectorTyp
 
 void FaceEqualitySplitter::split(const FaceVectorType &faces, FaceTypedBase *object)
 {
+    //the keys only depend on the surface of each face and are computed in parallel.
+    const int faceCount = static_cast<int>(faces.size());
+    std::vector<double> keys(faces.size());
+    std::vector<double> tolerances(faces.size());
+    std::vector<char> hasKey(faces.size());
+    OSD_Parallel::For(0, faceCount, [&](int index) {
+        hasKey[index] = object->getKey(faces[index], keys[index], tolerances[index]);
+    }, faceCount < 2);
+
+    double maxTolerance = 0.0;
+    for (std::size_t index = 0; index < faces.size(); ++index)
+    {
+        if (hasKey[index])
+            maxTolerance = std::max(maxTolerance, tolerances[index]);
+    }
+
+    //a face is added to the first group whose front face is equal. Only the groups with a key
+    //close to the one of the face need to be checked.
     std::vector<FaceVectorType> tempVector;
-    tempVector.reserve(faces.size());
-    FaceVectorType::const_iterator faceIt;
-    for (faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
+    std::multimap<double, std::size_t> groupKeys;
+    std::vector<std::size_t> candidates;
+    for (std::size_t index = 0; index < faces.size(); ++index)
     {
-        bool foundMatch(false);
-        std::vector<FaceVectorType>::iterator tempIt;
-        for (tempIt = tempVector.begin(); tempIt != tempVector.end(); ++tempIt)
+        const TopoDS_Face &face = faces[index];
+        std::size_t match = tempVector.size();
+        if (hasKey[index])
         {
-            if (object->isEqual((*tempIt).front(), *faceIt))
+            candidates.clear();
+            auto it = groupKeys.lower_bound(keys[index] - 2.0 * maxTolerance);
+            auto end = groupKeys.upper_bound(keys[index] + 2.0 * maxTolerance);
+            for (; it != end; ++it)
+                candidates.push_back(it->second);
+            std::sort(candidates.begin(), candidates.end());
+            for (std::size_t group : candidates)
             {
-                (*tempIt).push_back(*faceIt);
-                foundMatch = true;
-                break;
+                if (object->isEqual(tempVector[group].front(), face))
+                {
+                    match = group;
+                    break;
+                }
             }
         }
-        if (!foundMatch)
+        if (match < tempVector.size())
+        {
+            tempVector[match].push_back(face);
+        }
+        else
         {
-            FaceVectorType another;
-            another.reserve(faces.size());
-            another.push_back(*faceIt);
-            tempVector.push_back(another);
+            if (hasKey[index])
+                groupKeys.emplace(keys[index], tempVector.size());
+            tempVector.emplace_back(1, face);
         }
     }
     std::vector<FaceVectorType>::iterator it;
@@ -298,46 +369,67 @@ GeomAbs_SurfaceType FaceTypedBase::getFaceType(const TopoDS_Face &faceIn)
     return surfaceTest.GetType();
 }
 
+bool FaceTypedBase::getKey(const TopoDS_Face &, double &key, double &tolerance) const
+{
+    //without a better criterion all faces have to be compared with each other
+    key = 0.0;
+    tolerance = std::numeric_limits<double>::infinity();
+    return true;
+}
+
 void FaceTypedBase::boundarySplit(const FaceVectorType &facesIn, std::vector<EdgeVectorType> &boundariesOut) const
 {
     EdgeVectorType bEdges;
     boundaryEdges(facesIn, bEdges);
 
-    std::list<TopoDS_Edge> edges;
-    std::copy(bEdges.begin(), bEdges.end(), back_inserter(edges));
+    //the remaining edges by the index of their first vertex. The edges are always taken in the
+    //order of bEdges.
+    TopTools_IndexedMapOfShape vertices;
+    std::vector<int> firstVertex(bEdges.size());
+    std::vector<int> lastVertex(bEdges.size());
+    for (std::size_t index = 0; index < bEdges.size(); ++index)
+    {
+        firstVertex[index] = vertices.Add(TopExp::FirstVertex(bEdges[index], Standard_True));
+        lastVertex[index] = vertices.Add(TopExp::LastVertex(bEdges[index], Standard_True));
+    }
+    std::vector<std::set<std::size_t>> edgesFrom(vertices.Extent() + 1);
+    std::set<std::size_t> edges;
+    for (std::size_t index = 0; index < bEdges.size(); ++index)
+    {
+        edgesFrom[firstVertex[index]].insert(index);
+        edges.insert(edges.end(), index);
+    }
+
     while(!edges.empty())
     {
-        TopoDS_Vertex destination = TopExp::FirstVertex(edges.front(), Standard_True);
-        TopoDS_Vertex lastVertex = TopExp::LastVertex(edges.front(), Standard_True);
+        std::size_t front = *edges.begin();
+        edges.erase(edges.begin());
+        edgesFrom[firstVertex[front]].erase(front);
+
+        int destination = firstVertex[front];
+        int currentVertex = lastVertex[front];
         EdgeVectorType boundary;
-        boundary.push_back(edges.front());
-        edges.pop_front();
+        boundary.push_back(bEdges[front]);
         //single edge closed check.
-        if (destination.IsSame(lastVertex))
+        if (destination == currentVertex)
         {
             boundariesOut.push_back(boundary);
             continue;
         }
 
         bool closedSignal(false);
-        std::list<TopoDS_Edge>::iterator it;
-        for (it = edges.begin(); it != edges.end();)
+        while (!edgesFrom[currentVertex].empty())
         {
-            TopoDS_Vertex currentVertex = TopExp::FirstVertex(*it, Standard_True);
-            if (lastVertex.IsSame(currentVertex))
+            std::size_t next = *edgesFrom[currentVertex].begin();
+            edgesFrom[currentVertex].erase(edgesFrom[currentVertex].begin());
+            edges.erase(next);
+            boundary.push_back(bEdges[next]);
+            currentVertex = lastVertex[next];
+            if (currentVertex == destination)
             {
-                boundary.push_back(*it);
-                lastVertex = TopExp::LastVertex(*it, Standard_True);
-                edges.erase(it);
-                it = edges.begin();
-                if (lastVertex.IsSame(destination))
-                {
-                    closedSignal = true;
-                    break;
-                }
-                continue;
+                closedSignal = true;
+                break;
             }
-            ++it;
         }
         if (closedSignal)
             boundariesOut.push_back(boundary);
@@ -382,6 +474,21 @@ bool FaceTypedPlane::isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &face
             planeOne.Distance(planeTwo.Position().Location()) < Precision::Confusion());
 }
 
+bool FaceTypedPlane::getKey(const TopoDS_Face &face, double &key, double &tolerance) const
+{
+    Handle(Geom_Plane) planeSurface = getGeomPlane(face);
+    if (planeSurface.IsNull())
+        return false;
+
+    //the distance of the plane to the origin. The angular tolerance of isEqual() allows a
+    //difference that grows with the distance of the location of the plane.
+    gp_Pln plane(planeSurface->Pln());
+    gp_XYZ location = plane.Position().Location().XYZ();
+    key = std::fabs(plane.Position().Direction().XYZ().Dot(location));
+    tolerance = Precision::Confusion() * (1.0 + location.Modulus());
+    return true;
+}
+
 GeomAbs_SurfaceType FaceTypedPlane::getType() const
 {
     return GeomAbs_Plane;
@@ -478,6 +585,17 @@ bool FaceTypedCylinder::isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &f
     return true;
 }
 
+bool FaceTypedCylinder::getKey(const TopoDS_Face &face, double &key, double &tolerance) const
+{
+    Handle(Geom_CylindricalSurface) surface = getGeomCylinder(face);
+    if (surface.IsNull())
+        return false;
+
+    key = surface->Radius();
+    tolerance = Precision::Confusion();
+    return true;
+}
+
 GeomAbs_SurfaceType FaceTypedCylinder::getType() const
 {
     return GeomAbs_Cylinder;
@@ -1170,18 +1288,29 @@ bool FaceUniter::process()
             }
         }
         // update the list of modifications
+        // the modifications are indexed by the new face to avoid a linear search for each face
+        TopTools_IndexedMapOfShape newFaces;
+        std::vector<std::vector<std::size_t>> newFaceModifications(1);
+        for (std::size_t index = 0; index < modifiedShapes.size(); ++index)
+        {
+            int newFaceIndex = newFaces.Add(modifiedShapes[index].second);
+            if (newFaceIndex >= static_cast<int>(newFaceModifications.size()))
+                newFaceModifications.resize(newFaceIndex + 1);
+            newFaceModifications[newFaceIndex].push_back(index);
+        }
+
         TopTools_DataMapOfShapeShape faceMap;
         edgeFuse.Faces(faceMap);
         for (mapIt.Initialize(faceMap); mapIt.More(); mapIt.Next())
         {
             bool isModifiedFace = false;
-            for (auto & it : modifiedShapes)
+            // Note: IsEqual() for some reason does not work, the map uses IsSame()
+            int newFaceIndex = newFaces.FindIndex(mapIt.Key());
+            if (newFaceIndex > 0)
             {
-                if (mapIt.Key().IsSame(it.second)) {
-                    // Note: IsEqual() for some reason does not work
-                    it.second = mapIt.Value();
-                    isModifiedFace = true;
-                }
+                for (std::size_t index : newFaceModifications[newFaceIndex])
+                    modifiedShapes[index].second = mapIt.Value();
+                isModifiedFace = true;
             }
             if (!isModifiedFace)
             {
@@ -1232,6 +1361,11 @@ void Part::BRepBuilderAPI_RefineModel::Build()
     if (myShape.IsNull())
         Standard_Failure::Raise("Cannot remove splitter from empty shape");
 
+    FC_TIME_INIT(t);
+    TopTools_IndexedMapOfShape facesBefore;
+    if (FC_LOG_INSTANCE.isEnabled(FC_LOGLEVEL_LOG))
+        TopExp::MapShapes(myShape, TopAbs_FACE, facesBefore);
+
     if (myShape.ShapeType() == TopAbs_SOLID) {
         const TopoDS_Solid &solid = TopoDS::Solid(myShape);
         BRepBuilderAPI_MakeSolid mkSolid;
@@ -1321,6 +1455,13 @@ void Part::BRepBuilderAPI_RefineModel::Build()
         myShape = comp;
     }
 
+    if (FC_LOG_INSTANCE.isEnabled(FC_LOGLEVEL_LOG)) {
+        TopTools_IndexedMapOfShape facesAfter;
+        TopExp::MapShapes(myShape, TopAbs_FACE, facesAfter);
+        FC_TIME_LOG(t, "Refine " << facesBefore.Extent() << " -> " << facesAfter.Extent()
+                    << " faces");
+    }
+
     Done();
 }
 
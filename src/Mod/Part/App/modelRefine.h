@@ -64,6 +64,11 @@ namespace ModelRefine
         virtual GeomAbs_SurfaceType getType() const = 0;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const = 0;
 
+        /** Computes a value that is close for equal faces: if isEqual() returns true for two
+         * faces their keys differ by at most the larger of their tolerances. Returns false if
+         * the face is not equal to any other face. */
+        virtual bool getKey(const TopoDS_Face &face, double &key, double &tolerance) const;
+
         static GeomAbs_SurfaceType getFaceType(const TopoDS_Face &faceIn);
 
     protected:
@@ -77,6 +82,7 @@ namespace ModelRefine
         FaceTypedPlane();
     public:
         bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const override;
+        bool getKey(const TopoDS_Face &face, double &key, double &tolerance) const override;
         GeomAbs_SurfaceType getType() const override;
         TopoDS_Face buildFace(const FaceVectorType &faces) const override;
         friend FaceTypedPlane& getPlaneObject();
@@ -89,6 +95,7 @@ namespace ModelRefine
         FaceTypedCylinder();
     public:
         bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const override;
+        bool getKey(const TopoDS_Face &face, double &key, double &tolerance) const override;
         GeomAbs_SurfaceType getType() const override;
         TopoDS_Face buildFace(const FaceVectorType &faces) const override;
         friend FaceTypedCylinder& getCylinderObject();
@@ -135,7 +142,7 @@ namespace ModelRefine
 
     private:
         FaceAdjacencySplitter() = default;
-        void recursiveFind(const TopoDS_Face &face, FaceVectorType &outVector);
+        void findAdjacent(const TopoDS_Face &face, FaceVectorType &outVector);
         std::vector<FaceVectorType> adjacencyArray;
         TopTools_MapOfShape processedMap;
         TopTools_MapOfShape facesInMap;
@@ -0,0 +1,331 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <Inventor/nodes/SoCoordinate3.h>
+# include <Inventor/nodes/SoNormal.h>
+#endif
+
+#include <boost/functional/hash.hpp>
+
+#include <App/Application.h>
+#include <Mod/Part/App/TopoShape.h>
+
+#include "TessellationCache.h"
+#include "SoBrepEdgeSet.h"
+#include "SoBrepFaceSet.h"
+#include "SoBrepPointSet.h"
+
+
+using namespace PartGui;
+
+namespace {
+
+constexpr const char* cacheSizeParameter = "TessellationCacheSize";
+
+template<typename Field, typename Value>
+void copyFromField(const Field& field, std::vector<Value>& values)
+{
+    const Value* data = field.getValues(0);
+    values.assign(data, data + field.getNum());
+}
+
+template<typename Field, typename Value>
+void shareWithField(const std::vector<Value>& values, Field& field)
+{
+    // the field doesn't copy the values and doesn't free them, see release()
+    if (values.empty()) {
+        field.setNum(0);
+    }
+    else {
+        field.setValuesPointer(static_cast<int>(values.size()), values.data());
+    }
+}
+
+std::size_t readMaxMemSize(const ParameterGrp::handle& hGrp)
+{
+    long megaBytes = hGrp->GetInt(cacheSizeParameter, 256);
+    return static_cast<std::size_t>(std::max(megaBytes, 0L)) * 1024 * 1024;
+}
+
+}  // namespace
+
+std::size_t TessellationCache::Tessellation::memSize() const
+{
+    return sizeof(SbVec3f) * (points.size() + normals.size())
+        + sizeof(int32_t) * (faceIndex.size() + partIndex.size() + lineIndex.size());
+}
+
+TessellationCache& TessellationCache::instance()
+{
+    static TessellationCache cache;
+    return cache;
+}
+
+TessellationCache::TessellationCache()
+{
+    hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part");
+    maxBytes = readMaxMemSize(hGrp);
+    hGrp->Attach(this);
+
+    // the shapes of a closed document are only referenced by the cache any more
+    connectDeletedDocument = App::GetApplication().signalDeletedDocument.connect([this]() {
+        prune();
+    });
+}
+
+TessellationCache::~TessellationCache()
+{
+    hGrp->Detach(this);
+}
+
+void TessellationCache::OnChange(ParameterGrp::SubjectType& rCaller,
+                                 ParameterGrp::MessageType Reason)
+{
+    (void)rCaller;
+    // an empty name is sent when the whole group is cleared
+    if (!Reason || !*Reason || std::string(cacheSizeParameter) == Reason) {
+        setMaxMemSize(readMaxMemSize(hGrp));
+    }
+}
+
+bool TessellationCache::Key::operator==(const Key& other) const
+{
+    return tshape == other.tshape && orientation == other.orientation
+        && deviation == other.deviation && angularDeflection == other.angularDeflection
+        && normalsFromUV == other.normalsFromUV;
+}
+
+std::size_t TessellationCache::KeyHash::operator()(const Key& key) const
+{
+    std::size_t seed = 0;
+    boost::hash_combine(seed, key.tshape);
+    boost::hash_combine(seed, static_cast<int>(key.orientation));
+    boost::hash_combine(seed, key.deviation);
+    boost::hash_combine(seed, key.angularDeflection);
+    boost::hash_combine(seed, key.normalsFromUV);
+    return seed;
+}
+
+TessellationCache::Key TessellationCache::makeKey(const TopoDS_Shape& shape,
+                                                  double deviation,
+                                                  double angularDeflection,
+                                                  bool normalsFromUV)
+{
+    return {shape.TShape().get(),
+            shape.Orientation(),
+            deviation,
+            angularDeflection,
+            normalsFromUV};
+}
+
+TessellationCache::TessellationPtr TessellationCache::find(const TopoDS_Shape& shape,
+                                                           double deviation,
+                                                           double angularDeflection,
+                                                           bool normalsFromUV)
+{
+    if (shape.IsNull()) {
+        return {};
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(makeKey(shape, deviation, angularDeflection, normalsFromUV));
+    if (it == index.end()) {
+        return {};
+    }
+
+    // move the entry to the front of the list of recently used entries
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->data;
+}
+
+TessellationCache::TessellationPtr TessellationCache::store(const TopoDS_Shape& shape,
+                                                            double deviation,
+                                                            double angularDeflection,
+                                                            bool normalsFromUV,
+                                                            Tessellation&& data)
+{
+    auto result = std::make_shared<const Tessellation>(std::move(data));
+    if (shape.IsNull()) {
+        return result;
+    }
+
+    // the entry keeps the shape alive, so its memory is counted too
+    std::size_t size = result->memSize() + Part::TopoShape(shape).getMemSize();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Key key = makeKey(shape, deviation, angularDeflection, normalsFromUV);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            erase(it->second);
+        }
+
+        removeUnused();
+        if (size <= maxBytes) {
+            shrink(maxBytes - size);
+            entries.push_front({key, shape.TShape(), result, size});
+            index.emplace(key, entries.begin());
+            bytes += size;
+        }
+    }
+
+    // the slots may look up the cache, so it must not be locked any more
+    signalStored(shape, deviation, angularDeflection, normalsFromUV, result);
+    return result;
+}
+
+void TessellationCache::remove(const TopoDS_Shape& shape,
+                               double deviation,
+                               double angularDeflection,
+                               bool normalsFromUV)
+{
+    if (shape.IsNull()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(makeKey(shape, deviation, angularDeflection, normalsFromUV));
+    if (it != index.end()) {
+        erase(it->second);
+    }
+}
+
+void TessellationCache::erase(std::list<Entry>::iterator it)
+{
+    bytes -= it->bytes;
+    index.erase(it->key);
+    entries.erase(it);
+}
+
+void TessellationCache::removeUnused()
+{
+    for (auto it = entries.begin(); it != entries.end();) {
+        auto next = std::next(it);
+        if (it->shape->GetRefCount() <= 1) {
+            erase(it);
+        }
+        it = next;
+    }
+}
+
+void TessellationCache::shrink(std::size_t limit)
+{
+    while (bytes > limit && !entries.empty()) {
+        erase(std::prev(entries.end()));
+    }
+}
+
+void TessellationCache::prune()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    removeUnused();
+}
+
+void TessellationCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    entries.clear();
+    bytes = 0;
+}
+
+std::size_t TessellationCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+std::size_t TessellationCache::memSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return bytes;
+}
+
+std::size_t TessellationCache::maxMemSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxBytes;
+}
+
+void TessellationCache::setMaxMemSize(std::size_t limit)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    maxBytes = limit;
+    shrink(maxBytes);
+}
+
+TessellationCache::Tessellation TessellationCache::read(const SoCoordinate3* coords,
+                                                        const SoBrepFaceSet* faceset,
+                                                        const SoNormal* norm,
+                                                        const SoBrepEdgeSet* lineset,
+                                                        const SoBrepPointSet* nodeset)
+{
+    Tessellation data;
+    copyFromField(coords->point, data.points);
+    copyFromField(norm->vector, data.normals);
+    copyFromField(faceset->coordIndex, data.faceIndex);
+    copyFromField(faceset->partIndex, data.partIndex);
+    copyFromField(lineset->coordIndex, data.lineIndex);
+    data.pointStart = nodeset->startIndex.getValue();
+    return data;
+}
+
+void TessellationCache::apply(const Tessellation& data,
+                              SoCoordinate3* coords,
+                              SoBrepFaceSet* faceset,
+                              SoNormal* norm,
+                              SoBrepEdgeSet* lineset,
+                              SoBrepPointSet* nodeset)
+{
+    shareWithField(data.points, coords->point);
+    shareWithField(data.normals, norm->vector);
+    shareWithField(data.faceIndex, faceset->coordIndex);
+    shareWithField(data.partIndex, faceset->partIndex);
+    shareWithField(data.lineIndex, lineset->coordIndex);
+    nodeset->startIndex.setValue(data.pointStart);
+
+    // the arrays may be at the same addresses as the ones applied before
+    coords->touch();
+    norm->touch();
+    faceset->touch();
+    lineset->touch();
+    nodeset->touch();
+}
+
+void TessellationCache::release(SoCoordinate3* coords,
+                                SoBrepFaceSet* faceset,
+                                SoNormal* norm,
+                                SoBrepEdgeSet* lineset)
+{
+    // Setting the number of values to zero drops a pointer set with setValuesPointer()
+    // without writing to it. Any other change could write into the shared arrays.
+    coords->point.setNum(0);
+    norm->vector.setNum(0);
+    faceset->coordIndex.setNum(0);
+    faceset->partIndex.setNum(0);
+    lineset->coordIndex.setNum(0);
+}
@@ -0,0 +1,207 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef PARTGUI_TESSELLATIONCACHE_H
+#define PARTGUI_TESSELLATIONCACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <boost/signals2/connection.hpp>
+#include <boost/signals2/signal.hpp>
+
+#include <TopAbs_Orientation.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopoDS_TShape.hxx>
+#include <Inventor/SbVec3f.h>
+
+#include <Base/Parameter.h>
+#include <Mod/Part/PartGlobal.h>
+
+class SoCoordinate3;
+class SoNormal;
+
+namespace PartGui {
+
+class SoBrepFaceSet;
+class SoBrepEdgeSet;
+class SoBrepPointSet;
+
+/*!
+ * \brief The TessellationCache class keeps the Coin representation of shapes that have been
+ * displayed before.
+ *
+ * Shapes that share the same TopoDS_TShape, e.g. copies of a shape that only differ in their
+ * placement, have the same representation if they are displayed with the same deviation,
+ * angular deflection and normals mode. The cache is shared by all view providers of all
+ * documents so that such a shape is only tessellated once, and the view providers showing it
+ * share the arrays of the representation with the cache, see apply().
+ *
+ * An entry keeps its TopoDS_TShape alive so that the shape can't be replaced by another one at
+ * the same address. Entries whose shape isn't used anywhere else any more are removed by
+ * prune(), which is done whenever a shape is added and after a document has been closed.
+ * A shape that is modified in place must be removed with remove(). The nodes of other view
+ * providers still use the old arrays then, so they must apply the new representation once it is
+ * stored, see signalStored.
+ *
+ * The least recently used entries are removed when the memory of the cached arrays and shapes
+ * exceeds the limit set with setMaxMemSize(). The limit follows the parameter
+ * TessellationCacheSize (in MB) of the Part preferences, a limit of zero disables the cache.
+ */
+class PartGuiExport TessellationCache: public ParameterGrp::ObserverType
+{
+public:
+    /// The arrays of the Coin nodes representing a shape
+    struct Tessellation
+    {
+        std::vector<SbVec3f> points;
+        std::vector<SbVec3f> normals;
+        std::vector<int32_t> faceIndex;
+        std::vector<int32_t> partIndex;
+        std::vector<int32_t> lineIndex;
+        int32_t pointStart = 0;
+
+        /// Returns the number of bytes used by the arrays.
+        std::size_t memSize() const;
+    };
+    using TessellationPtr = std::shared_ptr<const Tessellation>;
+
+    static TessellationCache& instance();
+    ~TessellationCache() override;
+
+    /*!
+     * \brief Returns the cached representation of \a shape or null if there is none.
+     * The location of the shape is ignored.
+     */
+    TessellationPtr find(const TopoDS_Shape& shape,
+                         double deviation,
+                         double angularDeflection,
+                         bool normalsFromUV);
+    /*!
+     * \brief Adds the representation \a data of \a shape to the cache.
+     * \return the representation, which is also returned if it is too big to be cached.
+     */
+    TessellationPtr store(const TopoDS_Shape& shape,
+                          double deviation,
+                          double angularDeflection,
+                          bool normalsFromUV,
+                          Tessellation&& data);
+    /// Removes the representation of \a shape, e.g. after it has been modified in place.
+    void remove(const TopoDS_Shape& shape,
+                double deviation,
+                double angularDeflection,
+                bool normalsFromUV);
+    /// Removes the entries of shapes that are only referenced by the cache.
+    void prune();
+    /// Removes all entries.
+    void clear();
+
+    /// Returns the number of cached shapes.
+    std::size_t size() const;
+    /// Returns the number of bytes used by the cached arrays and shapes.
+    std::size_t memSize() const;
+    /// Returns the maximum number of bytes used by the cached arrays and shapes.
+    std::size_t maxMemSize() const;
+    /// Sets the maximum number of bytes used by the cached arrays and removes entries if needed.
+    void setMaxMemSize(std::size_t limit);
+
+    /// Copies the arrays of the nodes.
+    static Tessellation read(const SoCoordinate3* coords,
+                             const SoBrepFaceSet* faceset,
+                             const SoNormal* norm,
+                             const SoBrepEdgeSet* lineset,
+                             const SoBrepPointSet* nodeset);
+    /*!
+     * \brief Lets the nodes use the arrays of \a data without copying them.
+     * The caller must keep \a data alive until release() is called for the nodes.
+     */
+    static void apply(const Tessellation& data,
+                      SoCoordinate3* coords,
+                      SoBrepFaceSet* faceset,
+                      SoNormal* norm,
+                      SoBrepEdgeSet* lineset,
+                      SoBrepPointSet* nodeset);
+    /// Empties the nodes so that they no longer use the arrays passed to apply().
+    static void release(SoCoordinate3* coords,
+                        SoBrepFaceSet* faceset,
+                        SoNormal* norm,
+                        SoBrepEdgeSet* lineset);
+
+    void OnChange(ParameterGrp::SubjectType& rCaller, ParameterGrp::MessageType Reason) override;
+
+    /// Signal emitted by store() with the shape, deviation, angular deflection, normals mode and
+    /// the new representation
+    boost::signals2::signal<
+        void(const TopoDS_Shape&, double, double, bool, const TessellationPtr&)>
+        signalStored;
+
+private:
+    TessellationCache();
+
+    struct Key
+    {
+        const TopoDS_TShape* tshape;
+        TopAbs_Orientation orientation;
+        double deviation;
+        double angularDeflection;
+        bool normalsFromUV;
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    struct Entry
+    {
+        Key key;
+        Handle(TopoDS_TShape) shape;
+        TessellationPtr data;
+        std::size_t bytes = 0;
+    };
+
+    static Key makeKey(const TopoDS_Shape& shape,
+                       double deviation,
+                       double angularDeflection,
+                       bool normalsFromUV);
+    void erase(std::list<Entry>::iterator it);
+    void removeUnused();
+    void shrink(std::size_t limit);
+
+private:
+    mutable std::mutex mutex;
+    std::list<Entry> entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    std::size_t bytes = 0;
+    std::size_t maxBytes = 0;
+    ParameterGrp::handle hGrp;
+    boost::signals2::scoped_connection connectDeletedDocument;
+};
+
+}  // namespace PartGui
+
+#endif  // PARTGUI_TESSELLATIONCACHE_H
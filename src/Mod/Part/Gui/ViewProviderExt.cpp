@@ -70,6 +70,8 @@
 # include <boost/algorithm/string/predicate.hpp>
 #endif
 
+#include <OSD_Parallel.hxx>
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <Base/Console.h>
@@ -93,6 +95,7 @@
 #include "SoBrepFaceSet.h"
 #include "SoBrepPointSet.h"
 #include "TaskFaceAppearances.h"
+#include "TessellationCache.h"
 
 
 FC_LOG_LEVEL_INIT("Part", true, true)
@@ -242,6 +245,15 @@ ViewProviderPartExt::ViewProviderPartExt()
 
     sPixmap = "Part_3D_object";
     loadParameter();
+
+    connectTessellationStored = TessellationCache::instance().signalStored.connect(
+        [this](const TopoDS_Shape& shape,
+               double deviation,
+               double angularDeflection,
+               bool normalsFromUV,
+               const TessellationCache::TessellationPtr& data) {
+            onTessellationStored(shape, deviation, angularDeflection, normalsFromUV, data);
+        });
 }
 
 ViewProviderPartExt::~ViewProviderPartExt()
@@ -254,6 +266,9 @@ ViewProviderPartExt::~ViewProviderPartExt()
     pcLineStyle->unref();
     pcPointStyle->unref();
     pShapeHints->unref();
+    connectTessellationStored.disconnect();
+    // the nodes may be used elsewhere, e.g. by a link, but not the arrays of the cache
+    TessellationCache::release(coords, faceset, norm, lineset);
     coords->unref();
     faceset->unref();
     norm->unref();
@@ -989,43 +1004,74 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
     TopLoc_Location aLoc;
     shape.Location(aLoc);
 
-    // count triangles and nodes in the mesh
+    // get indexed maps of faces and edges
     TopTools_IndexedMapOfShape faceMap;
     TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+    TopTools_IndexedMapOfShape edgeMap;
+    TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+
+    // The triangulation of a face and the position of its nodes and triangles in the Coin
+    // fields. An edge that lies on several faces is taken from the first face with a polygon of
+    // the edge.
+    struct FaceMesh
+    {
+        Handle(Poly_Triangulation) mesh;
+        TopLoc_Location location;
+        int nodeOffset = 0;
+        int triaOffset = 0;
+        std::vector<std::pair<int, Handle(Poly_PolygonOnTriangulation)>> edges;
+    };
+    std::vector<FaceMesh> faceMeshes(faceMap.Extent());
+    std::vector<bool> edgeDone(edgeMap.Extent() + 1, false);
+
+    // count triangles and nodes in the mesh
     for (int i = 1; i <= faceMap.Extent(); i++) {
-        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(faceMap(i)), aLoc);
+        FaceMesh& faceMesh = faceMeshes[i - 1];
+        const TopoDS_Face& actFace = TopoDS::Face(faceMap(i));
+        faceMesh.mesh = BRep_Tool::Triangulation(actFace, faceMesh.location);
 
-        if (mesh.IsNull()) {
-            mesh = Part::Tools::triangulationOfFace(TopoDS::Face(faceMap(i)));
+        if (faceMesh.mesh.IsNull()) {
+            faceMesh.mesh = Part::Tools::triangulationOfFace(actFace);
         }
 
         // Note: we must also count empty faces
-        if (!mesh.IsNull()) {
-            numTriangles += mesh->NbTriangles();
-            numNodes += mesh->NbNodes();
-            numNorms += mesh->NbNodes();
+        faceMesh.nodeOffset = numNorms;
+        faceMesh.triaOffset = numTriangles;
+        if (!faceMesh.mesh.IsNull()) {
+            numTriangles += faceMesh.mesh->NbTriangles();
+            numNodes += faceMesh.mesh->NbNodes();
+            numNorms += faceMesh.mesh->NbNodes();
         }
 
         TopExp_Explorer xp;
-        for (xp.Init(faceMap(i), TopAbs_EDGE); xp.More(); xp.Next()) {
+        for (xp.Init(actFace, TopAbs_EDGE); xp.More(); xp.Next()) {
             faceEdges.insert(Part::ShapeMapHasher {}(xp.Current()));
+            if (faceMesh.mesh.IsNull()) {
+                continue;
+            }
+
+            // this holds the indices of the edge's triangulation to the current polygon
+            int edgeIndex = edgeMap.FindIndex(xp.Current());
+            if (!edgeDone[edgeIndex]) {
+                Handle(Poly_PolygonOnTriangulation) aPoly =
+                    BRep_Tool::PolygonOnTriangulation(TopoDS::Edge(xp.Current()),
+                                                      faceMesh.mesh,
+                                                      faceMesh.location);
+                if (!aPoly.IsNull()) {
+                    faceMesh.edges.emplace_back(edgeIndex, aPoly);
+                    edgeDone[edgeIndex] = true;
+                }
+            }
         }
         numFaces++;
     }
 
-    // get an indexed map of edges
-    TopTools_IndexedMapOfShape edgeMap;
-    TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
-
-    // key is the edge number, value the coord indexes. This is needed to keep the same order as
+    // the coord indexes of the edges by edge number. This is needed to keep the same order as
     // the edges.
-    std::map<int, std::vector<int32_t>> lineSetMap;
-    std::set<int> edgeIdxSet;
-    std::vector<int32_t> edgeVector;
+    std::vector<std::vector<int32_t>> lineSetMap(edgeMap.Extent() + 1);
 
-    // count and index the edges
+    // count the edges
     for (int i = 1; i <= edgeMap.Extent(); i++) {
-        edgeIdxSet.insert(i);
         numEdges++;
 
         const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
@@ -1064,26 +1110,19 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
     int32_t* index = faceset->coordIndex.startEditing();
     int32_t* parts = faceset->partIndex.startEditing();
 
-    // preset the normal vector with null vector
-    for (int i = 0; i < numNorms; i++) {
-        norms[i] = SbVec3f(0.0, 0.0, 0.0);
-    }
-
-    int ii = 0, faceNodeOffset = 0, faceTriaOffset = 0;
-    for (int i = 1; i <= faceMap.Extent(); i++, ii++) {
-        TopLoc_Location aLoc;
-        const TopoDS_Face& actFace = TopoDS::Face(faceMap(i));
-        // get the mesh of the shape
-        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(actFace, aLoc);
-        if (mesh.IsNull()) {
-            mesh = Part::Tools::triangulationOfFace(actFace);
-        }
+    // The faces are filled in parallel. Each face only writes its own part of the fields and the
+    // polygons of the edges it was assigned above.
+    auto fillFace = [&](int ii) {
+        const FaceMesh& faceMesh = faceMeshes[ii];
+        const TopoDS_Face& actFace = TopoDS::Face(faceMap(ii + 1));
+        const Handle(Poly_Triangulation)& mesh = faceMesh.mesh;
         if (mesh.IsNull()) {
             parts[ii] = 0;
-            continue;
+            return;
         }
 
         // getting the transformation of the shape/face
+        const TopLoc_Location& aLoc = faceMesh.location;
         gp_Trsf myTransf;
         Standard_Boolean identity = true;
         if (!aLoc.IsIdentity()) {
@@ -1093,17 +1132,23 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
         // getting size of node and triangle array of this face
         int nbNodesInFace = mesh->NbNodes();
         int nbTriInFace = mesh->NbTriangles();
+        int faceNodeOffset = faceMesh.nodeOffset;
+        int faceTriaOffset = faceMesh.triaOffset;
         // check orientation
         TopAbs_Orientation orient = actFace.Orientation();
 
+        // preset the normal vector with null vector
+        for (int i = 0; i < nbNodesInFace; i++) {
+            norms[faceNodeOffset + i] = SbVec3f(0.0, 0.0, 0.0);
+        }
+
         // cycling through the poly mesh
 #if OCC_VERSION_HEX < 0x070600
         const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
         const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
         TColgp_Array1OfDir Normals(Nodes.Lower(), Nodes.Upper());
 #else
-        int numNodes = mesh->NbNodes();
-        TColgp_Array1OfDir Normals(1, numNodes);
+        TColgp_Array1OfDir Normals(1, nbNodesInFace);
 #endif
         if (normalsFromUV) {
             Part::Tools::getPointNormals(actFace, mesh, Normals);
@@ -1181,57 +1226,40 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
 
         parts[ii] = nbTriInFace;  // new part
 
-        // handling the edges lying on this face
-        TopExp_Explorer Exp;
-        for (Exp.Init(actFace, TopAbs_EDGE); Exp.More(); Exp.Next()) {
-            const TopoDS_Edge& curEdge = TopoDS::Edge(Exp.Current());
-            // get the overall index of this edge
-            int edgeIndex = edgeMap.FindIndex(curEdge);
-            edgeVector.push_back((int32_t)edgeIndex - 1);
-            // already processed this index ?
-            if (edgeIdxSet.find(edgeIndex) != edgeIdxSet.end()) {
-
-                // this holds the indices of the edge's triangulation to the current polygon
-                Handle(Poly_PolygonOnTriangulation) aPoly =
-                    BRep_Tool::PolygonOnTriangulation(curEdge, mesh, aLoc);
-                if (aPoly.IsNull()) {
-                    continue;  // polygon does not exist
-                }
+        // normalize the normals of this face
+        for (int i = 0; i < nbNodesInFace; i++) {
+            norms[faceNodeOffset + i].normalize();
+        }
 
-                // getting the indexes of the edge polygon
-                const TColStd_Array1OfInteger& indices = aPoly->Nodes();
-                for (Standard_Integer i = indices.Lower(); i <= indices.Upper(); i++) {
-                    int nodeIndex = indices(i);
-                    int index = faceNodeOffset + nodeIndex - 1;
-                    lineSetMap[edgeIndex].push_back(index);
-
-                    // usually the coordinates for this edge are already set by the
-                    // triangles of the face this edge belongs to. However, there are
-                    // rare cases where some points are only referenced by the polygon
-                    // but not by any triangle. Thus, we must apply the coordinates to
-                    // make sure that everything is properly set.
+        // handling the edges lying on this face
+        for (const auto& [edgeIndex, aPoly] : faceMesh.edges) {
+            // getting the indexes of the edge polygon
+            const TColStd_Array1OfInteger& indices = aPoly->Nodes();
+            for (Standard_Integer i = indices.Lower(); i <= indices.Upper(); i++) {
+                int nodeIndex = indices(i);
+                int index = faceNodeOffset + nodeIndex - 1;
+                lineSetMap[edgeIndex].push_back(index);
+
+                // usually the coordinates for this edge are already set by the
+                // triangles of the face this edge belongs to. However, there are
+                // rare cases where some points are only referenced by the polygon
+                // but not by any triangle. Thus, we must apply the coordinates to
+                // make sure that everything is properly set.
 #if OCC_VERSION_HEX < 0x070600
-                    gp_Pnt p(Nodes(nodeIndex));
+                gp_Pnt p(Nodes(nodeIndex));
 #else
-                    gp_Pnt p(mesh->Node(nodeIndex));
+                gp_Pnt p(mesh->Node(nodeIndex));
 #endif
-                    if (!identity) {
-                        p.Transform(myTransf);
-                    }
-                    verts[index] = Base::convertTo<SbVec3f>(p);
+                if (!identity) {
+                    p.Transform(myTransf);
                 }
-
-                // remove the handled edge index from the set
-                edgeIdxSet.erase(edgeIndex);
+                verts[index] = Base::convertTo<SbVec3f>(p);
             }
         }
+    };
+    OSD_Parallel::For(0, faceMap.Extent(), fillFace, faceMap.Extent() < 2);
 
-        edgeVector.push_back(-1);
-
-        // counting up the per Face offsets
-        faceNodeOffset += nbNodesInFace;
-        faceTriaOffset += nbTriInFace;
-    }
+    int faceNodeOffset = numNorms;
 
     // handling of the free edges
     for (int i = 1; i <= edgeMap.Extent(); i++) {
@@ -1277,15 +1305,12 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
         verts[faceNodeOffset + i] = Base::convertTo<SbVec3f>(pnt);
     }
 
-    // normalize all normals
-    for (int i = 0; i < numNorms; i++) {
-        norms[i].normalize();
-    }
-
     std::vector<int32_t> lineSetCoords;
     for (const auto& it : lineSetMap) {
-        lineSetCoords.insert(lineSetCoords.end(), it.second.begin(), it.second.end());
-        lineSetCoords.push_back(-1);
+        if (!it.empty()) {
+            lineSetCoords.insert(lineSetCoords.end(), it.begin(), it.end());
+            lineSetCoords.push_back(-1);
+        }
     }
 
     // preset the index vector size
@@ -1347,16 +1372,50 @@ void ViewProviderPartExt::updateVisual()
 
     try {
         TopoDS_Shape cShape = getRenderedShape().getShape();
+        TopLoc_Location location = cShape.Location();
+
+        // The placement is applied by the transformation node. Without its location the
+        // representation only depends on the shape itself and can be shared with all copies.
+        cShape.Location(TopLoc_Location());
+
+        TessellationCache& cache = TessellationCache::instance();
+        // Updating the view for the shape it already shows at the same place means that the
+        // shape may have been modified in place, so its representation must be made anew.
+        if (tessellation && cShape.TShape().get() == tessellatedShape
+            && location.IsEqual(tessellatedLocation)) {
+            cache.remove(cShape,
+                         Deviation.getValue(),
+                         AngularDeflection.getValue(),
+                         NormalsFromUV);
+        }
 
-        setupCoinGeometry(cShape,
-                          coords,
-                          faceset,
-                          norm,
-                          lineset,
-                          nodeset,
-                          Deviation.getValue(),
-                          AngularDeflection.getValue(),
-                          NormalsFromUV);
+        auto data = cache.find(cShape,
+                               Deviation.getValue(),
+                               AngularDeflection.getValue(),
+                               NormalsFromUV);
+        // the nodes must not write into the arrays they share with the cache
+        TessellationCache::release(coords, faceset, norm, lineset);
+        tessellation.reset();
+        if (!data) {
+            setupCoinGeometry(cShape,
+                              coords,
+                              faceset,
+                              norm,
+                              lineset,
+                              nodeset,
+                              Deviation.getValue(),
+                              AngularDeflection.getValue(),
+                              NormalsFromUV);
+            data = cache.store(cShape,
+                               Deviation.getValue(),
+                               AngularDeflection.getValue(),
+                               NormalsFromUV,
+                               TessellationCache::read(coords, faceset, norm, lineset, nodeset));
+        }
+        applyTessellation(data);
+        tessellatedShape = cShape.TShape().get();
+        tessellatedOrientation = cShape.Orientation();
+        tessellatedLocation = location;
 
         VisualTouched = false;
     }
@@ -1375,6 +1434,43 @@ void ViewProviderPartExt::updateVisual()
     setHighlightedPoints(PointColorArray.getValue());
 }
 
+void ViewProviderPartExt::applyTessellation(const TessellationCache::TessellationPtr& data)
+{
+    TessellationCache::release(coords, faceset, norm, lineset);
+    TessellationCache::apply(*data, coords, faceset, norm, lineset, nodeset);
+    tessellation = data;
+}
+
+void ViewProviderPartExt::onTessellationStored(const TopoDS_Shape& shape,
+                                               double deviation,
+                                               double angularDeflection,
+                                               bool normalsFromUV,
+                                               const TessellationCache::TessellationPtr& data)
+{
+    // Another view provider has made the representation of the shape shown here anew, e.g.
+    // after the shape has been modified in place, while the nodes still use the old arrays.
+    if (!tessellation || tessellation == data || shape.TShape().get() != tessellatedShape
+        || shape.Orientation() != tessellatedOrientation || deviation != Deviation.getValue()
+        || angularDeflection != AngularDeflection.getValue()
+        || normalsFromUV != NormalsFromUV) {
+        return;
+    }
+
+    Gui::SoUpdateVBOAction action;
+    action.apply(this->faceset);
+
+    Gui::SoSelectionElementAction saction(Gui::SoSelectionElementAction::None);
+    saction.apply(this->faceset);
+    saction.apply(this->lineset);
+    saction.apply(this->nodeset);
+
+    applyTessellation(data);
+
+    setHighlightedFaces(ShapeAppearance.getValues());
+    setHighlightedEdges(LineColorArray.getValues());
+    setHighlightedPoints(PointColorArray.getValue());
+}
+
 void ViewProviderPartExt::forceUpdate(bool enable) {
     if(enable) {
         if(++forceUpdateCount == 1) {
@@ -24,6 +24,7 @@
 #define PARTGUI_VIEWPROVIDERPARTEXT_H
 
 #include "SoFCShapeObject.h"
+#include "TessellationCache.h"
 
 
 #include <map>
@@ -189,6 +190,14 @@ protected:
     void onChanged(const App::Property* prop) override;
     bool loadParameter();
     void updateVisual();
+    /// Lets the nodes use the arrays of \a data
+    void applyTessellation(const TessellationCache::TessellationPtr& data);
+    /// Applies a representation that has been made anew by another view provider
+    void onTessellationStored(const TopoDS_Shape& shape,
+                              double deviation,
+                              double angularDeflection,
+                              bool normalsFromUV,
+                              const TessellationCache::TessellationPtr& data);
     void handleChangedPropertyName(Base::XMLReader& reader,
                                    const char* TypeName,
                                    const char* PropName) override;
@@ -215,6 +224,12 @@ protected:
 
 private:
     Gui::ViewProviderFaceTexture texture;
+    // the representation whose arrays are used by the nodes and the shape it was made of
+    TessellationCache::TessellationPtr tessellation;
+    const TopoDS_TShape* tessellatedShape = nullptr;
+    TopAbs_Orientation tessellatedOrientation = TopAbs_FORWARD;
+    TopLoc_Location tessellatedLocation;
+    boost::signals2::scoped_connection connectTessellationStored;
     // settings stuff
     int forceUpdateCount;
     static App::PropertyFloatConstraint::Constraints sizeRange;
@@ -66,6 +66,9 @@ public:
     std::vector<TopoShape> getFaces(const TopoShape &shape);
     void getAddSubShape(Part::TopoShape &addShape, Part::TopoShape &subShape) override;
     void updatePreviewShape() override;
+    bool isShapeCacheable() const override {
+        return true;
+    }
 
 protected:
     void onChanged(const App::Property* prop) override;
@@ -35,6 +35,7 @@
 
 #include <array>
 
+#include <App/Application.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/ProgressIndicator.h>
@@ -60,6 +61,14 @@ namespace PartDesign
 using Part::OCCTProgressIndicator;
 extern bool getPDRefineModelParameter();
 
+// Whether runs of additive or subtractive originals are applied in one boolean operation
+static bool getBatchOriginalsParameter()
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/PartDesign");
+    return hGrp->GetBool("BatchPatternOriginals", true);
+}
+
 PROPERTY_SOURCE(PartDesign::Transformed, PartDesign::FeatureRefine)
 
 std::array<char const*, 3> transformModeEnums = {"Transform tool shapes",
@@ -333,32 +342,29 @@ App::DocumentObjectExecReturn* Transformed::execute()
 
     supportShape.setTransform(Base::Matrix4D());
 
-    auto getTransformedCompShape = [&](const auto& supportShape, const auto& origShape) {
-        std::vector<TopoShape> shapes = {supportShape};
-        TopoShape shape (origShape);
-        int idx=1;
-        auto transformIter = transformations.cbegin();
-        transformIter++;
-        for ( ; transformIter != transformations.end(); transformIter++) {
+    // Appends the copies of origShape for all but the first transformation, which is the identity
+    auto addTransformedShapes = [&](std::vector<TopoShape>& shapes, const TopoShape& origShape) {
+        for (std::size_t i = 1; i < transformations.size(); i++) {
             if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
-                return std::vector<TopoShape>();
+                return;
             }
-            auto opName = Data::indexSuffix(idx++);
-            shapes.emplace_back(shape.makeElementTransform(*transformIter, opName.c_str()));
+            auto opName = Data::indexSuffix(static_cast<int>(i));
+            shapes.emplace_back(origShape.makeElementTransform(transformations[i], opName.c_str()));
         }
+    };
+
+    auto getTransformedCompShape = [&](const auto& supportShape, const auto& origShape) {
+        std::vector<TopoShape> shapes = {supportShape};
+        addTransformedShapes(shapes, origShape);
         return shapes;
     };
 
     switch (mode) {
-        case Mode::TransformToolShapes:
-            // NOTE: It would be possible to build a compound from all original addShapes/subShapes
-            // and then transform the compounds as a whole. But we choose to apply the
-            // transformations to each Original separately. This way it is easier to discover what
-            // feature causes a fuse/cut to fail. The downside is that performance suffers when
-            // there are many originals. But it seems safe to assume that in most cases there are
-            // few originals and many transformations
+        case Mode::TransformToolShapes: {
+            // Extract the original shapes and determine whether to cut or to fuse
+            std::vector<Part::TopoShape> fuseShapes;
+            std::vector<Part::TopoShape> cutShapes;
             for (auto original : originals) {
-                // Extract the original shape and determine whether to cut or to fuse
                 Part::TopoShape fuseShape;
                 Part::TopoShape cutShape;
 
@@ -382,22 +388,99 @@ App::DocumentObjectExecReturn* Transformed::execute()
                 if (!cutShape.isNull()) {
                     cutShape = cutShape.makeElementTransform(trsf);
                 }
-                if (!fuseShape.isNull()) {
-                    auto shapes = getTransformedCompShape(supportShape, fuseShape);
-                    if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
-                        return new App::DocumentObjectExecReturn("User aborted");
+                fuseShapes.push_back(fuseShape);
+                cutShapes.push_back(cutShape);
+            }
+
+            // Applies the transformations of the originals [begin, end) to the support. A run
+            // of originals that are all additive or all subtractive is fused or cut in a single
+            // boolean operation.
+            auto applyOriginals = [&](std::size_t begin, std::size_t end) {
+                std::vector<TopoShape> shapes = {supportShape};
+                for (std::size_t i = begin; i < end; i++) {
+                    if (!fuseShapes[i].isNull()) {
+                        addTransformedShapes(shapes, fuseShapes[i]);
+                    }
+                    if (!cutShapes[i].isNull()) {
+                        addTransformedShapes(shapes, cutShapes[i]);
                     }
+                }
+                if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
+                    return false;
+                }
+                if (!fuseShapes[begin].isNull()) {
                     supportShape.makeElementFuse(shapes);
                 }
-                if (!cutShape.isNull()) {
-                    auto shapes = getTransformedCompShape(supportShape, cutShape);
+                else {
+                    supportShape.makeElementCut(shapes);
+                }
+                return true;
+            };
+
+            auto isAdditive = [&](std::size_t i) {
+                return !fuseShapes[i].isNull() && cutShapes[i].isNull();
+            };
+            auto isSubtractive = [&](std::size_t i) {
+                return fuseShapes[i].isNull() && !cutShapes[i].isNull();
+            };
+
+            for (std::size_t begin = 0; begin < originals.size();) {
+                std::size_t end = begin + 1;
+                if (isAdditive(begin)) {
+                    while (end < originals.size() && isAdditive(end)) {
+                        end++;
+                    }
+                }
+                else if (isSubtractive(begin)) {
+                    while (end < originals.size() && isSubtractive(end)) {
+                        end++;
+                    }
+                }
+
+                if (end - begin > 1 && getBatchOriginalsParameter()) {
+                    Part::TopoShape batchSupport(supportShape);
+                    try {
+                        if (!applyOriginals(begin, end)) {
+                            return new App::DocumentObjectExecReturn("User aborted");
+                        }
+                        begin = end;
+                        continue;
+                    }
+                    catch (Standard_Failure& e) {
+                        Base::Console().log("Transformed: batched boolean operation failed: %s\n",
+                                            e.GetMessageString());
+                    }
+                    catch (Base::Exception& e) {
+                        Base::Console().log("Transformed: batched boolean operation failed: %s\n",
+                                            e.what());
+                    }
                     if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
                         return new App::DocumentObjectExecReturn("User aborted");
                     }
-                    supportShape.makeElementCut(shapes);
+                    supportShape = batchSupport;
+                }
+
+                // Apply the transformations to each original separately. This way it is easier to
+                // discover what feature causes a fuse/cut to fail.
+                for (; begin < end; begin++) {
+                    if (!fuseShapes[begin].isNull()) {
+                        auto shapes = getTransformedCompShape(supportShape, fuseShapes[begin]);
+                        if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
+                            return new App::DocumentObjectExecReturn("User aborted");
+                        }
+                        supportShape.makeElementFuse(shapes);
+                    }
+                    if (!cutShapes[begin].isNull()) {
+                        auto shapes = getTransformedCompShape(supportShape, cutShapes[begin]);
+                        if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
+                            return new App::DocumentObjectExecReturn("User aborted");
+                        }
+                        supportShape.makeElementCut(shapes);
+                    }
                 }
             }
             break;
+        }
         case Mode::TransformBody: {
             auto shapes = getTransformedCompShape(supportShape, supportShape);
             if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
@@ -19,6 +19,7 @@
 #*                                                                         *
 #***************************************************************************
 
+import math
 import unittest
 
 import FreeCAD
@@ -167,6 +168,67 @@ class TestLinearPattern(unittest.TestCase):
         # self.assertEqual(len(self.LinearPattern.Shape.ElementReverseMap), 170)
         self.assertEqual(self.LinearPattern.Shape.ElementMapSize, 26)
 
+    def makeMultipleOriginalsLinearPattern(self):
+        # the additive originals are fused in one operation, the subtractive one after them
+        self.Body = self.Doc.addObject('PartDesign::Body','Body')
+        self.Box = self.Doc.addObject('PartDesign::AdditiveBox','Box')
+        self.Body.addObject(self.Box)
+        self.Box.Length=10.00
+        self.Box.Width=10.00
+        self.Box.Height=10.00
+        self.Cylinder = self.Doc.addObject('PartDesign::AdditiveCylinder','Cylinder')
+        self.Body.addObject(self.Cylinder)
+        self.Cylinder.Radius = 2.0
+        self.Cylinder.Height = 20.0
+        self.Cylinder.Placement = FreeCAD.Placement(FreeCAD.Vector(5, 5, 0), FreeCAD.Rotation())
+        self.Hole = self.Doc.addObject('PartDesign::SubtractiveCylinder','Hole')
+        self.Body.addObject(self.Hole)
+        self.Hole.Radius = 1.0
+        self.Hole.Height = 22.0
+        self.Hole.Placement = FreeCAD.Placement(FreeCAD.Vector(5, 5, -1), FreeCAD.Rotation())
+        self.Doc.recompute()
+        self.LinearPattern = self.Doc.addObject("PartDesign::LinearPattern","LinearPattern")
+        self.LinearPattern.Originals = [self.Box, self.Cylinder, self.Hole]
+        self.LinearPattern.Direction = (self.Doc.X_Axis,[""])
+        self.LinearPattern.Length = 90.0
+        self.LinearPattern.Occurrences = 10
+        self.LinearPattern.Refine = False
+        self.Body.addObject(self.LinearPattern)
+        self.Doc.recompute()
+
+    def getSideFaceNames(self, shape):
+        # the mapped names of the faces in the XZ plane, ordered by their position
+        reverseMap = shape.ElementReverseMap
+        names = []
+        for i, face in enumerate(shape.Faces):
+            center = face.CenterOfMass
+            if abs(center.y) < 1e-7:
+                names.append((round(center.x, 3), reverseMap.get("Face%d" % (i + 1))))
+        return sorted(names)
+
+    def testMultipleOriginalsLinearPattern(self):
+        self.makeMultipleOriginalsLinearPattern()
+        self.assertTrue(self.LinearPattern.isValid())
+        self.assertAlmostEqual(self.LinearPattern.Shape.Volume, 1e4 + 10 * (40 - 20) * math.pi)
+        self.assertEqual(len(self.LinearPattern.Shape.Solids), 1)
+
+    def testMultipleOriginalsKeepElementNames(self):
+        # fusing the originals in one operation must name the elements like fusing them one by one
+        self.makeMultipleOriginalsLinearPattern()
+        batchedMapSize = self.LinearPattern.Shape.ElementMapSize
+        batchedNames = self.getSideFaceNames(self.LinearPattern.Shape)
+        params = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/PartDesign")
+        params.SetBool("BatchPatternOriginals", False)
+        try:
+            self.LinearPattern.touch()
+            self.Doc.recompute()
+        finally:
+            params.RemBool("BatchPatternOriginals")
+        self.assertTrue(self.LinearPattern.isValid())
+        self.assertEqual(len(batchedNames), 10)
+        self.assertEqual(batchedMapSize, self.LinearPattern.Shape.ElementMapSize)
+        self.assertEqual(batchedNames, self.getSideFaceNames(self.LinearPattern.Shape))
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartDesignTestLinearPattern")
@@ -182,7 +182,7 @@ void PointKernel::Save(Base::Writer& writer) const
 {
     if (!writer.isForceXML()) {
         writer.Stream() << writer.ind() << "<Points file=\""
-                        << writer.addFile(writer.ObjectName.c_str(), this) << "\" "
+                        << writer.addFile(writer.ObjectName.c_str(), this, true) << "\" "
                         << "mtrx=\"" << _Mtrx.toString() << "\"/>" << std::endl;
     }
 }
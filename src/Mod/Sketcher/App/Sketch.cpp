@@ -4603,8 +4603,10 @@ int Sketch::internalSolve(std::string& solvername, int level)
     int defaultsoltype = -1;
 
     if (isInitMove) {
-        solvername = "DogLeg";  // DogLeg is used for dragging (same as before)
-        ret = GCSsys.solve(isFine, GCS::DogLeg);
+        // DogLeg is used for dragging (same as before). Only the components with the dragged
+        // geometry are solved, starting from the position of the previous move.
+        solvername = "DogLeg";
+        ret = GCSsys.solveIncremental(isFine, GCS::DogLeg);
     }
     else {
         switch (defaultSolver) {
@@ -607,6 +607,10 @@ public:
     {
         GCSsys.dogLegGaussStep = mode;
     }
+    inline void setJacobianStorage(GCS::JacobianStorage storage)
+    {
+        GCSsys.jacobianStorage = storage;
+    }
     inline void setDebugMode(GCS::DebugMode mode)
     {
         debugMode = mode;
@@ -47,10 +47,13 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <future>
 #include <iostream>
 #include <limits>
 #include <numbers>
+#include <thread>
 
 #include "GCS.h"
 #include "qp_eq.h"
@@ -98,6 +101,7 @@
 #include <Base/Console.h>
 #include <FCConfig.h>
 
+#include <boost/functional/hash.hpp>
 #include <boost/graph/connected_components.hpp>
 #include <boost_graph_adjacency_list.hpp>
 
@@ -249,6 +253,13 @@ public:
     void LogMatrix(const std::string str, Eigen::MatrixXd matrix);
     void LogMatrix(const std::string str, MatrixIndexType matrix);
 
+    // components are pairs of the component id and its number of parameters, times in seconds.
+    // Only the slowest component is listed unless detailed is true.
+    void LogComponentSolveTimes(const std::vector<std::pair<int, int>>& components,
+                                const std::vector<double>& times,
+                                int threads,
+                                bool detailed);
+
 private:
     SolverReportingManager();
     ~SolverReportingManager();
@@ -422,6 +433,39 @@ void SolverReportingManager::LogGroupOfParameters(const std::string& str,
     LogString(tempstream.str());
 }
 
+void SolverReportingManager::LogComponentSolveTimes(
+    const std::vector<std::pair<int, int>>& components,
+    const std::vector<double>& times,
+    int threads,
+    bool detailed)
+{
+    if (components.empty()) {
+        return;
+    }
+
+    std::stringstream tempstream;
+
+    auto logComponent = [&](size_t i) {
+        tempstream << "[" << components[i].first << "] Params: " << components[i].second
+                   << ", Time: " << times[i] << " s" << '\n';
+    };
+
+    tempstream << "Solved components: " << components.size() << ", Threads: " << threads;
+
+    if (detailed) {
+        tempstream << '\n';
+        for (size_t i = 0; i < components.size(); i++) {
+            logComponent(i);
+        }
+    }
+    else {
+        tempstream << ", Slowest: ";
+        logComponent(std::ranges::max_element(times) - times.begin());
+    }
+
+    LogString(tempstream.str());
+}
+
 #ifdef _GCS_DEBUG
 void SolverReportingManager::LogMatrix(const std::string str, Eigen::MatrixXd matrix)
 {
@@ -470,6 +514,7 @@ System::System()
     , hasUnknowns(false)
     , hasDiagnosis(false)
     , isInit(false)
+    , isIncremental(false)
     , emptyDiagnoseMatrix(true)
     , maxIter(100)
     , maxIterRedundant(100)
@@ -479,6 +524,8 @@ System::System()
     , convergenceRedundant(1e-10)
     , qrAlgorithm(EigenSparseQR)
     , dogLegGaussStep(FullPivLU)
+    , jacobianStorage(DenseJacobian)
+    , minParallelSolveParams(200)
     , qrpivotThreshold(1E-13)
     , debugMode(Minimal)
     , LM_eps(1E-10)
@@ -1974,26 +2021,20 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
         return Failed;
     }
 
-    bool isReset = false;
-    // return success by default in order to permit coincidence constraints to be applied
-    // even if no other system has to be solved
-    int res = Success;
+    isIncremental = false;
+    VEC_I cids;
     for (int cid = 0; cid < int(subSystems.size()); cid++) {
-        if ((subSystems[cid] || subSystemsAux[cid]) && !isReset) {
-            resetToReference();
-            isReset = true;
-        }
-        if (subSystems[cid] && subSystemsAux[cid]) {
-            res = std::max(res,
-                           solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving));
-        }
-        else if (subSystems[cid]) {
-            res = std::max(res, solve(subSystems[cid], isFine, alg, isRedundantsolving));
-        }
-        else if (subSystemsAux[cid]) {
-            res = std::max(res, solve(subSystemsAux[cid], isFine, alg, isRedundantsolving));
+        if (subSystems[cid] || subSystemsAux[cid]) {
+            cids.push_back(cid);
         }
     }
+    if (!cids.empty()) {
+        resetToReference();
+    }
+
+    // return success by default in order to permit coincidence constraints to be applied
+    // even if no other system has to be solved
+    int res = solveComponents(cids, isFine, alg, isRedundantsolving);
     if (res == Success) {
         for (std::set<Constraint*>::const_iterator constr = redundant.begin();
              constr != redundant.end();
@@ -2011,16 +2052,144 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
     return res;
 }
 
+int System::solveIncremental(bool isFine, Algorithm alg)
+{
+    if (!isInit) {
+        return Failed;
+    }
+
+    // Only the components with temporary constraints have moved away from their solution. All
+    // others are left alone and the parameters are not reset to the reference, so that the
+    // solver starts from the solution of the previous call.
+    isIncremental = true;
+    incrementalHessians.resize(subSystems.size());
+    VEC_I cids;
+    for (int cid = 0; cid < int(subSystems.size()); cid++) {
+        if (subSystemsAux[cid]) {
+            cids.push_back(cid);
+        }
+    }
+
+    int res = solveComponents(cids, isFine, alg, false);
+    if (res == Success) {
+        for (const auto constr : redundant) {
+            double err = constr->error();
+            if (err * err > convergence) {
+                return Converged;
+            }
+        }
+    }
+    return res;
+}
+
+int System::solveComponents(const VEC_I& cids, bool isFine, Algorithm alg, bool isRedundantsolving)
+{
+    auto solveComponent = [&](int cid) {
+        if (subSystems[cid] && subSystemsAux[cid]) {
+            Eigen::MatrixXd* hessian = isIncremental ? &incrementalHessians[cid] : nullptr;
+            return solve(subSystems[cid], subSystemsAux[cid], hessian, isFine, isRedundantsolving);
+        }
+        else if (subSystems[cid]) {
+            return solve(subSystems[cid], isFine, alg, isRedundantsolving);
+        }
+        else {
+            return solve(subSystemsAux[cid], isFine, alg, isRedundantsolving);
+        }
+    };
+
+    // The components share neither constraints nor parameters and every subsystem works on its
+    // own copy of the parameters until applySolution(), so they can be solved concurrently.
+    // Small systems are solved sequentially as the threads would cost more than they save, and
+    // so is everything at IterationLevel because Base::Console is not thread-safe.
+    int paramsNum = 0;
+    for (int cid : cids) {
+        paramsNum += int(plists[cid].size());
+    }
+    std::size_t threads = 1;
+    if (paramsNum >= minParallelSolveParams && debugMode != IterationLevel) {
+        threads = std::min<std::size_t>(std::thread::hardware_concurrency(), cids.size());
+        threads = std::max<std::size_t>(threads, 1);
+    }
+
+    // the biggest components first to balance the load of the threads
+    VEC_I order = cids;
+    if (threads > 1) {
+        std::ranges::stable_sort(order, [this](int cid1, int cid2) {
+            return plists[cid1].size() > plists[cid2].size();
+        });
+    }
+
+    // the solve times are only reported at IterationLevel, or in Minimal mode of a debug build,
+    // as Minimal is the default mode and the report would be written on every solve
+#ifdef _GCS_DEBUG
+    const bool logTimes = debugMode == Minimal || debugMode == IterationLevel;
+#else
+    const bool logTimes = debugMode == IterationLevel;
+#endif
+
+    std::vector<int> results(order.size(), Success);
+    std::vector<double> times(order.size(), 0.0);
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < order.size(); i = next++) {
+            if (!logTimes) {
+                results[i] = solveComponent(order[i]);
+                continue;
+            }
+            auto start = std::chrono::steady_clock::now();
+            results[i] = solveComponent(order[i]);
+            std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+            times[i] = time.count();
+        }
+    };
+
+    std::vector<std::future<void>> futures;
+    for (std::size_t i = 1; i < threads; i++) {
+        futures.push_back(std::async(std::launch::async, worker));
+    }
+    worker();
+    for (auto& fut : futures) {
+        fut.get();
+    }
+
+    if (logTimes) {
+        std::vector<std::pair<int, int>> components;
+        for (int cid : order) {
+            components.emplace_back(cid, int(plists[cid].size()));
+        }
+        SolverReportingManager::Manager().LogComponentSolveTimes(components,
+                                                                 times,
+                                                                 int(threads),
+                                                                 debugMode == IterationLevel);
+    }
+
+    int res = Success;
+    for (int result : results) {
+        res = std::max(res, result);
+    }
+    return res;
+}
+
 int System::solve(SubSystem* subsys, bool isFine, Algorithm alg, bool isRedundantsolving)
 {
     if (alg == BFGS) {
         return solve_BFGS(subsys, isFine, isRedundantsolving);
     }
     else if (alg == LevenbergMarquardt) {
-        return solve_LM(subsys, isRedundantsolving);
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+        if (jacobianStorage == SparseJacobian) {
+            return solve_LM<Eigen::SparseMatrix<double>>(subsys, isRedundantsolving);
+        }
+#endif
+        return solve_LM<Eigen::MatrixXd>(subsys, isRedundantsolving);
     }
     else if (alg == DogLeg) {
-        return solve_DL(subsys, isRedundantsolving);
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+        if (jacobianStorage == SparseJacobian) {
+            return solve_DL<Eigen::SparseMatrix<double>>(subsys, isRedundantsolving);
+        }
+#endif
+        return solve_DL<Eigen::MatrixXd>(subsys, isRedundantsolving);
     }
     else {
         return Failed;
@@ -2155,6 +2324,93 @@ int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolvi
     return Failed;
 }
 
+namespace
+{
+// Solves the augmented normal equations (A + mu*I) h = g of the Levenberg-Marquardt solver and
+// returns the relative error of the solution
+double solveAugmented(Eigen::MatrixXd& A,
+                      const Eigen::VectorXd& diag_A,
+                      double mu,
+                      const Eigen::VectorXd& g,
+                      Eigen::VectorXd& h)
+{
+    // augment normal equations A = A+uI
+    for (int i = 0; i < A.rows(); ++i) {
+        A(i, i) += mu;
+    }
+
+    // solve augmented functions A*h=-g
+    h = A.fullPivLu().solve(g);
+    double rel_error = (A * h - g).norm() / g.norm();
+
+    // restore diagonal J^T J entries
+    for (int i = 0; i < A.rows(); ++i) {
+        A(i, i) = diag_A(i);
+    }
+
+    return rel_error;
+}
+
+// Computes the Gauss-Newton step of the DogLeg solver, i.e. solves Jx * h_gn = -fx
+void solveGaussNewton(const Eigen::MatrixXd& Jx,
+                      const Eigen::VectorXd& fx,
+                      DogLegGaussStep dogLegGaussStep,
+                      Eigen::VectorXd& h_gn)
+{
+    // https://forum.freecad.org/viewtopic.php?f=10&t=12769&start=50#p106220
+    // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
+    switch (dogLegGaussStep) {
+        case FullPivLU:
+            h_gn = Jx.fullPivLu().solve(-fx);
+            break;
+        case LeastNormFullPivLU:
+            h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).fullPivLu().solve(-fx);
+            break;
+        case LeastNormLdlt:
+            h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).ldlt().solve(-fx);
+            break;
+    }
+}
+
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+double solveAugmented(Eigen::SparseMatrix<double>& A,
+                      const Eigen::VectorXd& /*diag_A*/,
+                      double mu,
+                      const Eigen::VectorXd& g,
+                      Eigen::VectorXd& h)
+{
+    // A + mu*I is positive definite for mu > 0, so the sparse Cholesky factorization can be
+    // used. The shift is applied by the factorization and leaves A untouched.
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt;
+    ldlt.setShift(mu);
+    ldlt.compute(A);
+    if (ldlt.info() != Eigen::Success) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    h = ldlt.solve(g);
+    return (A * h + mu * h - g).norm() / g.norm();
+}
+
+void solveGaussNewton(const Eigen::SparseMatrix<double>& Jx,
+                      const Eigen::VectorXd& fx,
+                      DogLegGaussStep /*dogLegGaussStep*/,
+                      Eigen::VectorXd& h_gn)
+{
+    // The least norm step is used for all Gauss steps because a sparse LU or QR decomposition of
+    // the Jacobian itself suffers from too much fill-in. A tiny shift keeps the factorization of
+    // J*J^T working if there are redundant constraints.
+    Eigen::SparseMatrix<double> JJt = Jx * Jx.transpose();
+    Eigen::VectorXd diagonal = JJt.diagonal();
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt;
+    ldlt.setShift(1e-14 * diagonal.lpNorm<Eigen::Infinity>());
+    ldlt.compute(JJt);
+    h_gn = Jx.transpose() * ldlt.solve(-fx);
+}
+#endif
+}  // namespace
+
+template<typename JacobianMatrix>
 int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 {
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
@@ -2170,8 +2426,8 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd e(csize),
         e_new(csize);  // vector of all function errors (every constraint is one function)
-    Eigen::MatrixXd J(csize, xsize);  // Jacobi of the subsystem
-    Eigen::MatrixXd A(xsize, xsize);
+    JacobianMatrix J(csize, xsize);  // Jacobi of the subsystem
+    JacobianMatrix A(xsize, xsize);
     Eigen::VectorXd x(xsize), h(xsize), x_new(xsize), g(xsize), diag_A(xsize);
 
     subsys->redirectParams();
@@ -2247,14 +2503,7 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         // determine increment using adaptive damping
         int k = 0;
         while (k < 50) {
-            // augment normal equations A = A+uI
-            for (int i = 0; i < xsize; ++i) {
-                A(i, i) += mu;
-            }
-
-            // solve augmented functions A*h=-g
-            h = A.fullPivLu().solve(g);
-            double rel_error = (A * h - g).norm() / g.norm();
+            double rel_error = solveAugmented(A, diag_A, mu, g, h);
 
             // check if solving works
             if (rel_error < 1e-5) {
@@ -2304,10 +2553,6 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
             mu *= nu;
             nu *= 2.0;
-            for (int i = 0; i < xsize; ++i) {  // restore diagonal J^T J entries
-                A(i, i) = diag_A(i);
-            }
-
             k++;
         }
         if (k > 50) {
@@ -2335,6 +2580,7 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
     return (stop == 1) ? Success : Failed;
 }
 
+template<typename JacobianMatrix>
 int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 {
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
@@ -2371,6 +2617,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
                        ? "FullPivLU"
                        : (dogLegGaussStep == LeastNormFullPivLU ? "LeastNormFullPivLU"
                                                                 : "LeastNormLdlt"))
+               << ", jacobian: " << (jacobianStorage == SparseJacobian ? "Sparse" : "Dense")
                << ", xsize: " << xsize << ", csize: " << csize << ", maxIter: " << maxIterNumber
                << "\n";
 
@@ -2380,7 +2627,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd x(xsize), x_new(xsize);
     Eigen::VectorXd fx(csize), fx_new(csize);
-    Eigen::MatrixXd Jx(csize, xsize), Jx_new(csize, xsize);
+    JacobianMatrix Jx(csize, xsize), Jx_new(csize, xsize);
     Eigen::VectorXd g(xsize), h_sd(xsize), h_gn(xsize), h_dl(xsize);
 
     subsys->redirectParams();
@@ -2432,19 +2679,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         h_sd = alpha * g;
 
         // get the gauss-newton step
-        // https://forum.freecad.org/viewtopic.php?f=10&t=12769&start=50#p106220
-        // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
-        switch (dogLegGaussStep) {
-            case FullPivLU:
-                h_gn = Jx.fullPivLu().solve(-fx);
-                break;
-            case LeastNormFullPivLU:
-                h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).fullPivLu().solve(-fx);
-                break;
-            case LeastNormLdlt:
-                h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).ldlt().solve(-fx);
-                break;
-        }
+        solveGaussNewton(Jx, fx, dogLegGaussStep, h_gn);
 
         double rel_error = (Jx * h_gn + fx).norm() / fx.norm();
         if (rel_error > 1e15) {
@@ -4606,7 +4841,16 @@ void System::extractSubsystem(SubSystem* subsys, bool isRedundantsolving)
 
 // The following solver variant solves a system compound of two subsystems
 // treating the first of them as of higher priority than the second
-int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool isRedundantsolving)
+int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool isFine, bool isRedundantsolving)
+{
+    return solve(subsysA, subsysB, nullptr, isFine, isRedundantsolving);
+}
+
+int System::solve(SubSystem* subsysA,
+                  SubSystem* subsysB,
+                  Eigen::MatrixXd* hessian,
+                  bool /*isFine*/,
+                  bool isRedundantsolving)
 {
     int xsizeA = subsysA->pSize();
     int xsizeB = subsysB->pSize();
@@ -4632,6 +4876,9 @@ int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool
     int xsize = plistAB.size();
 
     Eigen::MatrixXd B = Eigen::MatrixXd::Identity(xsize, xsize);
+    if (hessian && hessian->rows() == xsize) {
+        B = *hessian;  // continue with the approximation of a previous solve
+    }
     Eigen::MatrixXd JA(csizeA, xsize);
     Eigen::MatrixXd Y, Z;
 
@@ -4771,6 +5018,15 @@ int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool
         ret = Failed;
     }
 
+    if (hessian) {
+        if (ret == Success) {
+            *hessian = B;
+        }
+        else {
+            hessian->resize(0, 0);
+        }
+    }
+
     subsysA->revertParams();
     subsysB->revertParams();
     return ret;
@@ -4779,6 +5035,9 @@ int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool
 void System::applySolution()
 {
     for (int cid = 0; cid < int(subSystems.size()); cid++) {
+        if (isIncremental && !subSystemsAux[cid]) {
+            continue;  // not solved by solveIncremental()
+        }
         if (subSystemsAux[cid]) {
             subSystemsAux[cid]->applySolution();
         }
@@ -4800,38 +5059,29 @@ void System::undoSolution()
 
 void System::makeReducedJacobian(Eigen::MatrixXd& J,
                                  std::map<int, int>& jacobianconstraintmap,
-                                 GCS::VEC_pD& pdiagnoselist,
-                                 std::map<int, int>& tagmultiplicity)
+                                 const std::vector<Constraint*>& clistC,
+                                 const GCS::VEC_pD& pdiagnoselist)
 {
-    // construct specific parameter list for diagonose ignoring driven constraint parameters
-    for (int j = 0; j < int(plist.size()); j++) {
-        auto result1 = std::ranges::find(pdrivenlist, plist[j]);
-
-        if (result1 == std::end(pdrivenlist)) {
-            pdiagnoselist.push_back(plist[j]);
-        }
+    MAP_pD_I pdiagnoseindex;
+    for (int j = 0; j < int(pdiagnoselist.size()); j++) {
+        pdiagnoseindex[pdiagnoselist[j]] = j;
     }
 
-
-    J = Eigen::MatrixXd::Zero(clist.size(), pdiagnoselist.size());
+    J = Eigen::MatrixXd::Zero(clistC.size(), pdiagnoselist.size());
 
     int jacobianconstraintcount = 0;
     int allcount = 0;
-    for (auto& constr : clist) {
+    for (auto& constr : clistC) {
         constr->revertParams();
         ++allcount;
         if (constr->getTag() >= 0 && constr->isDriving()) {
             jacobianconstraintcount++;
-            for (int j = 0; j < int(pdiagnoselist.size()); j++) {
-                J(jacobianconstraintcount - 1, j) = constr->grad(pdiagnoselist[j]);
-            }
-
-            // parallel processing: create tag multiplicity map
-            if (tagmultiplicity.find(constr->getTag()) == tagmultiplicity.end()) {
-                tagmultiplicity[constr->getTag()] = 0;
-            }
-            else {
-                tagmultiplicity[constr->getTag()]++;
+            // the gradient is zero for any parameter the constraint does not depend on
+            for (auto param : constr->params()) {
+                auto it = pdiagnoseindex.find(param);
+                if (it != pdiagnoseindex.end()) {
+                    J(jacobianconstraintcount - 1, it->second) = constr->grad(param);
+                }
             }
 
             jacobianconstraintmap[jacobianconstraintcount - 1] = allcount - 1;
@@ -4843,50 +5093,121 @@ void System::makeReducedJacobian(Eigen::MatrixXd& J,
     }
 }
 
-int System::diagnose(Algorithm alg)
+void System::makeDiagnosisComponents(const GCS::VEC_pD& pdiagnoselist,
+                                     std::vector<std::vector<Constraint*>>& clists,
+                                     std::vector<GCS::VEC_pD>& plists)
 {
-    // Analyses the constrainess grad of the system and provides feedback
-    // The vector "conflictingTags" will hold a group of conflicting constraints
+    std::vector<Constraint*> clistD;
+    std::ranges::copy_if(clist, std::back_inserter(clistD), [](const auto& constr) {
+        return constr->isDriving();
+    });
 
-    // Hint 1: Only constraints with tag >= 0 are taken into account
-    // Hint 2: Constraints tagged with 0 are treated as high priority
-    //         constraints and they are excluded from the returned
-    //         list of conflicting constraints. Therefore, this function
-    //         will provide no feedback about possible conflicts between
-    //         two high priority constraints. For this reason, tagging
-    //         constraints with 0 should be used carefully.
-    hasDiagnosis = false;
-    if (!hasUnknowns) {
-        dofs = -1;
-        return dofs;
+    MAP_pD_I pdiagnoseindex;
+    for (int j = 0; j < int(pdiagnoselist.size()); j++) {
+        pdiagnoseindex[pdiagnoselist[j]] = j;
+    }
+
+    // Constraints are connected to the parameters they depend on and to the other solver
+    // constraints of the same sketcher constraint (same positive tag). The latter keeps the
+    // choice of redundant constraints the same as for the whole system.
+    Graph g(pdiagnoselist.size() + clistD.size());
+    std::map<int, int> tagvertex;
+    bool hasUnconnected = false;
+    int cvtid = int(pdiagnoselist.size());
+    for (auto constr : clistD) {
+        bool connected = false;
+        for (auto param : c2p[constr]) {
+            auto it = pdiagnoseindex.find(param);
+            if (it != pdiagnoseindex.end()) {
+                boost::add_edge(cvtid, it->second, g);
+                connected = true;
+            }
+        }
+        hasUnconnected = hasUnconnected || !connected;
+
+        if (constr->getTag() > 0) {
+            auto [it, inserted] = tagvertex.emplace(constr->getTag(), cvtid);
+            if (!inserted) {
+                boost::add_edge(cvtid, it->second, g);
+            }
+        }
+        ++cvtid;
     }
 
-#ifdef _DEBUG_TO_FILE
-    SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
-#endif
+    clists.clear();
+    plists.clear();
 
-    // Input parameters' lists:
-    // plist            =>  list of all the parameters of the system, e.g. each coordinate
-    //                      of a point
-    // pdrivenlist      =>  list of the parameters that are driven by other parameters
-    //                      (e.g. value of driven constraints)
+    // a constraint that only depends on driven parameters cannot be assigned to a component
+    if (hasUnconnected) {
+        clists.push_back(clistD);
+        plists.push_back(pdiagnoselist);
+        return;
+    }
 
-    // When adding an external geometry or a constraint on an external geometry the array
-    // 'plist' is empty.
-    // So, we must abort here because otherwise we would create an invalid matrix and make
-    // the application eventually crash. This fixes issues #0002372/#0002373.
-    if (plist.empty() || (plist.size() - pdrivenlist.size()) == 0) {
-        hasDiagnosis = true;
-        emptyDiagnoseMatrix = true;
-        dofs = 0;
-        return dofs;
+    VEC_I components(boost::num_vertices(g));
+    int componentsSize = 0;
+    if (!components.empty()) {
+        componentsSize = boost::connected_components(g, &components[0]);
     }
 
-    redundant.clear();
-    conflictingTags.clear();
-    redundantTags.clear();
-    partiallyRedundantTags.clear();
+    clists.resize(componentsSize);
+    plists.resize(componentsSize);
+    for (std::size_t j = 0; j < pdiagnoselist.size(); j++) {
+        plists[components[j]].push_back(pdiagnoselist[j]);
+    }
+    for (std::size_t i = 0; i < clistD.size(); i++) {
+        clists[components[pdiagnoselist.size() + i]].push_back(clistD[i]);
+    }
+}
+
+std::size_t System::makeDiagnosisKey(const std::vector<Constraint*>& clistC,
+                                     const GCS::VEC_pD& pdiagnoselist,
+                                     const std::map<int, int>& tagmultiplicity,
+                                     ComponentDiagnosis& diagnosis)
+{
+    MAP_pD_I pdiagnoseindex;
+    for (int j = 0; j < int(pdiagnoselist.size()); j++) {
+        pdiagnoseindex[pdiagnoselist[j]] = j;
+    }
+
+    std::vector<int>& structure = diagnosis.structure;
+    std::vector<double>& values = diagnosis.values;
+    structure.push_back(int(pdiagnoselist.size()));
+    for (auto constr : clistC) {
+        constr->revertParams();
+        auto multiplicity = tagmultiplicity.find(constr->getTag());
+        structure.push_back(int(constr->getTypeId()));
+        structure.push_back(constr->getTag());
+        structure.push_back(multiplicity != tagmultiplicity.end() ? multiplicity->second : -1);
+        structure.push_back(int(constr->isInternalAlignment()));
+
+        VEC_pD cparams = constr->params();
+        structure.push_back(int(cparams.size()));
+        for (auto param : cparams) {
+            auto it = pdiagnoseindex.find(param);
+            values.push_back(*param);
+            if (it != pdiagnoseindex.end()) {
+                structure.push_back(it->second);
+                values.push_back(constr->grad(param));
+            }
+            else {
+                structure.push_back(-1);
+            }
+        }
+        values.push_back(constr->error());
+    }
+
+    std::size_t key = boost::hash_range(structure.begin(), structure.end());
+    boost::hash_combine(key, boost::hash_range(values.begin(), values.end()));
+    return key;
+}
 
+void System::diagnoseComponent(Algorithm alg,
+                               const std::vector<Constraint*>& clistC,
+                               GCS::VEC_pD& pdiagnoselist,
+                               const std::map<int, int>& tagmultiplicity,
+                               ComponentDiagnosis& diagnosis)
+{
     // This QR diagnosis uses a reduced Jacobian matrix to calculate the rank of the system
     // and identify conflicting and redundant constraints.
     //
@@ -4897,24 +5218,25 @@ int System::diagnose(Algorithm alg)
     Eigen::MatrixXd J;
 
     // maps the index of the rows of the reduced jacobian matrix (solver constraints) to
-    // the index those constraints would have in a full size Jacobian matrix
+    // the index those constraints have in clistC
     std::map<int, int> jacobianconstraintmap;
 
-    // list of parameters to be diagnosed in this routine (removes value parameters from driven
-    // constraints)
-    GCS::VEC_pD pdiagnoselist;
+    makeReducedJacobian(J, jacobianconstraintmap, clistC, pdiagnoselist);
 
-    // tag multiplicity gives the number of solver constraints associated with the same tag
-    // A tag generally corresponds to the Sketcher constraint index - There are special tag values,
-    // like 0 and -1.
-    std::map<int, int> tagmultiplicity;
+    if (J.rows() == 0) {
+        // no constraint acts on these parameters, each of them is a free parameter
+        for (int j = 0; j < int(pdiagnoselist.size()); j++) {
+            diagnosis.dependentParameterGroups.push_back({j});
+        }
+        return;
+    }
 
-    makeReducedJacobian(J, jacobianconstraintmap, pdiagnoselist, tagmultiplicity);
+    // The parameters are diagnosed by a second QR decomposition. Running it in another thread
+    // only pays off for big components.
+    auto policy = J.size() > 10000 ? std::launch::async | std::launch::deferred
+                                   : std::launch::deferred;
 
-    // this function will exit with a diagnosis and, unless overridden by functions below, with full
-    // DoFs
-    hasDiagnosis = true;
-    dofs = pdiagnoselist.size();
+    std::vector<std::vector<Constraint*>> conflictGroups;
 
     // There is a legacy decision to use QR decomposition. I (abdullah) do not know all the
     // consideration taken in that decisions. I see that:
@@ -4962,21 +5284,6 @@ int System::diagnose(Algorithm alg)
 
     // QR decomposition method selection: SparseQR vs DenseQR
 
-#ifndef EIGEN_SPARSEQR_COMPATIBLE
-    if (qrAlgorithm == EigenSparseQR) {
-        Base::Console().warning("SparseQR not supported by you current version of Eigen. It "
-                                "requires Eigen 3.2.2 or higher. Falling back to Dense QR\n");
-        qrAlgorithm = EigenDenseQR;
-    }
-#endif
-
-    if (J.rows() == 0) {
-        return dofs;
-    }
-
-    // From here on, presuming `J.rows() > 0`.
-    emptyDiagnoseMatrix = false;
-
     if (qrAlgorithm == EigenDenseQR) {
 #ifdef PROFILE_DIAGNOSE
         Base::TimeElapsed DenseQR_start_time;
@@ -4987,26 +5294,29 @@ int System::diagnose(Algorithm alg)
         Eigen::FullPivHouseholderQR<Eigen::MatrixXd> qrJT;
         // Here we give the system the possibility to run the two QR decompositions in parallel,
         // depending on the load of the system so we are using the default std::launch::async |
-        // std::launch::deferred policy, as nobody better than the system nows if it can run the
-        // task in parallel or is oversubscribed and should deferred it. Care to wait() for the
-        // future before any prospective detection of conflicting/redundant, because the
-        // redundant solve modifies pdiagnoselist and it would NOT be thread-safe. Care to call
-        // the thread with silent=true, unless the present thread does not use Base::Console, or
-        // the launch policy is set to std::launch::deferred policy, as it is not thread-safe to
-        // use them in both at the same time.
+        // std::launch::deferred policy for big components, as nobody better than the system
+        // nows if it can run the task in parallel or is oversubscribed and should deferred it.
+        // Care to wait() for the future before any prospective detection of
+        // conflicting/redundant, because the redundant solve modifies pdiagnoselist and it would
+        // NOT be thread-safe. Care to call the thread with silent=true, unless the present
+        // thread does not use Base::Console, or the launch policy is set to
+        // std::launch::deferred policy, as it is not thread-safe to use them in both at the
+        // same time.
         //
-        // identifyDependentParametersDenseQR(J, jacobianconstraintmap, pdiagnoselist, true)
+        // identifyDependentParametersDenseQR(J, jacobianconstraintmap, pdiagnoselist, groups,
+        // true)
         //
-        auto fut = std::async(&System::identifyDependentParametersDenseQR,
+        auto fut = std::async(policy,
+                              &System::identifyDependentParametersDenseQR,
                               this,
                               J,
                               jacobianconstraintmap,
                               pdiagnoselist,
+                              std::ref(diagnosis.dependentParameterGroups),
                               true);
 
         makeDenseQRDecomposition(J, jacobianconstraintmap, qrJT, rank, R);
 
-        int paramsNum = qrJT.rows();
         int constrNum = qrJT.cols();
 
         // This function is legacy code that was used to obtain partial geometry dependency
@@ -5017,24 +5327,24 @@ int System::diagnose(Algorithm alg)
 
         fut.wait();  // wait for the execution of identifyDependentParametersSparseQR to finish
 
-        dofs = paramsNum - rank;  // unless overconstraint, which will be overridden below
+        diagnosis.rank = rank;
+        diagnosis.constrNum = constrNum;
+        diagnosis.nonredundantConstrNum = constrNum;
 
         // Detecting conflicting or redundant constraints
         if (constrNum > rank) {
             // conflicting or redundant constraints
-            int nonredundantconstrNum;
             identifyConflictingRedundantConstraints(alg,
                                                     qrJT,
+                                                    clistC,
                                                     jacobianconstraintmap,
                                                     tagmultiplicity,
                                                     pdiagnoselist,
                                                     R,
                                                     constrNum,
                                                     rank,
-                                                    nonredundantconstrNum);
-            if (paramsNum == rank && nonredundantconstrNum > rank) {  // over-constrained
-                dofs = paramsNum - nonredundantconstrNum;
-            }
+                                                    diagnosis.nonredundantConstrNum,
+                                                    conflictGroups);
         }
 
 #ifdef PROFILE_DIAGNOSE
@@ -5056,25 +5366,30 @@ int System::diagnose(Algorithm alg)
         Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> SqrJT;
         // Here we give the system the possibility to run the two QR decompositions in parallel,
         // depending on the load of the system so we are using the default std::launch::async |
-        // std::launch::deferred policy, as nobody better than the system nows if it can run the
-        // task in parallel or is oversubscribed and should deferred it. Care to wait() for the
-        // future before any prospective detection of conflicting/redundant, because the
-        // redundant solve modifies pdiagnoselist and it would NOT be thread-safe. Care to call
-        // the thread with silent=true, unless the present thread does not use Base::Console, or
-        // the launch policy is set to std::launch::deferred policy, as it is not thread-safe to
-        // use them in both at the same time.
+        // std::launch::deferred policy for big components, as nobody better than the system
+        // nows if it can run the task in parallel or is oversubscribed and should deferred it.
+        // Care to wait() for the future before any prospective detection of
+        // conflicting/redundant, because the redundant solve modifies pdiagnoselist and it would
+        // NOT be thread-safe. Care to call the thread with silent=true, unless the present
+        // thread does not use Base::Console, or the launch policy is set to
+        // std::launch::deferred policy, as it is not thread-safe to use them in both at the
+        // same time.
         //
-        // identifyDependentParametersSparseQR(J, jacobianconstraintmap, pdiagnoselist, true)
+        // identifyDependentParametersSparseQR(J, jacobianconstraintmap, pdiagnoselist, groups,
+        // true)
         //
         // Debug:
         // auto fut =
         // std::async(std::launch::deferred,&System::identifyDependentParametersSparseQR, this,
-        // J, jacobianconstraintmap, pdiagnoselist, false);
-        auto fut = std::async(&System::identifyDependentParametersSparseQR,
+        // J, jacobianconstraintmap, pdiagnoselist, std::ref(diagnosis.dependentParameterGroups),
+        // false);
+        auto fut = std::async(policy,
+                              &System::identifyDependentParametersSparseQR,
                               this,
                               J,
                               jacobianconstraintmap,
                               pdiagnoselist,
+                              std::ref(diagnosis.dependentParameterGroups),
                               /*silent=*/true);
 
         makeSparseQRDecomposition(J,
@@ -5085,31 +5400,27 @@ int System::diagnose(Algorithm alg)
                                   /*transposed=*/true,
                                   /*silent=*/false);
 
-        int paramsNum = SqrJT.rows();
         int constrNum = SqrJT.cols();
 
         fut.wait();  // wait for the execution of identifyDependentParametersSparseQR to finish
 
-        dofs = paramsNum - rank;  // unless overconstraint, which will be overridden below
+        diagnosis.rank = rank;
+        diagnosis.constrNum = constrNum;
+        diagnosis.nonredundantConstrNum = constrNum;
 
         // Detecting conflicting or redundant constraints
         if (constrNum > rank) {
-            int nonredundantconstrNum;
-
             identifyConflictingRedundantConstraints(alg,
                                                     SqrJT,
+                                                    clistC,
                                                     jacobianconstraintmap,
                                                     tagmultiplicity,
                                                     pdiagnoselist,
                                                     R,
                                                     constrNum,
                                                     rank,
-                                                    nonredundantconstrNum);
-
-            if (paramsNum == rank && nonredundantconstrNum > rank) {
-                // over-constrained
-                dofs = paramsNum - nonredundantconstrNum;
-            }
+                                                    diagnosis.nonredundantConstrNum,
+                                                    conflictGroups);
         }
 
 #ifdef PROFILE_DIAGNOSE
@@ -5122,6 +5433,198 @@ int System::diagnose(Algorithm alg)
     }
 #endif
 
+    // store the result by index so that it can be reused for another component with the same key
+    std::map<Constraint*, int> constraintindex;
+    for (int i = 0; i < int(clistC.size()); i++) {
+        constraintindex[clistC[i]] = i;
+        if (redundant.count(clistC[i]) > 0) {
+            diagnosis.redundant.push_back(i);
+        }
+    }
+    for (const auto& cGroup : conflictGroups) {
+        auto& group = diagnosis.conflictGroups.emplace_back();
+        for (auto constr : cGroup) {
+            group.push_back(constraintindex.at(constr));
+        }
+    }
+}
+
+int System::diagnose(Algorithm alg)
+{
+    // Analyses the constrainess grad of the system and provides feedback
+    // The vector "conflictingTags" will hold a group of conflicting constraints
+
+    // Hint 1: Only constraints with tag >= 0 are taken into account
+    // Hint 2: Constraints tagged with 0 are treated as high priority
+    //         constraints and they are excluded from the returned
+    //         list of conflicting constraints. Therefore, this function
+    //         will provide no feedback about possible conflicts between
+    //         two high priority constraints. For this reason, tagging
+    //         constraints with 0 should be used carefully.
+    hasDiagnosis = false;
+    if (!hasUnknowns) {
+        dofs = -1;
+        return dofs;
+    }
+
+#ifdef _DEBUG_TO_FILE
+    SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
+#endif
+
+    // Input parameters' lists:
+    // plist            =>  list of all the parameters of the system, e.g. each coordinate
+    //                      of a point
+    // pdrivenlist      =>  list of the parameters that are driven by other parameters
+    //                      (e.g. value of driven constraints)
+
+    // When adding an external geometry or a constraint on an external geometry the array
+    // 'plist' is empty.
+    // So, we must abort here because otherwise we would create an invalid matrix and make
+    // the application eventually crash. This fixes issues #0002372/#0002373.
+    if (plist.empty() || (plist.size() - pdrivenlist.size()) == 0) {
+        hasDiagnosis = true;
+        emptyDiagnoseMatrix = true;
+        dofs = 0;
+        return dofs;
+    }
+
+    redundant.clear();
+    conflictingTags.clear();
+    redundantTags.clear();
+    partiallyRedundantTags.clear();
+    pDependentParameters.clear();
+    pDependentParametersGroups.clear();
+
+#ifndef EIGEN_SPARSEQR_COMPATIBLE
+    if (qrAlgorithm == EigenSparseQR) {
+        Base::Console().warning("SparseQR not supported by you current version of Eigen. It "
+                                "requires Eigen 3.2.2 or higher. Falling back to Dense QR\n");
+        qrAlgorithm = EigenDenseQR;
+    }
+#endif
+
+    // list of parameters to be diagnosed in this routine (removes value parameters from driven
+    // constraints)
+    GCS::VEC_pD pdiagnoselist;
+    SET_pD pdrivenset(pdrivenlist.begin(), pdrivenlist.end());
+    std::ranges::copy_if(plist, std::back_inserter(pdiagnoselist), [&pdrivenset](auto param) {
+        return pdrivenset.count(param) == 0;
+    });
+
+    // tag multiplicity gives the number of solver constraints associated with the same tag
+    // A tag generally corresponds to the Sketcher constraint index - There are special tag values,
+    // like 0 and -1.
+    std::map<int, int> tagmultiplicity;
+    for (auto constr : clist) {
+        if (constr->getTag() >= 0 && constr->isDriving()) {
+            auto [it, inserted] = tagmultiplicity.emplace(constr->getTag(), 0);
+            if (!inserted) {
+                it->second++;
+            }
+        }
+    }
+
+    // The reduced Jacobian is block diagonal, with a block for each component of constraints
+    // and parameters that do not depend on each other. The components are diagnosed one by one,
+    // which is much cheaper than decomposing the whole Jacobian, and the diagnosis of a
+    // component that is unchanged since the last call is reused. As the sketcher rebuilds the
+    // system after each edit, only the component of an added or removed constraint is
+    // decomposed again.
+    std::vector<double> settings {double(alg),
+                                  double(qrAlgorithm),
+                                  qrpivotThreshold,
+                                  convergenceRedundant,
+                                  double(maxIterRedundant),
+                                  double(sketchSizeMultiplierRedundant),
+                                  LM_epsRedundant,
+                                  LM_eps1Redundant,
+                                  LM_tauRedundant,
+                                  DL_tolgRedundant,
+                                  DL_tolxRedundant,
+                                  DL_tolfRedundant,
+                                  double(dogLegGaussStep)};
+    if (settings != diagnosisCacheSettings) {
+        diagnosisCache.clear();
+        diagnosisCacheSettings = settings;
+    }
+
+    std::vector<std::vector<Constraint*>> clistsD;
+    std::vector<GCS::VEC_pD> plistsD;
+    makeDiagnosisComponents(pdiagnoselist, clistsD, plistsD);
+
+    int paramsNum = 0;
+    int rank = 0;
+    int constrNum = 0;
+    int nonredundantconstrNum = 0;
+    std::vector<std::vector<Constraint*>> conflictGroups;
+    std::unordered_multimap<std::size_t, ComponentDiagnosis> cache;
+    for (std::size_t cid = 0; cid < clistsD.size(); cid++) {
+        const std::vector<Constraint*>& clistC = clistsD[cid];
+        GCS::VEC_pD& plistC = plistsD[cid];
+
+        ComponentDiagnosis diagnosis;
+        std::size_t key = makeDiagnosisKey(clistC, plistC, tagmultiplicity, diagnosis);
+        auto [first, last] = diagnosisCache.equal_range(key);
+        auto cached = std::find_if(first, last, [&diagnosis](const auto& item) {
+            return item.second.structure == diagnosis.structure
+                && item.second.values == diagnosis.values;
+        });
+        if (cached != last) {
+            diagnosis = cached->second;
+            for (int i : diagnosis.redundant) {
+                redundant.insert(clistC[i]);
+            }
+        }
+        else {
+            diagnoseComponent(alg, clistC, plistC, tagmultiplicity, diagnosis);
+        }
+
+        paramsNum += int(plistC.size());
+        rank += diagnosis.rank;
+        constrNum += diagnosis.constrNum;
+        nonredundantconstrNum += diagnosis.nonredundantConstrNum;
+        for (const auto& group : diagnosis.dependentParameterGroups) {
+            auto& pgroup = pDependentParametersGroups.emplace_back();
+            for (int j : group) {
+                pgroup.push_back(plistC[j]);
+                pDependentParameters.push_back(plistC[j]);
+            }
+        }
+        for (const auto& group : diagnosis.conflictGroups) {
+            auto& cgroup = conflictGroups.emplace_back();
+            for (int i : group) {
+                cgroup.push_back(clistC[i]);
+            }
+        }
+
+        cache.emplace(key, std::move(diagnosis));
+    }
+    diagnosisCache = std::move(cache);
+
+    // this function will exit with a diagnosis and, unless overridden below, with full DoFs
+    hasDiagnosis = true;
+    dofs = paramsNum;
+
+    if (constrNum == 0) {  // only driven constraints
+        pDependentParameters.clear();
+        pDependentParametersGroups.clear();
+        return dofs;
+    }
+
+    // From here on, presuming there is at least one driving constraint.
+    emptyDiagnoseMatrix = false;
+
+    dofs = paramsNum - rank;  // unless overconstraint, which will be overridden below
+
+    // Detecting conflicting or redundant constraints
+    if (constrNum > rank) {
+        identifyConflictingRedundantTags(conflictGroups);
+
+        if (paramsNum == rank && nonredundantconstrNum > rank) {  // over-constrained
+            dofs = paramsNum - nonredundantconstrNum;
+        }
+    }
+
     return dofs;
 }
 
@@ -5302,6 +5805,7 @@ void System::makeSparseQRDecomposition(
 void System::identifyDependentParametersDenseQR(const Eigen::MatrixXd& J,
                                                 const std::map<int, int>& jacobianconstraintmap,
                                                 const GCS::VEC_pD& pdiagnoselist,
+                                                std::vector<std::vector<int>>& groups,
                                                 bool silent)
 {
     Eigen::FullPivHouseholderQR<Eigen::MatrixXd> qrJ;
@@ -5311,13 +5815,14 @@ void System::identifyDependentParametersDenseQR(const Eigen::MatrixXd& J,
 
     makeDenseQRDecomposition(J, jacobianconstraintmap, qrJ, rank, Rparams, false, true);
 
-    identifyDependentParameters(qrJ, Rparams, rank, pdiagnoselist, silent);
+    identifyDependentParameters(qrJ, Rparams, rank, pdiagnoselist, groups, silent);
 }
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
 void System::identifyDependentParametersSparseQR(const Eigen::MatrixXd& J,
                                                  const std::map<int, int>& jacobianconstraintmap,
                                                  const GCS::VEC_pD& pdiagnoselist,
+                                                 std::vector<std::vector<int>>& groups,
                                                  bool silent)
 {
     Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> SqrJ;
@@ -5333,7 +5838,7 @@ void System::identifyDependentParametersSparseQR(const Eigen::MatrixXd& J,
                               false,
                               true);  // do not transpose allow one to diagnose parameters
 
-    identifyDependentParameters(SqrJ, Rparams, nontransprank, pdiagnoselist, silent);
+    identifyDependentParameters(SqrJ, Rparams, nontransprank, pdiagnoselist, groups, silent);
 }
 #endif
 
@@ -5341,7 +5846,8 @@ template<typename T>
 void System::identifyDependentParameters(T& qrJ,
                                          Eigen::MatrixXd& Rparams,
                                          int rank,
-                                         const GCS::VEC_pD& pdiagnoselist,
+                                         [[maybe_unused]] const GCS::VEC_pD& pdiagnoselist,
+                                         std::vector<std::vector<int>>& groups,
                                          bool silent)
 {
     (void)silent;  // silent is only used in debug code, but it is important as Base::Console is not
@@ -5358,20 +5864,18 @@ void System::identifyDependentParameters(T& qrJ,
     }
 #endif
 
-    pDependentParametersGroups.resize(qrJ.cols() - rank);
+    groups.resize(qrJ.cols() - rank);
     for (int j = rank; j < qrJ.cols(); j++) {
         for (int row = 0; row < rank; row++) {
             if (fabs(Rparams(row, j)) > 1e-10) {
                 int origCol = qrJ.colsPermutation().indices()[row];
 
-                pDependentParametersGroups[j - rank].push_back(pdiagnoselist[origCol]);
-                pDependentParameters.push_back(pdiagnoselist[origCol]);
+                groups[j - rank].push_back(origCol);
             }
         }
         int origCol = qrJ.colsPermutation().indices()[j];
 
-        pDependentParametersGroups[j - rank].push_back(pdiagnoselist[origCol]);
-        pDependentParameters.push_back(pdiagnoselist[origCol]);
+        groups[j - rank].push_back(origCol);
     }
 
 #ifdef _GCS_DEBUG
@@ -5379,8 +5883,14 @@ void System::identifyDependentParameters(T& qrJ,
         SolverReportingManager::Manager().LogMatrix("PermMatrix",
                                                     (Eigen::MatrixXd)qrJ.colsPermutation());
 
-        SolverReportingManager::Manager().LogGroupOfParameters("ParameterGroups",
-                                                               pDependentParametersGroups);
+        std::vector<std::vector<double*>> parameterGroups;
+        for (const auto& group : groups) {
+            auto& pgroup = parameterGroups.emplace_back();
+            for (int j : group) {
+                pgroup.push_back(pdiagnoselist[j]);
+            }
+        }
+        SolverReportingManager::Manager().LogGroupOfParameters("ParameterGroups", parameterGroups);
     }
 
 #endif
@@ -5495,28 +6005,30 @@ template<typename T>
 void System::identifyConflictingRedundantConstraints(
     Algorithm alg,
     const T& qrJT,
+    const std::vector<Constraint*>& clistC,
     const std::map<int, int>& jacobianconstraintmap,
     const std::map<int, int>& tagmultiplicity,
     GCS::VEC_pD& pdiagnoselist,
     Eigen::MatrixXd& R,
     int constrNum,
     int rank,
-    int& nonredundantconstrNum)
+    int& nonredundantconstrNum,
+    std::vector<std::vector<Constraint*>>& conflictGroups)
 {
     eliminateNonZerosOverPivotInUpperTriangularMatrix(R, rank);
 
-    std::vector<std::vector<Constraint*>> conflictGroups(constrNum - rank);
+    conflictGroups.assign(constrNum - rank, {});
     for (int j = rank; j < constrNum; j++) {
         for (int row = 0; row < rank; row++) {
             if (fabs(R(row, j)) > 1e-10) {
                 int origCol = qrJT.colsPermutation().indices()[row];
 
-                conflictGroups[j - rank].push_back(clist[jacobianconstraintmap.at(origCol)]);
+                conflictGroups[j - rank].push_back(clistC[jacobianconstraintmap.at(origCol)]);
             }
         }
         int origCol = qrJT.colsPermutation().indices()[j];
 
-        conflictGroups[j - rank].push_back(clist[jacobianconstraintmap.at(origCol)]);
+        conflictGroups[j - rank].push_back(clistC[jacobianconstraintmap.at(origCol)]);
     }
 
     // Augment the information regarding the group of constraints that are conflicting or redundant.
@@ -5620,8 +6132,8 @@ void System::identifyConflictingRedundantConstraints(
     }
 
     std::vector<Constraint*> clistTmp;
-    clistTmp.reserve(clist.size());
-    std::ranges::copy_if(clist, std::back_inserter(clistTmp), [&skipped](const auto& constr) {
+    clistTmp.reserve(clistC.size());
+    std::ranges::copy_if(clistC, std::back_inserter(clistTmp), [&skipped](const auto& constr) {
         return (constr->isDriving() && skipped.count(constr) == 0);
     });
 
@@ -5685,6 +6197,12 @@ void System::identifyConflictingRedundantConstraints(
     }
     delete subSysTmp;
 
+    nonredundantconstrNum = constrNum;
+}
+
+void System::identifyConflictingRedundantTags(
+    const std::vector<std::vector<Constraint*>>& conflictGroups)
+{
     // simplified output of conflicting tags
     SET_I conflictingTagsSet;
     for (const auto& cGroup : conflictGroups) {
@@ -5728,8 +6246,6 @@ void System::identifyConflictingRedundantConstraints(
 
     partiallyRedundantTags.resize(partiallyRedundantTagsSet.size());
     std::ranges::copy(partiallyRedundantTagsSet, partiallyRedundantTags.begin());
-
-    nonredundantconstrNum = constrNum;
 }
 
 void System::clearSubSystems()
@@ -5739,6 +6255,7 @@ void System::clearSubSystems()
     deleteAllContent(subSystemsAux);
     subSystems.clear();
     subSystemsAux.clear();
+    incrementalHessians.clear();
 }
 
 double lineSearch(SubSystem* subsys, Eigen::VectorXd& xdir)
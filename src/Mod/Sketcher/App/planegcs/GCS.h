@@ -23,6 +23,8 @@
 #ifndef PLANEGCS_GCS_H
 #define PLANEGCS_GCS_H
 
+#include <unordered_map>
+
 #include <Eigen/QR>
 
 #include "../../SketcherGlobal.h"
@@ -78,6 +80,15 @@ enum QRAlgorithm
     EigenSparseQR = 1
 };
 
+// Storage of the Jacobian in the Levenberg-Marquardt and DogLeg solvers. Each constraint only
+// depends on a few parameters, so a sparse Jacobian scales much better for large sketches.
+// The DogLeg solver always takes the least norm LDLT Gauss step with a sparse Jacobian.
+enum JacobianStorage
+{
+    DenseJacobian = 0,
+    SparseJacobian = 1
+};
+
 enum DebugMode
 {
     NoDebug = 0,
@@ -123,6 +134,7 @@ private:
 
     std::vector<SubSystem*> subSystems, subSystemsAux;
     void clearSubSystems();
+    std::vector<Eigen::MatrixXd> incrementalHessians;  // per component, see solveIncremental()
 
     VEC_D reference;
     void setReference();      // copies the current parameter values to reference
@@ -137,20 +149,62 @@ private:
     std::set<Constraint*> redundant;
     VEC_I conflictingTags, redundantTags, partiallyRedundantTags;
 
-    bool hasUnknowns;   // if plist is filled with the unknown parameters
-    bool hasDiagnosis;  // if dofs, conflictingTags, redundantTags are up to date
-    bool isInit;        // if plists, clists, reductionmaps are up to date
+    bool hasUnknowns;    // if plist is filled with the unknown parameters
+    bool hasDiagnosis;   // if dofs, conflictingTags, redundantTags are up to date
+    bool isInit;         // if plists, clists, reductionmaps are up to date
+    bool isIncremental;  // if the last solution was calculated by solveIncremental()
 
     bool emptyDiagnoseMatrix;  // false only if there is at least one driving constraint.
 
+    // The diagnosis of a decoupled component with the parameters and constraints given by their
+    // index in the component. The key identifies the component, it consists of the structure
+    // (types, tags and parameter indices of the constraints) and the values (parameters, errors
+    // and gradients).
+    struct ComponentDiagnosis
+    {
+        std::vector<int> structure;
+        std::vector<double> values;
+        int rank = 0;
+        int constrNum = 0;  // rows of the reduced Jacobian
+        int nonredundantConstrNum = 0;
+        std::vector<std::vector<int>> dependentParameterGroups;
+        std::vector<std::vector<int>> conflictGroups;
+        std::vector<int> redundant;
+    };
+    // The diagnoses of the components of the last call of diagnose() by the hash of their key.
+    // This is not reset by clear() because the sketcher rebuilds the system after every change.
+    std::unordered_multimap<std::size_t, ComponentDiagnosis> diagnosisCache;
+    // the solver settings the cached diagnoses were calculated with
+    std::vector<double> diagnosisCacheSettings;
+
+    // solves the decoupled components cids and returns the worst result
+    int solveComponents(const VEC_I& cids, bool isFine, Algorithm alg, bool isRedundantsolving);
     int solve_BFGS(SubSystem* subsys, bool isFine = true, bool isRedundantsolving = false);
+    // JacobianMatrix is either Eigen::MatrixXd or Eigen::SparseMatrix<double>
+    template<typename JacobianMatrix>
     int solve_LM(SubSystem* subsys, bool isRedundantsolving = false);
+    template<typename JacobianMatrix>
     int solve_DL(SubSystem* subsys, bool isRedundantsolving = false);
 
     void makeReducedJacobian(Eigen::MatrixXd& J,
                              std::map<int, int>& jacobianconstraintmap,
-                             GCS::VEC_pD& pdiagnoselist,
-                             std::map<int, int>& tagmultiplicity);
+                             const std::vector<Constraint*>& clistC,
+                             const GCS::VEC_pD& pdiagnoselist);
+
+    // partitions the driving constraints and the parameters to be diagnosed into components
+    // that can be diagnosed independently
+    void makeDiagnosisComponents(const GCS::VEC_pD& pdiagnoselist,
+                                 std::vector<std::vector<Constraint*>>& clists,
+                                 std::vector<GCS::VEC_pD>& plists);
+    std::size_t makeDiagnosisKey(const std::vector<Constraint*>& clistC,
+                                 const GCS::VEC_pD& pdiagnoselist,
+                                 const std::map<int, int>& tagmultiplicity,
+                                 ComponentDiagnosis& diagnosis);
+    void diagnoseComponent(Algorithm alg,
+                           const std::vector<Constraint*>& clistC,
+                           GCS::VEC_pD& pdiagnoselist,
+                           const std::map<int, int>& tagmultiplicity,
+                           ComponentDiagnosis& diagnosis);
 
     void makeDenseQRDecomposition(const Eigen::MatrixXd& J,
                                   const std::map<int, int>& jacobianconstraintmap,
@@ -180,15 +234,21 @@ private:
         int rank);
 
     template<typename T>
-    void identifyConflictingRedundantConstraints(Algorithm alg,
-                                                 const T& qrJT,
-                                                 const std::map<int, int>& jacobianconstraintmap,
-                                                 const std::map<int, int>& tagmultiplicity,
-                                                 GCS::VEC_pD& pdiagnoselist,
-                                                 Eigen::MatrixXd& R,
-                                                 int constrNum,
-                                                 int rank,
-                                                 int& nonredundantconstrNum);
+    void identifyConflictingRedundantConstraints(
+        Algorithm alg,
+        const T& qrJT,
+        const std::vector<Constraint*>& clistC,
+        const std::map<int, int>& jacobianconstraintmap,
+        const std::map<int, int>& tagmultiplicity,
+        GCS::VEC_pD& pdiagnoselist,
+        Eigen::MatrixXd& R,
+        int constrNum,
+        int rank,
+        int& nonredundantconstrNum,
+        std::vector<std::vector<Constraint*>>& conflictGroups);
+
+    void identifyConflictingRedundantTags(
+        const std::vector<std::vector<Constraint*>>& conflictGroups);
 
     void eliminateNonZerosOverPivotInUpperTriangularMatrix(Eigen::MatrixXd& R, int rank);
 
@@ -196,19 +256,23 @@ private:
     void identifyDependentParametersSparseQR(const Eigen::MatrixXd& J,
                                              const std::map<int, int>& jacobianconstraintmap,
                                              const GCS::VEC_pD& pdiagnoselist,
+                                             std::vector<std::vector<int>>& groups,
                                              bool silent = true);
 #endif
 
     void identifyDependentParametersDenseQR(const Eigen::MatrixXd& J,
                                             const std::map<int, int>& jacobianconstraintmap,
                                             const GCS::VEC_pD& pdiagnoselist,
+                                            std::vector<std::vector<int>>& groups,
                                             bool silent = true);
 
+    // groups of dependent parameters given by their index in pdiagnoselist
     template<typename T>
     void identifyDependentParameters(T& qrJ,
                                      Eigen::MatrixXd& Rparams,
                                      int rank,
                                      const GCS::VEC_pD& pdiagnoselist,
+                                     std::vector<std::vector<int>>& groups,
                                      bool silent = true);
 
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
@@ -223,7 +287,9 @@ public:
     double convergence;
     double convergenceRedundant;
     QRAlgorithm qrAlgorithm;
-    DogLegGaussStep dogLegGaussStep;
+    DogLegGaussStep dogLegGaussStep;  // ignored with a sparse Jacobian, see JacobianStorage
+    JacobianStorage jacobianStorage;
+    int minParallelSolveParams;  // decoupled components are solved concurrently from this size
     double qrpivotThreshold;
     DebugMode debugMode;
     double LM_eps;
@@ -544,6 +610,11 @@ public:
     void initSolution(Algorithm alg = DogLeg);
 
     int solve(bool isFine = true, Algorithm alg = DogLeg, bool isRedundantsolving = false);
+    // Solves only the decoupled components that contain temporary constraints, i.e. the
+    // geometry that is being dragged, starting from the current parameter values instead of the
+    // reference, and with the Hessian approximation of the previous call for the SQP solver.
+    // applySolution() then only writes back the parameters of these components.
+    int solveIncremental(bool isFine = true, Algorithm alg = DogLeg);
     int solve(VEC_pD& params,
               bool isFine = true,
               Algorithm alg = DogLeg,
@@ -556,6 +627,13 @@ public:
               SubSystem* subsysB,
               bool isFine = true,
               bool isRedundantsolving = false);
+    // If hessian is not empty, it is used as initial approximation of the Hessian and on success
+    // it is replaced with the final approximation.
+    int solve(SubSystem* subsysA,
+              SubSystem* subsysB,
+              Eigen::MatrixXd* hessian,
+              bool isFine = true,
+              bool isRedundantsolving = false);
 
     void applySolution();
     void undoSolution();
@@ -276,6 +276,21 @@ void SubSystem::calcJacobi(Eigen::MatrixXd& jacobi)
     calcJacobi(plist, jacobi);
 }
 
+void SubSystem::calcJacobi(Eigen::SparseMatrix<double>& jacobi)
+{
+    std::vector<Eigen::Triplet<double>> entries;
+    entries.reserve(4 * csize);
+    for (int i = 0; i < csize; i++) {
+        // c2p holds pointers into pvals, so the column is the offset in pvals
+        for (double* param : c2p[clist[i]]) {
+            entries.emplace_back(i, int(param - pvals.data()), clist[i]->grad(param));
+        }
+    }
+
+    jacobi.resize(csize, psize);
+    jacobi.setFromTriplets(entries.begin(), entries.end());
+}
+
 void SubSystem::calcGrad(VEC_pD& params, Eigen::VectorXd& grad)
 {
     assert(grad.size() == int(params.size()));
@@ -49,6 +49,7 @@
 #define DEFAULT_SOLVER_DEBUG 1    // None=0, Minimal=1, IterationLevel=2
 #define MAX_ITER_MULTIPLIER false
 #define DEFAULT_DOGLEG_GAUSS_STEP 0  // FullPivLU = 0, LeastNormFullPivLU = 1, LeastNormLdlt = 2
+#define DEFAULT_JACOBIAN_STORAGE 0   // Dense = 0, Sparse = 1
 
 using namespace SketcherGui;
 using namespace Gui::TaskView;
@@ -70,6 +71,7 @@ TaskSketcherSolverAdvanced::TaskSketcherSolverAdvanced(ViewProviderSketch* sketc
 
     ui->comboBoxDefaultSolver->onRestore();
     ui->comboBoxDogLegGaussStep->onRestore();
+    ui->comboBoxJacobianStorage->onRestore();
     ui->spinBoxMaxIter->onRestore();
     ui->checkBoxSketchSizeMultiplier->onRestore();
     ui->lineEditConvergence->onRestore();
@@ -97,6 +99,10 @@ void TaskSketcherSolverAdvanced::setupConnections()
             qOverload<int>(&QComboBox::currentIndexChanged),
             this,
             &TaskSketcherSolverAdvanced::onComboBoxDogLegGaussStepCurrentIndexChanged);
+    connect(ui->comboBoxJacobianStorage,
+            qOverload<int>(&QComboBox::currentIndexChanged),
+            this,
+            &TaskSketcherSolverAdvanced::onComboBoxJacobianStorageCurrentIndexChanged);
     connect(ui->spinBoxMaxIter,
             qOverload<int>(&QSpinBox::valueChanged),
             this,
@@ -193,7 +199,9 @@ void TaskSketcherSolverAdvanced::updateDefaultMethodParameters()
     int currentindex = ui->comboBoxDefaultSolver->currentIndex();
     int redundantcurrentindex = ui->comboBoxRedundantDefaultSolver->currentIndex();
 
-    if (redundantcurrentindex == 2 || currentindex == 2) {
+    // the sparse Jacobian always uses the least norm LDLT step
+    if ((redundantcurrentindex == 2 || currentindex == 2)
+        && ui->comboBoxJacobianStorage->currentIndex() != GCS::SparseJacobian) {
         ui->comboBoxDogLegGaussStep->setEnabled(true);
     }
     else {
@@ -282,7 +290,9 @@ void TaskSketcherSolverAdvanced::updateRedundantMethodParameters()
     int currentindex = ui->comboBoxDefaultSolver->currentIndex();
     int redundantcurrentindex = ui->comboBoxRedundantDefaultSolver->currentIndex();
 
-    if (redundantcurrentindex == 2 || currentindex == 2) {
+    // the sparse Jacobian always uses the least norm LDLT step
+    if ((redundantcurrentindex == 2 || currentindex == 2)
+        && ui->comboBoxJacobianStorage->currentIndex() != GCS::SparseJacobian) {
         ui->comboBoxDogLegGaussStep->setEnabled(true);
     }
     else {
@@ -550,6 +560,14 @@ void TaskSketcherSolverAdvanced::onComboBoxDogLegGaussStepCurrentIndexChanged(in
     updateDefaultMethodParameters();
 }
 
+void TaskSketcherSolverAdvanced::onComboBoxJacobianStorageCurrentIndexChanged(int index)
+{
+    ui->comboBoxJacobianStorage->onSave();
+    const_cast<Sketcher::Sketch&>(sketchView->getSketchObject()->getSolvedSketch())
+        .setJacobianStorage((GCS::JacobianStorage)index);
+    updateDefaultMethodParameters();
+}
+
 void TaskSketcherSolverAdvanced::onSpinBoxMaxIterValueChanged(int i)
 {
     ui->spinBoxMaxIter->onSave();
@@ -685,6 +703,7 @@ void TaskSketcherSolverAdvanced::onPushButtonDefaultsClicked(bool checked /* = f
     // Set other settings
     hGrp->SetInt("DefaultSolver", DEFAULT_SOLVER);
     hGrp->SetInt("DogLegGaussStep", DEFAULT_DOGLEG_GAUSS_STEP);
+    hGrp->SetInt("JacobianStorage", DEFAULT_JACOBIAN_STORAGE);
 
     hGrp->SetInt("RedundantDefaultSolver", DEFAULT_RSOLVER);
     hGrp->SetInt("MaxIter", MAX_ITER);
@@ -699,6 +718,7 @@ void TaskSketcherSolverAdvanced::onPushButtonDefaultsClicked(bool checked /* = f
 
     ui->comboBoxDefaultSolver->onRestore();
     ui->comboBoxDogLegGaussStep->onRestore();
+    ui->comboBoxJacobianStorage->onRestore();
     ui->spinBoxMaxIter->onRestore();
     ui->checkBoxSketchSizeMultiplier->onRestore();
     ui->lineEditConvergence->onRestore();
@@ -740,6 +760,8 @@ void TaskSketcherSolverAdvanced::updateSketchObject()
         static_cast<GCS::Algorithm>(ui->comboBoxDefaultSolver->currentIndex());
     const_cast<Sketcher::Sketch&>(sketchView->getSketchObject()->getSolvedSketch())
         .setDogLegGaussStep((GCS::DogLegGaussStep)ui->comboBoxDogLegGaussStep->currentIndex());
+    const_cast<Sketcher::Sketch&>(sketchView->getSketchObject()->getSolvedSketch())
+        .setJacobianStorage((GCS::JacobianStorage)ui->comboBoxJacobianStorage->currentIndex());
 
     updateDefaultMethodParameters();
     updateRedundantMethodParameters();
@@ -73,6 +73,8 @@ void PropertySheet::clear()
     cellToPropertyNameMap.clear();
     documentObjectToCellMap.clear();
     cellToDocumentObjectMap.clear();
+    cellToReferencedCellsMap.clear();
+    cellToDependantCellsMap.clear();
     aliasProp.clear();
     revAliasProp.clear();
 
@@ -289,6 +291,8 @@ PropertySheet::PropertySheet(const PropertySheet& other)
     , cellToPropertyNameMap(other.cellToPropertyNameMap)
     , documentObjectToCellMap(other.documentObjectToCellMap)
     , cellToDocumentObjectMap(other.cellToDocumentObjectMap)
+    , cellToReferencedCellsMap(other.cellToReferencedCellsMap)
+    , cellToDependantCellsMap(other.cellToDependantCellsMap)
     , aliasProp(other.aliasProp)
     , revAliasProp(other.revAliasProp)
     , updateCount(other.updateCount)
@@ -1365,6 +1369,8 @@ void PropertySheet::addDependencies(CellAddress key)
         return;
     }
 
+    std::vector<CellAddress> referenced;
+
     for (auto& var : expression->getIdentifiers()) {
         for (auto& dep : var.first.getDep(true)) {
             App::DocumentObject* docObj = dep.first;
@@ -1383,6 +1389,13 @@ void PropertySheet::addDependencies(CellAddress key)
                 propertyNameToCellMap[propName].insert(key);
                 cellToPropertyNameMap[key].insert(propName);
 
+                if (docObj == owner && !name.empty()) {
+                    CellAddress address = stringToAddress(name.c_str(), true);
+                    if (address.isValid()) {
+                        referenced.push_back(address);
+                    }
+                }
+
                 // Also an alias?
                 if (!name.empty() && docObj->isDerivedFrom<Sheet>()) {
                     auto other = static_cast<Sheet*>(docObj);
@@ -1395,11 +1408,59 @@ void PropertySheet::addDependencies(CellAddress key)
                         // Insert into maps
                         propertyNameToCellMap[propName].insert(key);
                         cellToPropertyNameMap[key].insert(std::move(propName));
+
+                        if (docObj == owner) {
+                            referenced.push_back(j->second);
+                        }
                     }
                 }
             }
         }
     }
+
+    setReferencedCells(key, std::move(referenced));
+}
+
+/**
+ * Replace the cells of this sheet referenced by the cell at \a key.
+ *
+ * This keeps the same information as propertyNameToCellMap for references within the sheet,
+ * but as a graph of cell addresses, so that Sheet::execute() can collect the dependants of a
+ * changed cell without building and looking up a string for each of them.
+ *
+ * @param key        Address of cell containing the expression.
+ * @param referenced Cells referenced by the expression, may contain duplicates.
+ */
+
+void PropertySheet::setReferencedCells(CellAddress key, std::vector<CellAddress>&& referenced)
+{
+    auto it = cellToReferencedCellsMap.find(key);
+    if (it != cellToReferencedCellsMap.end()) {
+        for (const auto& address : it->second) {
+            auto& dependants = cellToDependantCellsMap[address];
+            auto pos = std::find(dependants.begin(), dependants.end(), key);
+            if (pos != dependants.end()) {
+                *pos = dependants.back();
+                dependants.pop_back();
+            }
+            if (dependants.empty()) {
+                cellToDependantCellsMap.erase(address);
+            }
+        }
+        cellToReferencedCellsMap.erase(it);
+    }
+
+    if (referenced.empty()) {
+        return;
+    }
+
+    std::sort(referenced.begin(), referenced.end());
+    referenced.erase(std::unique(referenced.begin(), referenced.end()), referenced.end());
+    for (const auto& address : referenced) {
+        cellToDependantCellsMap[address].push_back(key);
+    }
+    referenced.shrink_to_fit();
+    cellToReferencedCellsMap.emplace(key, std::move(referenced));
 }
 
 /**
@@ -1412,6 +1473,8 @@ void PropertySheet::addDependencies(CellAddress key)
 
 void PropertySheet::removeDependencies(CellAddress key)
 {
+    setReferencedCells(key, {});
+
     /* Remove from Property <-> Key maps */
 
     std::map<CellAddress, std::set<std::string>>::iterator i1 = cellToPropertyNameMap.find(key);
@@ -1638,6 +1701,13 @@ const std::set<CellAddress>& PropertySheet::getDeps(const std::string& name) con
     }
 }
 
+const std::vector<CellAddress>& PropertySheet::getDependantCells(CellAddress pos) const
+{
+    static const std::vector<CellAddress> empty;
+    auto it = cellToDependantCellsMap.find(pos);
+    return it != cellToDependantCellsMap.end() ? it->second : empty;
+}
+
 const std::set<std::string>& PropertySheet::getDeps(CellAddress pos) const
 {
     static std::set<std::string> empty;
@@ -24,6 +24,8 @@
 #define PROPERTYSHEET_H
 
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 #include <App/DocumentObject.h>
 #include <App/PropertyLinks.h>
@@ -201,6 +203,10 @@ public:
 
     const std::set<std::string>& getDeps(App::CellAddress pos) const;
 
+    /** Returns the cells of this sheet whose expression references the cell at \a pos, either
+     * by address or by alias. Unlike getDeps() this does not build any string. */
+    const std::vector<App::CellAddress>& getDependantCells(App::CellAddress pos) const;
+
     void recomputeDependencies(App::CellAddress key);
 
     PyObject* getPyObject() override;
@@ -304,6 +310,8 @@ private:
 
     void removeDependencies(App::CellAddress key);
 
+    void setReferencedCells(App::CellAddress key, std::vector<App::CellAddress>&& referenced);
+
     void slotChangedObject(const App::DocumentObject& obj, const App::Property& prop);
     void recomputeDependants(const App::DocumentObject* obj, const char* propName);
 
@@ -323,6 +331,14 @@ private:
     /*! DocumentObject this cell depends on */
     std::map<App::CellAddress, std::set<std::string>> cellToDocumentObjectMap;
 
+    /*! Cells of this sheet referenced by the expression of the cell given in key */
+    std::unordered_map<App::CellAddress, std::vector<App::CellAddress>> cellToReferencedCellsMap;
+
+    /*! Cells of this sheet that need to be recomputed when the cell given in key changes,
+      i.e. the reverse of cellToReferencedCellsMap.
+      */
+    std::unordered_map<App::CellAddress, std::vector<App::CellAddress>> cellToDependantCellsMap;
+
     /*! Mapping of cell position to alias property */
     std::map<App::CellAddress, std::string> aliasProp;
 
@@ -25,11 +25,12 @@
 #ifndef _PreComp_
 #include <boost/tokenizer.hpp>
 #include <boost/regex.hpp>
-#include <deque>
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <tuple>
 #include <list>
+#include <unordered_map>
 #include <map>
 #include <string>
 #include <set>
@@ -59,19 +60,6 @@ using namespace Spreadsheet;
 
 PROPERTY_SOURCE(Spreadsheet::Sheet, App::DocumentObject)
 
-using DependencyList = boost::adjacency_list<
-    boost::vecS,         // class OutEdgeListS  : a Sequence or an AssociativeContainer
-    boost::vecS,         // class VertexListS   : a Sequence or a RandomAccessContainer
-    boost::directedS,    // class DirectedS     : This is a directed graph
-    boost::no_property,  // class VertexProperty:
-    boost::no_property,  // class EdgeProperty:
-    boost::no_property,  // class GraphProperty:
-    boost::listS         // class EdgeListS:
-    >;
-using Traits = boost::graph_traits<DependencyList>;
-using Vertex = Traits::vertex_descriptor;
-using Edge = Traits::edge_descriptor;
-
 /**
  * Construct a new Sheet object.
  */
@@ -1040,6 +1028,67 @@ void Sheet::updateBindings()
     }
 }
 
+/**
+ * Extend \a order with all cells that directly or indirectly depend on the cells in it and
+ * sort it so that each cell comes after the cells it depends on.
+ *
+ * Only the transitive dependants are visited, using the cell graph of PropertySheet, and the
+ * order is computed with Kahn's algorithm on flat arrays.
+ *
+ * @param order Cells to start from, replaced by the evaluation order.
+ * @return false if the cells contain a cyclic dependency. \a order then holds all visited
+ * cells in no particular order.
+ */
+
+bool Sheet::sortDependants(std::vector<CellAddress>& order) const
+{
+    std::unordered_map<CellAddress, std::size_t> index;
+    index.reserve(order.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        index.emplace(order[i], i);
+    }
+
+    // Collect the dependants and count how many of the visited cells each cell depends on
+    std::vector<std::size_t> inDegree(order.size(), 0);
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        for (const auto& dep : cells.getDependantCells(order[i])) {
+            auto res = index.emplace(dep, order.size());
+            if (res.second) {
+                order.push_back(dep);
+                inDegree.push_back(0);
+            }
+            ++inDegree[res.first->second];
+        }
+    }
+
+    std::vector<std::size_t> ready;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        if (inDegree[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+
+    std::vector<CellAddress> sorted;
+    sorted.reserve(order.size());
+    while (!ready.empty()) {
+        const CellAddress& addr = order[ready.back()];
+        ready.pop_back();
+        sorted.push_back(addr);
+        for (const auto& dep : cells.getDependantCells(addr)) {
+            std::size_t i = index[dep];
+            if (--inDegree[i] == 0) {
+                ready.push_back(i);
+            }
+        }
+    }
+
+    if (sorted.size() != order.size()) {
+        return false;
+    }
+    order = std::move(sorted);
+    return true;
+}
+
 /**
  * Update the document properties.
  *
@@ -1058,122 +1107,58 @@ DocumentObjectExecReturn* Sheet::execute()
         dirtyCells.insert(cellError);
     }
 
-    DependencyList graph;
-    std::map<CellAddress, Vertex> VertexList;
-    std::map<Vertex, CellAddress> VertexIndexList;
-    std::deque<CellAddress> workQueue(dirtyCells.begin(), dirtyCells.end());
-    while (!workQueue.empty()) {
-        CellAddress currPos = workQueue.front();
-        workQueue.pop_front();
-
-        // Insert into map of CellPos -> Index, if it doesn't exist already
-        auto res = VertexList.emplace(currPos, Vertex());
-        if (res.second) {
-            res.first->second = add_vertex(graph);
-            VertexIndexList[res.first->second] = currPos;
-        }
-
-        // Process cells that depend on the current cell
-        for (auto& dep : providesTo(currPos)) {
-            auto resDep = VertexList.emplace(dep, Vertex());
-            if (resDep.second) {
-                resDep.first->second = add_vertex(graph);
-                VertexIndexList[resDep.first->second] = dep;
-                if (dirtyCells.insert(dep).second) {
-                    workQueue.push_back(dep);
-                }
-            }
-            // Add edge to graph to signal dependency
-            add_edge(res.first->second, resDep.first->second, graph);
-        }
-    }
-    // Compute cells
-    std::list<Vertex> make_order;
-    // Sort graph topologically to find evaluation order
-    try {
-        boost::topological_sort(graph, std::front_inserter(make_order));
+    std::vector<CellAddress> order(dirtyCells.begin(), dirtyCells.end());
+    if (sortDependants(order)) {
         // Recompute cells
         FC_LOG("recomputing " << getFullName());
-        for (auto& pos : make_order) {
-            const auto& addr = VertexIndexList[pos];
+        for (const auto& addr : order) {
             FC_TRACE(addr.toString());
             recomputeCell(addr);
         }
     }
-    catch (std::exception&) {
-        for (auto& v : VertexList) {
-            Cell* cell = cells.getValue(v.first);
+    else {
+        for (const auto& addr : order) {
+            Cell* cell = cells.getValue(addr);
             // Mark as erroneous
             if (cell) {
-                cellErrors.insert(v.first);
+                cellErrors.insert(addr);
                 cell->setException("Pending computation due to cyclic dependency", true);
-                cellUpdated(v.first);
+                cellUpdated(addr);
             }
         }
 
         // Try to be more user friendly by finding individual loops
+        dirtyCells.insert(order.begin(), order.end());
         while (!dirtyCells.empty()) {
-
-            std::deque<CellAddress> workQueue;
-            DependencyList graph;
-            std::map<CellAddress, Vertex> VertexList;
-            std::map<Vertex, CellAddress> VertexIndexList;
-
-            CellAddress currentAddr = *dirtyCells.begin();
-            workQueue.push_back(currentAddr);
-            dirtyCells.erase(dirtyCells.begin());
-
-            while (!workQueue.empty()) {
-                CellAddress currPos = workQueue.front();
-                workQueue.pop_front();
-
-                // Insert into map of CellPos -> Index, if it doesn't exist already
-                auto res = VertexList.emplace(currPos, Vertex());
-                if (res.second) {
-                    res.first->second = add_vertex(graph);
-                    VertexIndexList[res.first->second] = currPos;
-                }
-
-                // Process cells that depend on the current cell
-                for (auto& dep : providesTo(currPos)) {
-                    auto resDep = VertexList.emplace(dep, Vertex());
-                    if (resDep.second) {
-                        resDep.first->second = add_vertex(graph);
-                        VertexIndexList[resDep.first->second] = dep;
-                        workQueue.push_back(dep);
-                        dirtyCells.erase(dep);
-                    }
-                    // Add edge to graph to signal dependency
-                    add_edge(res.first->second, resDep.first->second, graph);
-                }
+            std::vector<CellAddress> loop {*dirtyCells.begin()};
+            bool sorted = sortDependants(loop);
+            for (const auto& addr : loop) {
+                dirtyCells.erase(addr);
             }
 
-            std::list<Vertex> make_order;
-            try {
-                boost::topological_sort(graph, std::front_inserter(make_order));
-            }
-            catch (std::exception&) {  // TODO: evaluate using a more specific exception (not_a_dag)
+            if (!sorted) {
                 // Cycle detected; flag all with errors
                 Base::Console().error("Cyclic dependency detected in spreadsheet : %s\n",
                                       getNameInDocument());
+                std::sort(loop.begin(), loop.end());
                 std::ostringstream ss;
                 ss << "Cyclic dependency";
                 int count = 0;
-                for (auto& v : VertexList) {
+                for (const auto& addr : loop) {
                     if (count++ % 20 == 0) {
                         ss << std::endl;
                     }
                     else {
                         ss << ", ";
                     }
-                    ss << v.first.toString();
+                    ss << addr.toString();
                 }
                 std::string msg = ss.str();
-                for (auto& v : VertexList) {
-                    Cell* cell = cells.getValue(v.first);
+                for (const auto& addr : loop) {
+                    Cell* cell = cells.getValue(addr);
                     if (cell) {
                         cell->setException(msg.c_str(), true);
-                        cellUpdated(v.first);
+                        cellUpdated(addr);
                     }
                 }
             }
@@ -1644,7 +1629,8 @@ void Sheet::providesTo(CellAddress address, std::set<std::string>& result) const
 
 std::set<CellAddress> Sheet::providesTo(CellAddress address) const
 {
-    return cells.getDeps(getFullName() + "." + address.toString());
+    const auto& deps = cells.getDependantCells(address);
+    return {deps.begin(), deps.end()};
 }
 
 void Sheet::onDocumentRestored()
@@ -246,6 +246,8 @@ protected:
 
     std::set<App::CellAddress> providesTo(App::CellAddress address) const;
 
+    bool sortDependants(std::vector<App::CellAddress>& order) const;
+
     void onDocumentRestored() override;
 
     void recomputeCell(App::CellAddress p);
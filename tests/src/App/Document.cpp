@@ -3,9 +3,20 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <filesystem>
+#include <sstream>
+#include <thread>
+
 #include "App/Application.h"
+#include "App/AutoTransaction.h"
 #include "App/Document.h"
+#include "App/Expression.h"
+#include "App/FeatureTest.h"
+#include "App/Link.h"
+#include "App/ObjectIdentifier.h"
+#include "App/RecomputeProfile.h"
 #include "App/StringHasher.h"
+#include "Base/Interpreter.h"
 #include "Base/Writer.h"
 #include <src/App/InitApplication.h>
 
@@ -94,4 +105,333 @@ TEST_F(DocumentTest, getStringHasherGivesExpectedHasher)
     EXPECT_EQ(hasher, foundHasher);
 }
 
+TEST_F(DocumentTest, undoLimitDropsOldestTransactions)
+{
+    // Arrange
+    auto obj = doc()->addObject<App::FeatureTest>();
+    const std::size_t count = 100000;
+    obj->FloatList.setValues(std::vector<double>(count, 0.0));
+    doc()->setUndoMode(1);
+    auto edit = [obj, count](double value) {
+        App::AutoTransaction transaction("Edit");
+        obj->FloatList.setValues(std::vector<double>(count, value));
+    };
+    for (int i = 1; i <= 4; ++i) {
+        edit(i);
+    }
+    std::size_t editSize = count * sizeof(double);
+    int undos = doc()->getAvailableUndos();
+    std::size_t memSize = doc()->getUndoMemSize();
+
+    // Act: the limit holds two edits, setting it already drops the two oldest
+    doc()->setUndoLimit(2 * editSize + editSize / 2);
+    int undosAfterLimit = doc()->getAvailableUndos();
+    edit(5);
+
+    // Assert
+    EXPECT_EQ(undos, 4);
+    EXPECT_GE(memSize, 4 * editSize);
+    EXPECT_EQ(undosAfterLimit, 2);
+    EXPECT_EQ(doc()->getAvailableUndos(), 2);
+    EXPECT_LE(doc()->getUndoMemSize(), doc()->getUndoLimit());
+    EXPECT_TRUE(doc()->undo());
+    EXPECT_TRUE(doc()->undo());
+    EXPECT_FALSE(doc()->undo());
+    EXPECT_DOUBLE_EQ(obj->FloatList.getValues().front(), 3.0);
+}
+
+TEST_F(DocumentTest, undoMemSizeFollowsUndoAndRedo)
+{
+    // Arrange
+    auto obj = doc()->addObject<App::FeatureTest>();
+    const std::size_t count = 100000;
+    doc()->setUndoMode(1);
+    auto edit = [obj, count](double value) {
+        App::AutoTransaction transaction("Edit");
+        obj->FloatList.setValues(std::vector<double>(count, value));
+    };
+    edit(1);
+    edit(2);
+    std::size_t memSize = doc()->getUndoMemSize();
+
+    // Act
+    doc()->undo();
+    std::size_t memSizeAfterUndo = doc()->getUndoMemSize();
+    doc()->redo();
+    std::size_t memSizeAfterRedo = doc()->getUndoMemSize();
+    doc()->clearUndos();
+
+    // Assert
+    EXPECT_GE(memSize, count * sizeof(double));
+    EXPECT_GE(memSizeAfterUndo, count * sizeof(double));
+    EXPECT_EQ(memSizeAfterRedo, memSize);
+    EXPECT_EQ(doc()->getUndoMemSize(), 0U);
+}
+
+TEST_F(DocumentTest, parallelRecomputeHonorsDependencies)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    hGrp->SetBool("ParallelRecompute", true);
+    hGrp->SetInt("RecomputeThreads", 4);
+
+    const int chainCount = 8;
+    const int chainLength = 4;
+    Base::Placement step(Base::Vector3d(1, 0, 0), Base::Rotation());
+    std::vector<App::FeatureTestPlacement*> tips;
+    for (int chain = 0; chain < chainCount; ++chain) {
+        App::FeatureTestPlacement* prev = nullptr;
+        for (int i = 0; i < chainLength; ++i) {
+            auto obj = doc()->addObject<App::FeatureTestPlacement>();
+            obj->Input2.setValue(step);
+            if (prev) {
+                std::string expr = std::string(prev->getNameInDocument()) + ".MultLeft";
+                std::shared_ptr<App::Expression> rule(App::Expression::parse(obj, expr));
+                obj->setExpression(App::ObjectIdentifier::parse(obj, "Input1"), rule);
+            }
+            prev = obj;
+        }
+        tips.push_back(prev);
+    }
+
+    // Act
+    bool hasError = false;
+    int count = doc()->recompute({}, false, &hasError);
+    hGrp->RemoveBool("ParallelRecompute");
+    hGrp->RemoveInt("RecomputeThreads");
+
+    // Assert
+    EXPECT_FALSE(hasError);
+    EXPECT_EQ(count, chainCount * chainLength);
+    for (auto tip : tips) {
+        EXPECT_DOUBLE_EQ(tip->MultLeft.getValue().getPosition().x, chainLength);
+        EXPECT_FALSE(tip->isTouched());
+    }
+}
+
+TEST_F(DocumentTest, parallelRecomputeSignalsBeforeChangeWithOldValue)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    hGrp->SetBool("ParallelRecompute", true);
+    hGrp->SetInt("RecomputeThreads", 4);
+    std::vector<App::FeatureTestPlacement*> objs;
+    for (int i = 0; i < 8; ++i) {
+        auto obj = doc()->addObject<App::FeatureTestPlacement>();
+        obj->Input2.setValue(Base::Placement(Base::Vector3d(1, 0, 0), Base::Rotation()));
+        objs.push_back(obj);
+    }
+    doc()->recompute();
+    for (auto obj : objs) {
+        obj->Input2.setValue(Base::Placement(Base::Vector3d(2, 0, 0), Base::Rotation()));
+    }
+    std::vector<double> oldValues;
+    bool mainThread = true;
+    auto mainId = std::this_thread::get_id();
+    auto connection = doc()->signalBeforeChangeObject.connect(
+        [&](const App::DocumentObject& obj, const App::Property& prop) {
+            auto feature = freecad_cast<const App::FeatureTestPlacement*>(&obj);
+            if (feature && &prop == &feature->MultLeft) {
+                oldValues.push_back(feature->MultLeft.getValue().getPosition().x);
+                mainThread = mainThread && std::this_thread::get_id() == mainId;
+            }
+        });
+
+    // Act
+    doc()->recompute();
+    connection.disconnect();
+    hGrp->RemoveBool("ParallelRecompute");
+    hGrp->RemoveInt("RecomputeThreads");
+
+    // Assert
+    EXPECT_TRUE(mainThread);
+    EXPECT_EQ(oldValues, std::vector<double>(objs.size(), 1.0));
+    for (auto obj : objs) {
+        EXPECT_DOUBLE_EQ(obj->MultLeft.getValue().getPosition().x, 2.0);
+    }
+}
+
+TEST_F(DocumentTest, parallelRecomputeMixesPythonFeatures)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    hGrp->SetBool("ParallelRecompute", true);
+    hGrp->SetInt("RecomputeThreads", 4);
+    Base::Interpreter().runString(
+        "import FreeCAD as App\n"
+        "class ParallelRecomputeProxy:\n"
+        "    def __init__(self, obj):\n"
+        "        obj.addProperty('App::PropertyPlacement', 'Input')\n"
+        "        obj.addProperty('App::PropertyPlacement', 'Output')\n"
+        "        obj.Proxy = self\n"
+        "    def execute(self, obj):\n"
+        "        obj.Output = obj.Input.multiply(obj.Input)\n"
+        "class ParallelRecomputeObserver:\n"
+        "    def __init__(self):\n"
+        "        self.count = 0\n"
+        "    def slotBeforeChangeObject(self, obj, prop):\n"
+        "        if prop == 'MultLeft':\n"
+        "            self.count += 1\n"
+        "parallelRecomputeObserver = ParallelRecomputeObserver()\n"
+        "App.addDocumentObserver(parallelRecomputeObserver)\n");
+
+    // Each chain is a thread safe object, a Python feature executed on the calling thread
+    // and another thread safe object. The workers need the GIL to evaluate their expressions.
+    const int chainCount = 8;
+    Base::Placement step(Base::Vector3d(1, 0, 0), Base::Rotation());
+    auto link = [](App::DocumentObject* obj, const char* path, const std::string& expr) {
+        std::shared_ptr<App::Expression> rule(App::Expression::parse(obj, expr));
+        obj->setExpression(App::ObjectIdentifier::parse(obj, path), rule);
+    };
+    std::vector<App::FeatureTestPlacement*> tips;
+    for (int chain = 0; chain < chainCount; ++chain) {
+        auto first = doc()->addObject<App::FeatureTestPlacement>();
+        first->Input2.setValue(step);
+        std::string name = "PythonFeature" + std::to_string(chain);
+        std::string cmd = "ParallelRecomputeProxy(App.getDocument('"
+            + std::string(doc()->getName()) + "').addObject('App::FeaturePython', '" + name
+            + "'))";
+        Base::Interpreter().runString(cmd.c_str());
+        auto feature = doc()->getObject(name.c_str());
+        ASSERT_TRUE(feature);
+        link(feature, "Input", std::string(first->getNameInDocument()) + ".MultLeft");
+        auto tip = doc()->addObject<App::FeatureTestPlacement>();
+        tip->Input2.setValue(step);
+        link(tip, "Input1", name + ".Output");
+        tips.push_back(tip);
+    }
+
+    // Act
+    // the Python console recomputes while holding the GIL
+    std::string cmd = "App.getDocument('" + std::string(doc()->getName()) + "').recompute()";
+    Base::Interpreter().runString(cmd.c_str());
+    long observed = 0;
+    {
+        Base::PyGILStateLocker lock;
+        observed = Py::Long(Base::Interpreter().runStringObject("parallelRecomputeObserver.count"))
+                       .as_long();
+    }
+    Base::Interpreter().runString("App.removeDocumentObserver(parallelRecomputeObserver)");
+    hGrp->RemoveBool("ParallelRecompute");
+    hGrp->RemoveInt("RecomputeThreads");
+
+    // Assert
+    EXPECT_EQ(observed, 2 * chainCount);
+    for (auto tip : tips) {
+        EXPECT_DOUBLE_EQ(tip->MultLeft.getValue().getPosition().x, 3.0);
+        EXPECT_FALSE(tip->isTouched());
+    }
+}
+
+TEST_F(DocumentTest, parallelRecomputeBindsSubPathHoldingGIL)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    hGrp->SetBool("ParallelRecompute", true);
+    hGrp->SetInt("RecomputeThreads", 4);
+    // Setting a sub path of a property is done by Python on the worker, which
+    // then waits for the calling thread to emit the BeforeChange signal.
+    std::vector<App::FeatureTestPlacement*> objs;
+    for (int i = 0; i < 8; ++i) {
+        auto obj = doc()->addObject<App::FeatureTestPlacement>();
+        std::shared_ptr<App::Expression> rule(App::Expression::parse(obj, std::to_string(i)));
+        obj->setExpression(App::ObjectIdentifier::parse(obj, "Input2.Base.x"), rule);
+        objs.push_back(obj);
+    }
+
+    // Act
+    // the Python console recomputes while holding the GIL
+    std::string cmd = "import FreeCAD as App\nApp.getDocument('" + std::string(doc()->getName())
+        + "').recompute()";
+    Base::Interpreter().runString(cmd.c_str());
+    hGrp->RemoveBool("ParallelRecompute");
+    hGrp->RemoveInt("RecomputeThreads");
+
+    // Assert
+    for (std::size_t i = 0; i < objs.size(); ++i) {
+        EXPECT_DOUBLE_EQ(objs[i]->MultLeft.getValue().getPosition().x, double(i));
+        EXPECT_FALSE(objs[i]->isTouched());
+    }
+}
+
+TEST_F(DocumentTest, recomputeProfileRecordsCause)
+{
+    // Arrange
+    auto first = doc()->addObject<App::FeatureTestPlacement>();
+    auto second = doc()->addObject<App::FeatureTestPlacement>();
+    std::string expr = std::string(first->getNameInDocument()) + ".MultLeft";
+    std::shared_ptr<App::Expression> rule(App::Expression::parse(second, expr));
+    second->setExpression(App::ObjectIdentifier::parse(second, "Input1"), rule);
+    doc()->recompute();
+    first->Input2.setValue(Base::Placement(Base::Vector3d(0, 0, 1), Base::Rotation()));
+    doc()->setRecomputeProfiling(true);
+
+    // Act
+    doc()->recompute();
+    const auto& profile = doc()->getRecomputeProfile();
+    std::ostringstream json;
+    profile.toJson(json);
+
+    // Assert
+    ASSERT_EQ(profile.getEntries().size(), 2);
+    const auto& entry1 = profile.getEntries()[0];
+    const auto& entry2 = profile.getEntries()[1];
+    EXPECT_EQ(entry1.name, first->getNameInDocument());
+    EXPECT_EQ(entry1.touched, std::vector<std::string> {"Input2"});
+    EXPECT_EQ(entry2.name, second->getNameInDocument());
+    EXPECT_EQ(entry2.dependencies,
+              std::vector<std::string> {first->getNameInDocument()});
+    EXPECT_GE(profile.getTotalTime(), entry1.duration + entry2.duration);
+    EXPECT_EQ(json.str().rfind("{\"document\":", 0), 0);
+}
+
+TEST_F(DocumentTest, parallelOpenRestoresLinkedDocuments)
+{
+    // Arrange
+    auto& app = App::GetApplication();
+    auto hGrp = app.GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
+    auto dir = std::filesystem::temp_directory_path();
+    std::string partFile = (dir / "unit_test_ParallelOpenPart.FCStd").string();
+    std::string assemblyFile = (dir / "unit_test_ParallelOpenAssembly.FCStd").string();
+    const std::vector<double> values(1000, 2.5);
+
+    auto part = app.newDocument(app.getUniqueDocumentName("part").c_str(), "testUser");
+    auto feature = part->addObject<App::FeatureTest>("Feature");
+    feature->FloatList.setValues(values);
+    part->saveAs(partFile.c_str());
+    auto assembly = app.newDocument(app.getUniqueDocumentName("assembly").c_str(), "testUser");
+    auto link = assembly->addObject<App::Link>("Link");
+    link->LinkedObject.setValue(feature);
+    assembly->saveAs(assemblyFile.c_str());
+    app.closeDocument(assembly->getName());
+    app.closeDocument(part->getName());
+    hGrp->SetBool("ParallelOpen", true);
+    hGrp->SetInt("OpenThreads", 2);
+
+    // Act
+    auto docs = app.openDocuments({assemblyFile});
+    hGrp->RemoveBool("ParallelOpen");
+    hGrp->RemoveInt("OpenThreads");
+
+    // Assert
+    ASSERT_EQ(docs.size(), 1);
+    ASSERT_TRUE(docs.front());
+    auto openedLink = freecad_cast<App::Link*>(docs.front()->getObject("Link"));
+    ASSERT_TRUE(openedLink);
+    auto linked = freecad_cast<App::FeatureTest*>(openedLink->LinkedObject.getValue());
+    ASSERT_TRUE(linked);
+    EXPECT_EQ(linked->FloatList.getValues(), values);
+
+    // Tear down
+    auto partDoc = linked->getDocument();
+    app.closeDocument(docs.front()->getName());
+    app.closeDocument(partDoc->getName());
+    std::filesystem::remove(assemblyFile);
+    std::filesystem::remove(partFile);
+}
+
 // NOLINTEND(readability-magic-numbers)
@@ -2,6 +2,10 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <map>
+#include <unordered_map>
+
 #include <App/Application.h>
 #include <App/ElementMap.h>
 #include <src/App/InitApplication.h>
@@ -553,4 +557,264 @@ TEST_F(ElementMapTest, addAndGetChildElementsTest)
             return e.indexedName.toString() == "Pong2";
         }));
 }
+
+TEST_F(ElementMapTest, mappedNameHashIgnoresPostfixSplit)
+{
+    // Arrange
+    Data::MappedName name1(Data::MappedName("TEST"), "POSTFIXTEST");
+    Data::MappedName name2("TESTPOSTFIXTEST");
+    Data::MappedName name3(Data::MappedName("TESTPOSTFIX"), "TEST");
+
+    // Act
+    Data::MappedNameHash hash;
+
+    // Assert
+    EXPECT_EQ(name1, name2);
+    EXPECT_EQ(name1, name3);
+    EXPECT_EQ(hash(name1), hash(name2));
+    EXPECT_EQ(hash(name1), hash(name3));
+    EXPECT_NE(hash(name1), hash(Data::MappedName("TESTPOSTFIXTES")));
+}
+
+TEST_F(ElementMapTest, getAllIsSortedByName)
+{
+    // Arrange
+    Data::ElementMap elementMap;
+    for (int i = 1; i <= 100; i++) {
+        Data::IndexedName face("Face", i);
+        elementMap.setElementName(face, Data::MappedName(face), 1);
+    }
+
+    // Act
+    auto all = elementMap.getAll();
+
+    // Assert
+    ASSERT_EQ(all.size(), 100);
+    for (std::size_t i = 1; i < all.size(); i++) {
+        EXPECT_TRUE(all[i - 1].name < all[i].name);
+    }
+}
+
+TEST_F(ElementMapTest, getAllFollowsChanges)
+{
+    // Arrange
+    Data::ElementMap elementMap;
+    Data::MappedName first("B");
+    Data::MappedName second("C");
+    Data::MappedName third("A");
+    elementMap.setElementName(Data::IndexedName("Edge", 1), first, 0);
+    elementMap.setElementName(Data::IndexedName("Edge", 2), second, 0);
+
+    // Act
+    auto before = elementMap.getAll();
+    elementMap.setElementName(Data::IndexedName("Edge", 3), third, 0);
+    auto added = elementMap.getAll();
+    elementMap.erase(first);
+    auto erased = elementMap.getAll();
+
+    // Assert
+    ASSERT_EQ(before.size(), 2);
+    EXPECT_EQ(before[0].name, first);
+    EXPECT_EQ(before[1].name, second);
+    ASSERT_EQ(added.size(), 3);
+    EXPECT_EQ(added[0].name, third);
+    EXPECT_EQ(added[1].name, first);
+    EXPECT_EQ(added[2].name, second);
+    ASSERT_EQ(erased.size(), 2);
+    EXPECT_EQ(erased[0].name, third);
+    EXPECT_EQ(erased[1].name, second);
+}
+
+namespace
+{
+// counts the bytes allocated by a container
+template<typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    explicit CountingAllocator(std::size_t* counter)
+        : bytes(counter)
+    {}
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>& other)  // NOLINT
+        : bytes(other.bytes)
+    {}
+    T* allocate(std::size_t n)
+    {
+        *bytes += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* ptr, std::size_t n)
+    {
+        *bytes -= n * sizeof(T);
+        std::allocator<T>().deallocate(ptr, n);
+    }
+    template<typename U>
+    bool operator==(const CountingAllocator<U>& other) const
+    {
+        return bytes == other.bytes;
+    }
+    template<typename U>
+    bool operator!=(const CountingAllocator<U>& other) const
+    {
+        return bytes != other.bytes;
+    }
+
+    std::size_t* bytes;
+};
+}  // namespace
+
+TEST_F(ElementMapTest, mappedNameMapFindsNamesAfterErase)
+{
+    // Arrange
+    Data::MappedNameMap map;
+    for (int i = 0; i < 1000; i++) {
+        map.insert(Data::MappedName(("Name" + std::to_string(i)).c_str()),
+                   Data::IndexedName("Edge", i + 1));
+    }
+
+    // Act
+    bool duplicate = map.insert(Data::MappedName("Name7"), Data::IndexedName("Edge", 2000)).second;
+    for (int i = 0; i < 1000; i += 3) {
+        map.erase(Data::MappedName(("Name" + std::to_string(i)).c_str()));
+    }
+
+    // Assert
+    EXPECT_FALSE(duplicate);
+    EXPECT_EQ(map.size(), 666);
+    for (int i = 0; i < 1000; i++) {
+        auto it = map.find(Data::MappedName(("Name" + std::to_string(i)).c_str()));
+        if (i % 3 == 0) {
+            EXPECT_EQ(it, map.end());
+        }
+        else {
+            ASSERT_NE(it, map.end());
+            EXPECT_EQ(it->second, Data::IndexedName("Edge", i + 1));
+        }
+    }
+    auto sorted = map.sorted();
+    ASSERT_EQ(sorted.size(), map.size());
+    for (std::size_t i = 1; i < sorted.size(); i++) {
+        EXPECT_TRUE(sorted[i - 1]->first < sorted[i]->first);
+    }
+}
+
+namespace
+{
+// names that look like the ones of a pattern of fused and filleted shapes
+std::vector<std::pair<Data::MappedName, Data::IndexedName>> makeMappedNames(int count)
+{
+    std::vector<std::pair<Data::MappedName, Data::IndexedName>> names;
+    names.reserve(count);
+    for (int i = 1; i <= count; i++) {
+        std::string name = "Edge" + std::to_string(i % 97 + 1) + ";:G;FUS;:H" + std::to_string(i)
+            + ":7,F;:U" + std::to_string(i % 5) + ";FLT;:H" + std::to_string(i / 7) + ":8,E";
+        names.emplace_back(Data::MappedName(name.c_str()), Data::IndexedName("Edge", i));
+    }
+    return names;
+}
+
+using TreeValue = std::pair<const Data::MappedName, Data::IndexedName>;
+using MappedNameTree =
+    std::map<Data::MappedName, Data::IndexedName, std::less<>, CountingAllocator<TreeValue>>;
+using MappedNameHashTable = std::unordered_map<Data::MappedName,
+                                               Data::IndexedName,
+                                               Data::MappedNameHash,
+                                               std::equal_to<>,
+                                               CountingAllocator<TreeValue>>;
+}  // namespace
+
+TEST_F(ElementMapTest, mappedNameMapIsSmallerThanPreviousStorage)
+{
+    // Compares the flat storage of the mapped names with the ordered map and the node based
+    // hash table used before. The name data is shared and not counted for either.
+    auto names = makeMappedNames(10000);
+    std::size_t treeBytes = 0;
+    MappedNameTree tree {CountingAllocator<TreeValue>(&treeBytes)};
+    std::size_t hashBytes = 0;
+    MappedNameHashTable hash {0,
+                              Data::MappedNameHash(),
+                              std::equal_to<>(),
+                              CountingAllocator<TreeValue>(&hashBytes)};
+    Data::MappedNameMap flat;
+
+    // Act
+    for (const auto& name : names) {
+        tree.emplace(name.first, name.second);
+        hash.emplace(name.first, name.second);
+        flat.insert(name.first, name.second);
+    }
+
+    // Assert
+    EXPECT_EQ(flat.size(), tree.size());
+    EXPECT_EQ(flat.size(), hash.size());
+    EXPECT_LT(flat.getMemSize(), treeBytes);
+    EXPECT_LT(flat.getMemSize(), hashBytes);
+}
+
+TEST_F(ElementMapTest, DISABLED_mappedNameStorageBenchmark)
+{
+    // Records the time to insert and find 100k names in the flat storage, the ordered map and the
+    // node based hash table
+    const auto names = makeMappedNames(100000);
+    auto measure = [](auto&& func) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto time = std::chrono::steady_clock::now() - start;
+        return std::to_string(std::chrono::duration<double, std::milli>(time).count());
+    };
+
+    std::size_t treeBytes = 0;
+    MappedNameTree tree {CountingAllocator<TreeValue>(&treeBytes)};
+    std::size_t hashBytes = 0;
+    MappedNameHashTable hash {0,
+                              Data::MappedNameHash(),
+                              std::equal_to<>(),
+                              CountingAllocator<TreeValue>(&hashBytes)};
+    Data::MappedNameMap flat;
+
+    RecordProperty("TreeInsertMilliseconds", measure([&]() {
+                       for (const auto& name : names) {
+                           tree.emplace(name.first, name.second);
+                       }
+                   }));
+    RecordProperty("HashInsertMilliseconds", measure([&]() {
+                       for (const auto& name : names) {
+                           hash.emplace(name.first, name.second);
+                       }
+                   }));
+    RecordProperty("FlatInsertMilliseconds", measure([&]() {
+                       for (const auto& name : names) {
+                           flat.insert(name.first, name.second);
+                       }
+                   }));
+
+    std::size_t treeFound = 0;
+    std::size_t hashFound = 0;
+    std::size_t flatFound = 0;
+    RecordProperty("TreeFindMilliseconds", measure([&]() {
+                       for (const auto& name : names) {
+                           treeFound += tree.count(name.first);
+                       }
+                   }));
+    RecordProperty("HashFindMilliseconds", measure([&]() {
+                       for (const auto& name : names) {
+                           hashFound += hash.count(name.first);
+                       }
+                   }));
+    RecordProperty("FlatFindMilliseconds", measure([&]() {
+                       for (const auto& name : names) {
+                           flatFound += flat.find(name.first) != flat.end() ? 1 : 0;
+                       }
+                   }));
+
+    RecordProperty("TreeBytes", std::to_string(treeBytes));
+    RecordProperty("HashBytes", std::to_string(hashBytes));
+    RecordProperty("FlatBytes", std::to_string(flat.getMemSize()));
+    EXPECT_EQ(treeFound, names.size());
+    EXPECT_EQ(hashFound, names.size());
+    EXPECT_EQ(flatFound, names.size());
+}
+
 // NOLINTEND(readability-magic-numbers)
@@ -1,9 +1,15 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 #include <src/App/InitApplication.h>
 
+#include "App/Application.h"
+#include "App/Document.h"
+#include "App/DocumentObject.h"
 #include "App/ExpressionParser.h"
 #include "App/ExpressionTokenizer.h"
+#include "App/PropertyUnits.h"
 
 // +------------------------------------------------+
 // | Note: For more expression related tests, see:  |
@@ -305,3 +311,149 @@ TEST_F(Expression, test_e_rad)
     op.release();
 }
 // clang-format on
+
+class CompiledExpression: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        auto doc = App::GetApplication().newDocument(_docName.c_str(), "testUser");
+        _values = doc->addObject("App::VarSet", "Values");
+        static_cast<App::PropertyInteger*>(
+            _values->addDynamicProperty("App::PropertyInteger", "Count"))
+            ->setValue(3);
+        static_cast<App::PropertyFloat*>(_values->addDynamicProperty("App::PropertyFloat", "Ratio"))
+            ->setValue(0.5);
+        static_cast<App::PropertyLength*>(
+            _values->addDynamicProperty("App::PropertyLength", "Width"))
+            ->setValue(10.0);
+        static_cast<App::PropertyBool*>(_values->addDynamicProperty("App::PropertyBool", "Flag"))
+            ->setValue(true);
+    }
+
+    void TearDown() override
+    {
+        App::GetApplication().closeDocument(_docName.c_str());
+    }
+
+    App::ExpressionPtr parse(const char* text) const
+    {
+        return App::ExpressionPtr(App::Expression::parse(_values, text));
+    }
+
+private:
+    std::string _docName;
+    App::DocumentObject* _values {};
+};
+
+TEST_F(CompiledExpression, matchesInterpreter)
+{
+    const char* texts[] = {
+        "1 + 2",
+        "7 / 2",
+        "7 % -3",
+        "-7.5 % 2",
+        "2 ^ 10",
+        "2 ^ -1",
+        "True + 1",
+        "-Flag",
+        "Count * Width",
+        "Width / 2 mm",
+        "Width ^ 2",
+        "Width % 3",
+        "Ratio * Count + 1",
+        "Flag ? Width : 2 * Width",
+        "Count > 2",
+        "Width < 20 mm",
+        "Width == 10",
+        "Count == 3.0",
+        "sin(30 deg) * Width",
+        "pow(Width; 2)",
+        "abs(-Width) + 1 mm",
+        "round(Ratio * 7)",
+        "hypot(Count; 4)",
+        "not(Flag)",
+    };
+
+    for (const char* text : texts) {
+        SCOPED_TRACE(text);
+        auto expr = parse(text);
+        App::CompiledExpression compiled = expr->compile();
+        ASSERT_TRUE(compiled);
+
+        App::any value;
+        ASSERT_TRUE(compiled.eval(value));
+        App::any expected = expr->getValueAsAny();
+        EXPECT_TRUE(value.type() == expected.type()) << value.type().name();
+        EXPECT_TRUE(App::isAnyEqual(value, expected));
+    }
+}
+
+TEST_F(CompiledExpression, fallsBackToInterpreter)
+{
+    // not purely numeric
+    EXPECT_FALSE(parse("str(Count)")->compile());
+    EXPECT_FALSE(parse("Flag ? None : 1")->compile());
+
+    // unit mismatch, division by zero and integer overflow are left to Python
+    App::any value;
+    auto mismatch = parse("Width + 1");
+    ASSERT_TRUE(mismatch->compile());
+    EXPECT_FALSE(mismatch->compile().eval(value));
+    EXPECT_THROW(mismatch->getValueAsAny(), Base::Exception);
+
+    auto division = parse("1 / (Count - 3)");
+    ASSERT_TRUE(division->compile());
+    EXPECT_FALSE(division->compile().eval(value));
+
+    EXPECT_FALSE(parse("2 ^ 70")->compile().eval(value));
+
+    // a property that does not hold a number, or an attribute of a property
+    EXPECT_FALSE(parse("Label")->compile().eval(value));
+    EXPECT_FALSE(parse("Width.Value")->compile().eval(value));
+}
+
+TEST_F(CompiledExpression, constantsAreFolded)
+{
+    auto expr = parse("2 * (3 mm + 4 mm)");
+    App::CompiledExpression compiled = expr->compile();
+    ASSERT_TRUE(compiled);
+    EXPECT_TRUE(compiled.isConstant());
+    EXPECT_FALSE(parse("2 * Width")->compile().isConstant());
+}
+
+TEST_F(CompiledExpression, benchmark)
+{
+    auto expr = parse("Count * Width + Ratio * 2 mm - (Flag ? 1 mm : 2 mm) + sin(30 deg) * Width / 3");
+    App::CompiledExpression compiled = expr->compile();
+    ASSERT_TRUE(compiled);
+
+    const int count = 20000;
+    App::any interpreted;
+    App::any value;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        interpreted = expr->getValueAsAny();
+    }
+    auto interpreterTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        compiled.eval(value);
+    }
+    auto compiledTime = std::chrono::steady_clock::now() - start;
+
+    RecordProperty(
+        "InterpretedMilliseconds",
+        std::to_string(std::chrono::duration<double, std::milli>(interpreterTime).count()));
+    RecordProperty(
+        "CompiledMilliseconds",
+        std::to_string(std::chrono::duration<double, std::milli>(compiledTime).count()));
+    EXPECT_TRUE(App::isAnyEqual(value, interpreted));
+}
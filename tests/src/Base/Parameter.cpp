@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
+#include <chrono>
 #include <boost/core/ignore_unused.hpp>
 #include <QLockFile>
 #include <Base/FileInfo.h>
 #include <Base/Parameter.h>
+#include <Base/ParameterCache.h>
 
 class FakeObserver: public ParameterGrp::ObserverType
 {
@@ -462,4 +464,85 @@ TEST_F(ParameterTest, TestLockFile)
     lockFile2.unlock();
 }
 
+TEST_F(ParameterTest, TestCacheFollowsChanges)
+{
+    auto cfg = getCreateConfig();
+    auto grp = cfg->GetGroup("TopLevelGroup");
+    grp->SetInt("Int", 3);
+
+    Base::ParameterCache<bool> flag(grp, "Bool", true);
+    Base::ParameterCache<long> number(grp, "Int", 0);
+    Base::ParameterCache<unsigned long> color(grp, "Unsigned", 5);
+    Base::ParameterCache<double> value(grp, "Float", 1.5);
+    EXPECT_TRUE(flag);
+    EXPECT_EQ(number.get(), 3);
+    EXPECT_EQ(color.get(), 5);
+    EXPECT_DOUBLE_EQ(value.get(), 1.5);
+
+    grp->SetBool("Bool", false);
+    grp->SetInt("Int", -4);
+    grp->SetUnsigned("Unsigned", 7);
+    grp->SetFloat("Float", 2.5);
+    EXPECT_FALSE(flag);
+    EXPECT_EQ(number.get(), -4);
+    EXPECT_EQ(color.get(), 7);
+    EXPECT_DOUBLE_EQ(value.get(), 2.5);
+
+    grp->RemoveInt("Int");
+    EXPECT_EQ(number.get(), 0);
+
+    grp->SetInt("Int", 8);
+    cfg->RemoveGrp("TopLevelGroup");
+    EXPECT_TRUE(flag);
+    EXPECT_EQ(number.get(), 0);
+}
+
+TEST_F(ParameterTest, TestCacheFollowsImport)
+{
+    auto cfg = getCreateConfig();
+    auto grp = cfg->GetGroup("TopLevelGroup/Sub1");
+    grp->SetBool("Bool", true);
+
+    std::string fn = getFileName();
+    cfg->exportTo(fn.c_str());
+
+    Base::ParameterCache<bool> flag(grp, "Bool", false);
+    grp->SetBool("Bool", false);
+    EXPECT_FALSE(flag);
+
+    cfg->importFrom(fn.c_str());
+    EXPECT_TRUE(flag);
+}
+
+TEST_F(ParameterTest, TestCacheBenchmark)
+{
+    auto cfg = getCreateConfig();
+    auto grp = cfg->GetGroup("TopLevelGroup");
+    // a group with a typical number of entries in front of the one that is read
+    for (int i = 0; i < 50; i++) {
+        grp->SetBool(("Bool" + std::to_string(i)).c_str(), true);
+    }
+    grp->SetBool("Flag", true);
+    Base::ParameterCache<bool> flag(grp, "Flag", false);
+
+    const int count = 100000;
+    auto measure = [count](auto&& func) {
+        auto start = std::chrono::steady_clock::now();
+        int enabled = 0;
+        for (int i = 0; i < count; i++) {
+            enabled += func() ? 1 : 0;
+        }
+        auto time = std::chrono::steady_clock::now() - start;
+        EXPECT_EQ(enabled, count);
+        return std::to_string(std::chrono::duration<double, std::milli>(time).count());
+    };
+
+    RecordProperty("GetBoolMilliseconds", measure([&]() {
+                       return grp->GetBool("Flag", false);
+                   }));
+    RecordProperty("CacheMilliseconds", measure([&]() {
+                       return flag.get();
+                   }));
+}
+
 // NOLINTEND(cppcoreguidelines-*,readability-*)
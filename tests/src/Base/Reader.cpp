@@ -7,13 +7,18 @@
 #endif
 
 #include "Base/Exception.h"
+#include "Base/Persistence.h"
 #include "Base/Reader.h"
+#include "Base/Writer.h"
 #include <array>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <random>
 #include <string>
 #include <xercesc/util/PlatformUtils.hpp>
+#include <zipios++/zipinputstream.h>
 #include <QString>
 
 namespace fs = std::filesystem;
@@ -59,7 +64,8 @@ public:
         return _reader.get();
     }
 
-    void givenDataAsXMLStream(const std::string& data)
+    void givenDataAsXMLStream(const std::string& data,
+                              Base::XMLReader::Backend backend = Base::XMLReader::Backend::Xerces)
     {
         auto stringData =
             R"(<?xml version="1.0" encoding="UTF-8"?><document>)" + data + "</document>";
@@ -68,7 +74,8 @@ public:
         fileStream.write(stringData.data(), static_cast<std::streamsize>(stringData.length()));
         fileStream.close();
         inputStream.open(_tempFile.string());
-        _reader = std::make_unique<Base::XMLReader>(_tempFile.string().c_str(), inputStream);
+        _reader =
+            std::make_unique<Base::XMLReader>(_tempFile.string().c_str(), inputStream, backend);
     }
 
 private:
@@ -459,3 +466,584 @@ TEST_F(ReaderTest, validDefaults)
     EXPECT_THROW({ xml.Reader()->getAttribute<TimesIGoToBed>("missing"); }, Base::XMLBaseException);
     EXPECT_EQ(value20, TimesIGoToBed::Late);
 }
+
+TEST_F(ReaderTest, pullParserReadNextStartElement)
+{
+    auto xmlBody = R"(
+<node1 attr='1'>Node1</node1>
+<node2 attr='2'/>
+)";
+
+    ReaderXML xml;
+    xml.givenDataAsXMLStream(xmlBody, Base::XMLReader::Backend::Pull);
+
+    // start of document
+    EXPECT_TRUE(xml.Reader()->isStartOfDocument());
+    xml.Reader()->readElement("document");
+    EXPECT_STREQ(xml.Reader()->localName(), "document");
+
+    // next element
+    EXPECT_TRUE(xml.Reader()->readNextElement());
+    EXPECT_STREQ(xml.Reader()->localName(), "node1");
+    EXPECT_STREQ(xml.Reader()->getAttribute<const char*>("attr"), "1");
+    EXPECT_EQ(xml.Reader()->level(), 2);
+    xml.Reader()->readEndElement("node1");
+    EXPECT_TRUE(xml.Reader()->isEndOfElement());
+
+    // next element
+    EXPECT_TRUE(xml.Reader()->readNextElement());
+    EXPECT_STREQ(xml.Reader()->localName(), "node2");
+    EXPECT_EQ(xml.Reader()->getAttributeCount(), 1);
+    EXPECT_EQ(xml.Reader()->getAttribute<long>("attr"), 2);
+    EXPECT_FALSE(xml.Reader()->hasAttribute("other"));
+    EXPECT_EQ(xml.Reader()->level(), 1);
+    xml.Reader()->readEndElement("document");
+    EXPECT_TRUE(xml.Reader()->isEndOfDocument());
+}
+
+TEST_F(ReaderTest, pullParserCharStream)
+{
+    // Arrange
+    ReaderXML xml;
+    xml.givenDataAsXMLStream("<data>a &lt; b\r\nc</data>", Base::XMLReader::Backend::Pull);
+    xml.Reader()->readElement("data");
+
+    // Act
+    auto& stream = xml.Reader()->beginCharStream();
+    std::string result {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+
+    // Assert
+    EXPECT_EQ("a < b\nc", result);
+}
+
+TEST_F(ReaderTest, pullParserInvalidDocument)
+{
+    // Arrange
+    ReaderXML xml;
+
+    // Act
+    xml.givenDataAsXMLStream("<data>", Base::XMLReader::Backend::Pull);
+
+    // Assert
+    EXPECT_TRUE(xml.Reader()->isValid());
+    xml.Reader()->readElement("data");
+    EXPECT_THROW(xml.Reader()->readEndElement("document"), Base::XMLParseException);
+}
+
+namespace
+{
+// A document shaped like Document.xml with many objects and properties
+std::string largeDocument(int objects)
+{
+    std::ostringstream str;
+    str << "<?xml version='1.0' encoding='utf-8'?>\n"
+        << "<!--\n FreeCAD Document, see https://www.freecad.org for more information...\n-->\n"
+        << "<Document SchemaVersion=\"4\" ProgramVersion=\"1.1\" FileVersion=\"1\">\n"
+        << "    <Objects Count=\"" << objects << "\">\n";
+    for (int i = 0; i < objects; ++i) {
+        str << "        <Object type=\"Part::Feature\" name=\"Feature" << i << "\" id=\"" << i
+            << "\" />\n";
+    }
+    str << "    </Objects>\n"
+        << "    <ObjectData Count=\"" << objects << "\">\n";
+    for (int i = 0; i < objects; ++i) {
+        str << "        <Object name=\"Feature" << i << "\">\n"
+            << "            <Properties Count=\"4\" TransientCount=\"0\">\n"
+            << "                <Property name=\"Label\" type=\"App::PropertyString\">\n"
+            << "                    <String value=\"Feature &lt;" << i
+            << "&gt; &amp; &quot;caf&#233;&quot;&#10;\"/>\n"
+            << "                </Property>\n"
+            << "                <Property name=\"Placement\" type=\"App::PropertyPlacement\">\n"
+            << "                    <PropertyPlacement Px=\"" << i << ".5\" Py=\"0\" Pz=\"-" << i
+            << "\" Q0=\"0\" Q1=\"0\" Q2=\"0\" Q3=\"1\" A=\"0\" Ox=\"0\" Oy=\"0\" Oz=\"1\"/>\n"
+            << "                </Property>\n"
+            << "                <Property name=\"Text\" type=\"App::PropertyString\">\n"
+            << "                    <Text>line " << i << " &amp; more\r\nnext line</Text>\n"
+            << "                </Property>\n"
+            << "                <Property name=\"Data\" type=\"App::PropertyFile\">\n"
+            << "                    <Data><![CDATA[RnJlZUNBRCByb2NrcyE=]]></Data>\n"
+            << "                </Property>\n"
+            << "            </Properties>\n"
+            << "        </Object>\n";
+    }
+    str << "    </ObjectData>\n"
+        << "</Document>\n";
+    return str.str();
+}
+
+// Record everything a Restore() implementation can observe through the reader
+std::vector<std::string> readAll(Base::XMLReader& reader, const fs::path& binFile)
+{
+    std::vector<std::string> events;
+    reader.readElement("Document");
+    for (;;) {
+        const bool start = reader.readNextElement();
+        if (reader.isEndOfDocument()) {
+            break;
+        }
+        std::string event = std::to_string(reader.level()) + ' ' + reader.localName() + ' ';
+        if (!start) {
+            events.push_back(event + "end");
+            continue;
+        }
+        event += std::to_string(reader.getAttributeCount());
+        for (const char* name : {"name", "type", "value", "Count", "Px", "Pz"}) {
+            if (reader.hasAttribute(name)) {
+                event += std::string(" ") + name + '=' + reader.getAttribute<const char*>(name);
+            }
+        }
+        if (event.find(" Text ") != std::string::npos) {
+            auto& stream = reader.beginCharStream();
+            event += std::string(std::istreambuf_iterator<char>(stream), {});
+            reader.endCharStream();
+        }
+        else if (event.find(" Data ") != std::string::npos) {
+            reader.readBinFile(binFile.string().c_str());
+            std::ifstream bin(binFile, std::ios::binary);
+            event += std::string(std::istreambuf_iterator<char>(bin), {});
+        }
+        events.push_back(event);
+    }
+    return events;
+}
+}  // namespace
+
+TEST_F(ReaderTest, pullParserMatchesXercesOnLargeDocument)
+{
+    // Arrange
+    const int objects = 5000;
+    const std::string data = largeDocument(objects);
+    const fs::path binFile = fs::temp_directory_path() / ("unit_test_Reader-" + random_string(4));
+
+    auto readWith = [&](Base::XMLReader::Backend backend) {
+        std::istringstream stream(data);
+        Base::XMLReader reader("Document.xml", stream, backend);
+        EXPECT_TRUE(reader.isValid());
+        return readAll(reader, binFile);
+    };
+    // only parse, as the restore of the properties would
+    auto timeWith = [&](Base::XMLReader::Backend backend) {
+        auto start = std::chrono::steady_clock::now();
+        std::istringstream stream(data);
+        Base::XMLReader reader("Document.xml", stream, backend);
+        std::size_t length = 0;
+        while (!reader.isEndOfDocument()) {
+            if (reader.readNextElement() && reader.hasAttribute("name")) {
+                length += std::strlen(reader.getAttribute<const char*>("name"));
+            }
+        }
+        EXPECT_GT(length, 0);
+        auto time = std::chrono::steady_clock::now() - start;
+        return std::to_string(std::chrono::duration<double, std::milli>(time).count());
+    };
+
+    // Act
+    auto xercesEvents = readWith(Base::XMLReader::Backend::Xerces);
+    auto pullEvents = readWith(Base::XMLReader::Backend::Pull);
+    fs::remove(binFile);
+    RecordProperty("XercesMilliseconds", timeWith(Base::XMLReader::Backend::Xerces));
+    RecordProperty("PullParserMilliseconds", timeWith(Base::XMLReader::Backend::Pull));
+
+    // Assert
+    EXPECT_GT(xercesEvents.size(), static_cast<std::size_t>(objects * 10));
+    EXPECT_EQ(xercesEvents, pullEvents);
+}
+
+// a file of a project that is saved and restored as a whole
+class DocFileData: public Base::Persistence
+{
+public:
+    explicit DocFileData(std::string data = {})
+        : data(std::move(data))
+    {}
+    unsigned int getMemSize() const override
+    {
+        return static_cast<unsigned int>(data.size());
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void SaveDocFile(Base::Writer& writer) const override
+    {
+        writer.Stream().write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+    void RestoreDocFile(Base::Reader& reader) override
+    {
+        data.assign(std::istreambuf_iterator<char>(reader), std::istreambuf_iterator<char>());
+    }
+    const std::string& getData() const
+    {
+        return data;
+    }
+
+private:
+    std::string data;
+};
+
+// a file that registers another file to be read after it, like a link to
+// a document saved in the same project file
+class NestedDocFile: public DocFileData
+{
+public:
+    NestedDocFile(const char* nestedName, DocFileData& nested)
+        : nestedName(nestedName)
+        , nested(nested)
+    {}
+    void RestoreDocFile(Base::Reader& reader) override
+    {
+        DocFileData::RestoreDocFile(reader);
+        auto localReader =
+            std::make_shared<Base::XMLReader>("Nested.xml", document, Base::XMLReader::Backend::Pull);
+        localReader->addFile(nestedName, &nested);
+        reader.initLocalReader(localReader);
+    }
+
+private:
+    const char* nestedName;
+    DocFileData& nested;
+    std::istringstream document {"<Document/>"};
+};
+
+class DeferredDocFileTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _archive = fs::temp_directory_path()
+            / (std::string("unit_test_DeferredDocFile-") + random_string(4) + ".zip");
+        writeArchive("first", "second");
+    }
+
+    void TearDown() override
+    {
+        if (fs::exists(_archive)) {
+            fs::remove(_archive);
+        }
+    }
+
+    void writeArchive(const std::string& first, const std::string& second)
+    {
+        std::ofstream file(_archive.string(), std::ios::out | std::ios::binary);
+        Base::ZipWriter writer(file);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        writer.putNextEntry("first.bin");
+        writer.Stream() << first;
+        writer.putNextEntry("second.bin");
+        writer.Stream() << second;
+    }
+
+    // write the files uncompressed and aligned for reading them from a memory mapping
+    void writeStoredArchive(const std::string& first, const std::string& second)
+    {
+        DocFileData firstData(first);
+        DocFileData secondData(second);
+        std::ofstream file(_archive.string(), std::ios::out | std::ios::binary);
+        Base::ZipWriter writer(file);
+        writer.setStorageAlignment(Base::XMLReader::getMappingAlignment());
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        writer.addFile("first.bin", &firstData, true);
+        writer.addFile("second.bin", &secondData, true);
+        writer.writeFiles();
+    }
+
+    // binary data larger than a page
+    static std::string binaryData(char seed)
+    {
+        std::string data(Base::XMLReader::getMappingAlignment() + 100, '\0');
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<char>(seed + i * 7);
+        }
+        return data;
+    }
+
+    std::string archive() const
+    {
+        return _archive.string();
+    }
+
+    static std::shared_ptr<Base::DeferredDocFile>
+    makeFile(const std::shared_ptr<Base::DeferredDocFile::Archive>& archive,
+             const char* name,
+             std::string& content)
+    {
+        auto file = Base::DeferredDocFile::create(archive, name, 1);
+        file->setRestorer([&content](Base::Reader& reader) {
+            reader >> content;
+        });
+        return file;
+    }
+
+private:
+    fs::path _archive;
+};
+
+TEST_F(DeferredDocFileTest, restoreReadsEntryOnce)
+{
+    // Arrange
+    auto archive = Base::DeferredDocFile::openArchive(this->archive());
+    ASSERT_TRUE(archive);
+    std::string content;
+    auto file = makeFile(archive, "second.bin", content);
+
+    // Act
+    bool first = file->restore();
+    std::string firstContent = content;
+    content.clear();
+    bool second = file->restore();
+
+    // Assert
+    EXPECT_TRUE(first);
+    EXPECT_TRUE(second);
+    EXPECT_EQ(firstContent, "second");
+    EXPECT_TRUE(content.empty());
+    EXPECT_FALSE(file->isPending());
+}
+
+TEST_F(DeferredDocFileTest, restoreAllReadsPendingFiles)
+{
+    // Arrange
+    auto archive = Base::DeferredDocFile::openArchive(this->archive());
+    ASSERT_TRUE(archive);
+    std::string first;
+    std::string second;
+    auto firstFile = makeFile(archive, "first.bin", first);
+    auto secondFile = makeFile(archive, "second.bin", second);
+    secondFile->discard();
+
+    // Act
+    bool result = Base::DeferredDocFile::restoreAll(this->archive());
+
+    // Assert
+    EXPECT_TRUE(result);
+    EXPECT_EQ(first, "first");
+    EXPECT_TRUE(second.empty());
+    EXPECT_FALSE(firstFile->isPending());
+    EXPECT_FALSE(secondFile->isPending());
+}
+
+TEST_F(DeferredDocFileTest, prefetchedArchiveHoldsAllEntries)
+{
+    // Arrange
+    auto archive = Base::PrefetchedArchive::read(this->archive());
+    std::string document;
+    std::string second;
+
+    // Act
+    *archive->openDocument() >> document;
+    *archive->openFile(1) >> second;
+
+    // Assert
+    EXPECT_EQ(document, "<Document/>");
+    ASSERT_EQ(archive->countFiles(), 2);
+    EXPECT_EQ(archive->getFileName(0), "first.bin");
+    EXPECT_EQ(archive->getFileName(1), "second.bin");
+    EXPECT_EQ(second, "second");
+    EXPECT_GE(archive->getMemSize(), document.size() + std::string("firstsecond").size());
+}
+
+TEST_F(DeferredDocFileTest, prefetchedArchiveRejectsInvalidFile)
+{
+    // Arrange
+    {
+        std::ofstream file(this->archive(), std::ios::out | std::ios::binary | std::ios::trunc);
+        file << "not a zip file";
+    }
+
+    // Act & Assert
+    EXPECT_THROW(Base::PrefetchedArchive::read(this->archive()), Base::FileException);
+}
+
+TEST_F(DeferredDocFileTest, restoreFailsIfArchiveChanged)
+{
+    // Arrange
+    auto archive = Base::DeferredDocFile::openArchive(this->archive());
+    ASSERT_TRUE(archive);
+    std::string content;
+    auto file = makeFile(archive, "first.bin", content);
+    writeArchive("changed first", "second");
+
+    // Act
+    bool result = file->restore();
+    bool resultAll = Base::DeferredDocFile::restoreAll(this->archive());
+
+    // Assert
+    EXPECT_FALSE(result);
+    EXPECT_FALSE(resultAll);
+    EXPECT_TRUE(content.empty());
+    EXPECT_TRUE(file->isPending());
+    EXPECT_TRUE(file->hasFailed());
+}
+
+TEST_F(DeferredDocFileTest, restoreAllSkipsDestroyedFiles)
+{
+    // Arrange
+    auto archive = Base::DeferredDocFile::openArchive(this->archive());
+    ASSERT_TRUE(archive);
+    std::string first;
+    std::string second;
+    auto firstFile = makeFile(archive, "first.bin", first);
+    makeFile(archive, "second.bin", second);
+
+    // Act
+    bool result = Base::DeferredDocFile::restoreAll(this->archive());
+
+    // Assert
+    EXPECT_TRUE(result);
+    EXPECT_EQ(first, "first");
+    EXPECT_TRUE(second.empty());
+}
+
+TEST_F(DeferredDocFileTest, getSizeReportsPendingData)
+{
+    // Arrange
+    auto archive = Base::DeferredDocFile::openArchive(this->archive());
+    ASSERT_TRUE(archive);
+    std::string content;
+    auto file = makeFile(archive, "second.bin", content);
+
+    // Act
+    auto pendingSize = file->getSize();
+    file->restore();
+    auto restoredSize = file->getSize();
+
+    // Assert
+    EXPECT_EQ(pendingSize, std::string("second").size());
+    EXPECT_EQ(restoredSize, 0U);
+}
+
+TEST_F(DeferredDocFileTest, mappingAlignmentIsPageSize)
+{
+    // Act
+    auto alignment = Base::XMLReader::getMappingAlignment();
+
+    // Assert
+    EXPECT_GE(alignment, 512U);
+    EXPECT_EQ(alignment & (alignment - 1), 0U);
+}
+
+TEST_F(DeferredDocFileTest, readFilesFromMappedArchive)
+{
+    // Arrange
+    std::string first = binaryData(1);
+    std::string second = binaryData(2);
+    writeStoredArchive(first, second);
+    std::istringstream document("<Document/>");
+    Base::XMLReader reader("Document.xml", document, Base::XMLReader::Backend::Pull);
+    DocFileData firstData;
+    DocFileData secondData;
+    reader.addFile("first.bin", &firstData);
+    reader.addFile("second.bin", &secondData);
+    reader.setMappedArchive(this->archive());
+    std::ifstream file(this->archive(), std::ios::in | std::ios::binary);
+    // the stream is opened at the first entry
+    zipios::ZipInputStream zipstream(file);
+
+    // Act
+    reader.readFiles(zipstream);
+
+    // Assert
+    EXPECT_FALSE(reader.hasReadFailed("first.bin"));
+    EXPECT_FALSE(reader.hasReadFailed("second.bin"));
+    EXPECT_EQ(firstData.getData(), first);
+    EXPECT_EQ(secondData.getData(), second);
+}
+
+TEST_F(DeferredDocFileTest, restoreMapsStoredEntry)
+{
+    // Arrange
+    std::string second = binaryData(3);
+    writeStoredArchive(binaryData(4), second);
+    auto archive = Base::DeferredDocFile::openArchive(this->archive());
+    ASSERT_TRUE(archive);
+    DocFileData secondData;
+    auto file = Base::DeferredDocFile::create(archive, "second.bin", 1);
+    file->setRestorer([&secondData](Base::Reader& reader) {
+        secondData.RestoreDocFile(reader);
+    });
+
+    // Act
+    bool result = file->restore();
+
+    // Assert
+    EXPECT_TRUE(result);
+    EXPECT_FALSE(file->isPending());
+    EXPECT_EQ(secondData.getData(), second);
+}
+
+TEST_F(DeferredDocFileTest, prefetchedArchiveMapsStoredFiles)
+{
+    // Arrange
+    std::string first = binaryData(5);
+    writeStoredArchive(first, binaryData(6));
+    auto archive = Base::PrefetchedArchive::read(this->archive());
+
+    // Act
+    auto stream = archive->openFile(0);
+    std::string content {std::istreambuf_iterator<char>(*stream),
+                         std::istreambuf_iterator<char>()};
+
+    // Assert
+    EXPECT_EQ(content, first);
+    // the stored files aren't copied into memory
+    EXPECT_LT(archive->getMemSize(), first.size());
+}
+
+TEST_F(DeferredDocFileTest, prefetchedArchiveReadsFilesOnOpen)
+{
+    // Arrange
+    auto archive = Base::PrefetchedArchive::read(this->archive(), false);
+    std::string second;
+
+    // Act
+    *archive->openFile(1) >> second;
+
+    // Assert
+    ASSERT_EQ(archive->countFiles(), 2);
+    EXPECT_EQ(second, "second");
+}
+
+TEST_F(DeferredDocFileTest, prefetchedArchiveRejectsChangedFile)
+{
+    // Arrange
+    auto archive = Base::PrefetchedArchive::read(this->archive(), false);
+    writeArchive("changed first", "second");
+
+    // Act & Assert
+    EXPECT_THROW(archive->openFile(0), Base::FileException);
+}
+
+TEST_F(DeferredDocFileTest, readFilesFromPrefetchedArchiveWithNestedReader)
+{
+    // Arrange
+    {
+        std::ofstream file(this->archive(), std::ios::out | std::ios::binary | std::ios::trunc);
+        Base::ZipWriter writer(file);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        writer.putNextEntry("outer.bin");
+        writer.Stream() << "outer";
+        writer.putNextEntry("inner.bin");
+        writer.Stream() << "inner";
+        writer.putNextEntry("last.bin");
+        writer.Stream() << "last";
+    }
+    auto archive = Base::PrefetchedArchive::read(this->archive());
+    std::istringstream document("<Document/>");
+    Base::XMLReader reader("Document.xml", document, Base::XMLReader::Backend::Pull);
+    DocFileData inner;
+    NestedDocFile outer("inner.bin", inner);
+    DocFileData last;
+    reader.addFile("outer.bin", &outer);
+    reader.addFile("last.bin", &last);
+
+    // Act
+    reader.readFiles(*archive);
+
+    // Assert
+    EXPECT_EQ(outer.getData(), "outer");
+    EXPECT_EQ(inner.getData(), "inner");
+    EXPECT_EQ(last.getData(), "last");
+}
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <Base/ThreadPool.h>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+TEST(ThreadPool, idealThreadCountIsPositive)
+{
+    EXPECT_GE(Base::ThreadPool::idealThreadCount(), 1U);
+}
+
+TEST(ThreadPool, runsAllTasks)
+{
+    // Arrange
+    std::atomic<int> counter {0};
+    Base::ThreadPool pool(4);
+
+    // Act
+    for (int i = 0; i < 1000; ++i) {
+        pool.start([&counter] {
+            ++counter;
+        });
+    }
+    pool.waitForDone();
+
+    // Assert
+    EXPECT_EQ(pool.threadCount(), 4U);
+    EXPECT_EQ(counter, 1000);
+}
+
+TEST(ThreadPool, destructorDrainsQueue)
+{
+    std::atomic<int> counter {0};
+    {
+        Base::ThreadPool pool(2);
+        for (int i = 0; i < 100; ++i) {
+            pool.start([&counter] {
+                ++counter;
+            });
+        }
+    }
+    EXPECT_EQ(counter, 100);
+}
+
+TEST(ThreadPool, exceptionInTaskDoesNotStopPool)
+{
+    std::atomic<int> counter {0};
+    Base::ThreadPool pool(2);
+    pool.start([] {
+        throw std::runtime_error("task failure");
+    });
+    pool.start([&counter] {
+        ++counter;
+    });
+    pool.waitForDone();
+    EXPECT_EQ(counter, 1);
+}
+
+TEST(ThreadPool, parallelForVisitsEveryIndexOnce)
+{
+    // Arrange
+    std::vector<std::atomic<int>> visits(10007);
+
+    // Act
+    Base::ThreadPool::parallelFor(
+        visits.size(),
+        [&visits](std::size_t i) {
+            ++visits[i];
+        },
+        8,
+        64);
+
+    // Assert
+    for (const auto& v : visits) {
+        EXPECT_EQ(v, 1);
+    }
+}
+
+TEST(ThreadPool, parallelForRethrows)
+{
+    EXPECT_THROW(Base::ThreadPool::parallelFor(
+                     100,
+                     [](std::size_t i) {
+                         if (i == 42) {
+                             throw std::runtime_error("index failure");
+                         }
+                     },
+                     4),
+                 std::runtime_error);
+}
+
+// NOLINTEND(readability-magic-numbers)
@@ -2,7 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <sstream>
+#include <zipios++/zipinputstream.h>
+
 #include "Base/Exception.h"
+#include "Base/Persistence.h"
 #include "Base/Writer.h"
 
 // Writer is designed to be a base class, so for testing we actually instantiate a StringWriter,
@@ -129,3 +133,105 @@ TEST_F(WriterTest, charStreamBase64Encoded)
     // Conversion done using https://www.base64encode.org for testing purposes
     EXPECT_EQ(std::string("RnJlZUNBRCByb2NrcyEg8J+qqPCfqqjwn6qo\n"), _writer.getString());
 }
+
+TEST(ZipWriterTest, parallelCompressionKeepsEntryOrder)
+{
+    // Arrange
+    std::vector<std::pair<std::string, std::string>> entries;
+    for (int i = 0; i < 20; ++i) {
+        std::string data;
+        for (int j = 0; j <= i * 1000; ++j) {
+            data += std::to_string(i * j) + ' ';
+        }
+        entries.emplace_back("Entry" + std::to_string(i), data);
+    }
+    std::ostringstream zip;
+
+    // Act
+    {
+        Base::ZipWriter writer(zip);
+        writer.setLevel(7);
+        writer.setThreadCount(4);
+        for (const auto& [name, data] : entries) {
+            writer.putNextEntry(name.c_str());
+            writer.Stream() << data;
+        }
+        writer.writeFiles();
+        EXPECT_FALSE(writer.hasErrors());
+    }
+
+    // Assert
+    std::istringstream input(zip.str());
+    // the stream is opened at the first entry
+    zipios::ZipInputStream reader(input);
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        if (i > 0) {
+            auto entry = reader.getNextEntry();
+            ASSERT_TRUE(entry->isValid());
+            EXPECT_EQ(entries[i].first, entry->getName());
+        }
+        std::string content {std::istreambuf_iterator<char>(reader),
+                             std::istreambuf_iterator<char>()};
+        EXPECT_EQ(entries[i].second, content);
+    }
+}
+
+namespace
+{
+class BinaryData: public Base::Persistence
+{
+public:
+    explicit BinaryData(std::string data)
+        : data(std::move(data))
+    {}
+    unsigned int getMemSize() const override
+    {
+        return static_cast<unsigned int>(data.size());
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void SaveDocFile(Base::Writer& writer) const override
+    {
+        writer.Stream() << data;
+    }
+
+private:
+    std::string data;
+};
+}  // namespace
+
+TEST(ZipWriterTest, binaryFilesAreStoredAligned)
+{
+    // Arrange
+    const unsigned int alignment = 4096;
+    BinaryData text(std::string(100, 't'));
+    BinaryData binary(std::string(5000, 'b'));
+    std::ostringstream zip;
+
+    // Act
+    {
+        Base::ZipWriter writer(zip);
+        writer.setStorageAlignment(alignment);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        writer.addFile("Text.txt", &text);
+        writer.addFile("Binary.bin", &binary, true);
+        writer.writeFiles();
+        EXPECT_FALSE(writer.hasErrors());
+    }
+
+    // Assert
+    std::istringstream input(zip.str());
+    zipios::ZipInputStream reader(input);
+    auto entry = reader.getNextEntry();
+    ASSERT_EQ("Text.txt", entry->getName());
+    EXPECT_EQ(zipios::DEFLATED, entry->getMethod());
+    entry = reader.getNextEntry();
+    ASSERT_EQ("Binary.bin", entry->getName());
+    EXPECT_EQ(zipios::STORED, entry->getMethod());
+    EXPECT_EQ(0, reader.getDataOffset() % alignment);
+    std::string content {std::istreambuf_iterator<char>(reader), std::istreambuf_iterator<char>()};
+    EXPECT_EQ(std::string(5000, 'b'), content);
+}
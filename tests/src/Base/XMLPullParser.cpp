@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include "Base/Exception.h"
+#include "Base/XMLPullParser.h"
+
+using Event = Base::XMLPullParser::Event;
+
+TEST(XMLPullParser, readsElementsAndAttributes)
+{
+    // Arrange
+    Base::XMLPullParser parser(R"(<?xml version="1.0" encoding="utf-8"?><a x="1" y='two'><b/></a>)");
+
+    // Act / Assert
+    EXPECT_EQ(Event::StartDocument, parser.event());
+    ASSERT_EQ(Event::StartElement, parser.next());
+    EXPECT_EQ("a", parser.name());
+    EXPECT_FALSE(parser.isEmptyElement());
+    ASSERT_EQ(2, parser.attributes().size());
+    EXPECT_STREQ("1", parser.attribute("x"));
+    EXPECT_STREQ("two", parser.attribute("y"));
+    EXPECT_EQ(nullptr, parser.attribute("z"));
+    EXPECT_EQ(1, parser.depth());
+
+    ASSERT_EQ(Event::StartElement, parser.next());
+    EXPECT_EQ("b", parser.name());
+    EXPECT_TRUE(parser.isEmptyElement());
+    EXPECT_TRUE(parser.attributes().empty());
+    EXPECT_EQ(1, parser.depth());
+
+    ASSERT_EQ(Event::EndElement, parser.next());
+    EXPECT_EQ("a", parser.name());
+    EXPECT_EQ(0, parser.depth());
+    EXPECT_EQ(Event::EndDocument, parser.next());
+    EXPECT_EQ(Event::EndDocument, parser.next());
+}
+
+TEST(XMLPullParser, namesAndValuesAreNullTerminated)
+{
+    // Arrange
+    Base::XMLPullParser parser("<element name=\"value\">text</element>");
+
+    // Act
+    parser.next();
+
+    // Assert
+    EXPECT_STREQ("element", parser.name().data());
+    EXPECT_STREQ("name", parser.attributes().front().name.data());
+    EXPECT_STREQ("value", parser.attributes().front().value.data());
+}
+
+TEST(XMLPullParser, decodesReferences)
+{
+    // Arrange
+    Base::XMLPullParser parser(
+        "<a v=\"&lt;&gt;&amp;&quot;&apos;&#65;&#x42;&#233;\">x &amp; y &#x263A;</a>");
+
+    // Act
+    parser.next();
+    std::string value = parser.attribute("v");
+    auto event = parser.next();
+
+    // Assert
+    EXPECT_EQ("<>&\"'AB\xC3\xA9", value);
+    ASSERT_EQ(Event::Characters, event);
+    EXPECT_EQ("x & y \xE2\x98\xBA", parser.text());
+}
+
+TEST(XMLPullParser, normalizesWhitespace)
+{
+    // Arrange
+    Base::XMLPullParser parser("<a v=\"1\t2\r\n3&#10;4&#13;\">x\r\ny\rz</a>");
+
+    // Act
+    parser.next();
+    std::string value = parser.attribute("v");
+    parser.next();
+
+    // Assert
+    EXPECT_EQ("1 2 3\n4\r", value);
+    EXPECT_EQ("x\ny\nz", parser.text());
+}
+
+TEST(XMLPullParser, skipsCommentsAndDeclarations)
+{
+    // Arrange
+    Base::XMLPullParser parser("<?xml version='1.0'?>\n<!DOCTYPE a [<!ENTITY e \">\">]>\n"
+                               "<!-- comment <a> -->\n<a><?pi data?><!-- x --></a>\n");
+
+    // Act / Assert
+    ASSERT_EQ(Event::StartElement, parser.next());
+    EXPECT_EQ("a", parser.name());
+    ASSERT_EQ(Event::EndElement, parser.next());
+    EXPECT_EQ(Event::EndDocument, parser.next());
+}
+
+TEST(XMLPullParser, readsCDATA)
+{
+    // Arrange
+    Base::XMLPullParser parser("<a><![CDATA[<b>&amp;</b>]]></a>");
+
+    // Act
+    parser.next();
+    auto event = parser.next();
+
+    // Assert
+    ASSERT_EQ(Event::CDATA, event);
+    EXPECT_EQ("<b>&amp;</b>", parser.text());
+}
+
+TEST(XMLPullParser, rejectsMalformedDocuments)
+{
+    auto parseAll = [](const char* text) {
+        Base::XMLPullParser parser(text);
+        while (parser.next() != Event::EndDocument) {}
+    };
+
+    EXPECT_THROW(parseAll("<a></b>"), Base::XMLParseException);
+    EXPECT_THROW(parseAll("<a>"), Base::XMLParseException);
+    EXPECT_THROW(parseAll("<a>&unknown;</a>"), Base::XMLParseException);
+    EXPECT_THROW(parseAll("<a>&#0;</a>"), Base::XMLParseException);
+    EXPECT_THROW(parseAll("<a x=\"1\" x=\"2\"/>"), Base::XMLParseException);
+    EXPECT_THROW(parseAll("<a x=\"1\"y=\"2\"/>"), Base::XMLParseException);
+    EXPECT_THROW(parseAll("<a x=\"<\"/>"), Base::XMLParseException);
+    EXPECT_THROW(parseAll("<a/><b/>"), Base::XMLParseException);
+    EXPECT_THROW(parseAll("text<a/>"), Base::XMLParseException);
+    EXPECT_THROW(parseAll(""), Base::XMLParseException);
+    EXPECT_THROW(parseAll("<?xml version='1.0' encoding='ISO-8859-1'?><a/>"),
+                 Base::XMLParseException);
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <Mod/Mesh/App/Core/CompactKernel.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class CompactKernelTest: public ::testing::Test
+{
+protected:
+    // a wavy surface with size x size quads
+    static MeshCore::MeshKernel makeSurface(int size)
+    {
+        MeshCore::MeshPointArray points;
+        points.reserve((size + 1) * (size + 1));
+        for (int i = 0; i <= size; i++) {
+            for (int j = 0; j <= size; j++) {
+                float z = std::sin(0.1F * float(i)) * std::cos(0.1F * float(j));
+                points.emplace_back(float(i), float(j), z);
+            }
+        }
+
+        MeshCore::MeshFacetArray facets;
+        facets.reserve(2 * size * size);
+        auto index = [size](int i, int j) {
+            return MeshCore::PointIndex(i * (size + 1) + j);
+        };
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                facets.emplace_back(index(i, j), index(i + 1, j), index(i, j + 1));
+                facets.emplace_back(index(i, j + 1), index(i + 1, j), index(i + 1, j + 1));
+            }
+        }
+
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    static Base::Matrix4D makeTransform()
+    {
+        Base::Matrix4D mat;
+        mat.rotZ(0.3);
+        mat.rotX(-0.2);
+        mat.move(Base::Vector3d(1.0, -2.0, 3.0));
+        return mat;
+    }
+
+    static void expectSameBoundBox(const Base::BoundBox3f& box1, const Base::BoundBox3f& box2)
+    {
+        EXPECT_EQ(box1.MinX, box2.MinX);
+        EXPECT_EQ(box1.MinY, box2.MinY);
+        EXPECT_EQ(box1.MinZ, box2.MinZ);
+        EXPECT_EQ(box1.MaxX, box2.MaxX);
+        EXPECT_EQ(box1.MaxY, box2.MaxY);
+        EXPECT_EQ(box1.MaxZ, box2.MaxZ);
+    }
+};
+
+TEST_F(CompactKernelTest, TestAssign)
+{
+    MeshCore::MeshKernel kernel = makeSurface(10);
+    kernel.GetPoints()[5].SetFlag(MeshCore::MeshPoint::SELECTED);
+    kernel.GetFacets()[7].SetFlag(MeshCore::MeshFacet::MARKED);
+
+    MeshCore::MeshCompactKernel compact(kernel);
+    EXPECT_EQ(compact.CountPoints(), kernel.CountPoints());
+    EXPECT_EQ(compact.CountFacets(), kernel.CountFacets());
+    expectSameBoundBox(compact.GetBoundBox(), kernel.GetBoundBox());
+    EXPECT_EQ(compact.GetPoint(5), kernel.GetPoint(5));
+    EXPECT_TRUE(compact.IsPointFlag(5, MeshCore::MeshPoint::SELECTED));
+    EXPECT_FALSE(compact.IsPointFlag(6, MeshCore::MeshPoint::SELECTED));
+    EXPECT_TRUE(compact.IsFacetFlag(7, MeshCore::MeshFacet::MARKED));
+
+    MeshCore::PointIndex p0 {}, p1 {}, p2 {};
+    compact.GetFacetPoints(7, p0, p1, p2);
+    const MeshCore::MeshFacet& face = kernel.GetFacets()[7];
+    EXPECT_EQ(p0, face._aulPoints[0]);
+    EXPECT_EQ(p1, face._aulPoints[1]);
+    EXPECT_EQ(p2, face._aulPoints[2]);
+}
+
+TEST_F(CompactKernelTest, TestNeighboursAreComputedLazily)
+{
+    MeshCore::MeshKernel kernel = makeSurface(10);
+    MeshCore::MeshCompactKernel compact(kernel);
+    EXPECT_FALSE(compact.HasNeighbours());
+
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        MeshCore::FacetIndex n0 {}, n1 {}, n2 {};
+        compact.GetFacetNeighbours(i, n0, n1, n2);
+        const MeshCore::MeshFacet& face = kernel.GetFacets()[i];
+        EXPECT_EQ(n0, face._aulNeighbours[0]);
+        EXPECT_EQ(n1, face._aulNeighbours[1]);
+        EXPECT_EQ(n2, face._aulNeighbours[2]);
+    }
+    EXPECT_TRUE(compact.HasNeighbours());
+}
+
+TEST_F(CompactKernelTest, TestExport)
+{
+    MeshCore::MeshKernel kernel = makeSurface(10);
+    kernel.GetFacets()[3].SetFlag(MeshCore::MeshFacet::SELECTED);
+    MeshCore::MeshCompactKernel compact(kernel);
+
+    MeshCore::MeshKernel copy;
+    compact.Export(copy);
+    expectSameBoundBox(copy.GetBoundBox(), kernel.GetBoundBox());
+    ASSERT_EQ(copy.CountFacets(), kernel.CountFacets());
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        const MeshCore::MeshFacet& face1 = copy.GetFacets()[i];
+        const MeshCore::MeshFacet& face2 = kernel.GetFacets()[i];
+        EXPECT_TRUE(face1.IsEqual(face2));
+        EXPECT_EQ(face1._aulNeighbours[0], face2._aulNeighbours[0]);
+        EXPECT_EQ(face1._aulNeighbours[1], face2._aulNeighbours[1]);
+        EXPECT_EQ(face1._aulNeighbours[2], face2._aulNeighbours[2]);
+        EXPECT_EQ(face1._ucFlag, face2._ucFlag);
+    }
+}
+
+TEST_F(CompactKernelTest, TestCompactLayoutMatchesMeshKernel)
+{
+    const int size = 400;
+    MeshCore::MeshKernel kernel = makeSurface(size);
+    MeshCore::MeshCompactKernel compact(kernel);
+    Base::Matrix4D mat = makeTransform();
+
+    // best of several runs, both layouts get the same sequence of operations
+    auto measure = [](auto&& func) {
+        double best = std::numeric_limits<double>::max();
+        for (int i = 0; i < 5; i++) {
+            auto start = std::chrono::steady_clock::now();
+            func();
+            auto time = std::chrono::steady_clock::now() - start;
+            best = std::min(best, std::chrono::duration<double, std::milli>(time).count());
+        }
+        return std::to_string(best);
+    };
+
+    RecordProperty("KernelBoundBoxMilliseconds", measure([&]() {
+                       kernel.RecalcBoundBox();
+                   }));
+    RecordProperty("CompactBoundBoxMilliseconds", measure([&]() {
+                       compact.RecalcBoundBox();
+                   }));
+    expectSameBoundBox(compact.GetBoundBox(), kernel.GetBoundBox());
+
+    RecordProperty("KernelTransformMilliseconds", measure([&]() {
+                       kernel.Transform(mat);
+                   }));
+    RecordProperty("CompactTransformMilliseconds", measure([&]() {
+                       compact.Transform(mat);
+                   }));
+    expectSameBoundBox(compact.GetBoundBox(), kernel.GetBoundBox());
+    EXPECT_EQ(compact.GetPoint(1234), kernel.GetPoint(1234));
+
+    std::vector<Base::Vector3f> kernelNormals;
+    std::vector<Base::Vector3f> compactNormals;
+    RecordProperty("KernelNormalsMilliseconds", measure([&]() {
+                       kernelNormals = kernel.CalcVertexNormals();
+                   }));
+    RecordProperty("CompactNormalsMilliseconds", measure([&]() {
+                       compactNormals = compact.CalcVertexNormals();
+                   }));
+    EXPECT_EQ(compactNormals, kernelNormals);
+
+    std::size_t kernelSize = kernel.CountPoints() * sizeof(MeshCore::MeshPoint)
+        + kernel.CountFacets() * sizeof(MeshCore::MeshFacet);
+    RecordProperty("KernelBytes", std::to_string(kernelSize));
+    RecordProperty("CompactBytes", std::to_string(compact.GetMemSize()));
+    EXPECT_LT(3 * compact.GetMemSize(), kernelSize);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
 #include <Base/FileInfo.h>
 #include <Mod/Mesh/App/Core/IO/Reader3MF.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <zipios++/fcoll.h>
 
@@ -37,4 +42,87 @@ TEST_F(ImporterTest, Test3MF)
     EXPECT_EQ(mesh2.CountEdges(), 1950);
     EXPECT_EQ(mesh2.CountFacets(), 1300);
 }
+
+TEST_F(ImporterTest, TestBinarySTL)
+{
+    // a grid with more facets than processed at once by the importer
+    const int size = 300;
+    auto point = [](int i, int j) {
+        return Base::Vector3f(float(i), float(j), float((i * j) % 7));
+    };
+
+    std::stringstream str;
+    std::string header(80, ' ');
+    str.write(header.data(), header.size());
+    uint32_t count = 2 * size * size;
+    str.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    auto writeFacet = [&str](const Base::Vector3f& p1,
+                             const Base::Vector3f& p2,
+                             const Base::Vector3f& p3) {
+        Base::Vector3f record[4] = {Base::Vector3f(), p1, p2, p3};
+        str.write(reinterpret_cast<const char*>(record), sizeof(record));
+        uint16_t attribute = 0;
+        str.write(reinterpret_cast<const char*>(&attribute), sizeof(attribute));
+    };
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            writeFacet(point(i, j), point(i + 1, j), point(i, j + 1));
+            writeFacet(point(i, j + 1), point(i + 1, j), point(i + 1, j + 1));
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::MeshInput input(kernel);
+    ASSERT_TRUE(input.LoadBinarySTL(str));
+    EXPECT_EQ(kernel.CountPoints(), (size + 1) * (size + 1));
+    ASSERT_EQ(kernel.CountFacets(), count);
+
+    // the importer starts a facet with its last point
+    MeshCore::MeshGeomFacet last = kernel.GetFacet(count - 1);
+    EXPECT_EQ(last._aclPoints[0], point(size, size));
+    EXPECT_EQ(last._aclPoints[1], point(size - 1, size));
+    EXPECT_EQ(last._aclPoints[2], point(size, size - 1));
+    EXPECT_EQ(kernel.CountEdges(), 3 * size * size + 2 * size);
+}
+
+TEST_F(ImporterTest, TestBinaryPLY)
+{
+    std::stringstream str;
+    str << "ply\n"
+        << "format binary_big_endian 1.0\n"
+        << "element vertex 3\n"
+        << "property double x\n"
+        << "property double y\n"
+        << "property double z\n"
+        << "property uchar flags\n"
+        << "element face 1\n"
+        << "property list uchar int vertex_indices\n"
+        << "end_header\n";
+
+    auto writeBigEndian = [&str](auto value) {
+        char bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        std::reverse(std::begin(bytes), std::end(bytes));
+        str.write(bytes, sizeof(bytes));
+    };
+    const double coords[3][3] = {{0.0, 0.0, 0.0}, {1.5, 0.0, -2.0}, {0.0, 3.0, 0.25}};
+    for (const auto& coord : coords) {
+        writeBigEndian(coord[0]);
+        writeBigEndian(coord[1]);
+        writeBigEndian(coord[2]);
+        writeBigEndian(uint8_t(1));
+    }
+    writeBigEndian(uint8_t(3));
+    writeBigEndian(int32_t(0));
+    writeBigEndian(int32_t(1));
+    writeBigEndian(int32_t(2));
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::MeshInput input(kernel);
+    ASSERT_TRUE(input.LoadPLY(str));
+    ASSERT_EQ(kernel.CountPoints(), 3);
+    ASSERT_EQ(kernel.CountFacets(), 1);
+    EXPECT_EQ(kernel.GetPoint(1), Base::Vector3f(1.5F, 0.0F, -2.0F));
+    EXPECT_EQ(kernel.GetPoint(2), Base::Vector3f(0.0F, 3.0F, 0.25F));
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <Mod/Mesh/App/Mesh.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 
@@ -106,4 +107,50 @@ TEST_F(MeshTest, TestGrid2OfAlmostPlanarMesh)
     EXPECT_EQ(countY, 1);
     EXPECT_EQ(countZ, 1);
 }
+
+TEST_F(MeshTest, TestGridOfLargeMesh)
+{
+    const int size = 120;
+    std::vector<MeshCore::MeshGeomFacet> facets;
+    auto point = [](int i, int j) {
+        return Base::Vector3f(float(i), float(j), float((i * j) % 7));
+    };
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            facets.emplace_back(point(i, j), point(i + 1, j), point(i, j + 1));
+            facets.emplace_back(point(i, j + 1), point(i + 1, j), point(i + 1, j + 1));
+        }
+    }
+    MeshCore::MeshKernel kernel;
+    kernel = facets;
+
+    MeshCore::MeshFacetGrid facetGrid(kernel, 20);
+    EXPECT_TRUE(facetGrid.Verify());
+
+    std::vector<int> facetCount(kernel.CountFacets());
+    MeshCore::MeshGridIterator facetIt(facetGrid);
+    for (facetIt.Init(); facetIt.More(); facetIt.Next()) {
+        std::vector<MeshCore::ElementIndex> elements;
+        facetIt.GetElements(elements);
+        EXPECT_TRUE(std::is_sorted(elements.begin(), elements.end()));
+        for (auto index : elements) {
+            facetCount[index]++;
+        }
+    }
+    EXPECT_EQ(std::count(facetCount.begin(), facetCount.end(), 0), 0);
+
+    MeshCore::MeshPointGrid pointGrid(kernel, 20);
+    std::vector<int> pointCount(kernel.CountPoints());
+    MeshCore::MeshGridIterator pointIt(pointGrid);
+    for (pointIt.Init(); pointIt.More(); pointIt.Next()) {
+        std::vector<MeshCore::ElementIndex> elements;
+        pointIt.GetElements(elements);
+        for (auto index : elements) {
+            EXPECT_TRUE(pointIt.GetBoundBox().IsInBox(kernel.GetPoint(index)));
+            pointCount[index]++;
+        }
+    }
+    EXPECT_EQ(std::count(pointCount.begin(), pointCount.end(), 1),
+              static_cast<long>(kernel.CountPoints()));
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
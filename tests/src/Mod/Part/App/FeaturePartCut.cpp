@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include "Mod/Part/App/FeaturePartCut.h"
+#include "Mod/Part/App/FeatureCompound.h"
 #include <src/App/InitApplication.h>
 
 #include "PartTestHelpers.h"
@@ -187,3 +188,50 @@ TEST_F(FeaturePartCutTest, testMapping)
 }
 
 // See FeaturePartCommon.cpp for a history test.  It would be exactly the same and redundant here.
+
+TEST_F(FeaturePartCutTest, testClustered)
+{
+    // Arrange a compound of boxes in a row cut by a compound of tools, one for every other box
+    std::vector<App::DocumentObject*> boxes;
+    std::vector<App::DocumentObject*> tools;
+    for (int i = 0; i < 10; i++) {
+        auto box = _doc->addObject<Part::Box>();
+        box->Length.setValue(10);
+        box->Width.setValue(10);
+        box->Height.setValue(10);
+        box->Placement.setValue(Base::Placement(Base::Vector3d(20.0 * i, 0, 0), Base::Rotation()));
+        boxes.push_back(box);
+        if (i % 2 == 0) {
+            auto tool = _doc->addObject<Part::Box>();
+            tool->Length.setValue(10);
+            tool->Width.setValue(10);
+            tool->Height.setValue(5);
+            tool->Placement.setValue(
+                Base::Placement(Base::Vector3d(20.0 * i + 5, 0, 0), Base::Rotation()));
+            tools.push_back(tool);
+        }
+    }
+    auto base = _doc->addObject<Part::Compound>();
+    base->Links.setValues(boxes);
+    base->execute();
+    auto tool = _doc->addObject<Part::Compound>();
+    tool->Links.setValues(tools);
+    tool->execute();
+    _cut->Base.setValue(base);
+    _cut->Tool.setValue(tool);
+    _cut->execute();
+    Part::TopoShape cut = _cut->Shape.getValue();
+
+    // Act
+    _cut->Clustered.setValue(true);
+    EXPECT_TRUE(_cut->mustExecute());
+    _cut->execute();
+    Part::TopoShape ts = _cut->Shape.getValue();
+
+    // Assert the result is the same as the one of a single cut
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(ts.getShape()), 10000.0 - 5 * 250.0);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(ts.getShape()),
+                     PartTestHelpers::getVolume(cut.getShape()));
+    EXPECT_EQ(ts.countSubShapes(TopAbs_SOLID), 10);
+    EXPECT_EQ(ts.countSubShapes(TopAbs_FACE), cut.countSubShapes(TopAbs_FACE));
+}
@@ -2,6 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include "App/Application.h"
+#include "App/Document.h"
+#include "App/Expression.h"
+#include "App/ObjectIdentifier.h"
+#include "Base/Interpreter.h"
 #include "Mod/Part/App/FeaturePartFuse.h"
 #include <src/App/InitApplication.h>
 #include "Mod/Part/App/FeatureCompound.h"
@@ -269,4 +274,93 @@ TEST_F(FeaturePartFuseTest, testRefine)
     EXPECT_EQ(_fuse->Shape.getShape().getElementMapSize(), 26);
 }
 
+TEST_F(FeaturePartFuseTest, testClustered)
+{
+    // Arrange ten pairs of overlapping boxes, the pairs are apart from each other
+    std::vector<App::DocumentObject*> links;
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 2; j++) {
+            auto box = _doc->addObject<Part::Box>();
+            box->Length.setValue(1);
+            box->Width.setValue(2);
+            box->Height.setValue(3);
+            box->Placement.setValue(
+                Base::Placement(Base::Vector3d(3.0 * i + 0.5 * j, 0, 0), Base::Rotation()));
+            links.push_back(box);
+        }
+    }
+    _multiFuse->Shapes.setValues(links);
+    _multiFuse->execute();
+    Part::TopoShape fused = _multiFuse->Shape.getValue();
+
+    // Act
+    _multiFuse->Clustered.setValue(true);
+    EXPECT_TRUE(_multiFuse->mustExecute());
+    _multiFuse->execute();
+    Part::TopoShape ts = _multiFuse->Shape.getValue();
+
+    // Assert the result is the same as the one of a single fusion
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(ts.getShape()), 90.0);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(ts.getShape()),
+                     PartTestHelpers::getVolume(fused.getShape()));
+    EXPECT_EQ(ts.countSubShapes(TopAbs_SOLID), 10);
+    EXPECT_EQ(ts.countSubShapes(TopAbs_FACE), fused.countSubShapes(TopAbs_FACE));
+    EXPECT_EQ(_multiFuse->History.getSize(), 20);
+}
+
+TEST_F(FeaturePartFuseTest, testParallelRecompute)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    hGrp->SetBool("ParallelRecompute", true);
+    hGrp->SetInt("RecomputeThreads", 4);
+    _fuse->Base.setValue(_boxes[0]);
+    _fuse->Tool.setValue(_boxes[1]);
+    _multiFuse->Shapes.setValues({_boxes[2], _boxes[3]});
+
+    // Act
+    bool hasError = false;
+    _doc->recompute({}, false, &hasError);
+    hGrp->RemoveBool("ParallelRecompute");
+    hGrp->RemoveInt("RecomputeThreads");
+
+    // Assert
+    EXPECT_TRUE(_boxes[0]->isExecuteThreadSafe());
+    EXPECT_FALSE(_fuse->isExecuteThreadSafe());
+    EXPECT_FALSE(hasError);
+    for (auto box : _boxes) {
+        EXPECT_FALSE(box->isTouched());
+        EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(box->Shape.getValue()), 6.0);
+    }
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(_fuse->Shape.getValue()), 9.0);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(_multiFuse->Shape.getValue()), 9.0);
+}
+
+TEST_F(FeaturePartFuseTest, testParallelRecomputeHoldingGIL)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    hGrp->SetBool("ParallelRecompute", true);
+    hGrp->SetInt("RecomputeThreads", 4);
+    _fuse->Base.setValue(_boxes[0]);
+    _fuse->Tool.setValue(_boxes[1]);
+    std::shared_ptr<App::Expression> rule(App::Expression::parse(_boxes[1], "2"));
+    _boxes[1]->setExpression(App::ObjectIdentifier::parse(_boxes[1], "Placement.Base.x"), rule);
+
+    // Act
+    // the Python console recomputes while holding the GIL
+    std::string cmd = "App.getDocument('" + std::string(_doc->getName()) + "').recompute()";
+    Base::Interpreter().runString(cmd.c_str());
+    hGrp->RemoveBool("ParallelRecompute");
+    hGrp->RemoveInt("RecomputeThreads");
+
+    // Assert
+    EXPECT_FALSE(_boxes[1]->isTouched());
+    EXPECT_DOUBLE_EQ(_boxes[1]->Placement.getValue().getPosition().x, 2.0);
+    // the boxes are apart now
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(_fuse->Shape.getValue()), 12.0);
+}
+
 // See FeaturePartCommon.cpp for a history test.  It would be exactly the same and redundant here.
@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Mod/Part/App/FeaturePartBox.h>
+#include <Mod/Part/App/ShapeCache.h>
+#include <src/App/InitApplication.h>
+
+#include "PartTestHelpers.h"
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+namespace fs = std::filesystem;
+using namespace PartTestHelpers;
+
+class ShapeCacheTest: public ::testing::Test, public PartTestHelperClass
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        createTestDoc();
+        _dir = fs::temp_directory_path() / ("unit_test_ShapeCache-" + _docName);
+        _param = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Part/ShapeCache");
+        _param->SetBool("Enabled", true);
+        _param->SetASCII("Directory", _dir.string().c_str());
+        _box = _boxes[0];
+        _box->execute();
+    }
+
+    void TearDown() override
+    {
+        _param->RemoveBool("Enabled");
+        _param->RemoveASCII("Directory");
+        _param->RemoveUnsigned("MaxSize");
+        fs::remove_all(_dir);
+        App::GetApplication().closeDocument(_docName.c_str());
+    }
+
+    static Part::ShapeCache& cache()
+    {
+        return Part::ShapeCache::instance();
+    }
+
+    fs::path entryPath(const std::string& key) const
+    {
+        return _dir / (key + ".fcsc");
+    }
+
+    std::size_t countEntries() const
+    {
+        std::size_t count = 0;
+        for (const auto& entry : fs::directory_iterator(_dir)) {
+            count += entry.path().extension() == ".fcsc" ? 1 : 0;
+        }
+        return count;
+    }
+
+    Part::Box* _box = nullptr;  // NOLINT Can't be private in a test framework
+    fs::path _dir;              // NOLINT
+
+private:
+    ParameterGrp::handle _param;
+};
+
+TEST_F(ShapeCacheTest, restoreMissesUnknownKey)
+{
+    // Arrange
+    auto key = cache().computeKey(_box);
+
+    // Act
+    bool restored = cache().restore(_box, key);
+
+    // Assert
+    EXPECT_FALSE(key.empty());
+    EXPECT_FALSE(restored);
+}
+
+TEST_F(ShapeCacheTest, restoreHitsStoredEntry)
+{
+    // Arrange
+    auto key = cache().computeKey(_box);
+    cache().store(_box, key);
+    _box->Shape.setValue(TopoDS_Shape());
+
+    // Act
+    bool restored = cache().restore(_box, key);
+
+    // Assert
+    EXPECT_TRUE(restored);
+    EXPECT_TRUE(fs::exists(entryPath(key)));
+    EXPECT_DOUBLE_EQ(getVolume(_box->Shape.getValue()), 6.0);
+}
+
+TEST_F(ShapeCacheTest, computeKeyFollowsInputs)
+{
+    // Arrange
+    auto key = cache().computeKey(_box);
+
+    // Act
+    _box->Height.setValue(4.0);
+    auto changedKey = cache().computeKey(_box);
+
+    // Assert
+    EXPECT_NE(key, changedKey);
+}
+
+TEST_F(ShapeCacheTest, restoreRejectsCorruptEntry)
+{
+    // Arrange
+    auto key = cache().computeKey(_box);
+    cache().store(_box, key);
+    {
+        std::ofstream file(entryPath(key), std::ios::out | std::ios::binary | std::ios::trunc);
+        file << "FCShapeCache 1\n"
+             << "not a chunk";
+    }
+
+    // Act
+    bool restored = cache().restore(_box, key);
+
+    // Assert
+    EXPECT_FALSE(restored);
+    EXPECT_DOUBLE_EQ(getVolume(_box->Shape.getValue()), 6.0);
+}
+
+TEST_F(ShapeCacheTest, pruneRemovesEntriesOverLimit)
+{
+    // Arrange
+    for (auto box : _boxes) {
+        box->execute();
+        cache().store(box, cache().computeKey(box));
+    }
+    auto stored = countEntries();
+    App::GetApplication()
+        .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Part/ShapeCache")
+        ->SetUnsigned("MaxSize", 0);
+
+    // Act
+    cache().prune();
+
+    // Assert
+    EXPECT_GT(stored, 0U);
+    EXPECT_EQ(countEntries(), 0U);
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
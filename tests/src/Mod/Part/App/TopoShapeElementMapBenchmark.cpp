@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// Benchmarks of the element map construction of typical operations. The tests record the number
+// of sub-shapes, the element map size and the time as test properties, run the test executable
+// with --gtest_output=xml to collect them. The large variants are disabled by default and can be
+// run with --gtest_also_run_disabled_tests --gtest_filter=TopoShapeElementMapBenchmark.*
+
+#include <gtest/gtest.h>
+#include "src/App/InitApplication.h"
+#include <Mod/Part/App/TopoShape.h>
+#include <Mod/Part/App/TopoShapeOpCode.h>
+
+#include <chrono>
+#include <functional>
+
+#include <Base/Matrix.h>
+#include <BRepPrimAPI_MakeBox.hxx>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+using namespace Part;
+
+class TopoShapeElementMapBenchmark: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        App::GetApplication().newDocument(_docName.c_str(), "testUser");
+        _hasher = Base::Reference<App::StringHasher>(new App::StringHasher);
+    }
+
+    void TearDown() override
+    {
+        App::GetApplication().closeDocument(_docName.c_str());
+    }
+
+    // size x size boxes with the given distance, the boxes overlap if the distance is below 1
+    std::vector<TopoShape> makeBoxes(int size, double distance) const
+    {
+        std::vector<TopoShape> boxes;
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                auto box =
+                    BRepPrimAPI_MakeBox(gp_Pnt(i * distance, j * distance, 0), 1.0, 1.0, 1.0)
+                        .Shape();
+                boxes.emplace_back(box, static_cast<long>(boxes.size() + 1), _hasher);
+            }
+        }
+        return boxes;
+    }
+
+    static unsigned long countSubShapes(const TopoShape& shape)
+    {
+        return shape.countSubShapes(TopAbs_FACE) + shape.countSubShapes(TopAbs_EDGE)
+            + shape.countSubShapes(TopAbs_VERTEX);
+    }
+
+    void record(const TopoShape& result, const std::function<void()>& func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto time = std::chrono::steady_clock::now() - start;
+        RecordProperty("SubShapes", std::to_string(countSubShapes(result)));
+        RecordProperty("ElementMapSize", std::to_string(result.getElementMapSize()));
+        RecordProperty("Milliseconds",
+                       std::to_string(std::chrono::duration<double, std::milli>(time).count()));
+    }
+
+    void boolean(int size)
+    {
+        auto boxes = makeBoxes(size, 0.75);
+        TopoShape result(0, _hasher);
+        record(result, [&]() {
+            result.makeElementBoolean(Part::OpCodes::Fuse, boxes);
+        });
+        EXPECT_EQ(result.getElementMapSize(), countSubShapes(result));
+    }
+
+    void fillet(int size)
+    {
+        TopoShape compound(0, _hasher);
+        compound.makeElementCompound(makeBoxes(size, 1.5));
+        auto edges = compound.getSubTopoShapes(TopAbs_EDGE);
+        TopoShape result(0, _hasher);
+        record(result, [&]() {
+            result.makeElementFillet(compound, edges, 0.1, 0.1);
+        });
+        EXPECT_EQ(result.countSubShapes(TopAbs_FACE), 26UL * size * size);
+        EXPECT_GT(result.getElementMapSize(), 0UL);
+    }
+
+    void pattern(int count)
+    {
+        auto box = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+        TopoShape original(box, 1L, _hasher);
+        TopoShape result(0, _hasher);
+        record(result, [&]() {
+            std::vector<TopoShape> copies;
+            copies.reserve(count);
+            for (int i = 0; i < count; i++) {
+                Base::Matrix4D mat;
+                mat.move(Base::Vector3d(1.5 * i, 0.0, 0.0));
+                copies.push_back(TopoShape(0, _hasher).makeElementTransform(original, mat));
+                copies.back().Tag = i + 2;
+            }
+            result.makeElementCompound(copies);
+        });
+        EXPECT_EQ(result.getElementMapSize(), 26UL * count);
+    }
+
+private:
+    std::string _docName;
+    App::StringHasherRef _hasher;
+};
+
+// about 1k sub-shapes
+TEST_F(TopoShapeElementMapBenchmark, boolean)
+{
+    boolean(7);
+}
+
+// about 10k sub-shapes
+TEST_F(TopoShapeElementMapBenchmark, DISABLED_booleanLarge)
+{
+    boolean(20);
+}
+
+// about 100k sub-shapes
+TEST_F(TopoShapeElementMapBenchmark, DISABLED_booleanHuge)
+{
+    boolean(63);
+}
+
+// about 1k sub-shapes
+TEST_F(TopoShapeElementMapBenchmark, fillet)
+{
+    fillet(6);
+}
+
+// about 10k sub-shapes
+TEST_F(TopoShapeElementMapBenchmark, DISABLED_filletLarge)
+{
+    fillet(20);
+}
+
+// about 1k sub-shapes
+TEST_F(TopoShapeElementMapBenchmark, pattern)
+{
+    pattern(40);
+}
+
+// about 10k sub-shapes
+TEST_F(TopoShapeElementMapBenchmark, DISABLED_patternLarge)
+{
+    pattern(400);
+}
+
+// about 100k sub-shapes
+TEST_F(TopoShapeElementMapBenchmark, DISABLED_patternHuge)
+{
+    pattern(4000);
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
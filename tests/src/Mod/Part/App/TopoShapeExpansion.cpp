@@ -1937,6 +1937,68 @@ TEST_F(TopoShapeExpansionTest, makeElementGeneralFuse)
                                  }));
 }
 
+TEST_F(TopoShapeExpansionTest, makeElementClusteredFuse)
+{
+    // Arrange two overlapping cubes and a third one apart from them
+    auto [cube1, cube2] = CreateTwoCubes();
+    auto tr {gp_Trsf()};
+    tr.SetTranslation(gp_Vec(gp_XYZ(-0.5, -0.5, 0)));
+    cube2.Move(TopLoc_Location(tr));
+    auto cube3 = BRepPrimAPI_MakeBox(gp_Pnt(5, 5, 5), 1, 1, 1).Shape();
+    std::vector<TopoShape> shapes {{cube1, 1L}, {cube2, 2L}, {cube3, 3L}};
+    TopoShape fused;
+    fused.makeElementFuse(shapes);
+    // Act
+    std::vector<std::shared_ptr<BRepAlgoAPI_BooleanOperation>> makers;
+    TopoShape result;
+    result.makeElementClusteredFuse(shapes, nullptr, -1.0, &makers);
+    // Assert the result is the same as the one of a single fusion
+    EXPECT_FLOAT_EQ(getVolume(result.getShape()), 2.75);
+    EXPECT_FLOAT_EQ(getVolume(result.getShape()), getVolume(fused.getShape()));
+    EXPECT_EQ(result.countSubShapes(TopAbs_SOLID), fused.countSubShapes(TopAbs_SOLID));
+    EXPECT_EQ(result.countSubShapes(TopAbs_FACE), fused.countSubShapes(TopAbs_FACE));
+    // Assert the result is a flat compound of solids
+    EXPECT_EQ(result.shapeType(), fused.shapeType());
+    EXPECT_EQ(result.getSubTopoShapes().size(), fused.getSubTopoShapes().size());
+    EXPECT_EQ(result.getSubTopoShapes().size(), 2);
+    // Assert only the overlapping cubes are fused
+    ASSERT_EQ(makers.size(), 3);
+    EXPECT_TRUE(makers[0]);
+    EXPECT_EQ(makers[0], makers[1]);
+    EXPECT_FALSE(makers[2]);
+}
+
+TEST_F(TopoShapeExpansionTest, makeElementClusteredCut)
+{
+    // Arrange a compound of cubes in a row and a compound of tools, one for every other cube
+    std::vector<TopoShape> cubes;
+    std::vector<TopoShape> tools;
+    for (int i = 0; i < 10; i++) {
+        cubes.emplace_back(BRepPrimAPI_MakeBox(gp_Pnt(2 * i, 0, 0), 1, 1, 1).Shape(), i + 1L);
+        if (i % 2 == 0) {
+            tools.emplace_back(BRepPrimAPI_MakeBox(gp_Pnt(2 * i + 0.5, 0, 0), 1, 1, 0.5).Shape(),
+                               i + 11L);
+        }
+    }
+    std::vector<TopoShape> shapes {TopoShape().makeElementCompound(cubes),
+                                   TopoShape().makeElementCompound(tools)};
+    TopoShape cut;
+    cut.makeElementCut(shapes);
+    // Act
+    TopoShape result;
+    result.makeElementClusteredCut(shapes);
+    // Assert the result is the same as the one of a single cut
+    EXPECT_FLOAT_EQ(getVolume(result.getShape()), 10 - 5 * 0.25);
+    EXPECT_FLOAT_EQ(getVolume(result.getShape()), getVolume(cut.getShape()));
+    EXPECT_EQ(result.countSubShapes(TopAbs_SOLID), 10);
+    EXPECT_EQ(result.countSubShapes(TopAbs_SOLID), cut.countSubShapes(TopAbs_SOLID));
+    EXPECT_EQ(result.countSubShapes(TopAbs_FACE), cut.countSubShapes(TopAbs_FACE));
+    // Assert the result is a flat compound of solids
+    EXPECT_EQ(result.shapeType(), cut.shapeType());
+    EXPECT_EQ(result.getSubTopoShapes().size(), cut.getSubTopoShapes().size());
+    EXPECT_EQ(result.getSubTopoShapes(TopAbs_SOLID).size(), result.getSubTopoShapes().size());
+}
+
 TEST_F(TopoShapeExpansionTest, makeElementFuse)
 {
     // Arrange
@@ -2,10 +2,42 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <numbers>
+
+#include <BRepAlgoAPI_Fuse.hxx>
+#include <BRepBuilderAPI_Transform.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <Precision.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <gp_Ax1.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Trsf.hxx>
+
 #include <src/App/InitApplication.h>
 
 #include "PartTestHelpers.h"
 
+namespace
+{
+
+Part::TopoShape fuse(const TopoDS_Shape& base, const TopoDS_Shape& tool)
+{
+    BRepAlgoAPI_Fuse mkFuse(base, tool);
+    EXPECT_TRUE(mkFuse.IsDone());
+    return Part::TopoShape(mkFuse.Shape());
+}
+
+// Two boxes of 1 x 2 x 3 touching at y = 2, the second one is raised by offset
+Part::TopoShape fuseBoxes(double offset)
+{
+    return fuse(BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape(),
+                BRepPrimAPI_MakeBox(gp_Pnt(0.0, 2.0, offset), 1.0, 2.0, 3.0).Shape());
+}
+
+}  // namespace
+
 class FeaturePartMakeElementRefineTest: public ::testing::Test,
                                         public PartTestHelpers::PartTestHelperClass
 {
@@ -53,3 +85,102 @@ TEST_F(FeaturePartMakeElementRefineTest, makeElementRefineBoxes)
     // TODO: Refine doesn't work on compounds, so we're going to need a binary operation or the
     // like, and those don't exist yet.  Once they do, this test can be expanded
 }
+
+TEST_F(FeaturePartMakeElementRefineTest, makeElementRefineGridOfBoxes)
+{
+    // Arrange
+    const int size = 20;
+    TopTools_ListOfShape arguments;
+    TopTools_ListOfShape tools;
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            TopoDS_Shape box = BRepPrimAPI_MakeBox(gp_Pnt(i, j, 0), 1.0, 1.0, 1.0).Shape();
+            if (i == 0 && j == 0) {
+                arguments.Append(box);
+            }
+            else {
+                tools.Append(box);
+            }
+        }
+    }
+    BRepAlgoAPI_Fuse fuse;
+    fuse.SetArguments(arguments);
+    fuse.SetTools(tools);
+    fuse.Build();
+    ASSERT_TRUE(fuse.IsDone());
+    Part::TopoShape ts(fuse.Shape());
+    // Act
+    auto start = std::chrono::steady_clock::now();
+    Part::TopoShape refined = ts.makeElementRefine();
+    auto time = std::chrono::steady_clock::now() - start;
+    RecordProperty("RefineMilliseconds",
+                   std::to_string(std::chrono::duration<double, std::milli>(time).count()));
+    // Assert
+    EXPECT_EQ(ts.countSubElements("Face"), 2 * size * size + 4 * size);
+    EXPECT_EQ(refined.countSubElements("Face"), 6);
+    EXPECT_EQ(refined.countSubElements("Edge"), 12);
+    EXPECT_NEAR(PartTestHelpers::getVolume(refined.getShape()), size * size, 1e-6);
+}
+
+TEST_F(FeaturePartMakeElementRefineTest, makeElementRefineCoplanarFacesFarFromOrigin)
+{
+    // Arrange
+    // The keys of the planes are their distances to the origin, whose rounding errors grow
+    // with the distance
+    gp_Trsf move;
+    move.SetRotation(gp_Ax1(gp_Pnt(), gp_Dir(1.0, 2.0, 3.0)), 0.3);
+    move.SetTranslationPart(gp_Vec(1e4, -2e4, 3e4));
+    TopoDS_Shape moved = BRepBuilderAPI_Transform(fuseBoxes(0.0).getShape(), move).Shape();
+    Part::TopoShape ts(moved);
+    // Act
+    Part::TopoShape refined = ts.makeElementRefine();
+    // Assert
+    EXPECT_EQ(ts.countSubElements("Face"), 10);
+    EXPECT_EQ(refined.countSubElements("Face"), 6);
+    EXPECT_NEAR(PartTestHelpers::getVolume(refined.getShape()), 12.0, 1e-6);
+}
+
+TEST_F(FeaturePartMakeElementRefineTest, makeElementRefineCoplanarFacesNearTolerance)
+{
+    // Arrange
+    Part::TopoShape inside = fuseBoxes(0.1 * Precision::Confusion());
+    Part::TopoShape outside = fuseBoxes(10.0 * Precision::Confusion());
+    // Act
+    Part::TopoShape refinedInside = inside.makeElementRefine();
+    Part::TopoShape refinedOutside = outside.makeElementRefine();
+    // Assert
+    // Within the tolerance the top and bottom faces are united, so it is one box again
+    EXPECT_EQ(refinedInside.countSubElements("Face"), 6);
+    // Otherwise only the side faces are united. The top and the bottom keep a small step each.
+    EXPECT_EQ(outside.countSubElements("Face"), 12);
+    EXPECT_EQ(refinedOutside.countSubElements("Face"), 10);
+}
+
+TEST_F(FeaturePartMakeElementRefineTest, makeElementRefineCoaxialCylinders)
+{
+    // Arrange
+    TopoDS_Shape lower = BRepPrimAPI_MakeCylinder(gp_Ax2(), 1.0, 2.0).Shape();
+    auto upper = [](double radius, bool reversed) {
+        gp_Ax2 axis = reversed ? gp_Ax2(gp_Pnt(0.0, 0.0, 5.0), -gp::DZ())
+                               : gp_Ax2(gp_Pnt(0.0, 0.0, 2.0), gp::DZ());
+        return BRepPrimAPI_MakeCylinder(axis, radius, 3.0).Shape();
+    };
+    Part::TopoShape same = fuse(lower, upper(1.0, false));
+    Part::TopoShape reversed = fuse(lower, upper(1.0, true));
+    Part::TopoShape inside = fuse(lower, upper(1.0 + 0.1 * Precision::Confusion(), false));
+    Part::TopoShape outside = fuse(lower, upper(1.0 + 10.0 * Precision::Confusion(), false));
+    // Act
+    Part::TopoShape refinedSame = same.makeElementRefine();
+    Part::TopoShape refinedReversed = reversed.makeElementRefine();
+    Part::TopoShape refinedInside = inside.makeElementRefine();
+    Part::TopoShape refinedOutside = outside.makeElementRefine();
+    // Assert
+    EXPECT_EQ(same.countSubElements("Face"), 4);
+    // The lateral faces are united, leaving the top, the bottom and one lateral face
+    EXPECT_EQ(refinedSame.countSubElements("Face"), 3);
+    EXPECT_EQ(refinedReversed.countSubElements("Face"), 3);
+    EXPECT_EQ(refinedInside.countSubElements("Face"), 3);
+    // Different radii, the step is a small ring
+    EXPECT_EQ(refinedOutside.countSubElements("Face"), 5);
+    EXPECT_NEAR(PartTestHelpers::getVolume(refinedSame.getShape()), 5.0 * std::numbers::pi, 1e-6);
+}
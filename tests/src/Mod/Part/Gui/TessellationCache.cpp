@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <gp_Trsf.hxx>
+#include <TopLoc_Location.hxx>
+#include <Inventor/SoDB.h>
+#include <Inventor/nodes/SoCoordinate3.h>
+#include <Inventor/nodes/SoNormal.h>
+
+#include <Mod/Part/Gui/SoBrepEdgeSet.h>
+#include <Mod/Part/Gui/SoBrepFaceSet.h>
+#include <Mod/Part/Gui/SoBrepPointSet.h>
+#include <Mod/Part/Gui/TessellationCache.h>
+#include <src/App/InitApplication.h>
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+using PartGui::TessellationCache;
+
+class TessellationCacheTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+        SoDB::init();
+        PartGui::SoBrepFaceSet::initClass();
+        PartGui::SoBrepEdgeSet::initClass();
+        PartGui::SoBrepPointSet::initClass();
+    }
+
+    void SetUp() override
+    {
+        _maxMemSize = cache().maxMemSize();
+        cache().clear();
+        cache().setMaxMemSize(64 * 1024 * 1024);
+    }
+
+    void TearDown() override
+    {
+        cache().clear();
+        cache().setMaxMemSize(_maxMemSize);
+    }
+
+    static TessellationCache& cache()
+    {
+        return TessellationCache::instance();
+    }
+
+    static TessellationCache::Tessellation makeData(int points)
+    {
+        TessellationCache::Tessellation data;
+        data.points.resize(points);
+        data.normals.resize(points);
+        data.faceIndex.resize(points * 4);
+        data.partIndex.resize(6);
+        data.lineIndex.resize(points);
+        return data;
+    }
+
+    static TessellationCache::TessellationPtr store(const TopoDS_Shape& shape)
+    {
+        return cache().store(shape, 0.5, 28.5, false, makeData(100));
+    }
+
+    static TessellationCache::TessellationPtr find(const TopoDS_Shape& shape)
+    {
+        return cache().find(shape, 0.5, 28.5, false);
+    }
+
+private:
+    std::size_t _maxMemSize {0};
+};
+
+TEST_F(TessellationCacheTest, findReturnsStoredData)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    auto stored = store(box);
+
+    // Act
+    auto found = find(box);
+
+    // Assert
+    EXPECT_EQ(found, stored);
+    EXPECT_EQ(cache().size(), 1U);
+    EXPECT_GT(cache().memSize(), stored->memSize());
+}
+
+TEST_F(TessellationCacheTest, findIgnoresLocation)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    auto stored = store(box);
+    gp_Trsf move;
+    move.SetTranslation(gp_Vec(10.0, 0.0, 0.0));
+
+    // Act
+    auto found = find(box.Located(TopLoc_Location(move)));
+
+    // Assert
+    EXPECT_EQ(found, stored);
+}
+
+TEST_F(TessellationCacheTest, findMissesOtherShapeOrParameters)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    TopoDS_Shape other = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    store(box);
+
+    // Act
+    auto otherShape = find(other);
+    auto otherDeviation = cache().find(box, 0.1, 28.5, false);
+    auto otherNormals = cache().find(box, 0.5, 28.5, true);
+    auto reversed = find(box.Reversed());
+
+    // Assert
+    EXPECT_FALSE(otherShape);
+    EXPECT_FALSE(otherDeviation);
+    EXPECT_FALSE(otherNormals);
+    EXPECT_FALSE(reversed);
+}
+
+TEST_F(TessellationCacheTest, storeEvictsLeastRecentlyUsed)
+{
+    // Arrange
+    TopoDS_Shape first = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    TopoDS_Shape second = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    TopoDS_Shape third = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    store(first);
+    cache().setMaxMemSize(2 * cache().memSize());
+    store(second);
+    find(first);
+
+    // Act
+    store(third);
+
+    // Assert
+    EXPECT_EQ(cache().size(), 2U);
+    EXPECT_TRUE(find(first));
+    EXPECT_FALSE(find(second));
+    EXPECT_TRUE(find(third));
+    EXPECT_LE(cache().memSize(), cache().maxMemSize());
+}
+
+TEST_F(TessellationCacheTest, storeSkipsDataExceedingLimit)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    cache().setMaxMemSize(1024);
+
+    // Act
+    auto stored = cache().store(box, 0.5, 28.5, false, makeData(1000));
+
+    // Assert
+    ASSERT_TRUE(stored);
+    EXPECT_EQ(stored->points.size(), 1000U);
+    EXPECT_EQ(cache().size(), 0U);
+    EXPECT_FALSE(find(box));
+}
+
+TEST_F(TessellationCacheTest, setMaxMemSizeEvictsEntries)
+{
+    // Arrange
+    store(BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape());
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    store(box);
+
+    // Act
+    cache().setMaxMemSize(0);
+
+    // Assert
+    EXPECT_EQ(cache().size(), 0U);
+    EXPECT_EQ(cache().memSize(), 0U);
+    EXPECT_FALSE(find(box));
+}
+
+TEST_F(TessellationCacheTest, removeDropsEntry)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    auto stored = store(box);
+
+    // Act
+    cache().remove(box, 0.5, 28.5, false);
+
+    // Assert
+    EXPECT_FALSE(find(box));
+    EXPECT_EQ(cache().memSize(), 0U);
+    // the data is still usable by whoever holds it
+    EXPECT_EQ(stored->points.size(), 100U);
+}
+
+TEST_F(TessellationCacheTest, pruneDropsUnusedShapes)
+{
+    // Arrange
+    TopoDS_Shape kept = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    store(kept);
+    {
+        TopoDS_Shape dropped = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+        store(dropped);
+    }
+
+    // Act
+    cache().prune();
+
+    // Assert
+    EXPECT_EQ(cache().size(), 1U);
+    EXPECT_TRUE(find(kept));
+}
+
+TEST_F(TessellationCacheTest, nodesFollowShapeModifiedTwice)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    auto coords = new SoCoordinate3();
+    auto faceset = new PartGui::SoBrepFaceSet();
+    auto norm = new SoNormal();
+    auto lineset = new PartGui::SoBrepEdgeSet();
+    auto nodeset = new PartGui::SoBrepPointSet();
+    for (SoNode* node : {static_cast<SoNode*>(coords),
+                         static_cast<SoNode*>(faceset),
+                         static_cast<SoNode*>(norm),
+                         static_cast<SoNode*>(lineset),
+                         static_cast<SoNode*>(nodeset)}) {
+        node->ref();
+    }
+    TessellationCache::apply(*store(box), coords, faceset, norm, lineset, nodeset);
+    // the nodes of another view provider showing the same shape, see ViewProviderPartExt
+    boost::signals2::scoped_connection connection = cache().signalStored.connect(
+        [&](const TopoDS_Shape& shape,
+            double,
+            double,
+            bool,
+            const TessellationCache::TessellationPtr& data) {
+            if (shape.TShape() == box.TShape()) {
+                TessellationCache::release(coords, faceset, norm, lineset);
+                TessellationCache::apply(*data, coords, faceset, norm, lineset, nodeset);
+            }
+        });
+
+    for (float x : {1.0F, 2.0F}) {
+        // Act
+        auto modified = makeData(100 + static_cast<int>(x));
+        modified.points.front().setValue(x, 0.0F, 0.0F);
+        cache().remove(box, 0.5, 28.5, false);
+        auto stored = cache().store(box, 0.5, 28.5, false, std::move(modified));
+
+        // Assert
+        ASSERT_EQ(coords->point.getNum(), static_cast<int>(stored->points.size()));
+        EXPECT_EQ(coords->point.getValues(0), stored->points.data());
+        EXPECT_EQ(coords->point[0], SbVec3f(x, 0.0F, 0.0F));
+        EXPECT_EQ(faceset->coordIndex.getValues(0), stored->faceIndex.data());
+        EXPECT_EQ(lineset->coordIndex.getNum(), static_cast<int>(stored->lineIndex.size()));
+    }
+
+    TessellationCache::release(coords, faceset, norm, lineset);
+    for (SoNode* node : {static_cast<SoNode*>(coords),
+                         static_cast<SoNode*>(faceset),
+                         static_cast<SoNode*>(norm),
+                         static_cast<SoNode*>(lineset),
+                         static_cast<SoNode*>(nodeset)}) {
+        node->unref();
+    }
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
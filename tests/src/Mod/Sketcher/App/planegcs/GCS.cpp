@@ -1,5 +1,10 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
 #include <gtest/gtest.h>
 
 #include "Mod/Sketcher/App/planegcs/GCS.h"
@@ -31,6 +36,152 @@ protected:
         return _system.get();
     }
 
+    // A grid of size x size points where neighbouring points have a distance of 1 and the points
+    // of a row are horizontal. The first point is fixed, the others start off their positions.
+    struct Grid
+    {
+        explicit Grid(int size)
+            : size(size)
+            , values(2 * size * size)
+            , points(size * size)
+        {
+            for (int i = 0; i < size * size; ++i) {
+                values[2 * i] = (i % size) + 0.1 * std::sin(i);
+                values[2 * i + 1] = (i / size) + 0.1 * std::cos(i);
+                points[i].x = &values[2 * i];
+                points[i].y = &values[2 * i + 1];
+                params.push_back(points[i].x);
+                params.push_back(points[i].y);
+            }
+        }
+
+        GCS::Point& point(int row, int col)
+        {
+            return points[row * size + col];
+        }
+
+        void addConstraints(GCS::System* system)
+        {
+            system->addConstraintCoordinateX(point(0, 0), &origin);
+            system->addConstraintCoordinateY(point(0, 0), &origin);
+            for (int row = 0; row < size; ++row) {
+                for (int col = 0; col < size; ++col) {
+                    if (col + 1 < size) {
+                        system->addConstraintHorizontal(point(row, col), point(row, col + 1));
+                        system->addConstraintP2PDistance(point(row, col),
+                                                         point(row, col + 1),
+                                                         &distance);
+                    }
+                    if (row + 1 < size) {
+                        system->addConstraintP2PDistance(point(row, col),
+                                                         point(row + 1, col),
+                                                         &distance);
+                    }
+                }
+            }
+        }
+
+        // Keeps the rows from sliding sideways, so that the solution is unique
+        void addColumnConstraints(GCS::System* system)
+        {
+            for (int row = 0; row + 1 < size; ++row) {
+                system->addConstraintVertical(point(row, 0), point(row + 1, 0));
+            }
+        }
+
+        double maxError()
+        {
+            double error = std::max(std::fabs(*point(0, 0).x), std::fabs(*point(0, 0).y));
+            auto distanceError = [](GCS::Point& p1, GCS::Point& p2) {
+                return std::fabs(std::hypot(*p1.x - *p2.x, *p1.y - *p2.y) - 1.0);
+            };
+            for (int row = 0; row < size; ++row) {
+                for (int col = 0; col < size; ++col) {
+                    if (col + 1 < size) {
+                        error = std::max(error,
+                                         std::fabs(*point(row, col).y - *point(row, col + 1).y));
+                        error = std::max(error, distanceError(point(row, col), point(row, col + 1)));
+                    }
+                    if (row + 1 < size) {
+                        error = std::max(error, distanceError(point(row, col), point(row + 1, col)));
+                    }
+                }
+            }
+            return error;
+        }
+
+        int size;
+        double origin {0.0};
+        double distance {1.0};
+        std::vector<double> values;
+        std::vector<GCS::Point> points;
+        std::vector<double*> params;
+    };
+
+    // Rectangles with a fixed width, each of them a decoupled component of the system. The
+    // constraints are tagged like the constraints of a sketch.
+    struct Rectangles
+    {
+        explicit Rectangles(int count)
+            : values(8 * count)
+            , points(4 * count)
+        {
+            for (int i = 0; i < 4 * count; ++i) {
+                points[i].x = &values[2 * i];
+                points[i].y = &values[2 * i + 1];
+                *points[i].x = 3.0 * (i / 4) + (i % 4 == 1 || i % 4 == 2 ? width : 0.0);
+                *points[i].y = i % 4 >= 2 ? 1.0 : 0.0;
+                params.push_back(points[i].x);
+                params.push_back(points[i].y);
+            }
+        }
+
+        GCS::Point* corners(int index)
+        {
+            return &points[4 * index];
+        }
+
+        // adds 5 constraints per rectangle with the tags 1, 2, ...
+        void addConstraints(GCS::System* system)
+        {
+            int tag = 0;
+            for (std::size_t i = 0; i < points.size() / 4; ++i) {
+                GCS::Point* c = corners(int(i));
+                system->addConstraintHorizontal(c[0], c[1], ++tag);
+                system->addConstraintVertical(c[1], c[2], ++tag);
+                system->addConstraintHorizontal(c[2], c[3], ++tag);
+                system->addConstraintVertical(c[3], c[0], ++tag);
+                system->addConstraintP2PDistance(c[0], c[1], &width, ++tag);
+            }
+        }
+
+        double width {2.0};
+        std::vector<double> values;
+        std::vector<GCS::Point> points;
+        std::vector<double*> params;
+    };
+
+    // Solves a grid and returns the time in milliseconds spent in the solver, i.e. without the
+    // diagnosis of the system
+    double solveGrid(int size, GCS::Algorithm alg, GCS::JacobianStorage storage)
+    {
+        Grid grid(size);
+        SystemTest system;
+        system.jacobianStorage = storage;
+        grid.addConstraints(&system);
+        system.declareUnknowns(grid.params);
+        system.initSolution(alg);
+
+        auto start = std::chrono::steady_clock::now();
+        int result = system.solve(true, alg);
+        auto time = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ(result, GCS::Success);
+        system.applySolution();
+        EXPECT_LT(grid.maxError(), 1e-6);
+        return std::chrono::duration<double, std::milli>(time).count();
+    }
+
 private:
     std::unique_ptr<SystemTest> _system;
 };
@@ -50,3 +201,240 @@ TEST_F(GCSTest, clearConstraints)  // NOLINT
     // Assert
     EXPECT_EQ(0, System()->getNumberOfConstraints());
 }
+
+TEST_F(GCSTest, sparseJacobianSolvesLikeDense)  // NOLINT
+{
+    auto solve = [](GCS::Algorithm alg, GCS::JacobianStorage storage) {
+        Grid grid(6);
+        SystemTest system;
+        system.jacobianStorage = storage;
+        grid.addConstraints(&system);
+        grid.addColumnConstraints(&system);
+        EXPECT_EQ(system.solve(grid.params, true, alg), GCS::Success);
+        system.applySolution();
+        EXPECT_LT(grid.maxError(), 1e-6);
+        return grid.values;
+    };
+
+    for (auto alg : {GCS::LevenbergMarquardt, GCS::DogLeg}) {
+        std::vector<double> dense = solve(alg, GCS::DenseJacobian);
+        std::vector<double> sparse = solve(alg, GCS::SparseJacobian);
+
+        ASSERT_EQ(sparse.size(), dense.size());
+        for (std::size_t i = 0; i < dense.size(); ++i) {
+            EXPECT_NEAR(sparse[i], dense[i], 1e-6) << "parameter " << i;
+        }
+    }
+}
+
+TEST_F(GCSTest, DISABLED_sparseJacobianScaling)  // NOLINT
+{
+    // Benchmark, takes several seconds. The grids have about 3 * size^2 constraints. The dense solver is left out for the largest
+    // grid because it already takes several seconds there.
+    for (int size : {8, 16, 28}) {
+        std::string name = std::to_string(3 * size * (size - 1) + 2) + "Constraints";
+        if (size < 28) {
+            RecordProperty("DenseDogLeg" + name,
+                           std::to_string(solveGrid(size, GCS::DogLeg, GCS::DenseJacobian)));
+        }
+        RecordProperty("SparseDogLeg" + name,
+                       std::to_string(solveGrid(size, GCS::DogLeg, GCS::SparseJacobian)));
+    }
+}
+
+TEST_F(GCSTest, incrementalSolveMovesOnlyDraggedComponents)  // NOLINT
+{
+    // Rectangles with a fixed width, each of them a decoupled component of the system. A corner
+    // of the first rectangle is dragged with a temporary constraint like in the sketcher.
+    const int count = 250;
+    double width = 2.0;
+    std::vector<double> values(8 * count);
+    std::vector<GCS::Point> points(4 * count);
+    std::vector<double*> params;
+    for (int i = 0; i < 4 * count; ++i) {
+        points[i].x = &values[2 * i];
+        points[i].y = &values[2 * i + 1];
+        *points[i].x = 3.0 * (i / 4) + (i % 4 == 1 || i % 4 == 2 ? width : 0.0);
+        *points[i].y = i % 4 >= 2 ? 1.0 : 0.0;
+        params.push_back(points[i].x);
+        params.push_back(points[i].y);
+    }
+    for (int i = 0; i < count; ++i) {
+        GCS::Point* corners = &points[4 * i];
+        System()->addConstraintHorizontal(corners[0], corners[1]);
+        System()->addConstraintVertical(corners[1], corners[2]);
+        System()->addConstraintHorizontal(corners[2], corners[3]);
+        System()->addConstraintVertical(corners[3], corners[0]);
+        System()->addConstraintP2PDistance(corners[0], corners[1], &width);
+    }
+
+    double mouse[2] = {*points[2].x, *points[2].y};
+    GCS::Point target {&mouse[0], &mouse[1]};
+    System()->addConstraintP2PCoincident(target, points[2], GCS::DefaultTemporaryConstraint);
+    System()->declareUnknowns(params);
+    System()->initSolution();
+
+    // the same sequence of mouse moves with both solvers
+    const std::vector<double> initial = values;
+    auto drag = [&](bool incremental) {
+        values = initial;
+        auto start = std::chrono::steady_clock::now();
+        for (int step = 1; step <= 50; ++step) {
+            mouse[0] = width + 0.05 * step;
+            mouse[1] = 1.0 + 0.03 * step;
+            int result = incremental ? System()->solveIncremental() : System()->solve();
+            EXPECT_EQ(result, GCS::Success);
+            System()->applySolution();
+            EXPECT_NEAR(*points[2].x, mouse[0], 1e-6);
+            EXPECT_NEAR(*points[2].y, mouse[1], 1e-6);
+        }
+        auto time = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::milli>(time).count() / 50;
+    };
+
+    RecordProperty("FullSolveMilliseconds", std::to_string(drag(false)));
+    const std::vector<double> full = values;
+    RecordProperty("IncrementalSolveMilliseconds", std::to_string(drag(true)));
+
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_NEAR(values[i], full[i], 1e-6);
+    }
+    for (int i = 8; i < 8 * count; ++i) {
+        EXPECT_EQ(values[i], initial[i]);
+    }
+}
+
+TEST_F(GCSTest, parallelSolveMatchesSequentialSolve)  // NOLINT
+{
+    // Separate grids are decoupled components that are solved concurrently unless the system is
+    // too small for it
+    auto solveGrids = [](int minParallelSolveParams, std::vector<double>& values) {
+        std::vector<std::unique_ptr<Grid>> grids;
+        SystemTest system;
+        system.minParallelSolveParams = minParallelSolveParams;
+        std::vector<double*> params;
+        for (int i = 0; i < 8; ++i) {
+            auto& grid = grids.emplace_back(std::make_unique<Grid>(6));
+            grid->addConstraints(&system);
+            params.insert(params.end(), grid->params.begin(), grid->params.end());
+        }
+        system.declareUnknowns(params);
+        system.initSolution();
+
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_EQ(system.solve(true, GCS::DogLeg), GCS::Success);
+        auto time = std::chrono::steady_clock::now() - start;
+
+        system.applySolution();
+        values.clear();
+        for (auto& grid : grids) {
+            EXPECT_LT(grid->maxError(), 1e-6);
+            values.insert(values.end(), grid->values.begin(), grid->values.end());
+        }
+        return std::to_string(std::chrono::duration<double, std::milli>(time).count());
+    };
+
+    std::vector<double> sequential;
+    std::vector<double> parallel;
+    RecordProperty("SequentialMilliseconds", solveGrids(std::numeric_limits<int>::max(), sequential));
+    RecordProperty("ParallelMilliseconds", solveGrids(0, parallel));
+    EXPECT_EQ(sequential, parallel);
+}
+
+TEST_F(GCSTest, rediagnosisReusesUnchangedComponents)  // NOLINT
+{
+    // The sketcher rebuilds and diagnoses the system after every change. Only the component with
+    // the added constraint has to be decomposed again.
+    for (int count : {200, 400, 1000, 2000}) {
+        std::string name = std::to_string(5 * count) + "Constraints";
+        Rectangles rectangles(count);
+        SystemTest system;
+        rectangles.addConstraints(&system);
+        system.declareUnknowns(rectangles.params);
+
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_EQ(system.diagnose(), 3 * count);
+        auto time = std::chrono::steady_clock::now() - start;
+        RecordProperty("Diagnose" + name,
+                       std::to_string(std::chrono::duration<double, std::milli>(time).count()));
+
+        // a redundant constraint on the last rectangle
+        system.clear();
+        rectangles.addConstraints(&system);
+        GCS::Point* corners = rectangles.corners(count - 1);
+        system.addConstraintHorizontal(corners[0], corners[1], 5 * count + 1);
+        system.declareUnknowns(rectangles.params);
+
+        start = std::chrono::steady_clock::now();
+        EXPECT_EQ(system.diagnose(), 3 * count);
+        time = std::chrono::steady_clock::now() - start;
+        RecordProperty("Rediagnose" + name,
+                       std::to_string(std::chrono::duration<double, std::milli>(time).count()));
+
+        GCS::VEC_I redundant;
+        system.getRedundant(redundant);
+        EXPECT_EQ(redundant, GCS::VEC_I {5 * count + 1});
+    }
+}
+
+TEST_F(GCSTest, rediagnosisMatchesDiagnosisOfNewSystem)  // NOLINT
+{
+    // Arrange
+    Rectangles rectangles(6);
+    double height {1.5};
+    auto addConstraints = [&](GCS::System* system) {
+        rectangles.addConstraints(system);
+        GCS::Point* corners = rectangles.corners(1);
+        system->addConstraintHorizontal(corners[0], corners[1], 31);  // redundant
+        corners = rectangles.corners(2);
+        system->addConstraintP2PDistance(corners[1], corners[2], &height, 32);  // conflicting
+        system->addConstraintP2PDistance(corners[2], corners[1], &rectangles.width, 33);
+        // couples the last two rectangles
+        system->addConstraintP2PCoincident(rectangles.corners(4)[2], rectangles.corners(5)[0], 34);
+    };
+    auto expectSameDiagnosis = [](SystemTest& system1, SystemTest& system2) {
+        GCS::VEC_I tags1, tags2;
+        system1.getConflicting(tags1);
+        system2.getConflicting(tags2);
+        EXPECT_EQ(tags1, tags2);
+        system1.getRedundant(tags1);
+        system2.getRedundant(tags2);
+        EXPECT_EQ(tags1, tags2);
+        system1.getPartiallyRedundant(tags1);
+        system2.getPartiallyRedundant(tags2);
+        EXPECT_EQ(tags1, tags2);
+        GCS::VEC_pD params1, params2;
+        system1.getDependentParams(params1);
+        system2.getDependentParams(params2);
+        std::sort(params1.begin(), params1.end());
+        std::sort(params2.begin(), params2.end());
+        EXPECT_EQ(params1, params2);
+    };
+
+    SystemTest system;
+    addConstraints(&system);
+    system.declareUnknowns(rectangles.params);
+    int dofs = system.diagnose();
+
+    // Act: rebuild the system like the sketcher, moving the corner of a rectangle
+    *rectangles.corners(3)[2].x += 0.5;
+    system.clear();
+    addConstraints(&system);
+    system.declareUnknowns(rectangles.params);
+    int rediagnosedDofs = system.diagnose();
+
+    SystemTest newSystem;
+    addConstraints(&newSystem);
+    newSystem.declareUnknowns(rectangles.params);
+    int newDofs = newSystem.diagnose();
+
+    // Assert
+    EXPECT_EQ(dofs, rediagnosedDofs);
+    EXPECT_EQ(rediagnosedDofs, newDofs);
+    expectSameDiagnosis(system, newSystem);
+    GCS::VEC_I tags;
+    system.getRedundant(tags);
+    EXPECT_EQ(tags, GCS::VEC_I {31});
+    system.getConflicting(tags);
+    EXPECT_FALSE(tags.empty());
+}
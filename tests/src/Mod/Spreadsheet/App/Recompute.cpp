@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <set>
+#include <string>
+
+#include <App/Document.h>
+#include <App/PropertyStandard.h>
+#include <Mod/Spreadsheet/App/Sheet.h>
+
+#include "src/App/InitApplication.h"
+
+class SheetRecompute: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        _doc = App::GetApplication().newDocument(_docName.c_str(), "testUser");
+        _sheet = freecad_cast<Spreadsheet::Sheet*>(_doc->addObject("Spreadsheet::Sheet", "Sheet"));
+        _connection = _sheet->cellUpdated.connect([this](App::CellAddress address) {
+            _updated.insert(address.toString());
+        });
+    }
+
+    void TearDown() override
+    {
+        _connection.disconnect();
+        App::GetApplication().closeDocument(_docName.c_str());
+    }
+
+    Spreadsheet::Sheet* sheet()
+    {
+        return _sheet;
+    }
+
+    /// Recompute the document and return the addresses of the recomputed cells
+    std::set<std::string> recompute()
+    {
+        _updated.clear();
+        _doc->recompute();
+        return _updated;
+    }
+
+    long valueOf(const char* address)
+    {
+        auto prop = freecad_cast<App::PropertyInteger*>(_sheet->getPropertyByName(address));
+        return prop ? prop->getValue() : -1;
+    }
+
+    bool hasException(const char* address)
+    {
+        auto cell = _sheet->getCell(App::CellAddress(address));
+        return cell && cell->hasException();
+    }
+
+private:
+    std::string _docName;
+    App::Document* _doc {};
+    Spreadsheet::Sheet* _sheet {};
+    boost::signals2::scoped_connection _connection;
+    std::set<std::string> _updated;
+};
+
+TEST_F(SheetRecompute, onlyDependantsAreRecomputed)
+{
+    // Arrange
+    sheet()->setCell("A1", "1");
+    sheet()->setCell("B1", "=A1 + 1");
+    sheet()->setCell("C1", "=B1 * 2");
+    sheet()->setCell("D1", "5");
+    sheet()->setCell("D2", "=D1");
+    recompute();
+
+    // Act
+    sheet()->setCell("A1", "3");
+    auto updated = recompute();
+
+    // Assert
+    EXPECT_EQ(updated, (std::set<std::string> {"A1", "B1", "C1"}));
+    EXPECT_EQ(valueOf("B1"), 4);
+    EXPECT_EQ(valueOf("C1"), 8);
+    EXPECT_EQ(valueOf("D2"), 5);
+}
+
+TEST_F(SheetRecompute, dependantCellsFollowEdits)
+{
+    // Arrange
+    sheet()->setCell("A1", "1");
+    sheet()->setCell("A2", "2");
+    sheet()->setCell("B1", "=A1 + A1");
+    recompute();
+    auto dependants = [this](const char* address) {
+        auto cells = sheet()->getCells()->getDependantCells(App::CellAddress(address));
+        std::set<std::string> result;
+        for (const auto& cell : cells) {
+            result.insert(cell.toString());
+        }
+        return result;
+    };
+
+    // Act
+    sheet()->setCell("B1", "=A2 * 2");
+    recompute();
+
+    // Assert
+    EXPECT_TRUE(dependants("A1").empty());
+    EXPECT_EQ(dependants("A2"), std::set<std::string> {"B1"});
+    EXPECT_EQ(valueOf("B1"), 4);
+}
+
+TEST_F(SheetRecompute, aliasesAreDependencies)
+{
+    // Arrange
+    sheet()->setCell("A1", "2");
+    sheet()->setAlias(App::CellAddress("A1"), "Width");
+    sheet()->setCell("B1", "=Width * 3");
+    recompute();
+
+    // Act
+    sheet()->setCell("A1", "4");
+    auto updated = recompute();
+
+    // Assert
+    EXPECT_EQ(updated, (std::set<std::string> {"A1", "B1"}));
+    EXPECT_EQ(valueOf("B1"), 12);
+}
+
+TEST_F(SheetRecompute, cyclesAreReported)
+{
+    // Arrange
+    sheet()->setCell("A1", "=B1 + 1");
+    sheet()->setCell("B1", "=A1 + 1");
+    sheet()->setCell("C1", "=A1");
+
+    // Act
+    recompute();
+    bool cyclic = hasException("A1") && hasException("B1") && hasException("C1");
+    sheet()->setCell("B1", "1");
+    recompute();
+
+    // Assert
+    EXPECT_TRUE(cyclic);
+    EXPECT_FALSE(hasException("A1"));
+    EXPECT_FALSE(hasException("C1"));
+    EXPECT_EQ(valueOf("C1"), 2);
+}
+
+TEST_F(SheetRecompute, DISABLED_benchmark)
+{
+    // Records the time of a full recompute and of a single edit. Disabled by default because of
+    // its size, run it with --gtest_also_run_disabled_tests.
+    // Arrange: a parameter table with 50000 cells, half of them formulas
+    const int rows = 25000;
+    for (int row = 1; row <= rows; ++row) {
+        std::string index = std::to_string(row);
+        sheet()->setCell(("A" + index).c_str(), index.c_str());
+        sheet()->setCell(("B" + index).c_str(), ("=A" + index + " * 2").c_str());
+    }
+    auto start = std::chrono::steady_clock::now();
+    recompute();
+    auto full = std::chrono::steady_clock::now() - start;
+
+    // Act
+    sheet()->setCell("A100", "1000");
+    start = std::chrono::steady_clock::now();
+    auto updated = recompute();
+    auto single = std::chrono::steady_clock::now() - start;
+
+    // Assert
+    RecordProperty("FullRecomputeMilliseconds",
+                   std::to_string(std::chrono::duration<double, std::milli>(full).count()));
+    RecordProperty("SingleEditMilliseconds",
+                   std::to_string(std::chrono::duration<double, std::milli>(single).count()));
+    EXPECT_EQ(updated, (std::set<std::string> {"A100", "B100"}));
+    EXPECT_EQ(valueOf("B100"), 2000);
+    EXPECT_EQ(valueOf("B25000"), 50000);
+}